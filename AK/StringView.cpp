@@ -206,6 +206,15 @@ bool StringView::is_ascii() const
     return simdutf::validate_ascii(characters_without_null_termination(), length());
 }
 
+size_t StringView::ascii_prefix_length() const
+{
+    if (is_empty())
+        return 0;
+
+    auto result = simdutf::validate_ascii_with_errors(characters_without_null_termination(), length());
+    return result.error == simdutf::SUCCESS ? length() : result.count;
+}
+
 String StringView::to_ascii_lowercase_string() const
 {
     VERIFY(Utf8View { *this }.validate());
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCompress/Brotli.h>
+
+#include <brotli/decode.h>
+
+namespace Compress {
+
+ErrorOr<NonnullOwnPtr<BrotliDecompressor>> BrotliDecompressor::create(MaybeOwned<Stream> stream)
+{
+    auto buffer = TRY(AK::FixedArray<u8>::create(16 * 1024));
+
+    auto* state = BrotliDecoderCreateInstance(nullptr, nullptr, nullptr);
+    if (!state)
+        return Error::from_errno(ENOMEM);
+
+    auto decompressor = adopt_own_if_nonnull(new (nothrow) BrotliDecompressor(move(buffer), move(stream), state));
+    if (!decompressor) {
+        BrotliDecoderDestroyInstance(state);
+        return Error::from_errno(ENOMEM);
+    }
+    return decompressor.release_nonnull();
+}
+
+ErrorOr<ByteBuffer> BrotliDecompressor::decompress_all(ReadonlyBytes bytes)
+{
+    FixedMemoryStream input_stream { bytes };
+    auto brotli_stream = TRY(BrotliDecompressor::create(MaybeOwned<Stream> { input_stream }));
+
+    ByteBuffer output;
+    Array<u8, 4096> buffer;
+    while (!brotli_stream->is_eof()) {
+        auto decompressed = TRY(brotli_stream->read_some(buffer));
+
+        // NOTE: Without this, a truncated stream would keep asking for more input forever.
+        if (decompressed.is_empty() && brotli_stream->m_available_input.is_empty() && input_stream.is_eof())
+            return Error::from_string_literal("brotli stream is truncated");
+
+        TRY(output.try_append(decompressed));
+    }
+    return output;
+}
+
+BrotliDecompressor::BrotliDecompressor(AK::FixedArray<u8> buffer, MaybeOwned<Stream> stream, BrotliDecoderState* state)
+    : m_stream(move(stream))
+    , m_state(state)
+    , m_buffer(move(buffer))
+{
+}
+
+BrotliDecompressor::~BrotliDecompressor()
+{
+    BrotliDecoderDestroyInstance(m_state);
+}
+
+ErrorOr<Bytes> BrotliDecompressor::read_some(Bytes bytes)
+{
+    if (m_eof)
+        return bytes.trim(0);
+
+    if (m_available_input.is_empty())
+        m_available_input = TRY(m_stream->read_some(m_buffer.span()));
+
+    size_t available_in = m_available_input.size();
+    auto const* next_in = m_available_input.data();
+    size_t available_out = bytes.size();
+    auto* next_out = bytes.data();
+
+    auto result = BrotliDecoderDecompressStream(m_state, &available_in, &next_in, &available_out, &next_out, nullptr);
+    m_available_input = m_available_input.slice(m_available_input.size() - available_in);
+
+    switch (result) {
+    case BROTLI_DECODER_RESULT_ERROR:
+        return Error::from_string_literal("brotli data error");
+    case BROTLI_DECODER_RESULT_SUCCESS:
+        m_eof = true;
+        break;
+    case BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT:
+    case BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT:
+        break;
+    }
+
+    return bytes.slice(0, bytes.size() - available_out);
+}
+
+ErrorOr<size_t> BrotliDecompressor::write_some(ReadonlyBytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+bool BrotliDecompressor::is_eof() const
+{
+    return m_eof;
+}
+
+bool BrotliDecompressor::is_open() const
+{
+    return m_stream->is_open();
+}
+
+void BrotliDecompressor::close()
+{
+}
+
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/FixedArray.h>
+#include <AK/MaybeOwned.h>
+#include <AK/Stream.h>
+
+extern "C" {
+typedef struct BrotliDecoderStateStruct BrotliDecoderState;
+}
+
+namespace Compress {
+
+class BrotliDecompressor final : public Stream {
+    AK_MAKE_NONCOPYABLE(BrotliDecompressor);
+
+public:
+    static ErrorOr<NonnullOwnPtr<BrotliDecompressor>> create(MaybeOwned<Stream>);
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
+
+    ~BrotliDecompressor() override;
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+private:
+    BrotliDecompressor(AK::FixedArray<u8>, MaybeOwned<Stream>, BrotliDecoderState*);
+
+    MaybeOwned<Stream> m_stream;
+    BrotliDecoderState* m_state { nullptr };
+
+    bool m_eof { false };
+
+    AK::FixedArray<u8> m_buffer;
+    ReadonlyBytes m_available_input;
+};
+
+}
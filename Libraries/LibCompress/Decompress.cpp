@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <LibCompress/Decompress.h>
+
+namespace Compress {
+
+ErrorOr<void> decompress_available_input(Stream& decompressor, Stream const& input, Function<ErrorOr<IterationDecision>(ReadonlyBytes)> const& on_data)
+{
+    auto buffer = TRY(ByteBuffer::create_uninitialized(64 * KiB));
+
+    while (true) {
+        auto data = TRY(decompressor.read_some(buffer.bytes()));
+        if (data.is_empty()) {
+            // NOTE: A decompressor only takes in so much of its input at a time, so running out of output doesn't mean
+            //       that it has seen all of it.
+            if (input.is_eof() || decompressor.is_eof())
+                return {};
+            continue;
+        }
+
+        if (TRY(on_data(data)) == IterationDecision::Break)
+            return {};
+    }
+}
+
+}
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/IterationDecision.h>
+#include <AK/Stream.h>
+
+namespace Compress {
+
+// Hands the decompressed data to the callback, piece by piece, until the decompressor has used up all of the input
+// written to it so far or has reached the end of the compressed data.
+ErrorOr<void> decompress_available_input(Stream& decompressor, Stream const& input, Function<ErrorOr<IterationDecision>(ReadonlyBytes)> const& on_data);
+
+}
@@ -8,6 +8,7 @@
 
 namespace Compress {
 
+class BrotliDecompressor;
 class DeflateCompressor;
 class DeflateDecompressor;
 class GzipCompressor;
@@ -6,16 +6,158 @@
  */
 
 #include "UnsignedBigIntegerAlgorithms.h"
+#include <AK/BigIntBase.h>
 
 namespace Crypto {
 
+using AK::Detail::DoubleWord;
+using AK::Detail::wide_multiply;
+using Word = UnsignedBigInteger::Word;
+using StorageSpan = UnsignedBigInteger::StorageSpan;
+using ConstStorageSpan = UnsignedBigInteger::ConstStorageSpan;
+using Ops = AK::StorageOperations<Word>;
+
+// Below this many words in the shorter operand, the additions and subtractions Karatsuba needs cost more than the word
+// products it saves, so the schoolbook method is used.
+static constexpr size_t karatsuba_threshold = 32;
+
+static ConstStorageSpan slice(ConstStorageSpan span, size_t start, size_t length)
+{
+    VERIFY(start + length <= span.size());
+    return { span.data() + start, length };
+}
+
+static StorageSpan slice(StorageSpan span, size_t start, size_t length)
+{
+    VERIFY(start + length <= span.size());
+    return { span.data() + start, length };
+}
+
+static ConstStorageSpan as_const(StorageSpan span)
+{
+    return { span.data(), span.size() };
+}
+
+static void add_into(StorageSpan destination, ConstStorageSpan value)
+{
+    auto carry = Ops::add<false>(destination, value, destination);
+    VERIFY(carry == 0);
+}
+
+static void subtract_from(StorageSpan destination, ConstStorageSpan value)
+{
+    auto borrow = Ops::add<true>(destination, value, destination);
+    VERIFY(borrow == 0);
+}
+
 /**
- * Complexity: O(N^2) where N is the number of words in the larger number
+ * Complexity: O(N * M) where N and M are the number of words in the two numbers
  * Multiplication method:
- * An integer is equal to the sum of the powers of two
- * according to the indices of its 'on' bits.
- * So to multiple x*y, we go over each '1' bit in x (say the i'th bit),
- * and add y<<i to the result.
+ * Schoolbook, one row of double-word products per word of the right number.
+ */
+static void baseline_multiply(ConstStorageSpan left, ConstStorageSpan right, StorageSpan result)
+{
+    result.fill(0);
+    for (size_t right_index = 0; right_index < right.size(); ++right_index) {
+        auto right_word = right[right_index];
+        if (right_word == 0)
+            continue;
+
+        // NOTE: (2^32 - 1)^2 + 2 * (2^32 - 1) is exactly 2^64 - 1, so neither the addend nor the carry can overflow.
+        DoubleWord<Word> carry = 0;
+        for (size_t left_index = 0; left_index < left.size(); ++left_index) {
+            auto product = wide_multiply(left[left_index], right_word) + result[left_index + right_index] + carry;
+            result[left_index + right_index] = static_cast<Word>(product);
+            carry = product >> UnsignedBigInteger::BITS_IN_WORD;
+        }
+        result[left.size() + right_index] = static_cast<Word>(carry);
+    }
+}
+
+// The number of scratch words multiply_words() needs for operands of at most this many words.
+static size_t karatsuba_scratch_length(size_t length)
+{
+    if (length < karatsuba_threshold)
+        return 0;
+
+    // Every level needs the sums of both operands' halves and their product, plus whatever multiplying those needs.
+    auto half = (length + 1) / 2;
+    return 4 * (half + 1) + karatsuba_scratch_length(half + 1);
+}
+
+/**
+ * Complexity: O(N^log2(3)) where N is the number of words in the larger number
+ * Multiplication method:
+ * Karatsuba: split both numbers in halves at the same word, x = x1 * B + x0 and y = y1 * B + y0.
+ * Then x * y = z2 * B^2 + z1 * B + z0, where z2 = x1 * y1, z0 = x0 * y0 and z1 = (x0 + x1)(y0 + y1) - z2 - z0,
+ * which takes three multiplications of half the size instead of four.
+ */
+static void multiply_words(ConstStorageSpan left, ConstStorageSpan right, StorageSpan result, StorageSpan scratch)
+{
+    if (left.size() < right.size())
+        swap(left, right);
+
+    auto left_length = left.size();
+    auto right_length = right.size();
+    VERIFY(result.size() == left_length + right_length);
+
+    if (right_length < karatsuba_threshold) {
+        baseline_multiply(left, right, result);
+        return;
+    }
+
+    auto half = (left_length + 1) / 2;
+
+    if (right_length <= half) {
+        // The operands are too lopsided to split at the same word, so multiply one right-sized piece of the left
+        // operand at a time.
+        result.fill(0);
+        auto piece_product_storage = slice(scratch, 0, 2 * right_length);
+        auto rest_of_scratch = slice(scratch, 2 * right_length, scratch.size() - 2 * right_length);
+
+        for (size_t offset = 0; offset < left_length; offset += right_length) {
+            auto piece = slice(left, offset, min(right_length, left_length - offset));
+            auto piece_product = slice(piece_product_storage, 0, piece.size() + right_length);
+            multiply_words(piece, right, piece_product, rest_of_scratch);
+            add_into(slice(result, offset, result.size() - offset), as_const(piece_product));
+        }
+        return;
+    }
+
+    auto left_low = slice(left, 0, half);
+    auto left_high = slice(left, half, left_length - half);
+    auto right_low = slice(right, 0, half);
+    auto right_high = slice(right, half, right_length - half);
+
+    // z0 and z2 are computed straight into their place in the result.
+    auto low_product = slice(result, 0, 2 * half);
+    auto high_product = slice(result, 2 * half, result.size() - 2 * half);
+    multiply_words(left_low, right_low, low_product, scratch);
+    multiply_words(left_high, right_high, high_product, scratch);
+
+    auto left_sum = slice(scratch, 0, half + 1);
+    auto right_sum = slice(scratch, half + 1, half + 1);
+    auto middle_product = slice(scratch, 2 * (half + 1), 2 * (half + 1));
+    auto rest_of_scratch = slice(scratch, 4 * (half + 1), scratch.size() - 4 * (half + 1));
+
+    Ops::add<false>(left_low, left_high, left_sum);
+    Ops::add<false>(right_low, right_high, right_sum);
+    multiply_words(as_const(left_sum), as_const(right_sum), middle_product, rest_of_scratch);
+    subtract_from(middle_product, as_const(low_product));
+    subtract_from(middle_product, as_const(high_product));
+
+    // NOTE: z1 is less than the full product divided by B, so any of its words that lie past the end of the result
+    //       are zero.
+    auto middle_length = min(middle_product.size(), result.size() - half);
+    add_into(slice(result, half, result.size() - half), as_const(slice(middle_product, 0, middle_length)));
+}
+
+/**
+ * Complexity: O(N^2) where N is the number of words in the larger number, O(N^log2(3)) once both numbers are large
+ * Multiplication method:
+ * Schoolbook multiplication of whole words with double-word intermediate products for small numbers, and Karatsuba
+ * (see multiply_words() above) when both numbers have at least karatsuba_threshold words.
+ * temp_shift is used as scratch space for Karatsuba.
  */
 FLATTEN void UnsignedBigIntegerAlgorithms::multiply_without_allocation(
     UnsignedBigInteger const& left,
@@ -23,22 +165,23 @@ FLATTEN void UnsignedBigIntegerAlgorithms::multiply_without_allocation(
     UnsignedBigInteger& temp_shift,
     UnsignedBigInteger& output)
 {
+    auto left_length = left.trimmed_length();
+    auto right_length = right.trimmed_length();
+
     output.set_to_0();
+    if (left_length == 0 || right_length == 0)
+        return;
 
-    // iterate all bits
-    for (size_t word_index = 0; word_index < left.length(); ++word_index) {
-        for (size_t bit_index = 0; bit_index < UnsignedBigInteger::BITS_IN_WORD; ++bit_index) {
-            // If the bit is off - skip over it
-            if (!(left.m_words[word_index] & (1 << bit_index)))
-                continue;
+    output.resize_with_leading_zeros(left_length + right_length);
 
-            size_t shift_amount = word_index * UnsignedBigInteger::BITS_IN_WORD + bit_index;
+    temp_shift.set_to_0();
+    temp_shift.resize_with_leading_zeros(karatsuba_scratch_length(max(left_length, right_length)));
 
-            // output += (right << shift_amount);
-            shift_left_without_allocation(right, shift_amount, temp_shift);
-            add_into_accumulator_without_allocation(output, temp_shift);
-        }
-    }
+    multiply_words(
+        { left.m_words.data(), left_length }, { right.m_words.data(), right_length },
+        output.words_span(), temp_shift.words_span());
+
+    output.clamp_to_trimmed_length();
 }
 
 }
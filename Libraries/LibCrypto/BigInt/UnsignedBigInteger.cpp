@@ -16,6 +16,10 @@
 
 namespace Crypto {
 
+using AK::Detail::div_mod_words;
+using AK::Detail::DoubleWord;
+using AK::Detail::wide_multiply;
+
 UnsignedBigInteger::UnsignedBigInteger(u8 const* ptr, size_t length)
 {
     m_words.resize_and_keep_capacity((length + sizeof(u32) - 1) / sizeof(u32));
@@ -135,8 +139,24 @@ size_t UnsignedBigInteger::export_data(Bytes data, bool remove_leading_zeros) co
 ErrorOr<UnsignedBigInteger> UnsignedBigInteger::from_base(u16 N, StringView str)
 {
     VERIFY(N <= 36);
-    UnsignedBigInteger result;
-    UnsignedBigInteger base { N };
+
+    // NOTE: Rather than building a new integer for every digit, digits are gathered into a word until it's full, and
+    //       each full word is folded into the result with a single multiply-and-add pass.
+    Vector<Word, STARTING_WORD_SIZE> words;
+    Word chunk = 0;
+    Word chunk_multiplier = 1;
+    auto flush_chunk = [&] {
+        auto carry = static_cast<DoubleWord<Word>>(chunk);
+        for (auto& word : words) {
+            auto value = wide_multiply(word, chunk_multiplier) + carry;
+            word = static_cast<Word>(value);
+            carry = value >> BITS_IN_WORD;
+        }
+        if (carry != 0 || words.is_empty())
+            words.append(static_cast<Word>(carry));
+        chunk = 0;
+        chunk_multiplier = 1;
+    };
 
     for (auto const& c : str) {
         if (c == '_')
@@ -147,9 +167,15 @@ ErrorOr<UnsignedBigInteger> UnsignedBigInteger::from_base(u16 N, StringView str)
         if (digit >= N)
             return Error::from_string_literal("Base36 digit out of range");
 
-        result = result.multiplied_by(base).plus(digit);
+        chunk = chunk * N + digit;
+        chunk_multiplier *= N;
+        if (chunk_multiplier > NumericLimits<Word>::max() / N)
+            flush_chunk();
     }
-    return result;
+    if (chunk_multiplier != 1)
+        flush_chunk();
+
+    return UnsignedBigInteger { move(words) };
 }
 
 ErrorOr<String> UnsignedBigInteger::to_base(u16 N) const
@@ -158,16 +184,32 @@ ErrorOr<String> UnsignedBigInteger::to_base(u16 N) const
     if (*this == UnsignedBigInteger { 0 })
         return "0"_string;
 
-    StringBuilder builder;
-    UnsignedBigInteger temp(*this);
-    UnsignedBigInteger quotient;
-    UnsignedBigInteger remainder;
+    // NOTE: Rather than dividing the whole number by N for every digit, it's divided by the largest power of N that fits
+    //       in a word, and the remainder is turned into that many digits with plain word arithmetic.
+    Word chunk_divisor = N;
+    size_t digits_per_chunk = 1;
+    while (chunk_divisor <= NumericLimits<Word>::max() / N) {
+        chunk_divisor *= N;
+        ++digits_per_chunk;
+    }
 
-    while (temp != UnsignedBigInteger { 0 }) {
-        UnsignedBigIntegerAlgorithms::divide_u16_without_allocation(temp, N, quotient, remainder);
-        VERIFY(remainder.words()[0] < N);
-        TRY(builder.try_append(to_ascii_base36_digit(remainder.words()[0])));
-        temp.set_to(quotient);
+    StringBuilder builder;
+    auto length = trimmed_length();
+    Vector<Word, STARTING_WORD_SIZE> remaining_words;
+    TRY(remaining_words.try_append(m_words.data(), length));
+
+    while (length > 0) {
+        Word remainder = 0;
+        for (size_t i = length; i-- > 0;)
+            remaining_words[i] = div_mod_words(remaining_words[i], remainder, chunk_divisor, remainder);
+        while (length > 0 && remaining_words[length - 1] == 0)
+            --length;
+
+        // Every chunk but the most significant one is padded with zeros to its full width.
+        for (size_t i = 0; i < digits_per_chunk && (length > 0 || remainder != 0); ++i) {
+            TRY(builder.try_append(to_ascii_base36_digit(remainder % N)));
+            remainder /= N;
+        }
     }
 
     return TRY(builder.to_string()).reverse();
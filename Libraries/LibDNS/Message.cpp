@@ -102,11 +102,8 @@ ErrorOr<Message> Message::from_raw(ParseContext& ctx)
 
 ErrorOr<size_t> Message::to_raw(ByteBuffer& out) const
 {
-    // NOTE: This is minimally implemented to allow for sending queries,
-    //       server-side responses are not implemented yet.
-    VERIFY(header.answer_count == 0);
-    VERIFY(header.authority_count == 0);
-
+    // NOTE: Domain names are never compressed, and only the record types with a to_raw() implementation can be
+    //       written. That is enough to send queries and to answer them from a stub server.
     auto start_size = out.size();
 
     auto header_bytes = TRY(out.get_bytes_for_writing(sizeof(Header)));
@@ -115,6 +112,12 @@ ErrorOr<size_t> Message::to_raw(ByteBuffer& out) const
     for (size_t i = 0; i < header.question_count; i++)
         TRY(questions[i].to_raw(out));
 
+    for (size_t i = 0; i < header.answer_count; i++)
+        TRY(answers[i].to_raw(out));
+
+    for (size_t i = 0; i < header.authority_count; i++)
+        TRY(authorities[i].to_raw(out));
+
     for (size_t i = 0; i < header.additional_count; i++)
         TRY(additional_records[i].to_raw(out));
 
@@ -911,6 +914,19 @@ ErrorOr<Records::AAAA> Records::AAAA::from_raw(ParseContext& ctx)
     return Records::AAAA { IPv6Address { bit_cast<Array<u8, 16>>(address) } };
 }
 
+ErrorOr<void> Records::A::to_raw(ByteBuffer& buffer) const
+{
+    auto address_bytes = TRY(buffer.get_bytes_for_writing(sizeof(u32)));
+    auto raw_address = static_cast<LittleEndian<u32>>(address.to_u32());
+    memcpy(address_bytes.data(), &raw_address, sizeof(u32));
+    return {};
+}
+
+ErrorOr<void> Records::AAAA::to_raw(ByteBuffer& buffer) const
+{
+    return buffer.try_append(address.to_in6_addr_t(), sizeof(IPv6Address::in6_addr_t));
+}
+
 ErrorOr<Records::TXT> Records::TXT::from_raw(ParseContext& ctx)
 {
     // RFC 1035, 3.3.14. TXT RDATA format.
@@ -962,6 +978,20 @@ ErrorOr<Records::SOA> Records::SOA::from_raw(ParseContext& ctx)
     return Records::SOA { move(mname), move(rname), serial, refresh, retry, expire, minimum };
 }
 
+ErrorOr<void> Records::SOA::to_raw(ByteBuffer& buffer) const
+{
+    TRY(mname.to_raw(buffer));
+    TRY(rname.to_raw(buffer));
+
+    for (u32 value : { serial, refresh, retry, expire, minimum }) {
+        auto value_bytes = TRY(buffer.get_bytes_for_writing(sizeof(u32)));
+        auto net_value = static_cast<NetworkOrdered<u32>>(value);
+        memcpy(value_bytes.data(), &net_value, sizeof(u32));
+    }
+
+    return {};
+}
+
 ErrorOr<Records::MX> Records::MX::from_raw(ParseContext& ctx)
 {
     // RFC 1035, 3.3.9. MX RDATA format.
@@ -364,7 +364,7 @@ struct A {
 
     static constexpr ResourceType type = ResourceType::A;
     static ErrorOr<A> from_raw(ParseContext&);
-    ErrorOr<void> to_raw(ByteBuffer&) const { return Error::from_string_literal("Not implemented"); }
+    ErrorOr<void> to_raw(ByteBuffer&) const;
     ErrorOr<String> to_string() const { return address.to_string(); }
 };
 struct AAAA {
@@ -372,7 +372,7 @@ struct AAAA {
 
     static constexpr ResourceType type = ResourceType::AAAA;
     static ErrorOr<AAAA> from_raw(ParseContext&);
-    ErrorOr<void> to_raw(ByteBuffer&) const { return Error::from_string_literal("Not implemented"); }
+    ErrorOr<void> to_raw(ByteBuffer&) const;
     ErrorOr<String> to_string() const { return address.to_string(); }
 };
 struct TXT {
@@ -410,7 +410,7 @@ struct SOA {
 
     static constexpr ResourceType type = ResourceType::SOA;
     static ErrorOr<SOA> from_raw(ParseContext&);
-    ErrorOr<void> to_raw(ByteBuffer&) const { return Error::from_string_literal("Not implemented"); }
+    ErrorOr<void> to_raw(ByteBuffer&) const;
     ErrorOr<String> to_string() const
     {
         return String::formatted("SOA MName: '{}', RName: '{}', Serial: {}, Refresh: {}, Retry: {}, Expire: {}, Minimum: {}", mname.to_string(), rname.to_string(), serial, refresh, retry, expire, minimum);
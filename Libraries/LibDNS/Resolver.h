@@ -6,14 +6,16 @@
 
 #pragma once
 
+#include <AK/AnyOf.h>
 #include <AK/AtomicRefCounted.h>
+#include <AK/HashMap.h>
 #include <AK/HashTable.h>
 #include <AK/MaybeOwned.h>
 #include <AK/MemoryStream.h>
 #include <AK/Random.h>
 #include <AK/StringView.h>
 #include <AK/TemporaryChange.h>
-#include <LibCore/DateTime.h>
+#include <AK/Time.h>
 #include <LibCore/Promise.h>
 #include <LibCore/Socket.h>
 #include <LibCore/Timer.h>
@@ -27,6 +29,13 @@ class Resolver;
 class LookupResult : public AtomicRefCounted<LookupResult>
     , public Weakable<LookupResult> {
 public:
+    // Expired records are kept around for this long, so that a lookup can be answered immediately while the cache
+    // entry is refreshed in the background.
+    static constexpr AK::Duration stale_while_revalidate_window = AK::Duration::from_seconds(60);
+
+    // RFC 2308 suggests capping negative TTLs at one to three hours, a browser is better off asking again sooner.
+    static constexpr AK::Duration max_negative_ttl = AK::Duration::from_seconds(300);
+
     explicit LookupResult(Messages::DomainName name)
         : m_name(move(name))
     {
@@ -44,32 +53,47 @@ public:
         return result;
     }
 
-    void check_expiration()
+    void check_expiration(MonotonicTime now = MonotonicTime::now_coarse())
     {
         if (!m_valid)
             return;
 
-        auto now = Core::DateTime::now();
-        for (size_t i = 0; i < m_cached_records.size();) {
-            auto& record = m_cached_records[i];
-            if (record.expiration.has_value() && record.expiration.value() < now) {
-                dbgln_if(DNS_DEBUG, "DNS: Removing expired record for {}", m_name.to_string());
-                m_cached_records.remove(i);
-            } else {
-                dbgln_if(DNS_DEBUG, "DNS: Keeping record for {} (expires in {})", m_name.to_string(), record.expiration.has_value() ? record.expiration.value().to_string() : "never"_string);
-                ++i;
-            }
-        }
+        // NOTE: Nothing can have run out before the earliest expiration, so most calls end here.
+        if (!m_next_removal.has_value() || now < *m_next_removal)
+            return;
+
+        m_cached_records.remove_all_matching([&](auto const& record) {
+            if (!record.expiration.has_value() || now < *record.expiration + stale_while_revalidate_window)
+                return false;
+            dbgln_if(DNS_DEBUG, "DNS: Removing expired record for {}", m_name.to_string());
+            return true;
+        });
+        m_negative_answers.remove_all_matching([&](auto const& answer) {
+            return answer.expiration <= now;
+        });
+        update_expirations();
 
-        if (m_cached_records.is_empty() && m_request_done)
+        if (m_cached_records.is_empty() && m_negative_answers.is_empty() && m_request_done)
             m_valid = false;
     }
 
     void add_record(Messages::ResourceRecord record)
     {
         m_valid = true;
-        auto expiration = record.ttl > 0 ? Optional<Core::DateTime>(Core::DateTime::from_timestamp(Core::DateTime::now().timestamp() + record.ttl)) : OptionalNone();
+        auto expiration = record.ttl > 0 ? Optional<MonotonicTime>(MonotonicTime::now_coarse() + AK::Duration::from_seconds(record.ttl)) : OptionalNone();
         m_cached_records.append({ move(record), move(expiration) });
+        update_expirations();
+    }
+
+    // RFC 2308, 5. Caching Negative Answers
+    // Remembers that the name has no records of the given type (NXDOMAIN or NODATA), so that asking again does not go
+    // out to the network until the negative answer expires.
+    void add_negative_answer(Messages::ResourceType type, u32 ttl)
+    {
+        m_valid = true;
+        auto expiration = MonotonicTime::now_coarse() + min(AK::Duration::from_seconds(ttl), max_negative_ttl);
+        m_negative_answers.append({ type, expiration });
+        update_expirations();
     }
 
     Vector<Messages::ResourceRecord> records() const
@@ -80,6 +104,7 @@ public:
         return result;
     }
 
+    // NOTE: A type for which the server told us there are no records counts as known, it just has no records.
     bool has_record_of_type(Messages::ResourceType type, bool later = false) const
     {
         if (later && m_desired_types.contains(type))
@@ -89,43 +114,112 @@ public:
             if (re.record.type == type)
                 return true;
         }
+        for (auto const& answer : m_negative_answers) {
+            if (answer.type == type)
+                return true;
+        }
         return false;
     }
 
+    // True if some records have outlived their TTL but are still within the stale-while-revalidate window.
+    bool is_stale(MonotonicTime now = MonotonicTime::now_coarse()) const
+    {
+        return m_earliest_record_expiration.has_value() && *m_earliest_record_expiration <= now;
+    }
+
+    Optional<MonotonicTime> next_removal() const { return m_next_removal; }
+
     void will_add_record_of_type(Messages::ResourceType type) { m_desired_types.set(type); }
+    void started_request() { m_request_done = false; }
     void finished_request() { m_request_done = true; }
 
-    void set_id(u16 id) { m_id = id; }
-    u16 id() { return m_id; }
-
     bool can_be_removed() const { return !m_valid && m_request_done; }
     bool is_done() const { return m_request_done; }
     Messages::DomainName const& name() const { return m_name; }
 
 private:
+    void update_expirations()
+    {
+        m_earliest_record_expiration.clear();
+        m_next_removal.clear();
+
+        auto note_removal = [&](MonotonicTime time) {
+            if (!m_next_removal.has_value() || time < *m_next_removal)
+                m_next_removal = time;
+        };
+
+        for (auto const& record : m_cached_records) {
+            if (!record.expiration.has_value())
+                continue;
+            if (!m_earliest_record_expiration.has_value() || *record.expiration < *m_earliest_record_expiration)
+                m_earliest_record_expiration = record.expiration;
+            note_removal(*record.expiration + stale_while_revalidate_window);
+        }
+        for (auto const& answer : m_negative_answers)
+            note_removal(answer.expiration);
+    }
+
     bool m_valid { false };
     bool m_request_done { false };
     Messages::DomainName m_name;
     struct RecordWithExpiration {
         Messages::ResourceRecord record;
-        Optional<Core::DateTime> expiration;
+        Optional<MonotonicTime> expiration;
     };
     Vector<RecordWithExpiration> m_cached_records;
+    struct NegativeAnswer {
+        Messages::ResourceType type;
+        MonotonicTime expiration;
+    };
+    Vector<NegativeAnswer> m_negative_answers;
+    Optional<MonotonicTime> m_earliest_record_expiration;
+    Optional<MonotonicTime> m_next_removal;
     HashTable<Messages::ResourceType> m_desired_types;
-    u16 m_id { 0 };
 };
 
 class Resolver {
+    using LookupPromise = Core::Promise<NonnullRefPtr<LookupResult const>>;
+
+    // All the queries sent on behalf of one lookup() of a name, one per record type.
+    struct InFlightLookup : public AtomicRefCounted<InFlightLookup> {
+        InFlightLookup(ByteString name, NonnullRefPtr<LookupResult> result, Vector<Messages::ResourceType> types, bool is_revalidation)
+            : name(move(name))
+            , result(move(result))
+            , types(move(types))
+            , is_revalidation(is_revalidation)
+        {
+        }
+
+        ByteString name;
+        NonnullRefPtr<LookupResult> result;
+        Vector<Messages::ResourceType> types;
+        Vector<NonnullRefPtr<LookupPromise>> promises;
+        size_t outstanding_queries { 0 };
+        bool is_revalidation { false };
+        bool promises_settled { false };
+        bool some_query_timed_out { false };
+        RefPtr<Core::Timer> resolution_delay_timer;
+    };
+
+    struct FinishedQuery {
+        NonnullRefPtr<InFlightLookup> lookup;
+        Messages::ResourceType type;
+    };
+
     struct PendingLookup {
         u16 id { 0 };
-        ByteString name;
-        WeakPtr<LookupResult> result;
-        NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> promise;
+        Messages::ResourceType type;
+        NonnullRefPtr<InFlightLookup> lookup;
+        ByteBuffer query_bytes;
         NonnullRefPtr<Core::Timer> repeat_timer;
         size_t times_repeated { 0 };
     };
 
 public:
+    // RFC 8305, 3. Hostname Resolution
+    // "The RECOMMENDED value for the Resolution Delay is 50 milliseconds."
+    static constexpr int happy_eyeballs_resolution_delay_ms = 50;
+
     enum class ConnectionMode {
         TCP,
         UDP,
@@ -212,23 +306,16 @@ public:
         });
     }
 
-    NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> lookup(ByteString name, Messages::Class class_ = Messages::Class::IN)
+    NonnullRefPtr<LookupPromise> lookup(ByteString name, Messages::Class class_ = Messages::Class::IN)
     {
         return lookup(move(name), class_, { Messages::ResourceType::A, Messages::ResourceType::AAAA });
     }
 
-    NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> lookup(ByteString name, Messages::Class class_, Vector<Messages::ResourceType> desired_types, PendingLookup* repeating_lookup = nullptr)
+    NonnullRefPtr<LookupPromise> lookup(ByteString name, Messages::Class class_, Vector<Messages::ResourceType> desired_types)
     {
         flush_cache();
 
-        if (repeating_lookup && repeating_lookup->times_repeated >= 5) {
-            auto promise = repeating_lookup->promise;
-            promise->reject(Error::from_string_literal("DNS lookup timed out"));
-            m_pending_lookups.with_write_locked([&](auto& lookups) { lookups->remove(repeating_lookup->id); });
-            return promise;
-        }
-
-        auto promise = repeating_lookup ? repeating_lookup->promise : Core::Promise<NonnullRefPtr<LookupResult const>>::construct();
+        auto promise = LookupPromise::construct();
 
         if (auto maybe_ipv4 = IPv4Address::from_string(name); maybe_ipv4.has_value()) {
             if (desired_types.contains_slow(Messages::ResourceType::A)) {
@@ -251,6 +338,9 @@ public:
         }
 
         if (auto result = lookup_in_cache(name, class_, desired_types)) {
+            // Stale-while-revalidate: hand out what we have now and refresh the entry for the next lookup.
+            if (result->is_stale())
+                revalidate(name, class_, desired_types);
             promise->resolve(result.release_nonnull());
             return promise;
         }
@@ -283,149 +373,255 @@ public:
             return promise;
         }
 
-        auto already_in_cache = false;
-        auto result = m_cache.with_write_locked([&](auto& cache) -> NonnullRefPtr<LookupResult> {
-            auto existing = [&] -> RefPtr<LookupResult> {
-                if (cache.contains(name)) {
-                    auto ptr = *cache.get(name);
-
-                    already_in_cache = true;
-                    for (auto const& type : desired_types) {
-                        if (!ptr->has_record_of_type(type, true)) {
-                            already_in_cache = false;
-                            break;
-                        }
-                    }
-
-                    return ptr;
-                }
-                return nullptr;
-            }();
+        // If the same name is already being looked up, wait for that lookup instead of asking again.
+        auto joined_existing_lookup = m_in_flight_lookups.with_write_locked([&](auto& lookups) {
+            auto existing = lookups.get(name);
+            if (!existing.has_value())
+                return false;
+            for (auto const& type : desired_types) {
+                if (!(*existing)->types.contains_slow(type))
+                    return false;
+            }
+            dbgln_if(DNS_DEBUG, "DNS::lookup({}) -> Lookup already underway", name);
+            // NOTE: Once the lookup has handed out its addresses early (see finish_query()), so do we.
+            if ((*existing)->promises_settled)
+                promise->resolve((*existing)->result);
+            else
+                (*existing)->promises.append(promise);
+            return true;
+        });
+        if (joined_existing_lookup)
+            return promise;
 
-            if (existing)
-                return *existing;
+        auto result = m_cache.with_write_locked([&](auto& cache) -> NonnullRefPtr<LookupResult> {
+            if (auto existing = cache.get(name); existing.has_value())
+                return *existing.value();
 
             auto ptr = make_ref_counted<LookupResult>(domain_name);
-            for (auto const& type : desired_types)
-                ptr->will_add_record_of_type(type);
             cache.set(name, ptr);
             return ptr;
         });
 
-        Optional<u16> cached_result_id;
-        if (already_in_cache) {
-            auto id = result->id();
-            cached_result_id = id;
-            auto existing_promise = m_pending_lookups.with_write_locked([&](auto& lookups) -> RefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> {
-                if (auto* lookup = lookups->find(id))
-                    return lookup->promise;
-                return nullptr;
-            });
-            if (existing_promise)
-                return existing_promise.release_nonnull();
-
-            // Something has gone wrong if there are no pending lookups but the result isn't done.
-            // Continue on and hope that we eventually resolve or timeout in that case.
-            if (result->is_done()) {
-                promise->resolve(*result);
-                return promise;
-            }
+        // Only ask for the types we don't have an answer for yet, e.g. just AAAA if A was looked up before.
+        Vector<Messages::ResourceType> types_to_query;
+        for (auto const& type : desired_types) {
+            if (!result->has_record_of_type(type))
+                types_to_query.append(type);
         }
+        if (types_to_query.is_empty())
+            types_to_query.append(Messages::ResourceType::A);
 
-        Messages::Message query;
-        if (repeating_lookup) {
-            query.header.id = repeating_lookup->id;
-            repeating_lookup->times_repeated++;
-        } else {
-            m_pending_lookups.with_read_locked([&](auto& lookups) {
-                do
-                    fill_with_random({ &query.header.id, sizeof(query.header.id) });
-                while (lookups->find(query.header.id) != nullptr);
-            });
-        }
-        query.header.question_count = max(1u, desired_types.size());
-        query.header.options.set_response_code(Messages::Options::ResponseCode::NoError);
-        query.header.options.set_recursion_desired(true);
-        query.header.options.set_op_code(Messages::OpCode::Query);
-        for (auto const& type : desired_types) {
+        for (auto const& type : types_to_query)
+            result->will_add_record_of_type(type);
+        result->started_request();
+
+        auto in_flight_lookup = adopt_ref(*new InFlightLookup(name, move(result), desired_types, false));
+        in_flight_lookup->promises.append(promise);
+        start_lookup(in_flight_lookup, domain_name, class_, types_to_query);
+
+        return promise;
+    }
+
+private:
+    // Refreshes a stale cache entry. The entry keeps answering lookups until the new answer arrives and replaces it.
+    void revalidate(ByteString const& name, Messages::Class class_, Vector<Messages::ResourceType> const& types)
+    {
+        if (!has_connection() || m_in_flight_lookups.with_read_locked([&](auto& lookups) { return lookups.contains(name); }))
+            return;
+
+        dbgln_if(DNS_DEBUG, "DNS: Revalidating stale entry for {}", name);
+        auto domain_name = Messages::DomainName::from_string(name);
+        auto result = make_ref_counted<LookupResult>(domain_name);
+        for (auto const& type : types)
+            result->will_add_record_of_type(type);
+
+        auto in_flight_lookup = adopt_ref(*new InFlightLookup(name, move(result), types, true));
+        start_lookup(in_flight_lookup, domain_name, class_, types);
+    }
+
+    // Sends one query per record type, so that A and AAAA are resolved in parallel and each answer can be used (and
+    // negatively cached) on its own, rather than one query carrying several questions that many servers won't answer.
+    void start_lookup(NonnullRefPtr<InFlightLookup> const& lookup, Messages::DomainName const& domain_name, Messages::Class class_, Vector<Messages::ResourceType> const& types)
+    {
+        m_in_flight_lookups.with_write_locked([&](auto& lookups) {
+            lookups.ensure(lookup->name, [&] { return lookup; });
+        });
+        lookup->outstanding_queries = types.size();
+
+        for (auto const& type : types) {
+            Messages::Message query;
+            query.header.question_count = 1;
+            query.header.options.set_response_code(Messages::Options::ResponseCode::NoError);
+            query.header.options.set_recursion_desired(true);
+            query.header.options.set_op_code(Messages::OpCode::Query);
             query.questions.append(Messages::Question {
                 .name = domain_name,
                 .type = type,
                 .class_ = class_,
             });
-        }
 
-        if (query.questions.is_empty()) {
-            query.questions.append(Messages::Question {
-                .name = Messages::DomainName::from_string(name),
-                .type = Messages::ResourceType::A,
-                .class_ = class_,
+            auto* pending_lookup = m_pending_lookups.with_write_locked([&](auto& lookups) {
+                do
+                    fill_with_random({ &query.header.id, sizeof(query.header.id) });
+                while (lookups->find(query.header.id) != nullptr);
+
+                ByteBuffer query_bytes;
+                MUST(query.to_raw(query_bytes));
+
+                lookups->insert(query.header.id, { query.header.id, type, lookup, move(query_bytes), Core::Timer::create(), 0 });
+                auto* p = lookups->find(query.header.id);
+                p->repeat_timer->set_single_shot(true);
+                p->repeat_timer->set_interval(1000);
+                p->repeat_timer->on_timeout = [this, id = query.header.id] {
+                    repeat_query(id);
+                };
+                return p;
             });
-        }
 
-        auto cached_entry = repeating_lookup ? nullptr : m_pending_lookups.with_write_locked([&](auto& pending_lookups) -> PendingLookup* {
-            // One more try to make sure we're not overwriting an existing lookup
-            if (cached_result_id.has_value()) {
-                if (auto* lookup = pending_lookups->find(*cached_result_id))
-                    return lookup;
+            if (auto result = send_query(pending_lookup->query_bytes); result.is_error()) {
+                auto id = pending_lookup->id;
+                m_pending_lookups.with_write_locked([&](auto& lookups) { lookups->remove(id); });
+                finish_query(lookup, type, result.release_error());
+                continue;
             }
 
-            pending_lookups->insert(query.header.id, { query.header.id, name, result->make_weak_ptr(), promise, Core::Timer::create(), 0 });
-            auto p = pending_lookups->find(query.header.id);
-            p->repeat_timer->set_single_shot(true);
-            p->repeat_timer->set_interval(1000);
-            p->repeat_timer->on_timeout = [=, this] {
-                (void)lookup(name, class_, desired_types, p);
-            };
+            pending_lookup->repeat_timer->start();
+        }
+    }
 
-            return nullptr;
-        });
+    void repeat_query(u16 id)
+    {
+        auto finished_query = m_pending_lookups.with_write_locked([&](auto& lookups) -> Optional<FinishedQuery> {
+            auto* lookup = lookups->find(id);
+            if (!lookup)
+                return {};
 
-        if (cached_entry) {
-            dbgln_if(DNS_DEBUG, "DNS::lookup({}) -> Lookup already underway", name);
-            auto user_promise = Core::Promise<NonnullRefPtr<LookupResult const>>::construct();
-            promise->on_resolution = [user_promise, cached_promise = cached_entry->promise](auto& result) {
-                user_promise->resolve(*result);
-                cached_promise->resolve(*result);
-                return ErrorOr<void> {};
-            };
-            promise->on_rejection = [user_promise, cached_promise = cached_entry->promise](auto& error) {
-                user_promise->reject(Error::copy(error));
-                cached_promise->reject(Error::copy(error));
-            };
-            cached_entry->promise = move(promise);
-            return user_promise;
-        }
+            if (lookup->times_repeated < 5) {
+                lookup->times_repeated++;
+                if (!send_query(lookup->query_bytes).is_error()) {
+                    lookup->repeat_timer->start();
+                    return {};
+                }
+            }
 
-        auto pending_lookup = m_pending_lookups.with_write_locked([&](auto& lookups) -> PendingLookup* {
-            return lookups->find(query.header.id);
+            FinishedQuery finished_query { lookup->lookup, lookup->type };
+            lookups->remove(id);
+            return finished_query;
         });
 
-        ByteBuffer query_bytes;
-        MUST(query.to_raw(query_bytes));
+        if (finished_query.has_value())
+            finish_query(finished_query->lookup, finished_query->type, Error::from_string_literal("DNS lookup timed out"));
+    }
 
+    ErrorOr<void> send_query(ByteBuffer const& query_bytes)
+    {
         if (m_mode == ConnectionMode::TCP) {
-            auto original_query_bytes = query_bytes;
-            query_bytes = MUST(ByteBuffer::create_uninitialized(query_bytes.size() + sizeof(u16)));
-            NetworkOrdered<u16> size = original_query_bytes.size();
-            query_bytes.overwrite(0, &size, sizeof(size));
-            query_bytes.overwrite(sizeof(size), original_query_bytes.data(), original_query_bytes.size());
+            auto framed_query_bytes = TRY(ByteBuffer::create_uninitialized(query_bytes.size() + sizeof(u16)));
+            NetworkOrdered<u16> size = query_bytes.size();
+            framed_query_bytes.overwrite(0, &size, sizeof(size));
+            framed_query_bytes.overwrite(sizeof(size), query_bytes.data(), query_bytes.size());
+            return m_socket.with_write_locked([&](auto& socket) {
+                return (*socket)->write_until_depleted(framed_query_bytes.bytes());
+            });
         }
 
-        auto write_result = m_socket.with_write_locked([&](auto& socket) {
+        return m_socket.with_write_locked([&](auto& socket) {
             return (*socket)->write_until_depleted(query_bytes.bytes());
         });
-        if (write_result.is_error()) {
-            promise->reject(write_result.release_error());
-            return promise;
+    }
+
+    // RFC 2308, 5. Caching Negative Answers
+    // "the TTL of this record is set from the minimum of the MINIMUM field of the SOA record and the TTL of the SOA
+    // itself". Negative responses without an SOA record should not be cached.
+    static Optional<u32> negative_answer_ttl(Messages::Message const& message)
+    {
+        for (auto const& authority : message.authorities) {
+            if (auto const* soa = authority.record.get_pointer<Messages::Records::SOA>())
+                return min(authority.ttl, soa->minimum);
         }
+        return {};
+    }
 
-        pending_lookup->repeat_timer->start();
+    void finish_query(NonnullRefPtr<InFlightLookup> const& lookup, Messages::ResourceType type, ErrorOr<Messages::Message> response)
+    {
+        auto& result = *lookup->result;
 
-        return promise;
+        if (response.is_error()) {
+            dbgln_if(DNS_DEBUG, "DNS: Query for {} {} failed: {}", lookup->name, Messages::to_string(type), response.error());
+            lookup->some_query_timed_out = true;
+        } else {
+            auto message = response.release_value();
+            auto response_code = message.header.options.response_code();
+
+            auto has_answer_of_type = false;
+            for (auto& record : message.answers) {
+                has_answer_of_type |= record.type == type;
+                result.add_record(move(record));
+            }
+
+            if (!has_answer_of_type && (response_code == Messages::Options::ResponseCode::NoError || response_code == Messages::Options::ResponseCode::NameError)) {
+                if (auto ttl = negative_answer_ttl(message); ttl.has_value())
+                    result.add_negative_answer(type, *ttl);
+            }
+        }
+
+        VERIFY(lookup->outstanding_queries > 0);
+        lookup->outstanding_queries--;
+
+        note_expiration(result.next_removal());
+
+        if (lookup->outstanding_queries == 0) {
+            result.finished_request();
+            if (lookup->resolution_delay_timer) {
+                lookup->resolution_delay_timer->stop();
+                lookup->resolution_delay_timer = nullptr;
+            }
+
+            m_in_flight_lookups.with_write_locked([&](auto& lookups) {
+                if (auto existing = lookups.get(lookup->name); existing.has_value() && existing.value() == lookup.ptr())
+                    lookups.remove(lookup->name);
+            });
+
+            // Only replace the stale entry if the refresh actually got an answer, otherwise keep serving the old one.
+            if (lookup->is_revalidation && (!result.records().is_empty() || !lookup->some_query_timed_out))
+                m_cache.with_write_locked([&](auto& cache) { cache.set(lookup->name, lookup->result); });
+
+            settle_promises(lookup);
+            return;
+        }
+
+        // RFC 8305, 3. Hostname Resolution
+        // "If a positive AAAA response (a response with at least one valid AAAA record) is received first, the first
+        // IPv6 connection attempt is immediately started. If a positive A response is received first due to reordering,
+        // the client SHOULD wait a short time for the AAAA response to ensure that preference is given to IPv6"
+        auto addresses = result.cached_addresses();
+        if (any_of(addresses, [](auto const& address) { return address.template has<IPv6Address>(); })) {
+            settle_promises(lookup);
+        } else if (!addresses.is_empty() && !lookup->resolution_delay_timer) {
+            lookup->resolution_delay_timer = Core::Timer::create_single_shot(happy_eyeballs_resolution_delay_ms, [this, lookup] {
+                settle_promises(lookup);
+            });
+            lookup->resolution_delay_timer->start();
+        }
+    }
+
+    void settle_promises(NonnullRefPtr<InFlightLookup> const& lookup)
+    {
+        if (lookup->promises_settled)
+            return;
+        lookup->promises_settled = true;
+
+        auto promises = move(lookup->promises);
+        if (lookup->result->records().is_empty() && lookup->some_query_timed_out) {
+            for (auto& promise : promises)
+                promise->reject(Error::from_string_literal("DNS lookup timed out"));
+            return;
+        }
+
+        for (auto& promise : promises)
+            promise->resolve(*lookup->result);
     }
 
-private:
     ErrorOr<Messages::Message> parse_one_message()
     {
         if (m_mode == ConnectionMode::UDP)
@@ -456,29 +652,22 @@ private:
             }
 
             auto message = message_or_err.release_value();
-            auto result = m_pending_lookups.with_write_locked([&](auto& lookups) -> ErrorOr<void> {
+            auto finished_query = m_pending_lookups.with_write_locked([&](auto& lookups) -> Optional<FinishedQuery> {
                 auto* lookup = lookups->find(message.header.id);
                 if (!lookup)
-                    return Error::from_string_literal("No pending lookup found for this message");
-
-                if (lookup->result.is_null())
-                    return {}; // Message is a response to a lookup that's been purged from the cache, ignore it
+                    return {};
 
                 lookup->repeat_timer->stop();
-
-                auto result = lookup->result.strong_ref();
-                for (auto& record : message.answers)
-                    result->add_record(move(record));
-
-                result->finished_request();
-                lookup->promise->resolve(*result);
+                FinishedQuery finished_query { lookup->lookup, lookup->type };
                 lookups->remove(message.header.id);
-                return {};
+                return finished_query;
             });
-            if (result.is_error()) {
-                dbgln_if(DNS_DEBUG, "DNS: Received a message with no pending lookup: {}", result.error());
+            if (!finished_query.has_value()) {
+                dbgln_if(DNS_DEBUG, "DNS: Received a message with no pending lookup: {}", message.header.id);
                 continue;
             }
+
+            finish_query(finished_query->lookup, finished_query->type, move(message));
         }
     }
 
@@ -520,14 +709,37 @@ private:
         m_socket_ready_promises.clear();
     }
 
+    void note_expiration(Optional<MonotonicTime> expiration)
+    {
+        if (!expiration.has_value())
+            return;
+        m_next_cache_expiration.with_locked([&](auto& next_expiration) {
+            if (!next_expiration.has_value() || *expiration < *next_expiration)
+                next_expiration = expiration;
+        });
+    }
+
     void flush_cache()
     {
+        // NOTE: The cache is only walked once its earliest expiration has passed, not on every lookup.
+        auto now = MonotonicTime::now_coarse();
+        auto due = m_next_cache_expiration.with_locked([&](auto& next_expiration) {
+            if (!next_expiration.has_value() || now < *next_expiration)
+                return false;
+            next_expiration.clear();
+            return true;
+        });
+        if (!due)
+            return;
+
         m_cache.with_write_locked([&](auto& cache) {
             HashTable<ByteString> to_remove;
             for (auto& entry : cache) {
-                entry.value->check_expiration();
+                entry.value->check_expiration(now);
                 if (entry.value->can_be_removed())
                     to_remove.set(entry.key);
+                else
+                    note_expiration(entry.value->next_removal());
             }
             for (auto const& key : to_remove)
                 cache.remove(key);
@@ -535,6 +747,8 @@ private:
     }
 
     Threading::RWLockProtected<HashMap<ByteString, NonnullRefPtr<LookupResult>>> m_cache;
+    Threading::MutexProtected<Optional<MonotonicTime>> m_next_cache_expiration;
+    Threading::RWLockProtected<HashMap<ByteString, NonnullRefPtr<InFlightLookup>>> m_in_flight_lookups;
     Threading::RWLockProtected<NonnullOwnPtr<RedBlackTree<u16, PendingLookup>>> m_pending_lookups;
     Threading::RWLockProtected<Optional<MaybeOwned<Core::Socket>>> m_socket;
     Function<ErrorOr<SocketResult>()> m_create_socket;
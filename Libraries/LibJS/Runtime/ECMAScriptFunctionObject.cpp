@@ -143,7 +143,7 @@ GC::Ref<ECMAScriptFunctionObject> ECMAScriptFunctionObject::create_from_function
 }
 
 SharedFunctionInstanceData::SharedFunctionInstanceData(
-    VM& vm,
+    VM&,
     FunctionKind kind,
     FlyString name,
     i32 function_length,
@@ -166,6 +166,7 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
     , m_contains_direct_call_to_eval(parsing_insights.contains_direct_call_to_eval)
     , m_is_arrow_function(is_arrow_function)
     , m_uses_this(parsing_insights.uses_this)
+    , m_uses_this_from_environment(parsing_insights.uses_this_from_environment)
 {
     if (m_is_arrow_function)
         m_this_mode = ThisMode::Lexical;
@@ -184,6 +185,13 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
             return false;
         return true;
     });
+}
+
+void SharedFunctionInstanceData::ensure_function_declaration_instantiation_is_analyzed(VM& vm)
+{
+    if (m_function_declaration_instantiation_is_analyzed)
+        return;
+    m_function_declaration_instantiation_is_analyzed = true;
 
     // NOTE: The following steps are from FunctionDeclarationInstantiation that could be executed once
     //       and then reused in all subsequent function instantiations.
@@ -277,7 +285,7 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
 
     size_t parameter_environment_bindings_count = 0;
     // 19. If strict is true or hasParameterExpressions is false, then
-    if (strict || !m_has_parameter_expressions) {
+    if (m_strict || !m_has_parameter_expressions) {
         // a. NOTE: Only a single Environment Record is needed for the parameters, since calls to eval in strict mode code cannot create new bindings which are visible outside of the eval.
         // b. Let env be the LexicalEnvironment of calleeContext
         // NOTE: Here we are only interested in the size of the environment.
@@ -414,7 +422,15 @@ SharedFunctionInstanceData::SharedFunctionInstanceData(
         }));
     }
 
-    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || parsing_insights.uses_this_from_environment || m_contains_direct_call_to_eval;
+    m_function_environment_needed = arguments_object_needs_binding || m_function_environment_bindings_count > 0 || m_var_environment_bindings_count > 0 || m_lex_environment_bindings_count > 0 || m_uses_this_from_environment || m_contains_direct_call_to_eval;
+}
+
+void SharedFunctionInstanceData::clear_compile_time_data()
+{
+    m_parameter_names.clear();
+    m_functions_to_initialize.clear();
+    m_var_names_to_initialize_binding.clear();
+    m_function_names_to_initialize_binding.clear();
 }
 
 ECMAScriptFunctionObject::ECMAScriptFunctionObject(
@@ -434,6 +450,32 @@ ECMAScriptFunctionObject::ECMAScriptFunctionObject(
     m_script_or_module = vm().get_active_script_or_module();
 }
 
+ThrowCompletionOr<void> ECMAScriptFunctionObject::ensure_bytecode_executable()
+{
+    if (m_bytecode_executable)
+        return {};
+
+    auto& vm = this->vm();
+    auto& shared_data = const_cast<SharedFunctionInstanceData&>(this->shared_data());
+
+    // NOTE: Most functions in a typical script are never called, so the static parts of FunctionDeclarationInstantiation
+    //       are only worked out once the function is first invoked, right before we generate bytecode for it.
+    shared_data.ensure_function_declaration_instantiation_is_analyzed(vm);
+
+    if (!ecmascript_code().bytecode_executable()) {
+        if (is_module_wrapper()) {
+            const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm, ecmascript_code(), kind(), name())));
+        } else {
+            const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm, *this)));
+        }
+    }
+    m_bytecode_executable = ecmascript_code().bytecode_executable();
+
+    // The lists that refer into the AST are only needed by the bytecode generator.
+    shared_data.clear_compile_time_data();
+    return {};
+}
+
 void ECMAScriptFunctionObject::initialize(Realm& realm)
 {
     auto& vm = this->vm();
@@ -489,16 +531,7 @@ ThrowCompletionOr<Value> ECMAScriptFunctionObject::internal_call(Value this_argu
     // 1. Let callerContext be the running execution context.
     // NOTE: No-op, kept by the VM in its execution context stack.
 
-    if (!m_bytecode_executable) {
-        if (!ecmascript_code().bytecode_executable()) {
-            if (is_module_wrapper()) {
-                const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm, ecmascript_code(), kind(), name())));
-            } else {
-                const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm, *this)));
-            }
-        }
-        m_bytecode_executable = ecmascript_code().bytecode_executable();
-    }
+    TRY(ensure_bytecode_executable());
 
     u32 arguments_count = max(arguments_list.size(), formal_parameters().size());
     auto registers_and_constants_and_locals_count = m_bytecode_executable->number_of_registers + m_bytecode_executable->constants.size() + m_bytecode_executable->local_variable_names.size();
@@ -561,16 +594,7 @@ ThrowCompletionOr<GC::Ref<Object>> ECMAScriptFunctionObject::internal_construct(
 {
     auto& vm = this->vm();
 
-    if (!m_bytecode_executable) {
-        if (!ecmascript_code().bytecode_executable()) {
-            if (is_module_wrapper()) {
-                const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm, ecmascript_code(), kind(), name())));
-            } else {
-                const_cast<Statement&>(ecmascript_code()).set_bytecode_executable(TRY(Bytecode::compile(vm, *this)));
-            }
-        }
-        m_bytecode_executable = ecmascript_code().bytecode_executable();
-    }
+    TRY(ensure_bytecode_executable());
 
     u32 arguments_count = max(arguments_list.size(), formal_parameters().size());
     auto registers_and_constants_and_locals_count = m_bytecode_executable->number_of_registers + m_bytecode_executable->constants.size() + m_bytecode_executable->local_variable_names.size();
@@ -48,6 +48,13 @@ public:
         FunctionParsingInsights const&,
         Vector<FlyString> local_variables_names);
 
+    // Performs the parts of FunctionDeclarationInstantiation that only depend on the function's code. This is deferred
+    // until the function is first invoked, and must happen before any of the data below it is used.
+    void ensure_function_declaration_instantiation_is_analyzed(VM&);
+
+    // Releases the data that is only needed to generate bytecode for the function.
+    void clear_compile_time_data();
+
     RefPtr<FunctionParameters const> m_formal_parameters; // [[FormalParameters]]
     RefPtr<Statement const> m_ecmascript_code;            // [[ECMAScriptCode]]
 
@@ -67,6 +74,7 @@ public:
     bool m_is_arrow_function { false };
     bool m_has_simple_parameter_list { false };
     bool m_is_module_wrapper { false };
+    bool m_function_declaration_instantiation_is_analyzed { false };
 
     struct VariableNameToInitialize {
         Identifier const& identifier;
@@ -85,6 +93,7 @@ public:
     bool m_arguments_object_needed { false };
     bool m_function_environment_needed { false };
     bool m_uses_this { false };
+    bool m_uses_this_from_environment { false };
     Vector<VariableNameToInitialize> m_var_names_to_initialize_binding;
     Vector<FlyString> m_function_names_to_initialize_binding;
 
@@ -198,6 +207,7 @@ private:
     virtual bool is_ecmascript_function_object() const override { return true; }
     virtual void visit_edges(Visitor&) override;
 
+    ThrowCompletionOr<void> ensure_bytecode_executable();
     ThrowCompletionOr<void> prepare_for_ordinary_call(ExecutionContext& callee_context, Object* new_target);
     void ordinary_call_bind_this(ExecutionContext&, Value this_argument);
 
@@ -277,8 +277,12 @@ private:
     // True if this object has lazily allocated intrinsic properties.
     bool m_has_intrinsic_accessors { false };
 
+    // The first few named properties live directly in the object cell, so that objects with a small, fixed set of
+    // properties (such as the ones stamped out by a constructor) don't need a separate allocation for their values.
+    static constexpr size_t inline_property_slot_count = 4;
+
     GC::Ptr<Shape> m_shape;
-    Vector<Value> m_storage;
+    Vector<Value, inline_property_slot_count> m_storage;
     IndexedProperties m_indexed_properties;
     OwnPtr<Vector<PrivateElement>> m_private_elements; // [[PrivateElements]]
 };
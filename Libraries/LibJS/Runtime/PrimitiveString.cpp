@@ -117,19 +117,48 @@ bool PrimitiveString::operator==(PrimitiveString const& other) const
     return utf8_string_view() == other.utf8_string_view();
 }
 
+bool PrimitiveString::has_ascii_utf8_string() const
+{
+    if (m_is_rope || !has_utf8_string())
+        return false;
+    if (m_utf8_ascii_state == AsciiState::Unknown)
+        m_utf8_ascii_state = m_utf8_string->bytes_as_string_view().is_ascii() ? AsciiState::Ascii : AsciiState::NotAscii;
+    return m_utf8_ascii_state == AsciiState::Ascii;
+}
+
+size_t PrimitiveString::length_in_utf16_code_units() const
+{
+    resolve_rope_if_needed(EncodingPreference::UTF16);
+
+    if (has_utf16_string())
+        return m_utf16_string->length_in_code_units();
+    if (has_ascii_utf8_string())
+        return m_utf8_string->bytes_as_string_view().length();
+    return utf16_string().length_in_code_units();
+}
+
 ThrowCompletionOr<Optional<Value>> PrimitiveString::get(VM& vm, PropertyKey const& property_key) const
 {
     if (property_key.is_symbol())
         return Optional<Value> {};
     if (property_key.is_string()) {
         if (property_key.as_string() == vm.names.length.as_string()) {
-            auto length = utf16_string().length_in_code_units();
+            auto length = length_in_utf16_code_units();
             return Value(static_cast<double>(length));
         }
     }
     auto index = canonical_numeric_index_string(property_key, CanonicalIndexMode::IgnoreNumericRoundtrip);
     if (!index.is_index())
         return Optional<Value> {};
+
+    resolve_rope_if_needed(EncodingPreference::UTF16);
+    if (!has_utf16_string() && has_ascii_utf8_string()) {
+        auto bytes = m_utf8_string->bytes_as_string_view();
+        if (bytes.length() <= index.as_index())
+            return Optional<Value> {};
+        return Value(&vm.single_ascii_character_string(static_cast<u8>(bytes[index.as_index()])));
+    }
+
     auto str = utf16_string_view();
     auto length = str.length_in_code_units();
     if (length <= index.as_index())
@@ -204,6 +233,23 @@ GC::Ref<PrimitiveString> PrimitiveString::create(VM& vm, PrimitiveString& lhs, P
     if (rhs_empty)
         return lhs;
 
+    // OPTIMIZATION: Joining two short strings right away is cheaper than allocating a rope that has to be flattened later.
+    static constexpr size_t maximum_length_to_concatenate_without_rope = 32;
+    if (!lhs.m_is_rope && !rhs.m_is_rope && lhs.has_utf8_string() && rhs.has_utf8_string()) {
+        auto lhs_view = lhs.m_utf8_string->bytes_as_string_view();
+        auto rhs_view = rhs.m_utf8_string->bytes_as_string_view();
+
+        // A surrogate pair split across the two strings has to be joined into one code point, leave that to the rope.
+        auto may_split_surrogate_pair = lhs_view.length() >= 3 && static_cast<u8>(lhs_view[lhs_view.length() - 3]) == 0xed && static_cast<u8>(rhs_view[0]) == 0xed;
+
+        if (lhs_view.length() + rhs_view.length() <= maximum_length_to_concatenate_without_rope && !may_split_surrogate_pair) {
+            StringBuilder builder(lhs_view.length() + rhs_view.length());
+            builder.append(lhs_view);
+            builder.append(rhs_view);
+            return create(vm, builder.to_string_without_validation());
+        }
+    }
+
     return vm.heap().allocate<RopeString>(lhs, rhs);
 }
 
@@ -218,11 +264,11 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
 
 void RopeString::resolve(EncodingPreference preference) const
 {
-
     // This vector will hold all the pieces of the rope that need to be assembled
     // into the resolved string.
     Vector<PrimitiveString const*> pieces;
-    size_t approximate_length = 0;
+    bool all_pieces_have_utf8_string = true;
+    bool all_pieces_have_utf16_string = true;
 
     // NOTE: We traverse the rope tree without using recursion, since we'd run out of
     //       stack space quickly when handling a long sequence of unresolved concatenations.
@@ -238,18 +284,36 @@ void RopeString::resolve(EncodingPreference preference) const
             continue;
         }
 
-        if (current->has_utf8_string())
-            approximate_length += current->utf8_string_view().length();
+        all_pieces_have_utf8_string &= current->has_utf8_string();
+        all_pieces_have_utf16_string &= current->has_utf16_string();
         pieces.append(current);
     }
 
-    if (preference == EncodingPreference::UTF16) {
-        // The caller wants a UTF-16 string, so we can simply concatenate all the pieces
-        // into a UTF-16 code unit buffer and create a Utf16String from it.
+    // Assemble the string in an encoding that the pieces already have, so that we don't have to transcode (and cache)
+    // every single piece. If the caller wants the other encoding, the result is converted once as a whole.
+    auto use_utf16 = !all_pieces_have_utf8_string || (preference == EncodingPreference::UTF16 && all_pieces_have_utf16_string);
+
+    if (use_utf16) {
+        // Concatenating UTF-16 code units takes care of surrogate pairs spread across two pieces by itself.
+        // A UTF-8 piece never has more UTF-16 code units than it has bytes, so this allocates the buffer just once.
+        size_t maximum_length = 0;
+        for (auto const* current : pieces) {
+            if (current->has_utf16_string())
+                maximum_length += current->m_utf16_string->length_in_code_units();
+            else
+                maximum_length += current->m_utf8_string->bytes_as_string_view().length();
+        }
 
         Utf16Data code_units;
-        for (auto const* current : pieces)
-            code_units.extend(current->utf16_string().string());
+        code_units.ensure_capacity(maximum_length);
+        for (auto const* current : pieces) {
+            if (current->has_utf16_string()) {
+                code_units.extend(current->m_utf16_string->string());
+            } else {
+                auto converted = MUST(utf8_to_utf16(current->m_utf8_string->bytes_as_string_view()));
+                code_units.extend(converted.data);
+            }
+        }
 
         m_utf16_string = Utf16String::create(move(code_units));
         m_is_rope = false;
@@ -258,15 +322,19 @@ void RopeString::resolve(EncodingPreference preference) const
         return;
     }
 
+    size_t length = 0;
+    for (auto const* current : pieces)
+        length += current->m_utf8_string->bytes_as_string_view().length();
+
     // Now that we have all the pieces, we can concatenate them using a StringBuilder.
-    StringBuilder builder(approximate_length);
+    StringBuilder builder(length);
 
     // We keep track of the previous piece in order to handle surrogate pairs spread across two pieces.
     PrimitiveString const* previous = nullptr;
     for (auto const* current : pieces) {
         if (!previous) {
             // This is the very first piece, just append it and continue.
-            builder.append(current->utf8_string());
+            builder.append(current->utf8_string_view());
             previous = current;
             continue;
         }
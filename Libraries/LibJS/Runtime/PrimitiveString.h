@@ -45,6 +45,9 @@ public:
     [[nodiscard]] Utf16View utf16_string_view() const;
     bool has_utf16_string() const { return m_utf16_string.has_value(); }
 
+    // The length in UTF-16 code units, i.e. the length observed by JavaScript code.
+    [[nodiscard]] size_t length_in_utf16_code_units() const;
+
     ThrowCompletionOr<Optional<Value>> get(VM&, PropertyKey const&) const;
 
     [[nodiscard]] bool operator==(PrimitiveString const&) const;
@@ -58,6 +61,13 @@ protected:
 
     mutable bool m_is_rope { false };
 
+    enum class AsciiState : u8 {
+        Unknown,
+        Ascii,
+        NotAscii,
+    };
+    mutable AsciiState m_utf8_ascii_state { AsciiState::Unknown };
+
     mutable Optional<String> m_utf8_string;
     mutable Optional<Utf16String> m_utf16_string;
 
@@ -73,6 +83,9 @@ private:
     explicit PrimitiveString(Utf16String);
 
     void resolve_rope_if_needed(EncodingPreference) const;
+
+    // ASCII strings have the same code units in UTF-8 as in UTF-16, so they don't need a UTF-16 copy for indexing.
+    bool has_ascii_utf8_string() const;
 };
 
 class RopeString final : public PrimitiveString {
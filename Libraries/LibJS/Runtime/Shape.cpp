@@ -29,9 +29,8 @@ GC::Ref<Shape> Shape::create_cacheable_dictionary_transition()
     new_shape->m_prototype = m_prototype;
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
     ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = m_property_table;
+    new_shape->m_property_count = m_property_table->properties.size();
     return new_shape;
 }
 
@@ -43,9 +42,8 @@ GC::Ref<Shape> Shape::create_uncacheable_dictionary_transition()
     new_shape->m_prototype = m_prototype;
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
     ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = m_property_table;
+    new_shape->m_property_count = m_property_table->properties.size();
     return new_shape;
 }
 
@@ -223,45 +221,58 @@ Optional<PropertyMetadata> Shape::lookup(StringOrSymbol const& property_key) con
 FLATTEN OrderedHashMap<StringOrSymbol, PropertyMetadata> const& Shape::property_table() const
 {
     ensure_property_table();
-    return *m_property_table;
+    return m_property_table->properties;
 }
 
 void Shape::ensure_property_table() const
 {
     if (m_property_table)
         return;
-    m_property_table = make<OrderedHashMap<StringOrSymbol, PropertyMetadata>>();
 
     u32 next_offset = 0;
+    bool chain_changes_properties = false;
 
     Vector<Shape const&, 64> transition_chain;
     transition_chain.append(*this);
+    chain_changes_properties |= m_property_key.is_valid();
     for (auto shape = m_previous; shape; shape = shape->m_previous) {
         if (shape->m_property_table) {
-            *m_property_table = *shape->m_property_table;
+            // Prototype transitions don't affect the key map, so a shape that is only separated from a materialized
+            // table by those can share it instead of making a copy.
+            if (!chain_changes_properties) {
+                m_property_table = shape->m_property_table;
+                return;
+            }
+            m_property_table = adopt_ref(*new ShapePropertyTable);
+            m_property_table->properties = shape->m_property_table->properties;
             next_offset = shape->m_property_count;
             break;
         }
         transition_chain.append(*shape);
+        chain_changes_properties |= shape->m_property_key.is_valid();
     }
 
+    if (!m_property_table)
+        m_property_table = adopt_ref(*new ShapePropertyTable);
+
+    auto& properties = m_property_table->properties;
     for (auto const& shape : transition_chain.in_reverse()) {
         if (!shape.m_property_key.is_valid()) {
             // Ignore prototype transitions as they don't affect the key map.
             continue;
         }
         if (shape.m_transition_type == TransitionType::Put) {
-            m_property_table->set(shape.m_property_key, { next_offset++, shape.m_attributes });
+            properties.set(shape.m_property_key, { next_offset++, shape.m_attributes });
         } else if (shape.m_transition_type == TransitionType::Configure) {
-            auto it = m_property_table->find(shape.m_property_key);
-            VERIFY(it != m_property_table->end());
+            auto it = properties.find(shape.m_property_key);
+            VERIFY(it != properties.end());
             it->value.attributes = shape.m_attributes;
         } else if (shape.m_transition_type == TransitionType::Delete) {
-            auto remove_it = m_property_table->find(shape.m_property_key);
-            VERIFY(remove_it != m_property_table->end());
+            auto remove_it = properties.find(shape.m_property_key);
+            VERIFY(remove_it != properties.end());
             auto removed_offset = remove_it->value.offset;
-            m_property_table->remove(remove_it);
-            for (auto& it : *m_property_table) {
+            properties.remove(remove_it);
+            for (auto& it : properties) {
                 if (it.value.offset > removed_offset)
                     --it.value.offset;
             }
@@ -282,10 +293,20 @@ GC::Ref<Shape> Shape::create_delete_transition(StringOrSymbol const& property_ke
     return new_shape;
 }
 
-void Shape::add_property_without_transition(StringOrSymbol const& property_key, PropertyAttributes attributes)
+void Shape::ensure_property_table_is_unshared()
 {
     ensure_property_table();
-    if (m_property_table->set(property_key, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry) {
+    if (m_property_table->ref_count() == 1)
+        return;
+    auto property_table = adopt_ref(*new ShapePropertyTable);
+    property_table->properties = m_property_table->properties;
+    m_property_table = move(property_table);
+}
+
+void Shape::add_property_without_transition(StringOrSymbol const& property_key, PropertyAttributes attributes)
+{
+    ensure_property_table_is_unshared();
+    if (m_property_table->properties.set(property_key, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry) {
         VERIFY(m_property_count < NumericLimits<u32>::max());
         ++m_property_count;
     }
@@ -300,19 +321,23 @@ void Shape::set_property_attributes_without_transition(StringOrSymbol const& pro
 {
     VERIFY(is_dictionary());
     VERIFY(m_property_table);
-    auto it = m_property_table->find(property_key);
-    VERIFY(it != m_property_table->end());
+    ensure_property_table_is_unshared();
+    auto& properties = m_property_table->properties;
+    auto it = properties.find(property_key);
+    VERIFY(it != properties.end());
     it->value.attributes = attributes;
-    m_property_table->set(property_key, it->value);
+    properties.set(property_key, it->value);
 }
 
 void Shape::remove_property_without_transition(StringOrSymbol const& property_key, u32 offset)
 {
     VERIFY(is_uncacheable_dictionary());
     VERIFY(m_property_table);
-    if (m_property_table->remove(property_key))
+    ensure_property_table_is_unshared();
+    auto& properties = m_property_table->properties;
+    if (properties.remove(property_key))
         --m_property_count;
-    for (auto& it : *m_property_table) {
+    for (auto& it : properties) {
         VERIFY(it.value.offset != offset);
         if (it.value.offset > offset)
             --it.value.offset;
@@ -338,9 +363,8 @@ GC::Ref<Shape> Shape::clone_for_prototype()
     new_shape->m_is_prototype_shape = true;
     new_shape->m_prototype = m_prototype;
     ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = m_property_table;
+    new_shape->m_property_count = m_property_table->properties.size();
     new_shape->m_prototype_chain_validity = heap().allocate<PrototypeChainValidity>();
     return new_shape;
 }
@@ -8,6 +8,7 @@
 
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
+#include <AK/RefCounted.h>
 #include <AK/StringView.h>
 #include <AK/WeakPtr.h>
 #include <AK/Weakable.h>
@@ -24,6 +25,12 @@ struct PropertyMetadata {
     PropertyAttributes attributes { 0 };
 };
 
+// Property tables are shared between shapes whose keys and attributes are identical, such as the shapes on either side of a
+// prototype or dictionary transition. A shared table is immutable, a shape that needs to modify it makes its own copy first.
+struct ShapePropertyTable : public RefCounted<ShapePropertyTable> {
+    OrderedHashMap<StringOrSymbol, PropertyMetadata> properties;
+};
+
 struct TransitionKey {
     StringOrSymbol property_key;
     PropertyAttributes attributes { 0 };
@@ -123,10 +130,11 @@ private:
     [[nodiscard]] GC::Ptr<Shape> get_or_prune_cached_delete_transition(StringOrSymbol const&);
 
     void ensure_property_table() const;
+    void ensure_property_table_is_unshared();
 
     GC::Ref<Realm> m_realm;
 
-    mutable OwnPtr<OrderedHashMap<StringOrSymbol, PropertyMetadata>> m_property_table;
+    mutable RefPtr<ShapePropertyTable> m_property_table;
 
     OwnPtr<HashMap<TransitionKey, WeakPtr<Shape>>> m_forward_transitions;
     OwnPtr<HashMap<GC::Ptr<Object>, WeakPtr<Shape>>> m_prototype_transitions;
@@ -0,0 +1,68 @@
+test("Objects keep their values when growing past the inline property slots", () => {
+    function Point(count) {
+        for (let i = 0; i < count; ++i) this["p" + i] = i;
+    }
+
+    for (let count = 0; count < 12; ++count) {
+        const point = new Point(count);
+        expect(Object.keys(point)).toHaveLength(count);
+        for (let i = 0; i < count; ++i) expect(point["p" + i]).toBe(i);
+    }
+});
+
+test("Deleting a property moves later values into its slot", () => {
+    const o = { a: 1, b: 2, c: 3, d: 4, e: 5, f: 6 };
+    delete o.b;
+    expect(Object.keys(o)).toEqual(["a", "c", "d", "e", "f"]);
+    expect(o.a).toBe(1);
+    expect(o.c).toBe(3);
+    expect(o.f).toBe(6);
+
+    delete o.e;
+    o.g = 7;
+    expect(Object.keys(o)).toEqual(["a", "c", "d", "f", "g"]);
+    expect(o.f).toBe(6);
+    expect(o.g).toBe(7);
+});
+
+test("Changing the prototype keeps the own properties", () => {
+    const o1 = { x: 1, y: 2 };
+    const o2 = { x: 3, y: 4 };
+    const prototype = { z: 5 };
+    Object.setPrototypeOf(o1, prototype);
+
+    expect(o1.x).toBe(1);
+    expect(o1.y).toBe(2);
+    expect(o1.z).toBe(5);
+    expect(Object.keys(o1)).toEqual(["x", "y"]);
+
+    o1.w = 6;
+    expect(Object.keys(o1)).toEqual(["x", "y", "w"]);
+    expect(Object.keys(o2)).toEqual(["x", "y"]);
+    expect(o2.w).toBeUndefined();
+});
+
+test("Modifying an object in dictionary mode does not affect objects with the shape it came from", () => {
+    const make = () => {
+        const o = {};
+        for (let i = 0; i < 100; ++i) o["p" + i] = i;
+        return o;
+    };
+    const a = make();
+    const b = make();
+
+    delete a.p10;
+    Object.defineProperty(a, "p20", { value: "changed", enumerable: false });
+    a.extra = true;
+
+    expect(a.p10).toBeUndefined();
+    expect(a.p20).toBe("changed");
+    expect(Object.keys(a)).not.toContain("p20");
+    expect(a.extra).toBeTrue();
+
+    expect(b.p10).toBe(10);
+    expect(b.p20).toBe(20);
+    expect(Object.keys(b)).toContain("p20");
+    expect(b.extra).toBeUndefined();
+    expect(Object.keys(b)).toHaveLength(100);
+});
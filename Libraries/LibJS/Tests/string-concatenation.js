@@ -28,3 +28,36 @@ test("adding strings with dangling surrogates", () => {
     expect("\ud834a" + "\udf06").toBe("\ud834a\udf06");
     expect("\ud834" + "a\udf06").toBe("\ud834a\udf06");
 });
+
+test("long concatenations keep length and indexing consistent", () => {
+    let ascii = "";
+    let expected = [];
+    for (let i = 0; i < 1000; ++i) {
+        const piece = String.fromCharCode(97 + (i % 26));
+        ascii += piece;
+        expected.push(piece);
+    }
+    expect(ascii.length).toBe(1000);
+    expect(ascii[0]).toBe("a");
+    expect(ascii[27]).toBe("b");
+    expect(ascii[1000]).toBeUndefined();
+    expect(ascii).toBe(expected.join(""));
+});
+
+test("concatenating strings with different encodings", () => {
+    // Strings produced by UTF-16 based operations mixed with plain literals.
+    const utf16 = "été".split("").reverse().join("");
+    let mixed = "";
+    for (let i = 0; i < 50; ++i) mixed += i % 2 ? utf16 : "summer ";
+
+    expect(mixed.length).toBe(25 * 3 + 25 * 7);
+    expect(mixed.charCodeAt(7)).toBe(0xe9);
+    expect(mixed.indexOf("summer été")).toBe(0);
+
+    let surrogates = "x".repeat(40);
+    surrogates += "\ud834";
+    surrogates += "\udf06".repeat(2);
+    expect(surrogates.length).toBe(43);
+    expect(surrogates.codePointAt(40)).toBe(0x1d306);
+    expect(surrogates.charCodeAt(42)).toBe(0xdf06);
+});
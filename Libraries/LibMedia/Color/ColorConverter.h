@@ -8,6 +8,8 @@
 
 #include <AK/Array.h>
 #include <AK/Function.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/Matrix4x4.h>
 #include <LibMedia/Color/CodingIndependentCodePoints.h>
@@ -150,9 +152,90 @@ public:
         return Gfx::Color(r, g, b);
     }
 
+    // Converts a row of pixels whose chroma planes have already been upsampled to the width of the luma plane, writing
+    // them to a BGRx8888 scanline.
+    template<Unsigned T>
+    void convert_yuv_row(T const* y_row, T const* u_row, T const* v_row, u32* output, size_t width) const
+    {
+        size_t column = 0;
+
+        // OPTIMIZATION: Without any color remapping, the conversion is a single matrix multiplication, so four pixels
+        //               can be converted at a time. The operations match those of convert_yuv() exactly, so the results
+        //               are identical.
+        if (m_should_skip_color_remapping) {
+            using namespace AK::SIMD;
+            auto const& matrix = m_input_conversion_matrix.elements();
+
+            auto convert_component = [&](size_t index, f32x4 y, f32x4 u, f32x4 v) {
+                auto component = y * matrix[index][0] + u * matrix[index][1] + v * matrix[index][2] + matrix[index][3];
+                component = 0.0f < component ? component : 0.0f;
+                component = component < 1.0f ? component : 1.0f;
+                return __builtin_convertvector(component * 255.0f, u32x4);
+            };
+
+            for (; column + 4 <= width; column += 4) {
+                auto y = to_f32x4(load_unaligned<Vector4For<T>>(&y_row[column]));
+                auto u = to_f32x4(load_unaligned<Vector4For<T>>(&u_row[column]));
+                auto v = to_f32x4(load_unaligned<Vector4For<T>>(&v_row[column]));
+
+                auto red = convert_component(0, y, u, v);
+                auto green = convert_component(1, y, u, v);
+                auto blue = convert_component(2, y, u, v);
+                store_unaligned(&output[column], pack_bgrx(red, green, blue));
+            }
+        }
+
+        for (; column < width; column++)
+            output[column] = convert_yuv(y_row[column], u_row[column], v_row[column]).value();
+    }
+
     // Fast conversion of 8-bit YUV to full-range RGB.
     template<MatrixCoefficients MC, VideoFullRangeFlag FR, Unsigned T>
     static ALWAYS_INLINE Gfx::Color convert_simple_yuv_to_rgb(T y_in, T u_in, T v_in)
+    {
+        i32 red;
+        i32 green;
+        i32 blue;
+        convert_simple_yuv_to_rgb_components<MC, FR>(static_cast<i32>(y_in), static_cast<i32>(u_in), static_cast<i32>(v_in), red, green, blue);
+        return Gfx::Color(u8(red), u8(green), u8(blue));
+    }
+
+    // The same conversion as convert_simple_yuv_to_rgb(), applied to a row of pixels four at a time.
+    template<MatrixCoefficients MC, VideoFullRangeFlag FR, Unsigned T>
+    static void convert_simple_yuv_row_to_rgb(T const* y_row, T const* u_row, T const* v_row, u32* output, size_t width)
+    {
+        using namespace AK::SIMD;
+
+        size_t column = 0;
+        for (; column + 4 <= width; column += 4) {
+            auto y = to_i32x4(load_unaligned<Vector4For<T>>(&y_row[column]));
+            auto u = to_i32x4(load_unaligned<Vector4For<T>>(&u_row[column]));
+            auto v = to_i32x4(load_unaligned<Vector4For<T>>(&v_row[column]));
+
+            i32x4 red;
+            i32x4 green;
+            i32x4 blue;
+            convert_simple_yuv_to_rgb_components<MC, FR>(y, u, v, red, green, blue);
+            store_unaligned(&output[column], pack_bgrx(to_u32x4(red), to_u32x4(green), to_u32x4(blue)));
+        }
+
+        for (; column < width; column++)
+            output[column] = convert_simple_yuv_to_rgb<MC, FR>(y_row[column], u_row[column], v_row[column]).value();
+    }
+
+private:
+    template<typename T>
+    using Vector4For = Conditional<IsSame<T, u8>, AK::SIMD::u8x4, AK::SIMD::u16x4>;
+
+    static ALWAYS_INLINE AK::SIMD::u32x4 pack_bgrx(AK::SIMD::u32x4 red, AK::SIMD::u32x4 green, AK::SIMD::u32x4 blue)
+    {
+        return 0xFF000000u | (red << 16) | (green << 8) | blue;
+    }
+
+    // The fixed-point arithmetic of convert_simple_yuv_to_rgb(), written so that it works on both single values (i32)
+    // and vectors of them (i32x4).
+    template<MatrixCoefficients MC, VideoFullRangeFlag FR, typename V>
+    static ALWAYS_INLINE void convert_simple_yuv_to_rgb_components(V y, V u, V v, V& red, V& green, V& blue)
     {
         static constexpr i32 bit_depth = 8;
         static constexpr i32 maximum_value = (1 << bit_depth) - 1;
@@ -197,13 +280,9 @@ public:
             return range_factors;
         }();
 
-        i32 y = y_in + range_factors.y_offset;
-        i32 u = u_in + range_factors.uv_offset;
-        i32 v = v_in + range_factors.uv_offset;
-
-        i32 red;
-        i32 green;
-        i32 blue;
+        y = y + range_factors.y_offset;
+        u = u + range_factors.uv_offset;
+        v = v + range_factors.uv_offset;
 
         constexpr i32 y_scale = range_factors.y_scale;
         constexpr i32 uv_scale = range_factors.uv_scale;
@@ -231,19 +310,24 @@ public:
             blue = y * y_scale + u * multiply(coef(94070), uv_scale);
         }
 
-        red = clamp(red, 0, maximum_value * one);
-        green = clamp(green, 0, maximum_value * one);
-        blue = clamp(blue, 0, maximum_value * one);
+        auto clamp_component = [](V component) -> V {
+            if constexpr (IsSame<V, i32>) {
+                return clamp(component, 0, maximum_value * one);
+            } else {
+                component = component < 0 ? 0 : component;
+                return component > maximum_value * one ? maximum_value * one : component;
+            }
+        };
+        red = clamp_component(red);
+        green = clamp_component(green);
+        blue = clamp_component(blue);
 
         // This compiles down to a bit shift if maximum_value == 255
         red /= fraction(maximum_value, 255);
         green /= fraction(maximum_value, 255);
         blue /= fraction(maximum_value, 255);
-
-        return Gfx::Color(u8(red), u8(green), u8(blue));
     }
 
-private:
     static constexpr size_t to_linear_size = 64;
     static constexpr size_t to_non_linear_size = 64;
 
@@ -9,6 +9,7 @@
 namespace Media {
 
 class DecoderError;
+class FramePool;
 class FrameQueueItem;
 class PlaybackManager;
 class Sample;
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibMedia/FramePool.h>
+
+namespace Media {
+
+FramePool::FramePool(size_t capacity)
+    : m_capacity(capacity)
+{
+}
+
+void FramePool::set_capacity(size_t capacity)
+{
+    m_capacity = capacity;
+
+    // Bitmaps that are still in use elsewhere will be freed by their last owner.
+    if (m_bitmaps.size() > m_capacity)
+        m_bitmaps.shrink(m_capacity);
+}
+
+DecoderErrorOr<NonnullRefPtr<Gfx::Bitmap>> FramePool::take_bitmap(Gfx::IntSize size)
+{
+    // Free bitmaps that can't be reused after a change in resolution.
+    m_bitmaps.remove_all_matching([&](auto const& bitmap) {
+        return bitmap->size() != size && bitmap->ref_count() == 1;
+    });
+
+    for (auto& bitmap : m_bitmaps) {
+        if (bitmap->size() != size || bitmap->ref_count() != 1)
+            continue;
+        // The last other owner may have released its reference on another thread. Make sure that anything it
+        // did with the pixels happens before we overwrite them.
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+        return bitmap;
+    }
+
+    auto bitmap = DECODER_TRY_ALLOC(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, size));
+    m_allocation_count++;
+    if (m_bitmaps.size() < m_capacity)
+        m_bitmaps.append(bitmap);
+    return bitmap;
+}
+
+}
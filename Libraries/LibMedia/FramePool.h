@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtr.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibMedia/DecoderError.h>
+
+namespace Media {
+
+// Recycles the bitmaps that decoded video frames are converted into. A bitmap is handed out again once every
+// other reference to it has been dropped, i.e. once the frame queue and the presentation side are done with it.
+// The pool itself is not thread-safe, it is meant to be owned by the thread that does the conversion.
+class FramePool {
+    AK_MAKE_NONCOPYABLE(FramePool);
+    AK_MAKE_NONMOVABLE(FramePool);
+
+public:
+    static constexpr size_t default_capacity = 8;
+
+    explicit FramePool(size_t capacity = default_capacity);
+
+    // Returns a BGRx8888 bitmap of the given size that nothing else holds a reference to. The contents are unspecified.
+    // If every pooled bitmap is still in use and the pool is at capacity, a bitmap is allocated outside of the pool.
+    DecoderErrorOr<NonnullRefPtr<Gfx::Bitmap>> take_bitmap(Gfx::IntSize);
+
+    size_t capacity() const { return m_capacity; }
+    void set_capacity(size_t);
+
+    size_t size() const { return m_bitmaps.size(); }
+    u64 allocation_count() const { return m_allocation_count; }
+
+private:
+    Vector<NonnullRefPtr<Gfx::Bitmap>> m_bitmaps;
+    size_t m_capacity { default_capacity };
+    u64 m_allocation_count { 0 };
+};
+
+}
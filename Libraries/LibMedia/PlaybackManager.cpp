@@ -131,6 +131,7 @@ void PlaybackManager::dispatch_decoder_error(DecoderError error)
 
 void PlaybackManager::dispatch_new_frame(RefPtr<Gfx::Bitmap> frame)
 {
+    m_presented_frames++;
     if (on_video_frame)
         on_video_frame(move(frame));
 }
@@ -166,11 +167,41 @@ void PlaybackManager::seek_to_timestamp(AK::Duration target_timestamp, SeekMode
 DecoderErrorOr<Optional<AK::Duration>> PlaybackManager::seek_demuxer_to_most_recent_keyframe(AK::Duration timestamp, Optional<AK::Duration> earliest_available_sample)
 {
     auto seeked_timestamp = TRY(m_demuxer->seek_to_most_recent_keyframe(m_selected_video_track, timestamp, move(earliest_available_sample)));
-    if (seeked_timestamp.has_value())
+    if (seeked_timestamp.has_value()) {
         m_decoder->flush();
+        m_frame_held_back_for_seek = nullptr;
+    }
     return seeked_timestamp;
 }
 
+void PlaybackManager::set_seek_target_for_decoder(Optional<AK::Duration> target)
+{
+    Threading::MutexLocker decoder_locker(m_decoder_mutex);
+    m_seek_target_for_decoder = target;
+}
+
+void PlaybackManager::set_decode_ahead_depth(size_t depth)
+{
+    m_decode_ahead_depth.store(clamp(depth, 1, MAX_DECODE_AHEAD_DEPTH));
+    // Wake the decoder up in case it is waiting on a queue it may now fill further.
+    m_decode_wait_condition.broadcast();
+}
+
+PlaybackStatistics PlaybackManager::statistics() const
+{
+    return {
+        .decoded_frames = m_decoded_frames.load(),
+        .presented_frames = m_presented_frames,
+        .dropped_frames = m_skipped_frames,
+        .skipped_conversions = m_skipped_conversions.load(),
+        .frame_allocations = m_frame_allocations.load(),
+        .total_decode_time = AK::Duration::from_microseconds(m_total_decode_time_in_microseconds.load()),
+        .longest_decode_time = AK::Duration::from_microseconds(m_longest_decode_time_in_microseconds.load()),
+        .queue_depth = m_frame_queue.weak_used(),
+        .decode_ahead_depth = m_decode_ahead_depth.load(),
+    };
+}
+
 Optional<FrameQueueItem> PlaybackManager::dequeue_one_frame()
 {
     auto result = m_frame_queue.dequeue();
@@ -193,116 +224,161 @@ void PlaybackManager::restart_playback()
     seek_to_timestamp(AK::Duration::zero());
 }
 
+// Besides the frames in the queue, a bitmap may be held by the frame that is waiting to be enqueued, the next frame to
+// present, the frame that is currently presented, and one that is still being painted.
+static constexpr size_t frames_in_use_outside_of_queue = 4;
+
+static void prepare_cicp_for_display(VideoFrame& frame, CodingIndependentCodePoints const& container_cicp)
+{
+    auto& cicp = frame.cicp();
+    cicp.adopt_specified_values(container_cicp);
+    cicp.default_code_points_if_unspecified({ ColorPrimaries::BT709, TransferCharacteristics::BT709, MatrixCoefficients::BT709, VideoFullRangeFlag::Studio });
+
+    // BT.470 M, B/G, BT.601, BT.709 and BT.2020 have a similar transfer function to sRGB, so other applications
+    // (Chromium, VLC) forgo transfer characteristics conversion. We will emulate that behavior by
+    // handling those as sRGB instead, which causes no transfer function change in the output,
+    // unless display color management is later implemented.
+    switch (cicp.transfer_characteristics()) {
+    case TransferCharacteristics::BT470BG:
+    case TransferCharacteristics::BT470M:
+    case TransferCharacteristics::BT601:
+    case TransferCharacteristics::BT709:
+    case TransferCharacteristics::BT2020BitDepth10:
+    case TransferCharacteristics::BT2020BitDepth12:
+        cicp.set_transfer_characteristics(TransferCharacteristics::SRGB);
+        break;
+    default:
+        break;
+    }
+}
+
+FrameQueueItem PlaybackManager::convert_frame_for_display(VideoFrame& frame)
+{
+    auto bitmap_result = [&]() -> DecoderErrorOr<NonnullRefPtr<Gfx::Bitmap>> {
+        auto bitmap = TRY(m_frame_pool.take_bitmap({ frame.width(), frame.height() }));
+        TRY(frame.output_to_bitmap(bitmap));
+        return bitmap;
+    }();
+
+    if (bitmap_result.is_error())
+        return FrameQueueItem::error_marker(bitmap_result.release_error(), frame.timestamp());
+    return FrameQueueItem::frame(bitmap_result.release_value(), frame.timestamp());
+}
+
 void PlaybackManager::decode_and_queue_one_sample()
 {
-#if PLAYBACK_MANAGER_DEBUG
     auto start_time = MonotonicTime::now();
-#endif
 
-    FrameQueueItem item_to_enqueue;
+    auto decode_ahead_depth = m_decode_ahead_depth.load();
+    m_frame_pool.set_capacity(decode_ahead_depth + frames_in_use_outside_of_queue);
 
-    while (item_to_enqueue.is_empty()) {
-        OwnPtr<VideoFrame> decoded_frame = nullptr;
-        CodingIndependentCodePoints container_cicp;
+    OwnPtr<VideoFrame> decoded_frame = nullptr;
+    // A frame that was held back while seeking must be presented before whatever we decode next.
+    OwnPtr<VideoFrame> preceding_frame = nullptr;
+    Optional<FrameQueueItem> error_item;
+    u64 decoded_frame_count = 0;
 
-        {
-            Threading::MutexLocker decoder_locker(m_decoder_mutex);
+    while (decoded_frame == nullptr && !error_item.has_value()) {
+        Threading::MutexLocker decoder_locker(m_decoder_mutex);
 
-            // Get a sample to decode.
-            auto sample_result = m_demuxer->get_next_sample_for_track(m_selected_video_track);
-            if (sample_result.is_error()) {
-                item_to_enqueue = FrameQueueItem::error_marker(sample_result.release_error(), FrameQueueItem::no_timestamp);
-                break;
-            }
-            auto sample = sample_result.release_value();
-            container_cicp = sample.auxiliary_data().get<VideoSampleData>().container_cicp();
+        // Get a sample to decode.
+        auto sample_result = m_demuxer->get_next_sample_for_track(m_selected_video_track);
+        if (sample_result.is_error()) {
+            error_item = FrameQueueItem::error_marker(sample_result.release_error(), FrameQueueItem::no_timestamp);
+            preceding_frame = move(m_frame_held_back_for_seek);
+            break;
+        }
+        auto sample = sample_result.release_value();
+        auto container_cicp = sample.auxiliary_data().get<VideoSampleData>().container_cicp();
+
+        // Submit the sample to the decoder.
+        auto decode_result = m_decoder->receive_sample(sample.timestamp(), sample.data());
+        if (decode_result.is_error()) {
+            error_item = FrameQueueItem::error_marker(decode_result.release_error(), sample.timestamp());
+            preceding_frame = move(m_frame_held_back_for_seek);
+            break;
+        }
+
+        // Retrieve the last available frame to present.
+        while (true) {
+            auto frame_result = m_decoder->get_decoded_frame();
 
-            // Submit the sample to the decoder.
-            auto decode_result = m_decoder->receive_sample(sample.timestamp(), sample.data());
-            if (decode_result.is_error()) {
-                item_to_enqueue = FrameQueueItem::error_marker(decode_result.release_error(), sample.timestamp());
+            if (frame_result.is_error()) {
+                if (frame_result.error().category() != DecoderErrorCategory::NeedsMoreInput && decoded_frame == nullptr)
+                    error_item = FrameQueueItem::error_marker(frame_result.release_error(), sample.timestamp());
                 break;
             }
 
-            // Retrieve the last available frame to present.
-            while (true) {
-                auto frame_result = m_decoder->get_decoded_frame();
-
-                if (frame_result.is_error()) {
-                    if (frame_result.error().category() == DecoderErrorCategory::NeedsMoreInput) {
-                        break;
-                    }
-
-                    item_to_enqueue = FrameQueueItem::error_marker(frame_result.release_error(), sample.timestamp());
-                    break;
-                }
-
-                decoded_frame = frame_result.release_value();
-            }
+            decoded_frame = frame_result.release_value();
+            decoded_frame_count++;
         }
 
-        // Convert the frame for display.
-        if (decoded_frame != nullptr) {
-            auto& cicp = decoded_frame->cicp();
-            cicp.adopt_specified_values(container_cicp);
-            cicp.default_code_points_if_unspecified({ ColorPrimaries::BT709, TransferCharacteristics::BT709, MatrixCoefficients::BT709, VideoFullRangeFlag::Studio });
-
-            // BT.470 M, B/G, BT.601, BT.709 and BT.2020 have a similar transfer function to sRGB, so other applications
-            // (Chromium, VLC) forgo transfer characteristics conversion. We will emulate that behavior by
-            // handling those as sRGB instead, which causes no transfer function change in the output,
-            // unless display color management is later implemented.
-            switch (cicp.transfer_characteristics()) {
-            case TransferCharacteristics::BT470BG:
-            case TransferCharacteristics::BT470M:
-            case TransferCharacteristics::BT601:
-            case TransferCharacteristics::BT709:
-            case TransferCharacteristics::BT2020BitDepth10:
-            case TransferCharacteristics::BT2020BitDepth12:
-                cicp.set_transfer_characteristics(TransferCharacteristics::SRGB);
-                break;
-            default:
-                break;
-            }
+        if (decoded_frame == nullptr) {
+            if (error_item.has_value())
+                preceding_frame = move(m_frame_held_back_for_seek);
+            continue;
+        }
 
-            auto bitmap_result = decoded_frame->to_bitmap();
+        prepare_cicp_for_display(*decoded_frame, container_cicp);
 
-            if (bitmap_result.is_error())
-                item_to_enqueue = FrameQueueItem::error_marker(bitmap_result.release_error(), decoded_frame->timestamp());
-            else
-                item_to_enqueue = FrameQueueItem::frame(bitmap_result.release_value(), decoded_frame->timestamp());
-            break;
+        // Frames up to the seek target will only be presented if they are the last one before it, so we can avoid
+        // converting them until the next frame tells us whether that is the case.
+        if (m_seek_target_for_decoder.has_value() && decoded_frame->timestamp() <= m_seek_target_for_decoder.value()) {
+            if (m_frame_held_back_for_seek != nullptr)
+                m_skipped_conversions++;
+            m_frame_held_back_for_seek = move(decoded_frame);
+            continue;
         }
+
+        preceding_frame = move(m_frame_held_back_for_seek);
     }
 
-    VERIFY(!item_to_enqueue.is_empty());
-#if PLAYBACK_MANAGER_DEBUG
-    dbgln("Media Decoder: Sample at {}ms took {}ms to decode, queue contains ~{} items", item_to_enqueue.timestamp().to_milliseconds(), (MonotonicTime::now() - start_time).to_milliseconds(), m_frame_queue.weak_used());
-#endif
+    // Convert the frames for display.
+    Vector<FrameQueueItem, 3> items_to_enqueue;
+    if (preceding_frame != nullptr)
+        items_to_enqueue.unchecked_append(convert_frame_for_display(*preceding_frame));
+    if (decoded_frame != nullptr)
+        items_to_enqueue.unchecked_append(convert_frame_for_display(*decoded_frame));
+    if (error_item.has_value())
+        items_to_enqueue.unchecked_append(error_item.release_value());
+    VERIFY(!items_to_enqueue.is_empty());
+
+    auto decode_time = (MonotonicTime::now() - start_time).to_microseconds();
+    m_decoded_frames += decoded_frame_count;
+    m_frame_allocations.store(m_frame_pool.allocation_count());
+    m_total_decode_time_in_microseconds += decode_time;
+    if (decode_time > m_longest_decode_time_in_microseconds.load())
+        m_longest_decode_time_in_microseconds.store(decode_time);
+
+    dbgln_if(PLAYBACK_MANAGER_DEBUG, "Media Decoder: Sample at {}ms took {}us to decode, queue contains ~{} items", items_to_enqueue.last().timestamp().to_milliseconds(), decode_time, m_frame_queue.weak_used());
 
     auto wait = [&] {
         auto wait_locker = Threading::MutexLocker(m_decode_wait_mutex);
         m_decode_wait_condition.wait();
     };
 
-    bool had_error = item_to_enqueue.is_error();
-    while (true) {
-        if (m_frame_queue.can_enqueue()) {
-            MUST(m_frame_queue.enqueue(move(item_to_enqueue)));
-            break;
-        }
+    bool had_error = items_to_enqueue.last().is_error();
+    for (auto& item : items_to_enqueue) {
+        while (true) {
+            // The queue can hold more items than we want to decode ahead, so that the depth can be changed at runtime.
+            if (m_frame_queue.can_enqueue() && m_frame_queue.weak_used() < m_decode_ahead_depth.load()) {
+                MUST(m_frame_queue.enqueue(move(item)));
+                break;
+            }
 
-        if (m_stop_decoding.load()) {
-            dbgln_if(PLAYBACK_MANAGER_DEBUG, "Media Decoder: Received signal to stop, exiting decode function...");
-            return;
-        }
+            if (m_stop_decoding.load()) {
+                dbgln_if(PLAYBACK_MANAGER_DEBUG, "Media Decoder: Received signal to stop, exiting decode function...");
+                return;
+            }
 
-        m_buffer_is_full.exchange(true);
-        dbgln_if(PLAYBACK_MANAGER_DEBUG, "Media Decoder: Waiting for a frame to be dequeued...");
-        wait();
+            m_buffer_is_full.exchange(true);
+            dbgln_if(PLAYBACK_MANAGER_DEBUG, "Media Decoder: Waiting for a frame to be dequeued...");
+            wait();
+        }
     }
 
     if (had_error) {
-        dbgln_if(PLAYBACK_MANAGER_DEBUG, "Media Decoder: Encountered {}, waiting...", item_to_enqueue.error().category() == DecoderErrorCategory::EndOfStream ? "end of stream"sv : "error"sv);
+        dbgln_if(PLAYBACK_MANAGER_DEBUG, "Media Decoder: Encountered {}, waiting...", items_to_enqueue.last().error().category() == DecoderErrorCategory::EndOfStream ? "end of stream"sv : "error"sv);
         m_buffer_is_full.exchange(true);
         wait();
     }
@@ -594,6 +670,7 @@ private:
 
             if (m_seek_mode == SeekMode::Fast)
                 m_target_timestamp = keyframe_timestamp.value_or(manager().m_last_present_in_media_time);
+            manager().m_seek_target_for_decoder = m_target_timestamp;
 
             if (keyframe_timestamp.has_value()) {
                 dbgln_if(PLAYBACK_MANAGER_DEBUG, "Keyframe is nearer to the target than the current frames, emptying queue");
@@ -603,6 +680,7 @@ private:
             } else if (m_target_timestamp >= manager().m_last_present_in_media_time && manager().m_next_frame.has_value() && manager().m_next_frame.value().timestamp() > m_target_timestamp) {
                 dbgln_if(PLAYBACK_MANAGER_DEBUG, "Target timestamp is between the last presented frame and the next frame, exiting seek at {}ms", m_target_timestamp.to_milliseconds());
                 manager().m_last_present_in_media_time = m_target_timestamp;
+                manager().m_seek_target_for_decoder.clear();
                 return assume_next_state();
             }
         }
@@ -627,6 +705,8 @@ private:
                     manager().m_last_present_in_media_time = m_target_timestamp;
                 }
 
+                manager().set_seek_target_for_decoder({});
+
                 if (manager().dispatch_frame_queue_item(manager().m_next_frame.release_value()))
                     return {};
 
@@ -681,6 +761,8 @@ public:
 private:
     ErrorOr<void> on_enter() override
     {
+        // A seek may have been interrupted by an error, the decoder should not keep holding frames back for it.
+        manager().set_seek_target_for_decoder({});
         return {};
     }
 
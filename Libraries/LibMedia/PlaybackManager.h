@@ -14,6 +14,7 @@
 #include <LibCore/SharedCircularQueue.h>
 #include <LibGfx/Bitmap.h>
 #include <LibMedia/Demuxer.h>
+#include <LibMedia/FramePool.h>
 #include <LibThreading/ConditionVariable.h>
 #include <LibThreading/Mutex.h>
 #include <LibThreading/Thread.h>
@@ -87,9 +88,35 @@ private:
     AK::Duration m_timestamp { no_timestamp };
 };
 
-static constexpr size_t frame_buffer_count = 4;
+// One slot of the circular queue always stays empty, so this allows up to 15 frames to be decoded ahead.
+static constexpr size_t frame_buffer_count = 16;
 using VideoFrameQueue = Core::SharedSingleProducerCircularQueue<FrameQueueItem, frame_buffer_count>;
 
+struct PlaybackStatistics {
+    // Every frame that came out of the decoder, including the ones that were never converted for display.
+    u64 decoded_frames { 0 };
+    u64 presented_frames { 0 };
+    // Frames that were converted for display, but were too late to be presented.
+    u64 dropped_frames { 0 };
+    // Frames that preceded a seek target, and could be skipped without converting them for display.
+    u64 skipped_conversions { 0 };
+    // Bitmaps that had to be allocated because none could be recycled from the frame pool.
+    u64 frame_allocations { 0 };
+
+    AK::Duration total_decode_time { AK::Duration::zero() };
+    AK::Duration longest_decode_time { AK::Duration::zero() };
+
+    size_t queue_depth { 0 };
+    size_t decode_ahead_depth { 0 };
+
+    AK::Duration average_decode_time_per_frame() const
+    {
+        if (decoded_frames == 0)
+            return AK::Duration::zero();
+        return AK::Duration::from_nanoseconds(total_decode_time.to_nanoseconds() / static_cast<i64>(decoded_frames));
+    }
+};
+
 enum class PlaybackState {
     Playing,
     Paused,
@@ -110,6 +137,9 @@ public:
 
     static constexpr SeekMode DEFAULT_SEEK_MODE = SeekMode::Accurate;
 
+    static constexpr size_t DEFAULT_DECODE_AHEAD_DEPTH = 3;
+    static constexpr size_t MAX_DECODE_AHEAD_DEPTH = frame_buffer_count - 1;
+
     static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> from_data(ReadonlyBytes data);
     static DecoderErrorOr<NonnullOwnPtr<PlaybackManager>> from_stream(NonnullOwnPtr<SeekableStream> stream);
 
@@ -132,6 +162,12 @@ public:
 
     u64 number_of_skipped_frames() const { return m_skipped_frames; }
 
+    // How many frames the decode thread may convert ahead of the one that is due to be presented.
+    size_t decode_ahead_depth() const { return m_decode_ahead_depth.load(); }
+    void set_decode_ahead_depth(size_t);
+
+    PlaybackStatistics statistics() const;
+
     AK::Duration current_playback_time();
     AK::Duration duration();
 
@@ -162,6 +198,8 @@ private:
     void set_state_update_timer(int delay_ms);
 
     void decode_and_queue_one_sample();
+    FrameQueueItem convert_frame_for_display(VideoFrame&);
+    void set_seek_target_for_decoder(Optional<AK::Duration>);
 
     void dispatch_decoder_error(DecoderError error);
     void dispatch_new_frame(RefPtr<Gfx::Bitmap> frame);
@@ -186,11 +224,29 @@ private:
     Threading::Mutex m_decode_wait_mutex;
     Threading::ConditionVariable m_decode_wait_condition;
     Atomic<bool> m_buffer_is_full { false };
+    Atomic<size_t> m_decode_ahead_depth { DEFAULT_DECODE_AHEAD_DEPTH };
+
+    // Only used by the decode thread.
+    FramePool m_frame_pool;
+
+    // While seeking, frames that precede the target are not converted for display unless they turn out to be the
+    // last one before it. The most recent such frame is held back here until a later frame (or an error) is decoded.
+    // Both of these must only be accessed with m_decoder_mutex locked!
+    Optional<AK::Duration> m_seek_target_for_decoder;
+    OwnPtr<VideoFrame> m_frame_held_back_for_seek;
 
     OwnPtr<PlaybackStateHandler> m_playback_handler;
     Optional<FrameQueueItem> m_next_frame;
 
     u64 m_skipped_frames { 0 };
+    u64 m_presented_frames { 0 };
+
+    // Written by the decode thread.
+    Atomic<u64> m_decoded_frames { 0 };
+    Atomic<u64> m_skipped_conversions { 0 };
+    Atomic<u64> m_frame_allocations { 0 };
+    Atomic<i64> m_total_decode_time_in_microseconds { 0 };
+    Atomic<i64> m_longest_decode_time_in_microseconds { 0 };
 
     // This is a nested class to allow private access.
     class PlaybackStateHandler {
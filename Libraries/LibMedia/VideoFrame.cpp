@@ -108,8 +108,8 @@ ALWAYS_INLINE void interpolate_row(u32 const row, u32 const width, T const* plan
     }
 }
 
-template<u32 subsampling_horizontal, u32 subsampling_vertical, typename T, typename Convert>
-ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(Convert convert, u32 const width, u32 const height, T const* plane_y, T const* plane_u, T const* plane_v, Gfx::Bitmap& bitmap)
+template<u32 subsampling_horizontal, u32 subsampling_vertical, typename T, typename ConvertRow>
+ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(ConvertRow convert_row, u32 const width, u32 const height, T const* plane_y, T const* plane_u, T const* plane_v, Gfx::Bitmap& bitmap)
 {
     VERIFY(bitmap.width() >= 0);
     VERIFY(bitmap.height() >= 0);
@@ -149,17 +149,10 @@ ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(Convert convert,
         }
 
         auto const* y_row_a = &plane_y[static_cast<size_t>(row) * width];
-        auto* scan_line_a = bitmap.scanline(static_cast<int>(row));
-
-        for (size_t column = 0; column < width; column++) {
-            scan_line_a[column] = convert(y_row_a[column], u_row_a[column], v_row_a[column]).value();
-        }
+        convert_row(y_row_a, u_row_a, v_row_a, bitmap.scanline(static_cast<int>(row)), width);
         if constexpr (subsampling_vertical != 0) {
             auto const* y_row_b = &plane_y[static_cast<size_t>(row + 1) * width];
-            auto* scan_line_b = bitmap.scanline(static_cast<int>(row + 1));
-            for (size_t column = 0; column < width; column++) {
-                scan_line_b[column] = convert(y_row_b[column], u_row_b[column], v_row_b[column]).value();
-            }
+            convert_row(y_row_b, u_row_b, v_row_b, bitmap.scanline(static_cast<int>(row + 1)), width);
         }
 
         AK::TypedTransfer<RemoveReference<decltype(*u_row_a)>>::move(u_row_a, u_row_b, width);
@@ -170,10 +163,7 @@ ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_subsampled(Convert convert,
         // If there is a final row that hasn't been set above, convert it now.
         if ((height & 1) == 0) {
             auto const* y_row = &plane_y[static_cast<size_t>(height - 1) * width];
-            auto* scan_line = bitmap.scanline(static_cast<int>(height - 1));
-            for (size_t column = 0; column < width; column++) {
-                scan_line[column] = convert(y_row[column], u_row_a[column], v_row_a[column]).value();
-            }
+            convert_row(y_row, u_row_a, v_row_a, bitmap.scanline(static_cast<int>(height - 1)), width);
         }
     }
 
@@ -193,16 +183,16 @@ static ALWAYS_INLINE DecoderErrorOr<void> convert_to_bitmap_selecting_converter(
         switch (cicp.matrix_coefficients()) {
         case MatrixCoefficients::BT470BG:
         case MatrixCoefficients::BT601:
-            return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([](T y, T u, T v) { return ColorConverter::convert_simple_yuv_to_rgb<MatrixCoefficients::BT601, VideoFullRangeFlag::Studio>(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
+            return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>(ColorConverter::convert_simple_yuv_row_to_rgb<MatrixCoefficients::BT601, VideoFullRangeFlag::Studio, T>, width, height, plane_y, plane_u, plane_v, bitmap);
         case MatrixCoefficients::BT709:
-            return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([](T y, T u, T v) { return ColorConverter::convert_simple_yuv_to_rgb<MatrixCoefficients::BT709, VideoFullRangeFlag::Studio>(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
+            return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>(ColorConverter::convert_simple_yuv_row_to_rgb<MatrixCoefficients::BT709, VideoFullRangeFlag::Studio, T>, width, height, plane_y, plane_u, plane_v, bitmap);
         default:
             break;
         }
     }
 
     auto converter = TRY(ColorConverter::create(bit_depth, cicp, output_cicp));
-    return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([&](T y, T u, T v) { return converter.convert_yuv(y, u, v); }, width, height, plane_y, plane_u, plane_v, bitmap);
+    return convert_to_bitmap_subsampled<subsampling_horizontal, subsampling_vertical>([&](T const* y_row, T const* u_row, T const* v_row, u32* output, size_t row_width) { converter.convert_yuv_row(y_row, u_row, v_row, output, row_width); }, width, height, plane_y, plane_u, plane_v, bitmap);
 }
 
 template<u32 subsampling_horizontal, u32 subsampling_vertical>
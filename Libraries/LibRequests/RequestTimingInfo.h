@@ -24,6 +24,14 @@ struct RequestTimingInfo {
     long response_end_microseconds { 0 };
     long encoded_body_size { 0 };
     ALPNHttpVersion http_version_alpn_identifier { ALPNHttpVersion::None };
+
+    // The connection the request was sent on. The reuse count is the number of requests that were sent on it before
+    // this one, and the byte counts cover every request sent on it so far, including this one.
+    u64 connection_id { 0 };
+    u64 connection_reuse_count { 0 };
+    long connection_round_trip_time_microseconds { 0 };
+    u64 connection_bytes_sent { 0 };
+    u64 connection_bytes_received { 0 };
 };
 
 }
@@ -43,6 +51,11 @@ inline ErrorOr<void> encode(Encoder& encoder, Requests::RequestTimingInfo const&
     TRY(encoder.encode(timing_info.response_end_microseconds));
     TRY(encoder.encode(timing_info.encoded_body_size));
     TRY(encoder.encode(timing_info.http_version_alpn_identifier));
+    TRY(encoder.encode(timing_info.connection_id));
+    TRY(encoder.encode(timing_info.connection_reuse_count));
+    TRY(encoder.encode(timing_info.connection_round_trip_time_microseconds));
+    TRY(encoder.encode(timing_info.connection_bytes_sent));
+    TRY(encoder.encode(timing_info.connection_bytes_received));
     return {};
 }
 
@@ -59,6 +72,11 @@ inline ErrorOr<Requests::RequestTimingInfo> decode(Decoder& decoder)
     auto response_end_microseconds = TRY(decoder.decode<long>());
     auto encoded_body_size = TRY(decoder.decode<long>());
     auto http_version_alpn_identifier = TRY(decoder.decode<Requests::ALPNHttpVersion>());
+    auto connection_id = TRY(decoder.decode<u64>());
+    auto connection_reuse_count = TRY(decoder.decode<u64>());
+    auto connection_round_trip_time_microseconds = TRY(decoder.decode<long>());
+    auto connection_bytes_sent = TRY(decoder.decode<u64>());
+    auto connection_bytes_received = TRY(decoder.decode<u64>());
 
     return Requests::RequestTimingInfo {
         .domain_lookup_start_microseconds = domain_lookup_start_microseconds,
@@ -71,6 +89,11 @@ inline ErrorOr<Requests::RequestTimingInfo> decode(Decoder& decoder)
         .response_end_microseconds = response_end_microseconds,
         .encoded_body_size = encoded_body_size,
         .http_version_alpn_identifier = http_version_alpn_identifier,
+        .connection_id = connection_id,
+        .connection_reuse_count = connection_reuse_count,
+        .connection_round_trip_time_microseconds = connection_round_trip_time_microseconds,
+        .connection_bytes_sent = connection_bytes_sent,
+        .connection_bytes_received = connection_bytes_received,
     };
 }
 
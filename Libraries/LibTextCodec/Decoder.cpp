@@ -347,18 +347,147 @@ bool Decoder::validate(StringView input)
 ErrorOr<String> Decoder::to_utf8(StringView input)
 {
     StringBuilder builder(input.length());
-    TRY(process(input, [&builder](u32 c) { return builder.try_append_code_point(c); }));
+    TRY(decode_into(input, builder));
     return builder.to_string_without_validation();
 }
 
-ErrorOr<void> UTF8Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+ErrorOr<void> Decoder::decode_into(StringView input, StringBuilder& output)
 {
-    for (auto c : Utf8View(input)) {
-        TRY(on_code_point(c));
+    return process(input, [&output](u32 c) { return output.try_append_code_point(c); });
+}
+
+namespace {
+
+// The decoders below are written against a sink, so that process() can hand out one code point at a time while
+// decode_into() writes straight into a StringBuilder and appends each run of ASCII with a single copy.
+class CodePointCallbackSink {
+public:
+    explicit CodePointCallbackSink(Function<ErrorOr<void>(u32)>& on_code_point)
+        : m_on_code_point(on_code_point)
+    {
     }
+
+    ErrorOr<void> append_code_point(u32 code_point) { return m_on_code_point(code_point); }
+
+    ErrorOr<void> append_ascii(StringView ascii)
+    {
+        for (u8 byte : ascii)
+            TRY(m_on_code_point(byte));
+        return {};
+    }
+
+private:
+    Function<ErrorOr<void>(u32)>& m_on_code_point;
+};
+
+class StringBuilderSink {
+public:
+    explicit StringBuilderSink(StringBuilder& builder)
+        : m_builder(builder)
+    {
+    }
+
+    ErrorOr<void> append_code_point(u32 code_point) { return m_builder.try_append_code_point(code_point); }
+    ErrorOr<void> append_ascii(StringView ascii) { return m_builder.try_append(ascii); }
+
+private:
+    StringBuilder& m_builder;
+};
+
+}
+
+// Appends the run of ASCII bytes that starts with the byte just read from input, and moves index past its end.
+template<typename Sink>
+static ErrorOr<void> append_ascii_run(Sink& sink, StringView input, size_t& index)
+{
+    auto run = input.substring_view(index - 1);
+    run = run.substring_view(0, run.ascii_prefix_length());
+    TRY(sink.append_ascii(run));
+    index += run.length() - 1;
+    return {};
+}
+
+// NOTE: Like String::from_utf8_with_replacement_character(), which to_utf8() used before, the decoding entry points
+//       discard a single leading BOM. process() hands it out like it always has.
+static StringView without_utf8_bom(StringView input)
+{
+    if (auto bytes = input.bytes(); bytes.size() >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF)
+        return input.substring_view(3);
+    return input;
+}
+
+// https://encoding.spec.whatwg.org/#utf-8-decoder
+// NOTE: Unlike Utf8View, this emits a U+FFFD for every byte that can't continue the current sequence, and rejects the
+//       encoded surrogates and overlong forms as soon as the byte that makes them so is seen.
+template<typename Callback>
+static ErrorOr<void> decode_utf8(ReadonlyBytes input, Callback on_code_point)
+{
+    u32 utf8_code_point = 0;
+    u8 utf8_bytes_seen = 0;
+    u8 utf8_bytes_needed = 0;
+    u8 utf8_lower_boundary = 0x80;
+    u8 utf8_upper_boundary = 0xBF;
+
+    for (size_t i = 0; i < input.size();) {
+        u8 byte = input[i];
+
+        if (utf8_bytes_needed == 0) {
+            ++i;
+            if (byte <= 0x7F) {
+                TRY(on_code_point(byte));
+            } else if (byte >= 0xC2 && byte <= 0xDF) {
+                utf8_bytes_needed = 1;
+                utf8_code_point = byte & 0x1F;
+            } else if (byte >= 0xE0 && byte <= 0xEF) {
+                if (byte == 0xE0)
+                    utf8_lower_boundary = 0xA0;
+                if (byte == 0xED)
+                    utf8_upper_boundary = 0x9F;
+                utf8_bytes_needed = 2;
+                utf8_code_point = byte & 0xF;
+            } else if (byte >= 0xF0 && byte <= 0xF4) {
+                if (byte == 0xF0)
+                    utf8_lower_boundary = 0x90;
+                if (byte == 0xF4)
+                    utf8_upper_boundary = 0x8F;
+                utf8_bytes_needed = 3;
+                utf8_code_point = byte & 0x7;
+            } else {
+                TRY(on_code_point(replacement_code_point));
+            }
+            continue;
+        }
+
+        // NOTE: A byte that can't continue the sequence is not consumed, but processed again as the start of the next one.
+        if (byte < utf8_lower_boundary || byte > utf8_upper_boundary) {
+            utf8_code_point = utf8_bytes_needed = utf8_bytes_seen = 0;
+            utf8_lower_boundary = 0x80;
+            utf8_upper_boundary = 0xBF;
+            TRY(on_code_point(replacement_code_point));
+            continue;
+        }
+
+        ++i;
+        utf8_lower_boundary = 0x80;
+        utf8_upper_boundary = 0xBF;
+        utf8_code_point = (utf8_code_point << 6) | (byte & 0x3F);
+        if (++utf8_bytes_seen != utf8_bytes_needed)
+            continue;
+
+        TRY(on_code_point(utf8_code_point));
+        utf8_code_point = utf8_bytes_needed = utf8_bytes_seen = 0;
+    }
+
+    if (utf8_bytes_needed != 0)
+        TRY(on_code_point(replacement_code_point));
     return {};
 }
 
+ErrorOr<void> UTF8Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+{
+    return decode_utf8(input.bytes(), [&](u32 code_point) { return on_code_point(code_point); });
+}
+
 bool UTF8Decoder::validate(StringView input)
 {
     return Utf8View(input).validate();
@@ -366,7 +495,22 @@ bool UTF8Decoder::validate(StringView input)
 
 ErrorOr<String> UTF8Decoder::to_utf8(StringView input)
 {
-    return String::from_utf8_with_replacement_character(input);
+    input = without_utf8_bom(input);
+    if (Utf8View(input).validate(Utf8View::AllowSurrogates::No))
+        return String::from_utf8_without_validation(input.bytes());
+
+    StringBuilder builder(input.length());
+    TRY(decode_utf8(input.bytes(), [&](u32 code_point) { return builder.try_append_code_point(code_point); }));
+    return builder.to_string_without_validation();
+}
+
+ErrorOr<void> UTF8Decoder::decode_into(StringView input, StringBuilder& output)
+{
+    input = without_utf8_bom(input);
+    if (Utf8View(input).validate(Utf8View::AllowSurrogates::No))
+        return output.try_append(input);
+
+    return decode_utf8(input.bytes(), [&](u32 code_point) { return output.try_append_code_point(code_point); });
 }
 
 bool UTF16BEDecoder::validate(StringView input)
@@ -383,6 +527,11 @@ ErrorOr<String> UTF16BEDecoder::to_utf8(StringView input)
     return String::from_utf16_be(input.bytes());
 }
 
+ErrorOr<void> UTF16BEDecoder::decode_into(StringView input, StringBuilder& output)
+{
+    return output.try_append(TRY(to_utf8(input)));
+}
+
 bool UTF16LEDecoder::validate(StringView input)
 {
     return AK::validate_utf16_le(input.bytes());
@@ -397,16 +546,40 @@ ErrorOr<String> UTF16LEDecoder::to_utf8(StringView input)
     return String::from_utf16_le(input.bytes());
 }
 
-ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+ErrorOr<void> UTF16LEDecoder::decode_into(StringView input, StringBuilder& output)
+{
+    return output.try_append(TRY(to_utf8(input)));
+}
+
+template<typename Sink>
+static ErrorOr<void> decode_latin1(StringView input, Sink& sink)
 {
-    for (u8 ch : input) {
+    size_t index = 0;
+    while (index < input.length()) {
+        u8 const ch = input[index++];
+
         // Latin1 is the same as the first 256 Unicode code_points, so no mapping is needed, just utf-8 encoding.
-        TRY(on_code_point(ch));
+        if (ch <= 0x7f)
+            TRY(append_ascii_run(sink, input, index));
+        else
+            TRY(sink.append_code_point(ch));
     }
 
     return {};
 }
 
+ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+{
+    CodePointCallbackSink sink { on_code_point };
+    return decode_latin1(input, sink);
+}
+
+ErrorOr<void> Latin1Decoder::decode_into(StringView input, StringBuilder& output)
+{
+    StringBuilderSink sink { output };
+    return decode_latin1(input, sink);
+}
+
 ErrorOr<void> PDFDocEncodingDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
     // PDF 1.7 spec, Appendix D.2 "PDFDocEncoding Character Set"
@@ -455,22 +628,24 @@ ErrorOr<void> PDFDocEncodingDecoder::process(StringView input, Function<ErrorOr<
 }
 
 // https://encoding.spec.whatwg.org/#x-user-defined-decoder
-ErrorOr<void> XUserDefinedDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+template<typename Sink>
+static ErrorOr<void> decode_x_user_defined(StringView input, Sink& sink)
 {
-    auto convert_x_user_defined_to_utf8 = [](u8 ch) -> u32 {
+    size_t index = 0;
+    while (index < input.length()) {
+        u8 const ch = input[index++];
+
         // 2. If byte is an ASCII byte, return a code point whose value is byte.
         // https://infra.spec.whatwg.org/#ascii-byte
         // An ASCII byte is a byte in the range 0x00 (NUL) to 0x7F (DEL), inclusive.
         // NOTE: This doesn't check for ch >= 0x00, as that would always be true due to being unsigned.
-        if (ch <= 0x7f)
-            return ch;
+        if (ch <= 0x7f) {
+            TRY(append_ascii_run(sink, input, index));
+            continue;
+        }
 
         // 3. Return a code point whose value is 0xF780 + byte − 0x80.
-        return 0xF780 + ch - 0x80;
-    };
-
-    for (auto ch : input) {
-        TRY(on_code_point(convert_x_user_defined_to_utf8(ch)));
+        TRY(sink.append_code_point(0xF780 + ch - 0x80));
     }
 
     // 1. If byte is end-of-queue, return finished.
@@ -478,29 +653,57 @@ ErrorOr<void> XUserDefinedDecoder::process(StringView input, Function<ErrorOr<vo
     return {};
 }
 
+ErrorOr<void> XUserDefinedDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+{
+    CodePointCallbackSink sink { on_code_point };
+    return decode_x_user_defined(input, sink);
+}
+
+ErrorOr<void> XUserDefinedDecoder::decode_into(StringView input, StringBuilder& output)
+{
+    StringBuilderSink sink { output };
+    return decode_x_user_defined(input, sink);
+}
+
 // https://encoding.spec.whatwg.org/#single-byte-decoder
-template<Integral ArrayType>
-ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+template<Integral ArrayType, typename Sink>
+static ErrorOr<void> decode_single_byte(StringView input, Array<ArrayType, 128> const& translation_table, Sink& sink)
 {
-    for (u8 const byte : input) {
+    size_t index = 0;
+    while (index < input.length()) {
+        u8 const byte = input[index++];
         if (byte < 0x80) {
             // 2. If byte is an ASCII byte, return a code point whose value is byte.
-            TRY(on_code_point(byte));
+            TRY(append_ascii_run(sink, input, index));
         } else {
             // 3. Let code point be the index code point for byte − 0x80 in index single-byte.
-            auto code_point = m_translation_table[byte - 0x80];
+            auto code_point = translation_table[byte - 0x80];
 
             // 4. If code point is null, return error.
             // NOTE: Error is communicated with 0xFFFD
 
             // 5. Return a code point whose value is code point.
-            TRY(on_code_point(code_point));
+            TRY(sink.append_code_point(code_point));
         }
     }
     // 1. If byte is end-of-queue, return finished.
     return {};
 }
 
+template<Integral ArrayType>
+ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+{
+    CodePointCallbackSink sink { on_code_point };
+    return decode_single_byte(input, m_translation_table, sink);
+}
+
+template<Integral ArrayType>
+ErrorOr<void> SingleByteDecoder<ArrayType>::decode_into(StringView input, StringBuilder& output)
+{
+    StringBuilderSink sink { output };
+    return decode_single_byte(input, m_translation_table, sink);
+}
+
 // https://encoding.spec.whatwg.org/#index-gb18030-ranges-code-point
 static Optional<u32> index_gb18030_ranges_code_point(u32 pointer)
 {
@@ -568,7 +771,8 @@ static Optional<u32> index_gb18030_ranges_code_point(u32 pointer)
 }
 
 // https://encoding.spec.whatwg.org/#gb18030-decoder
-ErrorOr<void> GB18030Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+template<typename Sink>
+static ErrorOr<void> decode_gb18030(StringView input, Sink& sink)
 {
     // gb18030’s decoder has an associated gb18030 first, gb18030 second, and gb18030 third (all initially 0x00).
     u8 first = 0x00;
@@ -587,7 +791,7 @@ ErrorOr<void> GB18030Decoder::process(StringView input, Function<ErrorOr<void>(u
             first = 0x00;
             second = 0x00;
             third = 0x00;
-            TRY(on_code_point(replacement_code_point));
+            TRY(sink.append_code_point(replacement_code_point));
             continue;
         }
 
@@ -605,7 +809,7 @@ ErrorOr<void> GB18030Decoder::process(StringView input, Function<ErrorOr<void>(u
                 third = 0x00;
 
                 // 3. Return error.
-                TRY(on_code_point(replacement_code_point));
+                TRY(sink.append_code_point(replacement_code_point));
                 continue;
             }
 
@@ -619,12 +823,12 @@ ErrorOr<void> GB18030Decoder::process(StringView input, Function<ErrorOr<void>(u
 
             // 4. If code point is null, return error.
             if (!code_point.has_value()) {
-                TRY(on_code_point(replacement_code_point));
+                TRY(sink.append_code_point(replacement_code_point));
                 continue;
             }
 
             // 5. Return a code point whose value is code point.
-            TRY(on_code_point(code_point.value()));
+            TRY(sink.append_code_point(code_point.value()));
             continue;
         }
 
@@ -640,7 +844,7 @@ ErrorOr<void> GB18030Decoder::process(StringView input, Function<ErrorOr<void>(u
             index -= 2;
             first = 0x00;
             second = 0x00;
-            TRY(on_code_point(replacement_code_point));
+            TRY(sink.append_code_point(replacement_code_point));
             continue;
         }
 
@@ -669,7 +873,7 @@ ErrorOr<void> GB18030Decoder::process(StringView input, Function<ErrorOr<void>(u
 
             // 6. If code point is non-null, return a code point whose value is code point.
             if (code_point.has_value()) {
-                TRY(on_code_point(code_point.value()));
+                TRY(sink.append_code_point(code_point.value()));
                 continue;
             }
 
@@ -678,19 +882,19 @@ ErrorOr<void> GB18030Decoder::process(StringView input, Function<ErrorOr<void>(u
                 index--;
 
             // 8. Return error.
-            TRY(on_code_point(replacement_code_point));
+            TRY(sink.append_code_point(replacement_code_point));
             continue;
         }
 
         // 6. If byte is an ASCII byte, return a code point whose value is byte.
         if (byte <= 0x7F) {
-            TRY(on_code_point(byte));
+            TRY(append_ascii_run(sink, input, index));
             continue;
         }
 
         // 7. If byte is 0x80, return code point U+20AC.
         if (byte == 0x80) {
-            TRY(on_code_point(0x20AC));
+            TRY(sink.append_code_point(0x20AC));
             continue;
         }
 
@@ -701,12 +905,25 @@ ErrorOr<void> GB18030Decoder::process(StringView input, Function<ErrorOr<void>(u
         }
 
         // 9. Return error.
-        TRY(on_code_point(replacement_code_point));
+        TRY(sink.append_code_point(replacement_code_point));
     }
 }
 
+ErrorOr<void> GB18030Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+{
+    CodePointCallbackSink sink { on_code_point };
+    return decode_gb18030(input, sink);
+}
+
+ErrorOr<void> GB18030Decoder::decode_into(StringView input, StringBuilder& output)
+{
+    StringBuilderSink sink { output };
+    return decode_gb18030(input, sink);
+}
+
 // https://encoding.spec.whatwg.org/#big5-decoder
-ErrorOr<void> Big5Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+template<typename Sink>
+static ErrorOr<void> decode_big5(StringView input, Sink& sink)
 {
     // Big5’s decoder has an associated Big5 lead (initially 0x00).
     u8 big5_lead = 0x00;
@@ -717,7 +934,7 @@ ErrorOr<void> Big5Decoder::process(StringView input, Function<ErrorOr<void>(u32)
         // 1. If byte is end-of-queue and Big5 lead is not 0x00, set Big5 lead to 0x00 and return error.
         if (index >= input.length() && big5_lead != 0x00) {
             big5_lead = 0x00;
-            TRY(on_code_point(replacement_code_point));
+            TRY(sink.append_code_point(replacement_code_point));
             continue;
         }
 
@@ -742,23 +959,23 @@ ErrorOr<void> Big5Decoder::process(StringView input, Function<ErrorOr<void>(u32)
 
             // 3. If there is a row in the table below whose first column is pointer, return the two code points listed in its second column (the third column is irrelevant):
             if (pointer.has_value() && pointer.value() == 1133) {
-                TRY(on_code_point(0x00CA));
-                TRY(on_code_point(0x0304));
+                TRY(sink.append_code_point(0x00CA));
+                TRY(sink.append_code_point(0x0304));
                 continue;
             }
             if (pointer.has_value() && pointer.value() == 1135) {
-                TRY(on_code_point(0x00CA));
-                TRY(on_code_point(0x030C));
+                TRY(sink.append_code_point(0x00CA));
+                TRY(sink.append_code_point(0x030C));
                 continue;
             }
             if (pointer.has_value() && pointer.value() == 1164) {
-                TRY(on_code_point(0x00EA));
-                TRY(on_code_point(0x0304));
+                TRY(sink.append_code_point(0x00EA));
+                TRY(sink.append_code_point(0x0304));
                 continue;
             }
             if (pointer.has_value() && pointer.value() == 1166) {
-                TRY(on_code_point(0x00EA));
-                TRY(on_code_point(0x030C));
+                TRY(sink.append_code_point(0x00EA));
+                TRY(sink.append_code_point(0x030C));
                 continue;
             }
 
@@ -767,7 +984,7 @@ ErrorOr<void> Big5Decoder::process(StringView input, Function<ErrorOr<void>(u32)
 
             // 5. If code point is non-null, return a code point whose value is code point.
             if (code_pointer.has_value()) {
-                TRY(on_code_point(code_pointer.value()));
+                TRY(sink.append_code_point(code_pointer.value()));
                 continue;
             }
 
@@ -776,13 +993,13 @@ ErrorOr<void> Big5Decoder::process(StringView input, Function<ErrorOr<void>(u32)
                 index--;
 
             // 7. Return error.
-            TRY(on_code_point(replacement_code_point));
+            TRY(sink.append_code_point(replacement_code_point));
             continue;
         }
 
         // 4. If byte is an ASCII byte, return a code point whose value is byte.
         if (byte <= 0x7F) {
-            TRY(on_code_point(byte));
+            TRY(append_ascii_run(sink, input, index));
             continue;
         }
 
@@ -793,12 +1010,25 @@ ErrorOr<void> Big5Decoder::process(StringView input, Function<ErrorOr<void>(u32)
         }
 
         // 6. Return error
-        TRY(on_code_point(replacement_code_point));
+        TRY(sink.append_code_point(replacement_code_point));
     }
 }
 
+ErrorOr<void> Big5Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+{
+    CodePointCallbackSink sink { on_code_point };
+    return decode_big5(input, sink);
+}
+
+ErrorOr<void> Big5Decoder::decode_into(StringView input, StringBuilder& output)
+{
+    StringBuilderSink sink { output };
+    return decode_big5(input, sink);
+}
+
 // https://encoding.spec.whatwg.org/#euc-jp-decoder
-ErrorOr<void> EUCJPDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+template<typename Sink>
+static ErrorOr<void> decode_euc_jp(StringView input, Sink& sink)
 {
     // EUC-JP’s decoder has an associated EUC-JP jis0212 (initially false) and EUC-JP lead (initially 0x00).
     bool jis0212 = false;
@@ -810,7 +1040,7 @@ ErrorOr<void> EUCJPDecoder::process(StringView input, Function<ErrorOr<void>(u32
         // 1. If byte is end-of-queue and EUC-JP lead is not 0x00, set EUC-JP lead to 0x00, and return error.
         if (index >= input.length() && euc_jp_lead != 0x00) {
             euc_jp_lead = 0x00;
-            TRY(on_code_point(replacement_code_point));
+            TRY(sink.append_code_point(replacement_code_point));
             continue;
         }
 
@@ -823,7 +1053,7 @@ ErrorOr<void> EUCJPDecoder::process(StringView input, Function<ErrorOr<void>(u32
         // 3. If EUC-JP lead is 0x8E and byte is in the range 0xA1 to 0xDF, inclusive, set EUC-JP lead to 0x00 and return a code point whose value is 0xFF61 − 0xA1 + byte.
         if (euc_jp_lead == 0x8E && byte >= 0xA1 && byte <= 0xDF) {
             euc_jp_lead = 0x00;
-            TRY(on_code_point(0xFF61 - 0xA1 + byte));
+            TRY(sink.append_code_point(0xFF61 - 0xA1 + byte));
             continue;
         }
 
@@ -853,7 +1083,7 @@ ErrorOr<void> EUCJPDecoder::process(StringView input, Function<ErrorOr<void>(u32
 
             // 4. If code point is non-null, return a code point whose value is code point.
             if (code_point.has_value()) {
-                TRY(on_code_point(code_point.value()));
+                TRY(sink.append_code_point(code_point.value()));
                 continue;
             }
 
@@ -862,13 +1092,13 @@ ErrorOr<void> EUCJPDecoder::process(StringView input, Function<ErrorOr<void>(u32
                 index--;
 
             // 6. Return error.
-            TRY(on_code_point(replacement_code_point));
+            TRY(sink.append_code_point(replacement_code_point));
             continue;
         }
 
         // 6. If byte is an ASCII byte, return a code point whose value is byte.
         if (byte <= 0x7F) {
-            TRY(on_code_point(byte));
+            TRY(append_ascii_run(sink, input, index));
             continue;
         }
 
@@ -879,10 +1109,22 @@ ErrorOr<void> EUCJPDecoder::process(StringView input, Function<ErrorOr<void>(u32
         }
 
         // 8. Return error.
-        TRY(on_code_point(replacement_code_point));
+        TRY(sink.append_code_point(replacement_code_point));
     }
 }
 
+ErrorOr<void> EUCJPDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+{
+    CodePointCallbackSink sink { on_code_point };
+    return decode_euc_jp(input, sink);
+}
+
+ErrorOr<void> EUCJPDecoder::decode_into(StringView input, StringBuilder& output)
+{
+    StringBuilderSink sink { output };
+    return decode_euc_jp(input, sink);
+}
+
 enum class ISO2022JPState {
     ASCII,
     Roman,
@@ -1133,7 +1375,8 @@ ErrorOr<void> ISO2022JPDecoder::process(StringView input, Function<ErrorOr<void>
 }
 
 // https://encoding.spec.whatwg.org/#shift_jis-decoder
-ErrorOr<void> ShiftJISDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+template<typename Sink>
+static ErrorOr<void> decode_shift_jis(StringView input, Sink& sink)
 {
     // Shift_JIS’s decoder has an associated Shift_JIS lead (initially 0x00).
     u8 shift_jis_lead = 0x00;
@@ -1144,7 +1387,7 @@ ErrorOr<void> ShiftJISDecoder::process(StringView input, Function<ErrorOr<void>(
         // 1. If byte is end-of-queue and Shift_JIS lead is not 0x00, set Shift_JIS lead to 0x00 and return error.
         if (index >= input.length() && shift_jis_lead != 0x00) {
             shift_jis_lead = 0x00;
-            TRY(on_code_point(replacement_code_point));
+            TRY(sink.append_code_point(replacement_code_point));
             continue;
         }
 
@@ -1172,7 +1415,7 @@ ErrorOr<void> ShiftJISDecoder::process(StringView input, Function<ErrorOr<void>(
 
             // 4. If pointer is in the range 8836 to 10715, inclusive, return a code point whose value is 0xE000 − 8836 + pointer.
             if (pointer.has_value() && pointer.value() >= 8836 && pointer.value() <= 10715) {
-                TRY(on_code_point(0xE000 - 8836 + pointer.value()));
+                TRY(sink.append_code_point(0xE000 - 8836 + pointer.value()));
                 continue;
             }
 
@@ -1181,7 +1424,7 @@ ErrorOr<void> ShiftJISDecoder::process(StringView input, Function<ErrorOr<void>(
 
             // 6. If code point is non-null, return a code point whose value is code point.
             if (code_point.has_value()) {
-                TRY(on_code_point(code_point.value()));
+                TRY(sink.append_code_point(code_point.value()));
                 continue;
             }
 
@@ -1190,19 +1433,23 @@ ErrorOr<void> ShiftJISDecoder::process(StringView input, Function<ErrorOr<void>(
                 index--;
 
             // 8. Return error.
-            TRY(on_code_point(replacement_code_point));
+            TRY(sink.append_code_point(replacement_code_point));
             continue;
         }
 
         // 4. If byte is an ASCII byte or 0x80, return a code point whose value is byte.
-        if (byte <= 0x80) {
-            TRY(on_code_point(byte));
+        if (byte <= 0x7F) {
+            TRY(append_ascii_run(sink, input, index));
+            continue;
+        }
+        if (byte == 0x80) {
+            TRY(sink.append_code_point(byte));
             continue;
         }
 
         // 5. If byte is in the range 0xA1 to 0xDF, inclusive, return a code point whose value is 0xFF61 − 0xA1 + byte.
         if (byte >= 0xA1 && byte <= 0xDF) {
-            TRY(on_code_point(0xFF61 - 0xA1 + byte));
+            TRY(sink.append_code_point(0xFF61 - 0xA1 + byte));
             continue;
         }
 
@@ -1213,12 +1460,25 @@ ErrorOr<void> ShiftJISDecoder::process(StringView input, Function<ErrorOr<void>(
         }
 
         // 7. Return error.
-        TRY(on_code_point(replacement_code_point));
+        TRY(sink.append_code_point(replacement_code_point));
     }
 }
 
+ErrorOr<void> ShiftJISDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+{
+    CodePointCallbackSink sink { on_code_point };
+    return decode_shift_jis(input, sink);
+}
+
+ErrorOr<void> ShiftJISDecoder::decode_into(StringView input, StringBuilder& output)
+{
+    StringBuilderSink sink { output };
+    return decode_shift_jis(input, sink);
+}
+
 // https://encoding.spec.whatwg.org/#euc-kr-decoder
-ErrorOr<void> EUCKRDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+template<typename Sink>
+static ErrorOr<void> decode_euc_kr(StringView input, Sink& sink)
 {
     // EUC-KR’s decoder has an associated EUC-KR lead (initially 0x00).
     u8 euc_kr_lead = 0x00;
@@ -1229,7 +1489,7 @@ ErrorOr<void> EUCKRDecoder::process(StringView input, Function<ErrorOr<void>(u32
         // 1. If byte is end-of-queue and EUC-KR lead is not 0x00, set EUC-KR lead to 0x00 and return error.
         if (index >= input.length() && euc_kr_lead != 0x00) {
             euc_kr_lead = 0x00;
-            TRY(on_code_point(replacement_code_point));
+            TRY(sink.append_code_point(replacement_code_point));
             continue;
         }
 
@@ -1254,7 +1514,7 @@ ErrorOr<void> EUCKRDecoder::process(StringView input, Function<ErrorOr<void>(u32
 
             // 3. If code point is non-null, return a code point whose value is code point.
             if (code_point.has_value()) {
-                TRY(on_code_point(code_point.value()));
+                TRY(sink.append_code_point(code_point.value()));
                 continue;
             }
 
@@ -1263,13 +1523,13 @@ ErrorOr<void> EUCKRDecoder::process(StringView input, Function<ErrorOr<void>(u32
                 index--;
 
             // 5. Return error.
-            TRY(on_code_point(replacement_code_point));
+            TRY(sink.append_code_point(replacement_code_point));
             continue;
         }
 
         // 4. If byte is an ASCII byte, return a code point whose value is byte.
         if (byte <= 0x7F) {
-            TRY(on_code_point(byte));
+            TRY(append_ascii_run(sink, input, index));
             continue;
         }
 
@@ -1280,10 +1540,22 @@ ErrorOr<void> EUCKRDecoder::process(StringView input, Function<ErrorOr<void>(u32
         }
 
         // 6. Return error.
-        TRY(on_code_point(replacement_code_point));
+        TRY(sink.append_code_point(replacement_code_point));
     }
 }
 
+ErrorOr<void> EUCKRDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
+{
+    CodePointCallbackSink sink { on_code_point };
+    return decode_euc_kr(input, sink);
+}
+
+ErrorOr<void> EUCKRDecoder::decode_into(StringView input, StringBuilder& output)
+{
+    StringBuilderSink sink { output };
+    return decode_euc_kr(input, sink);
+}
+
 // https://encoding.spec.whatwg.org/#replacement-decoder
 ErrorOr<void> ReplacementDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
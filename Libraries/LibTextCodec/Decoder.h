@@ -20,6 +20,10 @@ public:
     virtual bool validate(StringView);
     virtual ErrorOr<String> to_utf8(StringView);
 
+    // Decodes input and appends the result to output as UTF-8. Decoders that override this write into the builder
+    // directly and copy runs of ASCII in bulk, instead of handing out one code point at a time through process().
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder& output);
+
 protected:
     virtual ~Decoder() = default;
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) = 0;
@@ -30,12 +34,14 @@ public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
     virtual bool validate(StringView) override;
     virtual ErrorOr<String> to_utf8(StringView) override;
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder&) override;
 };
 
 class UTF16BEDecoder final : public Decoder {
 public:
     virtual bool validate(StringView) override;
     virtual ErrorOr<String> to_utf8(StringView) override;
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder&) override;
 
 private:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)>) override { VERIFY_NOT_REACHED(); }
@@ -45,6 +51,7 @@ class UTF16LEDecoder final : public Decoder {
 public:
     virtual bool validate(StringView) override;
     virtual ErrorOr<String> to_utf8(StringView) override;
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder&) override;
 
 private:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)>) override { VERIFY_NOT_REACHED(); }
@@ -59,6 +66,7 @@ public:
     }
 
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder&) override;
 
 private:
     Array<ArrayType, 128> m_translation_table;
@@ -68,6 +76,7 @@ class Latin1Decoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
     virtual bool validate(StringView) override { return true; }
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder&) override;
 };
 
 class PDFDocEncodingDecoder final : public Decoder {
@@ -80,21 +89,25 @@ class XUserDefinedDecoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
     virtual bool validate(StringView) override { return true; }
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder&) override;
 };
 
 class GB18030Decoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder&) override;
 };
 
 class Big5Decoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder&) override;
 };
 
 class EUCJPDecoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder&) override;
 };
 
 class ISO2022JPDecoder final : public Decoder {
@@ -105,11 +118,13 @@ public:
 class ShiftJISDecoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder&) override;
 };
 
 class EUCKRDecoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+    virtual ErrorOr<void> decode_into(StringView, StringBuilder&) override;
 };
 
 class ReplacementDecoder final : public Decoder {
@@ -5,6 +5,7 @@
  */
 
 #include <AK/BinarySearch.h>
+#include <AK/ByteBuffer.h>
 #include <AK/Error.h>
 #include <AK/Utf8View.h>
 #include <LibTextCodec/Decoder.h>
@@ -137,6 +138,41 @@ Optional<Encoder&> encoder_for(StringView label)
     return encoding.has_value() ? encoder_for_exact_name(encoding.value()) : Optional<Encoder&> {};
 }
 
+ErrorOr<void> Encoder::encode_into(Utf8View input, ByteBuffer& output, Function<ErrorOr<void>(u32)> on_error)
+{
+    return process(input, [&output](u8 byte) { return output.try_append(byte); }, move(on_error));
+}
+
+// For encoders that encode every code point on its own and map ASCII to itself: runs of ASCII are copied to the output
+// as they are, and only the code points in between go through process().
+// NOTE: An ASCII byte is never part of a multi-byte UTF-8 sequence, not even an invalid one, so splitting the input at
+//       ASCII bytes does not change how the rest of it is decoded.
+static ErrorOr<void> encode_into_copying_ascii_runs(Encoder& encoder, Utf8View input, ByteBuffer& output, Function<ErrorOr<void>(u32)>& on_error)
+{
+    TRY(output.try_ensure_capacity(output.size() + input.byte_length()));
+
+    auto remaining = input.as_string();
+    while (!remaining.is_empty()) {
+        auto ascii_length = remaining.ascii_prefix_length();
+        TRY(output.try_append(remaining.bytes().trim(ascii_length)));
+        remaining = remaining.substring_view(ascii_length);
+
+        size_t non_ascii_length = 0;
+        while (non_ascii_length < remaining.length() && static_cast<u8>(remaining[non_ascii_length]) > 0x7f)
+            ++non_ascii_length;
+        if (non_ascii_length == 0)
+            continue;
+
+        TRY(encoder.process(
+            Utf8View { remaining.substring_view(0, non_ascii_length) },
+            [&output](u8 byte) { return output.try_append(byte); },
+            [&on_error](u32 code_point) { return on_error(code_point); }));
+        remaining = remaining.substring_view(non_ascii_length);
+    }
+
+    return {};
+}
+
 // https://encoding.spec.whatwg.org/#utf-8-encoder
 ErrorOr<void> UTF8Encoder::process(Utf8View input, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)>)
 {
@@ -146,6 +182,11 @@ ErrorOr<void> UTF8Encoder::process(Utf8View input, Function<ErrorOr<void>(u8)> o
     return {};
 }
 
+ErrorOr<void> UTF8Encoder::encode_into(Utf8View input, ByteBuffer& output, Function<ErrorOr<void>(u32)>)
+{
+    return output.try_append(input.bytes(), input.byte_length());
+}
+
 // https://encoding.spec.whatwg.org/#euc-jp-encoder
 ErrorOr<void> EUCJPEncoder::process(Utf8View input, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)> on_error)
 {
@@ -204,6 +245,11 @@ ErrorOr<void> EUCJPEncoder::process(Utf8View input, Function<ErrorOr<void>(u8)>
     return {};
 }
 
+ErrorOr<void> EUCJPEncoder::encode_into(Utf8View input, ByteBuffer& output, Function<ErrorOr<void>(u32)> on_error)
+{
+    return encode_into_copying_ascii_runs(*this, input, output, on_error);
+}
+
 // https://encoding.spec.whatwg.org/#iso-2022-jp-encoder
 ErrorOr<ISO2022JPEncoder::State> ISO2022JPEncoder::process_item(u32 item, State state, Function<ErrorOr<void>(u8)>& on_byte, Function<ErrorOr<void>(u32)>& on_error)
 {
@@ -425,6 +471,11 @@ ErrorOr<void> ShiftJISEncoder::process(Utf8View input, Function<ErrorOr<void>(u8
     return {};
 }
 
+ErrorOr<void> ShiftJISEncoder::encode_into(Utf8View input, ByteBuffer& output, Function<ErrorOr<void>(u32)> on_error)
+{
+    return encode_into_copying_ascii_runs(*this, input, output, on_error);
+}
+
 // https://encoding.spec.whatwg.org/#euc-kr-encoder
 ErrorOr<void> EUCKREncoder::process(Utf8View input, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)> on_error)
 {
@@ -460,6 +511,11 @@ ErrorOr<void> EUCKREncoder::process(Utf8View input, Function<ErrorOr<void>(u8)>
     return {};
 }
 
+ErrorOr<void> EUCKREncoder::encode_into(Utf8View input, ByteBuffer& output, Function<ErrorOr<void>(u32)> on_error)
+{
+    return encode_into_copying_ascii_runs(*this, input, output, on_error);
+}
+
 // https://encoding.spec.whatwg.org/#index-big5-pointer
 static Optional<u32> index_big5_pointer(u32 code_point)
 {
@@ -526,6 +582,11 @@ ErrorOr<void> Big5Encoder::process(Utf8View input, Function<ErrorOr<void>(u8)> o
     return {};
 }
 
+ErrorOr<void> Big5Encoder::encode_into(Utf8View input, ByteBuffer& output, Function<ErrorOr<void>(u32)> on_error)
+{
+    return encode_into_copying_ascii_runs(*this, input, output, on_error);
+}
+
 // https://encoding.spec.whatwg.org/#index-gb18030-ranges-pointer
 static u32 index_gb18030_ranges_pointer(u32 code_point)
 {
@@ -636,6 +697,11 @@ ErrorOr<void> GB18030Encoder::process(Utf8View input, Function<ErrorOr<void>(u8)
     return {};
 }
 
+ErrorOr<void> GB18030Encoder::encode_into(Utf8View input, ByteBuffer& output, Function<ErrorOr<void>(u32)> on_error)
+{
+    return encode_into_copying_ascii_runs(*this, input, output, on_error);
+}
+
 // https://encoding.spec.whatwg.org/#single-byte-encoder
 template<Integral ArrayType>
 ErrorOr<void> SingleByteEncoder<ArrayType>::process(Utf8View input, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)> on_error)
@@ -666,4 +732,10 @@ ErrorOr<void> SingleByteEncoder<ArrayType>::process(Utf8View input, Function<Err
     return {};
 }
 
+template<Integral ArrayType>
+ErrorOr<void> SingleByteEncoder<ArrayType>::encode_into(Utf8View input, ByteBuffer& output, Function<ErrorOr<void>(u32)> on_error)
+{
+    return encode_into_copying_ascii_runs(*this, input, output, on_error);
+}
+
 }
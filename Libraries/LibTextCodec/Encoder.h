@@ -15,6 +15,10 @@ class Encoder {
 public:
     virtual ErrorOr<void> process(Utf8View, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)> on_error) = 0;
 
+    // Encodes input and appends the result to output. Encoders that override this copy runs of ASCII in bulk, instead
+    // of handing out one byte at a time through process().
+    virtual ErrorOr<void> encode_into(Utf8View, ByteBuffer& output, Function<ErrorOr<void>(u32)> on_error);
+
 protected:
     virtual ~Encoder() = default;
 };
@@ -22,11 +26,13 @@ protected:
 class UTF8Encoder final : public Encoder {
 public:
     virtual ErrorOr<void> process(Utf8View, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)> on_error) override;
+    virtual ErrorOr<void> encode_into(Utf8View, ByteBuffer&, Function<ErrorOr<void>(u32)> on_error) override;
 };
 
 class EUCJPEncoder final : public Encoder {
 public:
     virtual ErrorOr<void> process(Utf8View, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)> on_error) override;
+    virtual ErrorOr<void> encode_into(Utf8View, ByteBuffer&, Function<ErrorOr<void>(u32)> on_error) override;
 };
 
 class ISO2022JPEncoder final : public Encoder {
@@ -46,16 +52,19 @@ private:
 class ShiftJISEncoder final : public Encoder {
 public:
     virtual ErrorOr<void> process(Utf8View, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)> on_error) override;
+    virtual ErrorOr<void> encode_into(Utf8View, ByteBuffer&, Function<ErrorOr<void>(u32)> on_error) override;
 };
 
 class EUCKREncoder final : public Encoder {
 public:
     virtual ErrorOr<void> process(Utf8View, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)> on_error) override;
+    virtual ErrorOr<void> encode_into(Utf8View, ByteBuffer&, Function<ErrorOr<void>(u32)> on_error) override;
 };
 
 class Big5Encoder final : public Encoder {
 public:
     virtual ErrorOr<void> process(Utf8View, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)> on_error) override;
+    virtual ErrorOr<void> encode_into(Utf8View, ByteBuffer&, Function<ErrorOr<void>(u32)> on_error) override;
 };
 
 class GB18030Encoder final : public Encoder {
@@ -68,6 +77,7 @@ public:
     GB18030Encoder(IsGBK is_gbk = IsGBK::No);
 
     virtual ErrorOr<void> process(Utf8View, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)> on_error) override;
+    virtual ErrorOr<void> encode_into(Utf8View, ByteBuffer&, Function<ErrorOr<void>(u32)> on_error) override;
 
 private:
     IsGBK m_is_gbk { IsGBK::No };
@@ -81,6 +91,7 @@ public:
     }
 
     virtual ErrorOr<void> process(Utf8View, Function<ErrorOr<void>(u8)> on_byte, Function<ErrorOr<void>(u32)> on_error) override;
+    virtual ErrorOr<void> encode_into(Utf8View, ByteBuffer&, Function<ErrorOr<void>(u32)> on_error) override;
 
 private:
     Array<ArrayType, 128> m_translation_table;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <LibCore/System.h>
+#include <LibThreading/ThreadPool.h>
+
+namespace Threading {
+
+ThreadPool& ThreadPool::the()
+{
+    // NOTE: The threads are never joined, so the pool is intentionally leaked rather than destroyed at exit.
+    static ThreadPool* s_the = new ThreadPool(clamp(Core::System::hardware_concurrency(), 1u, 4u));
+    return *s_the;
+}
+
+ThreadPool::ThreadPool(size_t thread_count)
+{
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto thread = Thread::construct([this] { return worker_loop(); }, "Pool Worker"sv);
+        thread->start();
+        thread->detach();
+        m_threads.append(move(thread));
+    }
+}
+
+void ThreadPool::submit(Job job)
+{
+    MutexLocker locker { m_mutex };
+    m_jobs.enqueue(move(job));
+    m_job_available.signal();
+}
+
+intptr_t ThreadPool::worker_loop()
+{
+    while (true) {
+        Job job;
+        {
+            MutexLocker locker { m_mutex };
+            while (m_jobs.is_empty())
+                m_job_available.wait();
+            job = m_jobs.dequeue();
+        }
+
+        job();
+    }
+}
+
+void ThreadPool::for_each_index(size_t count, Function<void(size_t)> const& callback)
+{
+    if (count == 0)
+        return;
+
+    // NOTE: The pool may be busy with other jobs, so a helper can start after every index has been handed out and this
+    //       has returned. The state is therefore shared with the helpers, which only touch the callback for indices
+    //       they claimed while it was still alive.
+    struct State : public AtomicRefCounted<State> {
+        State(size_t count, Function<void(size_t)> const& callback)
+            : count(count)
+            , callback(callback)
+        {
+        }
+
+        // NOTE: Indices are handed out one at a time rather than in fixed slices, since the work per index can vary a
+        //       lot between callers (and between indices).
+        void run()
+        {
+            for (auto index = next_index.fetch_add(1); index < count; index = next_index.fetch_add(1)) {
+                callback(index);
+                if (finished_count.fetch_add(1) + 1 == count) {
+                    MutexLocker locker { mutex };
+                    all_finished.signal();
+                }
+            }
+        }
+
+        size_t const count;
+        Function<void(size_t)> const& callback;
+        Atomic<size_t> next_index { 0 };
+        Atomic<size_t> finished_count { 0 };
+        Mutex mutex;
+        ConditionVariable all_finished { mutex };
+    };
+
+    auto state = adopt_ref(*new State(count, callback));
+
+    auto helper_count = min(count - 1, thread_count());
+    for (size_t i = 0; i < helper_count; ++i)
+        submit([state] { state->run(); });
+
+    state->run();
+
+    MutexLocker locker { state->mutex };
+    while (state->finished_count.load() < count)
+        state->all_finished.wait();
+}
+
+}
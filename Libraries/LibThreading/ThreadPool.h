@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/Queue.h>
+#include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace Threading {
+
+// A fixed set of threads that takes CPU-heavy work off the threads that queue it, so that their event loops keep
+// spinning in the meantime. Jobs are started in the order they were queued.
+class ThreadPool {
+    AK_MAKE_NONCOPYABLE(ThreadPool);
+    AK_MAKE_NONMOVABLE(ThreadPool);
+
+public:
+    using Job = Function<void()>;
+
+    // The pool shared by the whole process, with one thread per core, up to four.
+    static ThreadPool& the();
+
+    size_t thread_count() const { return m_threads.size(); }
+
+    void submit(Job);
+
+    // Runs the operation on one of the pool's threads, then invokes the completion handler with its result on the
+    // event loop that was current when this was called.
+    template<typename Operation, typename CompletionHandler>
+    void run(Operation operation, CompletionHandler on_complete)
+    {
+        submit([operation = move(operation), on_complete = move(on_complete), event_loop = &Core::EventLoop::current()]() mutable {
+            auto result = operation();
+            event_loop->deferred_invoke([on_complete = move(on_complete), result = move(result)]() mutable {
+                on_complete(move(result));
+            });
+            event_loop->wake();
+        });
+    }
+
+    // Calls the callback once for every index below the count, spread across the calling thread and the pool's
+    // threads, and returns once all calls have finished.
+    void for_each_index(size_t count, Function<void(size_t)> const&);
+
+private:
+    explicit ThreadPool(size_t thread_count);
+
+    intptr_t worker_loop();
+
+    Mutex m_mutex;
+    ConditionVariable m_job_available { m_mutex };
+    Queue<Job> m_jobs;
+    Vector<NonnullRefPtr<Thread>> m_threads;
+};
+
+}
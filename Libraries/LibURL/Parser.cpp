@@ -705,8 +705,157 @@ String Parser::percent_encode_after_encoding(TextCodec::Encoder& encoder, String
     return MUST(output.to_string());
 }
 
+namespace {
+
+struct ParseCacheEntry {
+    ByteString input;
+    Optional<URL> base_url;
+    Optional<URL> result;
+    bool is_used { false };
+};
+
+}
+
+// Recent results of parsing a string against a base URL. The same relative URLs get resolved against the same base URL
+// over and over, e.g. for url() values during style computation and for href reflection. URLs are reference counted
+// without atomics, so every thread gets its own cache.
+static constexpr size_t parse_cache_size = 256;
+static thread_local Array<ParseCacheEntry, parse_cache_size> s_parse_cache;
+
 // https://url.spec.whatwg.org/#concept-basic-url-parser
 Optional<URL> Parser::basic_parse(StringView raw_input, Optional<URL const&> base_url, URL* url, Optional<State> state_override, Optional<StringView> encoding)
+{
+    // NOTE: Only plain parses are cached, as parsing into an existing URL or with a non-UTF-8 encoding depends on more
+    //       than the input and base URL.
+    if (url || state_override.has_value() || (encoding.has_value() && !TextCodec::get_output_encoding(*encoding).equals_ignoring_ascii_case("UTF-8"sv)))
+        return basic_parse_impl(raw_input, base_url, url, state_override, encoding);
+
+    // NOTE: The cache holds a reference to the base URL's data, so that data cannot be modified in place and then
+    //       mistaken for the URL that was cached. Comparing the data pointers is enough to identify the base URL.
+    auto const* base_url_data = base_url.has_value() ? base_url->m_data.ptr() : nullptr;
+    auto hash = pair_int_hash(raw_input.hash(), ptr_hash(base_url_data));
+    auto& entry = s_parse_cache[hash % parse_cache_size];
+
+    if (entry.is_used && entry.input == raw_input) {
+        auto const* cached_base_url_data = entry.base_url.has_value() ? entry.base_url->m_data.ptr() : nullptr;
+        if (cached_base_url_data == base_url_data)
+            return entry.result;
+    }
+
+    // OPTIMIZATION: Absolute URLs that are already in their serialized form can be split into their components
+    //               without running the state machine.
+    auto result = parse_canonical_special_url(raw_input);
+    if (!result.has_value())
+        result = basic_parse_impl(raw_input, base_url, nullptr, {}, encoding);
+
+    entry.input = raw_input;
+    entry.base_url = base_url.copy();
+    entry.result = result;
+    entry.is_used = true;
+
+    return result;
+}
+
+// Recognizes URLs with a special scheme other than "file" that the basic URL parser would return unchanged: those made
+// up of a lowercase scheme, a lowercase ASCII domain, an optional non-default port, and a path, query and fragment of
+// printable ASCII that needs no percent-encoding and contains no dot segments.
+Optional<URL> Parser::parse_canonical_special_url(StringView input)
+{
+    auto scheme_length = input.find("://"sv);
+    if (!scheme_length.has_value())
+        return {};
+
+    auto scheme = input.substring_view(0, *scheme_length);
+    if (!scheme.is_one_of("http"sv, "https"sv, "ws"sv, "wss"sv, "ftp"sv))
+        return {};
+
+    auto rest = input.substring_view(*scheme_length + 3);
+    auto authority_length = rest.find('/');
+    if (!authority_length.has_value())
+        return {};
+
+    auto authority = rest.substring_view(0, *authority_length);
+    auto remainder = rest.substring_view(*authority_length);
+
+    auto host = authority;
+    Optional<u16> port;
+    if (auto port_start = authority.find(':'); port_start.has_value()) {
+        host = authority.substring_view(0, *port_start);
+
+        auto port_string = authority.substring_view(*port_start + 1);
+        if (port_string.is_empty() || port_string.length() > 5 || (port_string.length() > 1 && port_string[0] == '0') || !all_of(port_string, is_ascii_digit))
+            return {};
+        auto port_number = port_string.to_number<u32>();
+        if (!port_number.has_value() || *port_number > NumericLimits<u16>::max())
+            return {};
+        port = static_cast<u16>(*port_number);
+        if (port == default_port_for_scheme(scheme))
+            return {};
+    }
+
+    if (host.is_empty() || !all_of(host, [](char c) { return is_ascii_lower_alpha(c) || is_ascii_digit(c) || c == '-' || c == '.'; }))
+        return {};
+    for (auto label : host.split_view('.')) {
+        if (label.starts_with("xn--"sv))
+            return {};
+    }
+    if (ends_in_a_number_checker(host))
+        return {};
+
+    auto is_unchanged_by_percent_encoding = [](StringView component, PercentEncodeSet set) {
+        return all_of(component, [set](char c) { return c != '\\' && !code_point_is_in_percent_encode_set(static_cast<u8>(c), set); });
+    };
+
+    Optional<StringView> fragment;
+    if (auto fragment_start = remainder.find('#'); fragment_start.has_value()) {
+        fragment = remainder.substring_view(*fragment_start + 1);
+        remainder = remainder.substring_view(0, *fragment_start);
+        if (!is_unchanged_by_percent_encoding(*fragment, PercentEncodeSet::Fragment))
+            return {};
+    }
+
+    Optional<StringView> query;
+    if (auto query_start = remainder.find('?'); query_start.has_value()) {
+        query = remainder.substring_view(*query_start + 1);
+        remainder = remainder.substring_view(0, *query_start);
+        if (!is_unchanged_by_percent_encoding(*query, PercentEncodeSet::SpecialQuery))
+            return {};
+    }
+
+    auto path = remainder.substring_view(1);
+    if (!is_unchanged_by_percent_encoding(path, PercentEncodeSet::Path))
+        return {};
+
+    Vector<StringView, 8> segments;
+    size_t segment_start = 0;
+    for (size_t i = 0; i <= path.length(); ++i) {
+        if (i < path.length() && path[i] != '/')
+            continue;
+
+        auto segment = path.substring_view(segment_start, i - segment_start);
+        if (is_single_dot_path_segment(segment) || is_double_dot_path_segment(segment))
+            return {};
+        segments.append(segment);
+        segment_start = i + 1;
+    }
+
+    auto to_string = [](StringView ascii) { return String::from_utf8_without_validation(ascii.bytes()); };
+
+    URL url;
+    url.m_data->scheme = to_string(scheme);
+    url.m_data->host = Host { to_string(host) };
+    url.m_data->port = port;
+    url.m_data->paths.ensure_capacity(segments.size());
+    for (auto segment : segments)
+        url.m_data->paths.unchecked_append(to_string(segment));
+    if (query.has_value())
+        url.m_data->query = to_string(*query);
+    if (fragment.has_value())
+        url.m_data->fragment = to_string(*fragment);
+    return url;
+}
+
+Optional<URL> Parser::basic_parse_impl(StringView raw_input, Optional<URL const&> base_url, URL* url, Optional<State> state_override, Optional<StringView> encoding)
 {
     dbgln_if(URL_PARSER_DEBUG, "URL::Parser::basic_parse: Parsing '{}'", raw_input);
 
@@ -65,6 +65,10 @@ public:
 
     // https://url.spec.whatwg.org/#shorten-a-urls-path
     static void shorten_urls_path(URL&);
+
+private:
+    static Optional<URL> basic_parse_impl(StringView input, Optional<URL const&> base_url, URL* url, Optional<State> state_override, Optional<StringView> encoding);
+    static Optional<URL> parse_canonical_special_url(StringView input);
 };
 
 #undef ENUMERATE_STATES
@@ -32,6 +32,11 @@ namespace Web::CSS {
 
 GC_DEFINE_ALLOCATOR(CSSStyleProperties);
 
+struct CSSStyleProperties::UnparsedDeclarations {
+    Parser::ParsingParams parsing_params;
+    Vector<Parser::Declaration> declarations;
+};
+
 GC::Ref<CSSStyleProperties> CSSStyleProperties::create(JS::Realm& realm, Vector<StyleProperty> properties, HashMap<FlyString, StyleProperty> custom_properties)
 {
     // https://drafts.csswg.org/cssom/#dom-cssstylerule-style
@@ -44,6 +49,14 @@ GC::Ref<CSSStyleProperties> CSSStyleProperties::create(JS::Realm& realm, Vector<
     return realm.create<CSSStyleProperties>(realm, Computed::No, Readonly::No, move(properties), move(custom_properties), OptionalNone {});
 }
 
+GC::Ref<CSSStyleProperties> CSSStyleProperties::create_with_unparsed_declarations(JS::Realm& realm, Parser::ParsingParams const& parsing_params, Vector<Parser::Declaration> declarations)
+{
+    auto style = realm.create<CSSStyleProperties>(realm, Computed::No, Readonly::No, Vector<StyleProperty> {}, HashMap<FlyString, StyleProperty> {}, OptionalNone {});
+    if (!declarations.is_empty())
+        style->m_unparsed_declarations = adopt_own(*new UnparsedDeclarations { parsing_params, move(declarations) });
+    return style;
+}
+
 GC::Ref<CSSStyleProperties> CSSStyleProperties::create_resolved_style(DOM::ElementReference element_reference)
 {
     // https://drafts.csswg.org/cssom/#dom-window-getcomputedstyle
@@ -75,6 +88,8 @@ CSSStyleProperties::CSSStyleProperties(JS::Realm& realm, Computed computed, Read
     set_owner_node(move(owner_node));
 }
 
+CSSStyleProperties::~CSSStyleProperties() = default;
+
 void CSSStyleProperties::initialize(JS::Realm& realm)
 {
     WEB_SET_PROTOTYPE_FOR_INTERFACE(CSSStyleProperties);
@@ -87,6 +102,18 @@ void CSSStyleProperties::visit_edges(Visitor& visitor)
     for (auto& property : m_properties) {
         property.value->visit_edges(visitor);
     }
+    if (m_unparsed_declarations) {
+        visitor.visit(m_unparsed_declarations->parsing_params.realm);
+        visitor.visit(m_unparsed_declarations->parsing_params.document);
+    }
+}
+
+void CSSStyleProperties::parse_unparsed_declarations()
+{
+    auto unparsed_declarations = m_unparsed_declarations.release_nonnull();
+    auto style = parse_css_declarations(unparsed_declarations->parsing_params, unparsed_declarations->declarations);
+    m_properties = move(style.properties);
+    m_custom_properties = move(style.custom_properties);
 }
 
 // https://drafts.csswg.org/cssom/#dom-cssstyledeclaration-length
@@ -98,7 +125,7 @@ size_t CSSStyleProperties::length() const
     if (is_computed())
         return to_underlying(last_longhand_property_id) - to_underlying(first_longhand_property_id) + 1;
 
-    return m_properties.size();
+    return properties().size();
 }
 
 String CSSStyleProperties::item(size_t index) const
@@ -114,7 +141,7 @@ String CSSStyleProperties::item(size_t index) const
         return string_from_property_id(property_id).to_string();
     }
 
-    return CSS::string_from_property_id(m_properties[index].property_id).to_string();
+    return CSS::string_from_property_id(properties()[index].property_id).to_string();
 }
 
 Optional<StyleProperty> CSSStyleProperties::property(PropertyID property_id) const
@@ -171,7 +198,7 @@ Optional<StyleProperty> CSSStyleProperties::property(PropertyID property_id) con
         };
     }
 
-    for (auto& property : m_properties) {
+    for (auto& property : properties()) {
         if (property.property_id == property_id)
             return property;
     }
@@ -197,7 +224,7 @@ Optional<StyleProperty const&> CSSStyleProperties::custom_property(FlyString con
         return {};
     }
 
-    return m_custom_properties.get(custom_property_name);
+    return custom_properties().get(custom_property_name);
 }
 
 // https://drafts.csswg.org/cssom/#dom-cssstyledeclaration-setproperty
@@ -207,6 +234,8 @@ WebIDL::ExceptionOr<void> CSSStyleProperties::set_property(StringView property_n
     if (is_computed())
         return WebIDL::NoModificationAllowedError::create(realm(), "Cannot modify properties in result of getComputedStyle()"_string);
 
+    ensure_declarations_are_parsed();
+
     // FIXME: 2. If property is not a custom property, follow these substeps:
     // FIXME:    1. Let property be property converted to ASCII lowercase.
     // FIXME:    2. If property is not a case-sensitive match for a supported CSS property, then return.
@@ -1027,6 +1056,8 @@ WebIDL::ExceptionOr<String> CSSStyleProperties::remove_property(StringView prope
     if (is_readonly())
         return WebIDL::NoModificationAllowedError::create(realm(), "Cannot remove property: CSSStyleProperties is read-only."_string);
 
+    ensure_declarations_are_parsed();
+
     auto property_id = property_id_from_string(property_name);
     if (!property_id.has_value())
         return String {};
@@ -1086,6 +1117,8 @@ WebIDL::ExceptionOr<void> CSSStyleProperties::set_css_float(StringView value)
 // https://www.w3.org/TR/cssom/#serialize-a-css-declaration-block
 String CSSStyleProperties::serialized() const
 {
+    ensure_declarations_are_parsed();
+
     // 1. Let list be an empty array.
     Vector<String> list;
 
@@ -1213,12 +1246,14 @@ bool CSSStyleProperties::set_a_css_declaration(PropertyID property_id, NonnullRe
 
 void CSSStyleProperties::empty_the_declarations()
 {
+    m_unparsed_declarations = nullptr;
     m_properties.clear();
     m_custom_properties.clear();
 }
 
 void CSSStyleProperties::set_the_declarations(Vector<StyleProperty> properties, HashMap<FlyString, StyleProperty> custom_properties)
 {
+    m_unparsed_declarations = nullptr;
     m_properties = move(properties);
     m_custom_properties = move(custom_properties);
 }
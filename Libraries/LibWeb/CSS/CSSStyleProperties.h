@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/OwnPtr.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
 #include <LibWeb/CSS/GeneratedCSSStyleProperties.h>
 
@@ -22,10 +23,14 @@ class CSSStyleProperties
 public:
     [[nodiscard]] static GC::Ref<CSSStyleProperties> create(JS::Realm&, Vector<StyleProperty>, HashMap<FlyString, StyleProperty> custom_properties);
 
+    // Keeps the declarations of a style rule as parsed component values, and only parses the property values once
+    // something looks at them. In large style sheets, most rules never match anything, so that usually never happens.
+    [[nodiscard]] static GC::Ref<CSSStyleProperties> create_with_unparsed_declarations(JS::Realm&, Parser::ParsingParams const&, Vector<Parser::Declaration>);
+
     [[nodiscard]] static GC::Ref<CSSStyleProperties> create_resolved_style(DOM::ElementReference);
     [[nodiscard]] static GC::Ref<CSSStyleProperties> create_element_inline_style(DOM::ElementReference, Vector<StyleProperty>, HashMap<FlyString, StyleProperty> custom_properties);
 
-    virtual ~CSSStyleProperties() override = default;
+    virtual ~CSSStyleProperties() override;
     virtual void initialize(JS::Realm&) override;
 
     virtual size_t length() const override;
@@ -43,10 +48,18 @@ public:
     virtual String get_property_value(StringView property_name) const override;
     virtual StringView get_property_priority(StringView property_name) const override;
 
-    Vector<StyleProperty> const& properties() const { return m_properties; }
-    HashMap<FlyString, StyleProperty> const& custom_properties() const { return m_custom_properties; }
+    Vector<StyleProperty> const& properties() const
+    {
+        ensure_declarations_are_parsed();
+        return m_properties;
+    }
+    HashMap<FlyString, StyleProperty> const& custom_properties() const
+    {
+        ensure_declarations_are_parsed();
+        return m_custom_properties;
+    }
 
-    size_t custom_property_count() const { return m_custom_properties.size(); }
+    size_t custom_property_count() const { return custom_properties().size(); }
 
     String css_float() const;
     WebIDL::ExceptionOr<void> set_css_float(StringView);
@@ -73,8 +86,18 @@ private:
 
     void invalidate_owners(DOM::StyleInvalidationReason);
 
+    void ensure_declarations_are_parsed() const
+    {
+        if (m_unparsed_declarations)
+            const_cast<CSSStyleProperties&>(*this).parse_unparsed_declarations();
+    }
+    void parse_unparsed_declarations();
+
     Vector<StyleProperty> m_properties;
     HashMap<FlyString, StyleProperty> m_custom_properties;
+
+    struct UnparsedDeclarations;
+    OwnPtr<UnparsedDeclarations> m_unparsed_declarations;
 };
 
 }
@@ -64,6 +64,11 @@ CSS::Parser::Parser::PropertiesAndCustomProperties parse_css_property_declaratio
     return CSS::Parser::Parser::create(context, css).parse_as_property_declaration_block();
 }
 
+CSS::Parser::Parser::PropertiesAndCustomProperties parse_css_declarations(CSS::Parser::ParsingParams const& context, Vector<CSS::Parser::Declaration> const& declarations)
+{
+    return CSS::Parser::Parser::create(context, ""sv).convert_to_properties(declarations);
+}
+
 Vector<CSS::Descriptor> parse_css_descriptor_declaration_block(CSS::Parser::ParsingParams const& parsing_params, CSS::AtRuleID at_rule_id, StringView css)
 {
     if (css.is_empty())
@@ -70,17 +70,15 @@ ParsingParams::ParsingParams(DOM::Document const& document, ParsingMode mode)
 
 Parser Parser::create(ParsingParams const& context, StringView input, StringView encoding)
 {
-    auto tokens = Tokenizer::tokenize(input, encoding);
-    return Parser { context, move(tokens) };
+    return Parser { context, Tokenizer::create(input, encoding) };
 }
 
-Parser::Parser(ParsingParams const& context, Vector<Token> tokens)
+Parser::Parser(ParsingParams const& context, NonnullOwnPtr<Tokenizer> tokenizer)
     : m_document(context.document)
     , m_realm(context.realm)
     , m_url(context.url)
     , m_parsing_mode(context.mode)
-    , m_tokens(move(tokens))
-    , m_token_stream(m_tokens)
+    , m_token_stream(move(tokenizer))
     , m_rule_context(move(context.rule_context))
 {
 }
@@ -401,6 +399,9 @@ Vector<Rule> Parser::consume_a_stylesheets_contents(TokenStream<T>& input)
 
     // Process input:
     for (;;) {
+        // OPTIMIZATION: Everything before a top-level rule has been consumed into `rules`, so the tokens for it can go.
+        input.discard_consumed_tokens();
+
         auto& token = input.next_token();
 
         // <whitespace-token>
@@ -1560,13 +1561,17 @@ void Parser::extract_property(Declaration const& declaration, PropertiesAndCusto
     }
 }
 
-GC::Ref<CSSStyleProperties> Parser::convert_to_style_declaration(Vector<Declaration> const& declarations)
+Parser::PropertiesAndCustomProperties Parser::convert_to_properties(Vector<Declaration> const& declarations)
 {
     PropertiesAndCustomProperties properties;
-    PropertiesAndCustomProperties& dest = properties;
-    for (auto const& declaration : declarations) {
-        extract_property(declaration, dest);
-    }
+    for (auto const& declaration : declarations)
+        extract_property(declaration, properties);
+    return properties;
+}
+
+GC::Ref<CSSStyleProperties> Parser::convert_to_style_declaration(Vector<Declaration> const& declarations)
+{
+    auto properties = convert_to_properties(declarations);
     return CSSStyleProperties::create(realm(), move(properties.properties), move(properties.custom_properties));
 }
 
@@ -1854,6 +1859,16 @@ JS::Realm& Parser::realm() const
     return *m_realm;
 }
 
+ParsingParams Parser::parsing_params() const
+{
+    ParsingParams params { m_parsing_mode };
+    params.realm = m_realm;
+    params.document = m_document;
+    if (m_url.has_value())
+        params.url = m_url.value();
+    return params;
+}
+
 bool Parser::in_quirks_mode() const
 {
     return m_document ? m_document->in_quirks_mode() : false;
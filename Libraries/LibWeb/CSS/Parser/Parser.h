@@ -100,6 +100,7 @@ public:
         HashMap<FlyString, StyleProperty> custom_properties;
     };
     PropertiesAndCustomProperties parse_as_property_declaration_block();
+    PropertiesAndCustomProperties convert_to_properties(Vector<Declaration> const&);
     Vector<Descriptor> parse_as_descriptor_declaration_block(AtRuleID);
     CSSRule* parse_as_css_rule();
     Optional<StyleProperty> parse_as_supports_condition();
@@ -135,7 +136,7 @@ public:
     [[nodiscard]] LengthOrCalculated parse_as_sizes_attribute(DOM::Element const& element, HTML::HTMLImageElement const* img = nullptr);
 
 private:
-    Parser(ParsingParams const&, Vector<Token>);
+    Parser(ParsingParams const&, NonnullOwnPtr<Tokenizer>);
 
     enum class ParseError {
         IncludesIgnoredVendorPrefix,
@@ -477,6 +478,7 @@ private:
     DOM::Document const* document() const;
     HTML::Window const* window() const;
     JS::Realm& realm() const;
+    ParsingParams parsing_params() const;
     bool in_quirks_mode() const;
     bool is_parsing_svg_presentation_attribute() const;
     Optional<::URL::URL> complete_url(StringView) const;
@@ -486,7 +488,6 @@ private:
     Optional<::URL::URL> m_url;
     ParsingMode m_parsing_mode { ParsingMode::Normal };
 
-    Vector<Token> m_tokens;
     TokenStream<Token> m_token_stream;
 
     struct FunctionContext {
@@ -516,6 +517,7 @@ namespace Web {
 
 GC::Ref<CSS::CSSStyleSheet> parse_css_stylesheet(CSS::Parser::ParsingParams const&, StringView, Optional<::URL::URL> location = {}, Vector<NonnullRefPtr<CSS::MediaQuery>> = {});
 CSS::Parser::Parser::PropertiesAndCustomProperties parse_css_property_declaration_block(CSS::Parser::ParsingParams const&, StringView);
+CSS::Parser::Parser::PropertiesAndCustomProperties parse_css_declarations(CSS::Parser::ParsingParams const&, Vector<CSS::Parser::Declaration> const&);
 Vector<CSS::Descriptor> parse_css_descriptor_declaration_block(CSS::Parser::ParsingParams const&, CSS::AtRuleID, StringView);
 RefPtr<CSS::CSSStyleValue const> parse_css_value(CSS::Parser::ParsingParams const&, StringView, CSS::PropertyID property_id = CSS::PropertyID::Invalid);
 RefPtr<CSS::CSSStyleValue const> parse_css_descriptor(CSS::Parser::ParsingParams const&, CSS::AtRuleID, CSS::DescriptorID, StringView);
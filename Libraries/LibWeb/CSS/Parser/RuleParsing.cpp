@@ -105,7 +105,8 @@ GC::Ptr<CSSStyleRule> Parser::convert_to_style_rule(QualifiedRule const& qualifi
     if (nested == Nested::Yes)
         selectors = adapt_nested_relative_selector_list(selectors);
 
-    auto declaration = convert_to_style_declaration(qualified_rule.declarations);
+    // OPTIMIZATION: Property values are only parsed once something looks at them, which usually means the rule matched.
+    auto declaration = CSSStyleProperties::create_with_unparsed_declarations(realm(), parsing_params(), qualified_rule.declarations);
 
     GC::RootVector<GC::Ref<CSSRule>> child_rules { realm().heap() };
     for (auto& child : qualified_rule.child_rules) {
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <AK/Format.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/Vector.h>
 #include <LibWeb/CSS/Parser/ComponentValue.h>
 #include <LibWeb/CSS/Parser/Tokenizer.h>
@@ -24,12 +26,14 @@ public:
             : m_token_stream(token_stream)
             , m_saved_index(token_stream.m_index)
         {
+            ++m_token_stream.m_open_transaction_count;
         }
 
         ~StateTransaction()
         {
             if (!m_commit)
                 m_token_stream.m_index = m_saved_index;
+            --m_token_stream.m_open_transaction_count;
         }
 
         StateTransaction create_child() { return StateTransaction(*this); }
@@ -47,6 +51,7 @@ public:
             , m_token_stream(parent.m_token_stream)
             , m_saved_index(parent.m_token_stream.m_index)
         {
+            ++m_token_stream.m_open_transaction_count;
         }
 
         StateTransaction* m_parent { nullptr };
@@ -67,6 +72,14 @@ public:
     {
     }
 
+    // Pulls tokens from the tokenizer as they are needed, instead of requiring the whole input to be tokenized up front.
+    explicit TokenStream(NonnullOwnPtr<Tokenizer> tokenizer)
+    requires(IsSame<T, Token>)
+        : m_tokenizer(move(tokenizer))
+        , m_eof(make_eof())
+    {
+    }
+
     static TokenStream<T> of_single_token(T const& token)
     {
         return TokenStream(Span<T const> { &token, 1 });
@@ -80,8 +93,8 @@ public:
     {
         // The item of tokens at index.
         // If that index would be out-of-bounds past the end of the list, it’s instead an <eof-token>.
-        if (m_index < m_tokens.size())
-            return m_tokens[m_index];
+        if (auto const* token = token_at(m_index))
+            return *token;
         return m_eof;
     }
 
@@ -146,19 +159,19 @@ public:
     // Deprecated, used in older versions of the spec.
     T const& current_token()
     {
-        if (m_index < 1 || (m_index - 1) >= m_tokens.size())
+        if (m_index < 1)
             return m_eof;
-
-        return m_tokens.at(m_index - 1);
+        if (auto const* token = token_at(m_index - 1))
+            return *token;
+        return m_eof;
     }
 
     // Deprecated
     T const& peek_token(size_t offset = 0)
     {
-        if (remaining_token_count() <= offset)
-            return m_eof;
-
-        return m_tokens.at(m_index + offset);
+        if (auto const* token = token_at(m_index + offset))
+            return *token;
+        return m_eof;
     }
 
     // Deprecated, was used in older versions of the spec.
@@ -172,16 +185,26 @@ public:
 
     size_t remaining_token_count() const
     {
-        if (m_tokens.size() > m_index)
-            return m_tokens.size() - m_index;
+        auto token_count = m_tokens.size();
+        if (m_tokenizer) {
+            // NOTE: This has to tokenize the rest of the input, so avoid it on streams that read from a tokenizer.
+            while (token_at(m_pulled_token_count))
+                ;
+            token_count = m_pulled_token_count;
+        }
+
+        if (token_count > m_index)
+            return token_count - m_index;
         return 0;
     }
 
     void dump_all_tokens()
     {
         dbgln("Dumping all tokens:");
-        for (size_t i = 0; i < m_tokens.size(); ++i) {
-            auto& token = m_tokens[i];
+        auto first_index = m_tokenizer ? m_first_buffered_index : 0;
+        auto end_index = m_tokenizer ? m_pulled_token_count : m_tokens.size();
+        for (size_t i = first_index; i < end_index; ++i) {
+            auto& token = *token_at(i);
             if (i == m_index - 1)
                 dbgln("-> {}", token.to_debug_string());
             else
@@ -189,10 +212,82 @@ public:
         }
     }
 
+    // OPTIMIZATION: When reading from a tokenizer, drop the tokens that can no longer be returned to, so that only
+    //               a small window of the input is held as tokens at any time. Callers must not hold references to
+    //               tokens across this call.
+    void discard_consumed_tokens()
+    {
+        if (!m_tokenizer || m_open_transaction_count > 0)
+            return;
+
+        // NOTE: The current token stays reachable through current_token() and reconsume_current_input_token().
+        auto oldest_reachable_index = m_index > 0 ? m_index - 1 : 0;
+        for (auto marked_index : m_marked_indexes)
+            oldest_reachable_index = min(oldest_reachable_index, marked_index);
+
+        while (!m_chunks.is_empty()
+            && m_chunks.first()->size() == tokens_per_chunk
+            && m_first_buffered_index + tokens_per_chunk <= oldest_reachable_index) {
+            m_chunks.take_first();
+            m_first_buffered_index += tokens_per_chunk;
+        }
+    }
+
 private:
+    T const* token_at(size_t index) const
+    {
+        if constexpr (IsSame<T, Token>) {
+            if (m_tokenizer)
+                return pull_tokens_until(index);
+        }
+
+        if (index < m_tokens.size())
+            return &m_tokens[index];
+        return nullptr;
+    }
+
+    T const* pull_tokens_until(size_t index) const
+    requires(IsSame<T, Token>)
+    {
+        VERIFY(index >= m_first_buffered_index);
+
+        while (index >= m_pulled_token_count) {
+            if (m_reached_end_of_input)
+                return nullptr;
+
+            auto token = m_tokenizer->next_token();
+            if (token.is(Token::Type::EndOfFile)) {
+                m_reached_end_of_input = true;
+                return nullptr;
+            }
+
+            // NOTE: Chunks never grow past their initial capacity, so references to tokens stay valid as more arrive.
+            if (m_chunks.is_empty() || m_chunks.last()->size() == tokens_per_chunk) {
+                auto chunk = make<Vector<T>>();
+                chunk->ensure_capacity(tokens_per_chunk);
+                m_chunks.append(move(chunk));
+            }
+            m_chunks.last()->unchecked_append(move(token));
+            ++m_pulled_token_count;
+        }
+
+        auto offset = index - m_first_buffered_index;
+        return &m_chunks[offset / tokens_per_chunk]->at(offset % tokens_per_chunk);
+    }
+
     // https://drafts.csswg.org/css-syntax/#token-stream-tokens
     Span<T const> m_tokens;
 
+    // When set, tokens are read from here instead of m_tokens, and buffered in fixed-size chunks.
+    static constexpr size_t tokens_per_chunk = 256;
+    mutable OwnPtr<Tokenizer> m_tokenizer;
+    mutable Vector<NonnullOwnPtr<Vector<T>>> m_chunks;
+    mutable size_t m_first_buffered_index { 0 };
+    mutable size_t m_pulled_token_count { 0 };
+    mutable bool m_reached_end_of_input { false };
+
+    size_t m_open_transaction_count { 0 };
+
     // https://drafts.csswg.org/css-syntax/#token-stream-index
     size_t m_index { 0 };
 
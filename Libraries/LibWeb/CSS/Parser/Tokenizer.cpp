@@ -155,69 +155,75 @@ static inline bool is_E(u32 code_point)
     return code_point == 0x45;
 }
 
-Vector<Token> Tokenizer::tokenize(StringView input, StringView encoding)
+// https://www.w3.org/TR/css-syntax-3/#css-filter-code-points
+static String filter_code_points(StringView input, StringView encoding)
 {
-    // https://www.w3.org/TR/css-syntax-3/#css-filter-code-points
-    auto filter_code_points = [](StringView input, auto encoding) -> String {
-        auto decoder = TextCodec::decoder_for(encoding);
-        VERIFY(decoder.has_value());
-
-        auto decoded_input = MUST(decoder->to_utf8(input));
-
-        // OPTIMIZATION: If the input doesn't contain any filterable characters, we can skip the filtering
-        bool const contains_filterable = [&] {
-            for (auto code_point : decoded_input.code_points()) {
-                if (code_point == '\r' || code_point == '\f' || code_point == 0x00 || is_unicode_surrogate(code_point))
-                    return true;
-            }
-            return false;
-        }();
-        if (!contains_filterable) {
-            return decoded_input;
-        }
+    auto decoder = TextCodec::decoder_for(encoding);
+    VERIFY(decoder.has_value());
 
-        StringBuilder builder { input.length() };
-        bool last_was_carriage_return = false;
+    auto decoded_input = MUST(decoder->to_utf8(input));
 
-        // To filter code points from a stream of (unfiltered) code points input:
+    // OPTIMIZATION: If the input doesn't contain any filterable characters, we can skip the filtering
+    bool const contains_filterable = [&] {
         for (auto code_point : decoded_input.code_points()) {
-            // Replace any U+000D CARRIAGE RETURN (CR) code points,
-            // U+000C FORM FEED (FF) code points,
-            // or pairs of U+000D CARRIAGE RETURN (CR) followed by U+000A LINE FEED (LF)
-            // in input by a single U+000A LINE FEED (LF) code point.
-            if (code_point == '\r') {
-                if (last_was_carriage_return) {
-                    builder.append('\n');
-                } else {
-                    last_was_carriage_return = true;
-                }
-            } else {
-                if (last_was_carriage_return)
-                    builder.append('\n');
+            if (code_point == '\r' || code_point == '\f' || code_point == 0x00 || is_unicode_surrogate(code_point))
+                return true;
+        }
+        return false;
+    }();
+    if (!contains_filterable) {
+        return decoded_input;
+    }
 
-                if (code_point == '\n') {
-                    if (!last_was_carriage_return)
-                        builder.append('\n');
+    StringBuilder builder { input.length() };
+    bool last_was_carriage_return = false;
+
+    // To filter code points from a stream of (unfiltered) code points input:
+    for (auto code_point : decoded_input.code_points()) {
+        // Replace any U+000D CARRIAGE RETURN (CR) code points,
+        // U+000C FORM FEED (FF) code points,
+        // or pairs of U+000D CARRIAGE RETURN (CR) followed by U+000A LINE FEED (LF)
+        // in input by a single U+000A LINE FEED (LF) code point.
+        if (code_point == '\r') {
+            if (last_was_carriage_return) {
+                builder.append('\n');
+            } else {
+                last_was_carriage_return = true;
+            }
+        } else {
+            if (last_was_carriage_return)
+                builder.append('\n');
 
-                } else if (code_point == '\f') {
+            if (code_point == '\n') {
+                if (!last_was_carriage_return)
                     builder.append('\n');
-                    // Replace any U+0000 NULL or surrogate code points in input with U+FFFD REPLACEMENT CHARACTER (�).
-                } else if (code_point == 0x00 || is_unicode_surrogate(code_point)) {
-                    builder.append_code_point(REPLACEMENT_CHARACTER);
-                } else {
-                    builder.append_code_point(code_point);
-                }
-
-                last_was_carriage_return = false;
+
+            } else if (code_point == '\f') {
+                builder.append('\n');
+                // Replace any U+0000 NULL or surrogate code points in input with U+FFFD REPLACEMENT CHARACTER (�).
+            } else if (code_point == 0x00 || is_unicode_surrogate(code_point)) {
+                builder.append_code_point(REPLACEMENT_CHARACTER);
+            } else {
+                builder.append_code_point(code_point);
             }
+
+            last_was_carriage_return = false;
         }
-        return builder.to_string_without_validation();
-    };
+    }
+    return builder.to_string_without_validation();
+}
 
+Vector<Token> Tokenizer::tokenize(StringView input, StringView encoding)
+{
     Tokenizer tokenizer { filter_code_points(input, encoding) };
     return tokenizer.tokenize();
 }
 
+NonnullOwnPtr<Tokenizer> Tokenizer::create(StringView input, StringView encoding)
+{
+    return adopt_own(*new Tokenizer(filter_code_points(input, encoding)));
+}
+
 Tokenizer::Tokenizer(String decoded_input)
     : m_decoded_input(move(decoded_input))
     , m_utf8_view(m_decoded_input)
@@ -229,18 +235,24 @@ Vector<Token> Tokenizer::tokenize()
 {
     Vector<Token> tokens;
     for (;;) {
-        auto token_start = m_position;
-        auto token = consume_a_token();
-        token.m_start_position = token_start;
-        token.m_end_position = m_position;
-        tokens.append(token);
+        auto token = next_token();
+        auto is_eof = token.is(Token::Type::EndOfFile);
+        tokens.append(move(token));
 
-        if (token.is(Token::Type::EndOfFile)) {
+        if (is_eof)
             return tokens;
-        }
     }
 }
 
+Token Tokenizer::next_token()
+{
+    auto token_start = m_position;
+    auto token = consume_a_token();
+    token.m_start_position = token_start;
+    token.m_end_position = m_position;
+    return token;
+}
+
 u32 Tokenizer::next_code_point()
 {
     if (m_utf8_iterator == m_utf8_view.end())
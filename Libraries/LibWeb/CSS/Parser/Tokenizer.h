@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
@@ -61,6 +62,11 @@ class Tokenizer {
 public:
     static Vector<Token> tokenize(StringView input, StringView encoding);
 
+    // For consumers that pull tokens one at a time instead of tokenizing the whole input up front.
+    // The returned tokenizer keeps producing <EOF-token>s once the input is exhausted.
+    static NonnullOwnPtr<Tokenizer> create(StringView input, StringView encoding);
+    [[nodiscard]] Token next_token();
+
     [[nodiscard]] static Token create_eof_token();
 
 private:
@@ -77,6 +77,32 @@ static bool can_selector_use_fast_matches(CSS::Selector const& selector)
     return true;
 }
 
+static Selector::FastMatchShape fast_match_shape_for_selector(Selector const& selector)
+{
+    using Type = Selector::SimpleSelector::Type;
+    auto const& compound_selectors = selector.compound_selectors();
+    auto const& subject = compound_selectors.last().simple_selectors;
+
+    if (compound_selectors.size() == 1) {
+        if (subject.size() == 1 && subject[0].type == Type::Class)
+            return Selector::FastMatchShape::Class;
+        if (subject.size() == 2 && subject[0].type == Type::TagName && subject[1].type == Type::Class)
+            return Selector::FastMatchShape::TagNameAndClass;
+        if (subject.size() == 2 && subject[0].type == Type::Class
+            && subject[1].type == Type::PseudoClass && subject[1].pseudo_class().type == PseudoClass::Hover)
+            return Selector::FastMatchShape::ClassWithHover;
+        return Selector::FastMatchShape::Generic;
+    }
+
+    if (compound_selectors.size() == 2 && compound_selectors.last().combinator == Selector::Combinator::Descendant) {
+        auto const& ancestor = compound_selectors.first().simple_selectors;
+        if (ancestor.size() == 1 && ancestor[0].type == Type::Id && subject.size() == 1 && subject[0].type == Type::Class)
+            return Selector::FastMatchShape::ClassDescendantOfId;
+    }
+
+    return Selector::FastMatchShape::Generic;
+}
+
 Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     : m_compound_selectors(move(compound_selectors))
 {
@@ -130,6 +156,8 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     collect_ancestor_hashes();
 
     m_can_use_fast_matches = can_selector_use_fast_matches(*this);
+    if (m_can_use_fast_matches)
+        m_fast_match_shape = fast_match_shape_for_selector(*this);
 }
 
 void Selector::collect_ancestor_hashes()
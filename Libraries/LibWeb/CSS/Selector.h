@@ -248,6 +248,17 @@ public:
     bool can_use_fast_matches() const { return m_can_use_fast_matches; }
     bool can_use_ancestor_filter() const { return m_can_use_ancestor_filter; }
 
+    // Selector shapes common enough that SelectorEngine matches them with dedicated code instead of walking the
+    // compound selectors. Anything other than Generic implies can_use_fast_matches().
+    enum class FastMatchShape : u8 {
+        Generic,
+        Class,               // .a
+        TagNameAndClass,     // div.a
+        ClassWithHover,      // .a:hover
+        ClassDescendantOfId, // #a .b
+    };
+    FastMatchShape fast_match_shape() const { return m_fast_match_shape; }
+
     size_t sibling_invalidation_distance() const;
 
 private:
@@ -258,6 +269,7 @@ private:
     Optional<Selector::PseudoElementSelector> m_pseudo_element;
     mutable Optional<size_t> m_sibling_invalidation_distance;
     bool m_can_use_fast_matches { false };
+    FastMatchShape m_fast_match_shape { FastMatchShape::Generic };
     bool m_can_use_ancestor_filter { false };
     bool m_contains_the_nesting_selector { false };
 
@@ -1043,6 +1043,14 @@ bool matches(CSS::Selector const& selector, DOM::Element const& element, GC::Ptr
     return matches(selector, selector.compound_selectors().size() - 1, element, shadow_host, context, scope, selector_kind, anchor);
 }
 
+static ALWAYS_INLINE bool fast_matches_class(FlyString const& class_name, DOM::Element const& element)
+{
+    // Class selectors are matched case insensitively in quirks mode.
+    // See: https://drafts.csswg.org/selectors-4/#class-html
+    auto case_sensitivity = element.document().in_quirks_mode() ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive;
+    return element.has_class(class_name, case_sensitivity);
+}
+
 static bool fast_matches_simple_selector(CSS::Selector::SimpleSelector const& simple_selector, DOM::Element const& element, GC::Ptr<DOM::Element const> shadow_host, MatchContext& context)
 {
     if (should_block_shadow_host_matching(simple_selector, shadow_host, element))
@@ -1064,12 +1072,8 @@ static bool fast_matches_simple_selector(CSS::Selector::SimpleSelector const& si
             return false;
         }
         return matches_namespace(simple_selector.qualified_name(), element, context.style_sheet_for_rule);
-    case CSS::Selector::SimpleSelector::Type::Class: {
-        // Class selectors are matched case insensitively in quirks mode.
-        // See: https://drafts.csswg.org/selectors-4/#class-html
-        auto case_sensitivity = element.document().in_quirks_mode() ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive;
-        return element.has_class(simple_selector.name(), case_sensitivity);
-    }
+    case CSS::Selector::SimpleSelector::Type::Class:
+        return fast_matches_class(simple_selector.name(), element);
     case CSS::Selector::SimpleSelector::Type::Id:
         return simple_selector.name() == element.id();
     case CSS::Selector::SimpleSelector::Type::Attribute:
@@ -1081,17 +1085,61 @@ static bool fast_matches_simple_selector(CSS::Selector::SimpleSelector const& si
     }
 }
 
+static ALWAYS_INLINE bool is_id_or_class_selector(CSS::Selector::SimpleSelector const& simple_selector)
+{
+    return simple_selector.type == CSS::Selector::SimpleSelector::Type::Id || simple_selector.type == CSS::Selector::SimpleSelector::Type::Class;
+}
+
 static bool fast_matches_compound_selector(CSS::Selector::CompoundSelector const& compound_selector, DOM::Element const& element, GC::Ptr<DOM::Element const> shadow_host, MatchContext& context)
 {
+    // OPTIMIZATION: ID and class selectors are cheap to check and reject most elements, so try them first.
+    for (auto const& simple_selector : compound_selector.simple_selectors) {
+        if (is_id_or_class_selector(simple_selector) && !fast_matches_simple_selector(simple_selector, element, shadow_host, context))
+            return false;
+    }
     for (auto const& simple_selector : compound_selector.simple_selectors) {
-        if (!fast_matches_simple_selector(simple_selector, element, shadow_host, context))
+        if (!is_id_or_class_selector(simple_selector) && !fast_matches_simple_selector(simple_selector, element, shadow_host, context))
             return false;
     }
     return true;
 }
 
+static bool fast_matches_common_shape(CSS::Selector const& selector, DOM::Element const& element, MatchContext& context)
+{
+    auto const& subject = selector.compound_selectors().last().simple_selectors;
+
+    switch (selector.fast_match_shape()) {
+    case CSS::Selector::FastMatchShape::Generic:
+        VERIFY_NOT_REACHED();
+    case CSS::Selector::FastMatchShape::Class:
+        return fast_matches_class(subject[0].name(), element);
+    case CSS::Selector::FastMatchShape::TagNameAndClass:
+        return fast_matches_class(subject[1].name(), element)
+            && fast_matches_simple_selector(subject[0], element, nullptr, context);
+    case CSS::Selector::FastMatchShape::ClassWithHover:
+        return fast_matches_class(subject[0].name(), element)
+            && matches_pseudo_class(subject[1].pseudo_class(), element, nullptr, context, nullptr, SelectorKind::Normal);
+    case CSS::Selector::FastMatchShape::ClassDescendantOfId: {
+        if (!fast_matches_class(subject[0].name(), element))
+            return false;
+        auto const& id = selector.compound_selectors().first().simple_selectors[0].name();
+        for (auto const* ancestor = element.parent_element(); ancestor; ancestor = ancestor->parent_element()) {
+            if (id == ancestor->id())
+                return true;
+        }
+        return false;
+    }
+    }
+    VERIFY_NOT_REACHED();
+}
+
 bool fast_matches(CSS::Selector const& selector, DOM::Element const& element_to_match, GC::Ptr<DOM::Element const> shadow_host, MatchContext& context)
 {
+    // OPTIMIZATION: Common selector shapes get a dedicated matcher. Inside shadow trees, the shadow host can only be
+    //               matched by :host, which those don't account for, so leave that case to the general code below.
+    if (selector.fast_match_shape() != CSS::Selector::FastMatchShape::Generic && !shadow_host)
+        return fast_matches_common_shape(selector, element_to_match, context);
+
     DOM::Element const* current = &element_to_match;
 
     ssize_t compound_selector_index = selector.compound_selectors().size() - 1;
@@ -14,14 +14,33 @@
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Compression/CompressionStream.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/Streams/TransformStream.h>
 #include <LibWeb/Streams/TransformStreamOperations.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
+#include <LibWeb/WebIDL/Promise.h>
 
 namespace Web::Compression {
 
 GC_DEFINE_ALLOCATOR(CompressionStream);
 
+GC::Ref<WebIDL::Promise> settle_promise_in_parallel(JS::Realm& realm, Function<ErrorOr<ByteBuffer>()> operation, Function<WebIDL::ExceptionOr<void>(ErrorOr<ByteBuffer>)> completion_steps)
+{
+    auto promise = WebIDL::create_promise(realm);
+
+    HTML::perform_in_parallel(HTML::Task::Source::Unspecified, realm, move(operation), [promise = GC::make_root(promise), completion_steps = move(completion_steps)](JS::Realm& realm, ErrorOr<ByteBuffer> result) {
+        if (auto completion = completion_steps(move(result)); completion.is_error()) {
+            auto throw_completion = Bindings::exception_to_throw_completion(realm.vm(), completion.exception());
+            WebIDL::reject_promise(realm, *promise, throw_completion.value());
+            return;
+        }
+
+        WebIDL::resolve_promise(realm, *promise, JS::js_undefined());
+    });
+
+    return promise;
+}
+
 // https://compression.spec.whatwg.org/#dom-compressionstream-compressionstream
 WebIDL::ExceptionOr<GC::Ref<CompressionStream>> CompressionStream::construct_impl(JS::Realm& realm, Bindings::CompressionFormat format)
 {
@@ -52,28 +71,12 @@ WebIDL::ExceptionOr<GC::Ref<CompressionStream>> CompressionStream::construct_imp
     // 3. Let transformAlgorithm be an algorithm which takes a chunk argument and runs the compress and enqueue a chunk
     //    algorithm with this and chunk.
     auto transform_algorithm = GC::create_function(realm.heap(), [stream](JS::Value chunk) -> GC::Ref<WebIDL::Promise> {
-        auto& realm = stream->realm();
-        auto& vm = realm.vm();
-
-        if (auto result = stream->compress_and_enqueue_chunk(chunk); result.is_error()) {
-            auto throw_completion = Bindings::exception_to_throw_completion(vm, result.exception());
-            return WebIDL::create_rejected_promise(realm, throw_completion.release_value());
-        }
-
-        return WebIDL::create_resolved_promise(realm, JS::js_undefined());
+        return stream->compress_and_enqueue_chunk(chunk);
     });
 
     // 4. Let flushAlgorithm be an algorithm which takes no argument and runs the compress flush and enqueue algorithm with this.
     auto flush_algorithm = GC::create_function(realm.heap(), [stream]() -> GC::Ref<WebIDL::Promise> {
-        auto& realm = stream->realm();
-        auto& vm = realm.vm();
-
-        if (auto result = stream->compress_flush_and_enqueue(); result.is_error()) {
-            auto throw_completion = Bindings::exception_to_throw_completion(vm, result.exception());
-            return WebIDL::create_rejected_promise(realm, throw_completion.release_value());
-        }
-
-        return WebIDL::create_resolved_promise(realm, JS::js_undefined());
+        return stream->compress_flush_and_enqueue();
     });
 
     // 6. Set up this's transform with transformAlgorithm set to transformAlgorithm and flushAlgorithm set to flushAlgorithm.
@@ -105,58 +108,67 @@ void CompressionStream::visit_edges(JS::Cell::Visitor& visitor)
 }
 
 // https://compression.spec.whatwg.org/#compress-and-enqueue-a-chunk
-WebIDL::ExceptionOr<void> CompressionStream::compress_and_enqueue_chunk(JS::Value chunk)
+GC::Ref<WebIDL::Promise> CompressionStream::compress_and_enqueue_chunk(JS::Value chunk)
 {
     auto& realm = this->realm();
 
     // 1. If chunk is not a BufferSource type, then throw a TypeError.
     if (!WebIDL::is_buffer_source_type(chunk))
-        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "Chunk is not a BufferSource type"sv };
-
-    // 2. Let buffer be the result of compressing chunk with cs's format and context.
-    auto maybe_buffer = [&]() -> ErrorOr<ByteBuffer> {
-        auto chunk_buffer = TRY(WebIDL::get_buffer_source_copy(chunk.as_object()));
-        return compress(move(chunk_buffer), Finish::No);
-    }();
-    if (maybe_buffer.is_error())
-        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, MUST(String::formatted("Unable to compress chunk: {}", maybe_buffer.error())) };
+        return WebIDL::create_rejected_promise_from_exception(realm, WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "Chunk is not a BufferSource type"sv });
 
-    auto buffer = maybe_buffer.release_value();
+    auto chunk_buffer = WebIDL::get_buffer_source_copy(chunk.as_object());
+    if (chunk_buffer.is_error())
+        return WebIDL::create_rejected_promise_from_exception(realm, WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, MUST(String::formatted("Unable to compress chunk: {}", chunk_buffer.error())) });
 
+    // 2. Let buffer be the result of compressing chunk with cs's format and context.
     // 3. If buffer is empty, return.
-    if (buffer.is_empty())
-        return {};
-
     // 4. Split buffer into one or more non-empty pieces and convert them into Uint8Arrays.
-    auto array_buffer = JS::ArrayBuffer::create(realm, move(buffer));
-    auto array = JS::Uint8Array::create(realm, array_buffer->byte_length(), *array_buffer);
-
     // 5. For each Uint8Array array, enqueue array in cs's transform.
-    TRY(Streams::transform_stream_default_controller_enqueue(*m_transform->controller(), array));
-    return {};
+    return compress_in_parallel(chunk_buffer.release_value(), Finish::No, "Unable to compress chunk"sv);
 }
 
 // https://compression.spec.whatwg.org/#compress-flush-and-enqueue
-WebIDL::ExceptionOr<void> CompressionStream::compress_flush_and_enqueue()
+GC::Ref<WebIDL::Promise> CompressionStream::compress_flush_and_enqueue()
 {
-    auto& realm = this->realm();
-
     // 1. Let buffer be the result of compressing an empty input with cs's format and context, with the finish flag.
-    auto maybe_buffer = compress({}, Finish::Yes);
-    if (maybe_buffer.is_error())
-        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, MUST(String::formatted("Unable to compress flush: {}", maybe_buffer.error())) };
+    // 2. If buffer is empty, return.
+    // 3. Split buffer into one or more non-empty pieces and convert them into Uint8Arrays.
+    // 4. For each Uint8Array array, enqueue array in cs's transform.
+    return compress_in_parallel({}, Finish::Yes, "Unable to compress flush"sv);
+}
 
-    auto buffer = maybe_buffer.release_value();
+// NOTE: The transform stream doesn't pass on the next chunk until the promise returned for the previous one has
+//       settled, so the compressor is only ever used by one thread at a time, chunks are compressed in order, and
+//       backpressure still reaches the writable side.
+GC::Ref<WebIDL::Promise> CompressionStream::compress_in_parallel(ByteBuffer bytes, Finish finish, StringView error_message)
+{
+    // NOTE: The stream is kept alive by the completion steps until the operation has finished, so the operation can
+    //       use the compressor it owns.
+    auto operation = [this, bytes = move(bytes), finish] {
+        return compress(bytes, finish);
+    };
 
-    // 2. If buffer is empty, return.
+    return settle_promise_in_parallel(realm(), move(operation), [stream = GC::make_root(*this), error_message](ErrorOr<ByteBuffer> maybe_buffer) -> WebIDL::ExceptionOr<void> {
+        if (maybe_buffer.is_error())
+            return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, MUST(String::formatted("{}: {}", error_message, maybe_buffer.error())) };
+
+        return stream->enqueue_compressed_data(maybe_buffer.release_value());
+    });
+}
+
+WebIDL::ExceptionOr<void> CompressionStream::enqueue_compressed_data(ByteBuffer buffer)
+{
+    auto& realm = this->realm();
+
+    // If buffer is empty, return.
     if (buffer.is_empty())
         return {};
 
-    // 3. Split buffer into one or more non-empty pieces and convert them into Uint8Arrays.
+    // Split buffer into one or more non-empty pieces and convert them into Uint8Arrays.
     auto array_buffer = JS::ArrayBuffer::create(realm, move(buffer));
     auto array = JS::Uint8Array::create(realm, array_buffer->byte_length(), *array_buffer);
 
-    // 4. For each Uint8Array array, enqueue array in cs's transform.
+    // For each Uint8Array array, enqueue array in cs's transform.
     TRY(Streams::transform_stream_default_controller_enqueue(*m_transform->controller(), array));
     return {};
 }
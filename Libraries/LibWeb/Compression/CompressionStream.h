@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/MemoryStream.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Variant.h>
@@ -24,6 +25,10 @@ using Compressor = Variant<
     NonnullOwnPtr<Compress::DeflateCompressor>,
     NonnullOwnPtr<Compress::GzipCompressor>>;
 
+// Performs the operation in parallel, so that (de)compressing large chunks doesn't block the event loop, and returns a
+// promise that settles once the completion steps have run with its result.
+GC::Ref<WebIDL::Promise> settle_promise_in_parallel(JS::Realm&, Function<ErrorOr<ByteBuffer>()> operation, Function<WebIDL::ExceptionOr<void>(ErrorOr<ByteBuffer>)> completion_steps);
+
 // https://compression.spec.whatwg.org/#compressionstream
 class CompressionStream final
     : public Bindings::PlatformObject
@@ -41,14 +46,16 @@ private:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
-    WebIDL::ExceptionOr<void> compress_and_enqueue_chunk(JS::Value);
-    WebIDL::ExceptionOr<void> compress_flush_and_enqueue();
+    GC::Ref<WebIDL::Promise> compress_and_enqueue_chunk(JS::Value);
+    GC::Ref<WebIDL::Promise> compress_flush_and_enqueue();
 
     enum class Finish {
         No,
         Yes,
     };
+    GC::Ref<WebIDL::Promise> compress_in_parallel(ByteBuffer, Finish, StringView error_message);
     ErrorOr<ByteBuffer> compress(ReadonlyBytes, Finish);
+    WebIDL::ExceptionOr<void> enqueue_compressed_data(ByteBuffer);
 
     Compressor m_compressor;
     NonnullOwnPtr<AllocatingMemoryStream> m_output_stream;
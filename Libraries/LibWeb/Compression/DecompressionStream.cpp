@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCompress/Decompress.h>
 #include <LibCompress/Deflate.h>
 #include <LibCompress/Gzip.h>
 #include <LibCompress/Zlib.h>
@@ -17,6 +18,7 @@
 #include <LibWeb/Compression/DecompressionStream.h>
 #include <LibWeb/Streams/TransformStream.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
+#include <LibWeb/WebIDL/Promise.h>
 
 namespace Web::Compression {
 
@@ -52,28 +54,12 @@ WebIDL::ExceptionOr<GC::Ref<DecompressionStream>> DecompressionStream::construct
     // 3. Let transformAlgorithm be an algorithm which takes a chunk argument and runs the decompress and enqueue a chunk
     //    algorithm with this and chunk.
     auto transform_algorithm = GC::create_function(realm.heap(), [stream](JS::Value chunk) -> GC::Ref<WebIDL::Promise> {
-        auto& realm = stream->realm();
-        auto& vm = realm.vm();
-
-        if (auto result = stream->decompress_and_enqueue_chunk(chunk); result.is_error()) {
-            auto throw_completion = Bindings::exception_to_throw_completion(vm, result.exception());
-            return WebIDL::create_rejected_promise(realm, throw_completion.release_value());
-        }
-
-        return WebIDL::create_resolved_promise(realm, JS::js_undefined());
+        return stream->decompress_and_enqueue_chunk(chunk);
     });
 
     // 4. Let flushAlgorithm be an algorithm which takes no argument and runs the decompress flush and enqueue algorithm with this.
     auto flush_algorithm = GC::create_function(realm.heap(), [stream]() -> GC::Ref<WebIDL::Promise> {
-        auto& realm = stream->realm();
-        auto& vm = realm.vm();
-
-        if (auto result = stream->decompress_flush_and_enqueue(); result.is_error()) {
-            auto throw_completion = Bindings::exception_to_throw_completion(vm, result.exception());
-            return WebIDL::create_rejected_promise(realm, throw_completion.release_value());
-        }
-
-        return WebIDL::create_resolved_promise(realm, JS::js_undefined());
+        return stream->decompress_flush_and_enqueue();
     });
 
     // 6. Set up this's transform with transformAlgorithm set to transformAlgorithm and flushAlgorithm set to flushAlgorithm.
@@ -105,71 +91,86 @@ void DecompressionStream::visit_edges(JS::Cell::Visitor& visitor)
 }
 
 // https://compression.spec.whatwg.org/#decompress-and-enqueue-a-chunk
-WebIDL::ExceptionOr<void> DecompressionStream::decompress_and_enqueue_chunk(JS::Value chunk)
+GC::Ref<WebIDL::Promise> DecompressionStream::decompress_and_enqueue_chunk(JS::Value chunk)
 {
     auto& realm = this->realm();
 
     // 1. If chunk is not a BufferSource type, then throw a TypeError.
     if (!WebIDL::is_buffer_source_type(chunk))
-        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "Chunk is not a BufferSource type"sv };
+        return WebIDL::create_rejected_promise_from_exception(realm, WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "Chunk is not a BufferSource type"sv });
+
+    auto chunk_buffer = WebIDL::get_buffer_source_copy(chunk.as_object());
+    if (chunk_buffer.is_error())
+        return WebIDL::create_rejected_promise_from_exception(realm, WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, MUST(String::formatted("Unable to decompress chunk: {}", chunk_buffer.error())) });
 
     // 2. Let buffer be the result of decompressing chunk with ds's format and context. If this results in an error,
     //    then throw a TypeError.
-    auto maybe_buffer = [&]() -> ErrorOr<ByteBuffer> {
-        auto chunk_buffer = TRY(WebIDL::get_buffer_source_copy(chunk.as_object()));
-        TRY(m_input_stream->write_until_depleted(move(chunk_buffer)));
-
-        auto decompressed = TRY(ByteBuffer::create_uninitialized(4096));
-        auto size = TRY(m_decompressor.visit([&](auto const& decompressor) -> ErrorOr<size_t> {
-            return TRY(decompressor->read_some(decompressed.bytes())).size();
-        }));
-        return decompressed.slice(0, size);
-    }();
-    if (maybe_buffer.is_error())
-        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, MUST(String::formatted("Unable to decompress chunk: {}", maybe_buffer.error())) };
-
-    auto buffer = maybe_buffer.release_value();
-
-    // 3. If buffer is empty, return.
-    if (buffer.is_empty())
-        return {};
-
-    // 4. Split buffer into one or more non-empty pieces and convert them into Uint8Arrays.
-    auto array_buffer = JS::ArrayBuffer::create(realm, move(buffer));
-    auto array = JS::Uint8Array::create(realm, array_buffer->byte_length(), *array_buffer);
-
-    // 5. For each Uint8Array array, enqueue array in ds's transform.
-    m_transform->enqueue(array);
-    return {};
+    // NOTE: This happens on a worker thread. As with CompressionStream, the transform stream waits for the returned
+    //       promise to settle before passing on the next chunk, which keeps the chunks in order.
+    auto operation = [this, chunk_buffer = chunk_buffer.release_value()] -> ErrorOr<ByteBuffer> {
+        TRY(m_input_stream->write_until_depleted(chunk_buffer));
+        return decompress_available_input();
+    };
+
+    return settle_promise_in_parallel(realm, move(operation), [stream = GC::make_root(*this)](ErrorOr<ByteBuffer> maybe_buffer) -> WebIDL::ExceptionOr<void> {
+        if (maybe_buffer.is_error())
+            return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, MUST(String::formatted("Unable to decompress chunk: {}", maybe_buffer.error())) };
+
+        // 3. If buffer is empty, return.
+        // 4. Split buffer into one or more non-empty pieces and convert them into Uint8Arrays.
+        // 5. For each Uint8Array array, enqueue array in ds's transform.
+        return stream->enqueue_decompressed_data(maybe_buffer.release_value());
+    });
 }
 
 // https://compression.spec.whatwg.org/#decompress-flush-and-enqueue
-WebIDL::ExceptionOr<void> DecompressionStream::decompress_flush_and_enqueue()
+GC::Ref<WebIDL::Promise> DecompressionStream::decompress_flush_and_enqueue()
 {
-    auto& realm = this->realm();
-
     // 1. Let buffer be the result of decompressing an empty input with ds's format and context, with the finish flag.
-    auto maybe_buffer = m_decompressor.visit([&](auto const& decompressor) -> ErrorOr<ByteBuffer> {
-        return TRY(decompressor->read_until_eof());
+    auto operation = [this] {
+        return decompress_available_input();
+    };
+
+    return settle_promise_in_parallel(realm(), move(operation), [stream = GC::make_root(*this)](ErrorOr<ByteBuffer> maybe_buffer) -> WebIDL::ExceptionOr<void> {
+        if (maybe_buffer.is_error())
+            return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, MUST(String::formatted("Unable to compress flush: {}", maybe_buffer.error())) };
+
+        // 2. If the end of the compressed input has not been reached, then throw a TypeError.
+        if (stream->m_decompressor.visit([](auto const& decompressor) { return !decompressor->is_eof(); }))
+            return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "End of compressed input has not been reached"sv };
+
+        // 3. If buffer is empty, return.
+        // 4. Split buffer into one or more non-empty pieces and convert them into Uint8Arrays.
+        // 5. For each Uint8Array array, enqueue array in ds's transform.
+        return stream->enqueue_decompressed_data(maybe_buffer.release_value());
     });
-    if (maybe_buffer.is_error())
-        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, MUST(String::formatted("Unable to compress flush: {}", maybe_buffer.error())) };
+}
 
-    auto buffer = maybe_buffer.release_value();
+// Decompresses as much as the input written so far allows.
+ErrorOr<ByteBuffer> DecompressionStream::decompress_available_input()
+{
+    ByteBuffer buffer;
+    auto& decompressor = m_decompressor.visit([](auto const& decompressor) -> Stream& { return *decompressor; });
+    TRY(Compress::decompress_available_input(decompressor, *m_input_stream, [&](ReadonlyBytes data) -> ErrorOr<IterationDecision> {
+        TRY(buffer.try_append(data));
+        return IterationDecision::Continue;
+    }));
+    return buffer;
+}
 
-    // 2. If the end of the compressed input has not been reached, then throw a TypeError.
-    if (m_decompressor.visit([](auto const& decompressor) { return !decompressor->is_eof(); }))
-        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "End of compressed input has not been reached"sv };
+WebIDL::ExceptionOr<void> DecompressionStream::enqueue_decompressed_data(ByteBuffer buffer)
+{
+    auto& realm = this->realm();
 
-    // 3. If buffer is empty, return.
+    // If buffer is empty, return.
     if (buffer.is_empty())
         return {};
 
-    // 4. Split buffer into one or more non-empty pieces and convert them into Uint8Arrays.
+    // Split buffer into one or more non-empty pieces and convert them into Uint8Arrays.
     auto array_buffer = JS::ArrayBuffer::create(realm, move(buffer));
     auto array = JS::Uint8Array::create(realm, array_buffer->byte_length(), *array_buffer);
 
-    // 5. For each Uint8Array array, enqueue array in ds's transform.
+    // For each Uint8Array array, enqueue array in ds's transform.
     m_transform->enqueue(array);
     return {};
 }
@@ -41,8 +41,11 @@ private:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
-    WebIDL::ExceptionOr<void> decompress_and_enqueue_chunk(JS::Value);
-    WebIDL::ExceptionOr<void> decompress_flush_and_enqueue();
+    GC::Ref<WebIDL::Promise> decompress_and_enqueue_chunk(JS::Value);
+    GC::Ref<WebIDL::Promise> decompress_flush_and_enqueue();
+
+    ErrorOr<ByteBuffer> decompress_available_input();
+    WebIDL::ExceptionOr<void> enqueue_decompressed_data(ByteBuffer);
 
     Decompressor m_decompressor;
     NonnullOwnPtr<AllocatingMemoryStream> m_input_stream;
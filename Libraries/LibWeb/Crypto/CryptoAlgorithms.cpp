@@ -3662,6 +3662,21 @@ WebIDL::ExceptionOr<GC::Ref<CryptoKey>> HKDF::import_key(AlgorithmParams const&,
 }
 
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> SHA::digest(AlgorithmParams const& algorithm, ByteBuffer const& data)
+{
+    auto data_copy_or_error = ByteBuffer::copy(data);
+    if (data_copy_or_error.is_error())
+        return WebIDL::OperationError::create(m_realm, "Failed to copy data"_string);
+    auto data_copy = data_copy_or_error.release_value();
+
+    auto operation = TRY(prepare_parallel_digest(algorithm, data_copy));
+    auto result_buffer = (*operation)();
+    if (result_buffer.is_error())
+        return WebIDL::OperationError::create(m_realm, "Failed to create result buffer"_string);
+
+    return JS::ArrayBuffer::create(m_realm, result_buffer.release_value());
+}
+
+WebIDL::ExceptionOr<Optional<AlgorithmMethods::ParallelOperation>> SHA::prepare_parallel_digest(AlgorithmParams const& algorithm, ByteBuffer& data)
 {
     auto& algorithm_name = algorithm.name;
 
@@ -3678,15 +3693,16 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> SHA::digest(AlgorithmParams const&
         return WebIDL::NotSupportedError::create(m_realm, MUST(String::formatted("Invalid hash function '{}'", algorithm_name)));
     }
 
-    ::Crypto::Hash::Manager hash { hash_kind };
-    hash.update(data);
+    return ParallelOperation { [hash_kind, data = move(data)]() -> ErrorOr<ByteBuffer> {
+        ::Crypto::Hash::Manager hash { hash_kind };
+        hash.update(data);
 
-    auto digest = hash.digest();
-    auto result_buffer = ByteBuffer::copy(digest.immutable_data(), hash.digest_size());
-    if (result_buffer.is_error())
-        return WebIDL::OperationError::create(m_realm, "Failed to create result buffer"_string);
-
-    return JS::ArrayBuffer::create(m_realm, result_buffer.release_value());
+        auto digest = hash.digest();
+        auto result_buffer = ByteBuffer::copy(digest.immutable_data(), hash.digest_size());
+        if (result_buffer.is_error())
+            return Error::from_string_literal("Failed to create result buffer");
+        return result_buffer.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#ecdsa-operations
@@ -6589,6 +6605,21 @@ WebIDL::ExceptionOr<JS::Value> ED448::verify(AlgorithmParams const& params, GC::
 
 // https://w3c.github.io/webcrypto/#hkdf-operations
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> HKDF::derive_bits(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length_optional)
+{
+    auto& realm = *m_realm;
+
+    auto operation = TRY(prepare_parallel_derive_bits(params, key, length_optional));
+    auto maybe_result = (*operation)();
+
+    // 4. If the key derivation operation fails, then throw an OperationError.
+    if (maybe_result.is_error())
+        return WebIDL::OperationError::create(realm, "Failed to derive key"_string);
+
+    // 5. Return result
+    return JS::ArrayBuffer::create(realm, maybe_result.release_value());
+}
+
+WebIDL::ExceptionOr<Optional<AlgorithmMethods::ParallelOperation>> HKDF::prepare_parallel_derive_bits(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length_optional)
 {
     auto& realm = *m_realm;
     auto const& normalized_algorithm = static_cast<HKDFParams const&>(params);
@@ -6612,9 +6643,8 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> HKDF::derive_bits(AlgorithmParams
     // Because we are forced by neither peer pressure nor the spec, we don't support it either.
 
     // Note: Check for zero length early because our implementation doesn't support it.
-    if (*length_optional == 0) {
-        return TRY(JS::ArrayBuffer::create(realm, static_cast<size_t>(0)));
-    }
+    if (*length_optional == 0)
+        return ParallelOperation { [] -> ErrorOr<ByteBuffer> { return ByteBuffer {}; } };
 
     auto const& hash_algorithm = TRY(normalized_algorithm.hash.name(realm.vm()));
     auto hash_kind = TRY([&] -> WebIDL::ExceptionOr<::Crypto::Hash::HashKind> {
@@ -6629,15 +6659,13 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> HKDF::derive_bits(AlgorithmParams
         return WebIDL::NotSupportedError::create(m_realm, MUST(String::formatted("Invalid hash function '{}'", hash_algorithm)));
     }());
 
-    ::Crypto::Hash::HKDF hkdf(hash_kind);
-    auto maybe_result = hkdf.derive_key(Optional<ReadonlyBytes>(normalized_algorithm.salt), key_derivation_key, normalized_algorithm.info, *length_optional / 8);
-
-    // 4. If the key derivation operation fails, then throw an OperationError.
-    if (maybe_result.is_error())
-        return WebIDL::OperationError::create(realm, "Failed to derive key"_string);
-
-    // 5. Return result
-    return JS::ArrayBuffer::create(realm, maybe_result.release_value());
+    return ParallelOperation { [hash_kind, key_derivation_key = move(key_derivation_key), salt = normalized_algorithm.salt, info = normalized_algorithm.info, derived_key_length_bytes = *length_optional / 8]() -> ErrorOr<ByteBuffer> {
+        ::Crypto::Hash::HKDF hkdf(hash_kind);
+        auto maybe_result = hkdf.derive_key(Optional<ReadonlyBytes>(salt), key_derivation_key, info, derived_key_length_bytes);
+        if (maybe_result.is_error())
+            return Error::from_string_literal("Failed to derive key");
+        return maybe_result.release_value();
+    } };
 }
 
 WebIDL::ExceptionOr<JS::Value> HKDF::get_key_length(AlgorithmParams const&)
@@ -6648,6 +6676,22 @@ WebIDL::ExceptionOr<JS::Value> HKDF::get_key_length(AlgorithmParams const&)
 
 // https://w3c.github.io/webcrypto/#pbkdf2-operations
 WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> PBKDF2::derive_bits(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length_optional)
+{
+    auto& realm = *m_realm;
+
+    auto operation = TRY(prepare_parallel_derive_bits(params, key, length_optional));
+    auto maybe_result = (*operation)();
+
+    // 5. If the key derivation operation fails, then throw an OperationError.
+    if (maybe_result.is_error())
+        return WebIDL::OperationError::create(realm, "Failed to derive key"_string);
+
+    // 6. Return result
+    return JS::ArrayBuffer::create(realm, maybe_result.release_value());
+}
+
+// https://w3c.github.io/webcrypto/#pbkdf2-operations
+WebIDL::ExceptionOr<Optional<AlgorithmMethods::ParallelOperation>> PBKDF2::prepare_parallel_derive_bits(AlgorithmParams const& params, GC::Ref<CryptoKey> key, Optional<u32> length_optional)
 {
     auto& realm = *m_realm;
     auto const& normalized_algorithm = static_cast<PBKDF2Params const&>(params);
@@ -6686,15 +6730,13 @@ WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> PBKDF2::derive_bits(AlgorithmParam
         return WebIDL::NotSupportedError::create(m_realm, MUST(String::formatted("Invalid hash function '{}'", hash_algorithm)));
     }());
 
-    ::Crypto::Hash::PBKDF2 pbkdf2(hash_kind);
-    auto maybe_result = pbkdf2.derive_key(password, salt, iterations, derived_key_length_bytes);
-
-    // 5. If the key derivation operation fails, then throw an OperationError.
-    if (maybe_result.is_error())
-        return WebIDL::OperationError::create(realm, "Failed to derive key"_string);
-
-    // 6. Return result
-    return JS::ArrayBuffer::create(realm, maybe_result.release_value());
+    return ParallelOperation { [hash_kind, password = move(password), salt = move(salt), iterations, derived_key_length_bytes]() -> ErrorOr<ByteBuffer> {
+        ::Crypto::Hash::PBKDF2 pbkdf2(hash_kind);
+        auto maybe_result = pbkdf2.derive_key(password, salt, iterations, derived_key_length_bytes);
+        if (maybe_result.is_error())
+            return Error::from_string_literal("Failed to derive key");
+        return maybe_result.release_value();
+    } };
 }
 
 // https://w3c.github.io/webcrypto/#pbkdf2-operations
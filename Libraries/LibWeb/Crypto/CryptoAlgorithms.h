@@ -9,6 +9,7 @@
 #pragma once
 
 #include <AK/EnumBits.h>
+#include <AK/Function.h>
 #include <AK/String.h>
 #include <LibCrypto/BigInt/UnsignedBigInteger.h>
 #include <LibGC/Ptr.h>
@@ -331,6 +332,23 @@ public:
         return WebIDL::NotSupportedError::create(m_realm, "deriveBits is not supported"_string);
     }
 
+    // The byte-crunching part of an operation, which doesn't touch the JS heap and may run on a thread pool thread.
+    using ParallelOperation = Function<ErrorOr<ByteBuffer>()>;
+
+    // Algorithms whose digest or derive bits operation can take long enough to block the page (large inputs, many
+    // iterations) override these to validate their parameters up front and return the rest as a ParallelOperation.
+    // An empty result means the operation has to run on the event loop through digest() or derive_bits() instead.
+    // NOTE: To avoid copying large messages, a returned digest operation takes ownership of the data passed in.
+    virtual WebIDL::ExceptionOr<Optional<ParallelOperation>> prepare_parallel_digest(AlgorithmParams const&, ByteBuffer&)
+    {
+        return Optional<ParallelOperation> {};
+    }
+
+    virtual WebIDL::ExceptionOr<Optional<ParallelOperation>> prepare_parallel_derive_bits(AlgorithmParams const&, GC::Ref<CryptoKey>, Optional<u32>)
+    {
+        return Optional<ParallelOperation> {};
+    }
+
     virtual WebIDL::ExceptionOr<GC::Ref<CryptoKey>> import_key(AlgorithmParams const&, Bindings::KeyFormat, CryptoKey::InternalKeyData, bool, Vector<Bindings::KeyUsage> const&)
     {
         return WebIDL::NotSupportedError::create(m_realm, "importKey is not supported"_string);
@@ -505,6 +523,7 @@ class HKDF : public AlgorithmMethods {
 public:
     virtual WebIDL::ExceptionOr<GC::Ref<CryptoKey>> import_key(AlgorithmParams const&, Bindings::KeyFormat, CryptoKey::InternalKeyData, bool, Vector<Bindings::KeyUsage> const&) override;
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> derive_bits(AlgorithmParams const&, GC::Ref<CryptoKey>, Optional<u32>) override;
+    virtual WebIDL::ExceptionOr<Optional<ParallelOperation>> prepare_parallel_derive_bits(AlgorithmParams const&, GC::Ref<CryptoKey>, Optional<u32>) override;
     virtual WebIDL::ExceptionOr<JS::Value> get_key_length(AlgorithmParams const&) override;
 
     static NonnullOwnPtr<AlgorithmMethods> create(JS::Realm& realm) { return adopt_own(*new HKDF(realm)); }
@@ -520,6 +539,7 @@ class PBKDF2 : public AlgorithmMethods {
 public:
     virtual WebIDL::ExceptionOr<GC::Ref<CryptoKey>> import_key(AlgorithmParams const&, Bindings::KeyFormat, CryptoKey::InternalKeyData, bool, Vector<Bindings::KeyUsage> const&) override;
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> derive_bits(AlgorithmParams const&, GC::Ref<CryptoKey>, Optional<u32>) override;
+    virtual WebIDL::ExceptionOr<Optional<ParallelOperation>> prepare_parallel_derive_bits(AlgorithmParams const&, GC::Ref<CryptoKey>, Optional<u32>) override;
     virtual WebIDL::ExceptionOr<JS::Value> get_key_length(AlgorithmParams const&) override;
 
     static NonnullOwnPtr<AlgorithmMethods> create(JS::Realm& realm) { return adopt_own(*new PBKDF2(realm)); }
@@ -534,6 +554,7 @@ private:
 class SHA : public AlgorithmMethods {
 public:
     virtual WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> digest(AlgorithmParams const&, ByteBuffer const&) override;
+    virtual WebIDL::ExceptionOr<Optional<ParallelOperation>> prepare_parallel_digest(AlgorithmParams const&, ByteBuffer&) override;
 
     static NonnullOwnPtr<AlgorithmMethods> create(JS::Realm& realm) { return adopt_own(*new SHA(realm)); }
 
@@ -17,6 +17,7 @@
 #include <LibWeb/Bindings/SubtleCryptoPrototype.h>
 #include <LibWeb/Crypto/KeyAlgorithms.h>
 #include <LibWeb/Crypto/SubtleCrypto.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/WebIDL/AbstractOperations.h>
@@ -30,6 +31,18 @@ static void normalize_key_usages(Vector<Bindings::KeyUsage>& key_usages)
 {
     quick_sort(key_usages);
 }
+
+// Settles the promise with an ArrayBuffer holding the result of the operation once it has finished on a worker thread.
+static void resolve_promise_in_parallel(JS::Realm& realm, GC::Ref<WebIDL::Promise> promise, AlgorithmMethods::ParallelOperation operation)
+{
+    HTML::perform_in_parallel(HTML::Task::Source::Crypto, realm, move(operation), [promise = GC::make_root(promise)](JS::Realm& realm, ErrorOr<ByteBuffer> result) {
+        if (result.is_error()) {
+            WebIDL::reject_promise(realm, *promise, WebIDL::OperationError::create(realm, MUST(String::formatted("{}", result.error()))));
+            return;
+        }
+        WebIDL::resolve_promise(realm, *promise, JS::ArrayBuffer::create(realm, result.release_value()));
+    });
+}
 struct RegisteredAlgorithm {
     NonnullOwnPtr<AlgorithmMethods> (*create_methods)(JS::Realm&) = nullptr;
     JS::ThrowCompletionOr<NonnullOwnPtr<AlgorithmParams>> (*parameter_from_value)(JS::VM&, JS::Value) = nullptr;
@@ -275,12 +288,24 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::digest(AlgorithmIdentifier const& algorit
     auto promise = WebIDL::create_promise(realm);
 
     // 6. Return promise and perform the remaining steps in parallel.
-    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, algorithm_object = normalized_algorithm.release_value(), promise, data_buffer = move(data_buffer)]() -> void {
+    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(realm.heap(), [&realm, algorithm_object = normalized_algorithm.release_value(), promise, data_buffer = move(data_buffer)]() mutable -> void {
         HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
         // 7. If the following steps or referenced procedures say to throw an error, reject promise with the returned error and then terminate the algorithm.
         // FIXME: Need spec reference to https://webidl.spec.whatwg.org/#reject
 
         // 8. Let result be the result of performing the digest operation specified by normalizedAlgorithm using algorithm, with data as message.
+        // NOTE: Hashing a large message can take a long time, so where the algorithm allows it, this happens on a worker
+        //       thread and the promise is resolved from a task queued once it's done.
+        auto parallel_operation = algorithm_object.methods->prepare_parallel_digest(*algorithm_object.parameter, data_buffer);
+        if (parallel_operation.is_exception()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), parallel_operation.release_error()).release_value());
+            return;
+        }
+        if (auto operation = parallel_operation.release_value(); operation.has_value()) {
+            resolve_promise_in_parallel(realm, promise, operation.release_value());
+            return;
+        }
+
         auto result = algorithm_object.methods->digest(*algorithm_object.parameter, data_buffer);
 
         if (result.is_exception()) {
@@ -632,6 +657,18 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::derive_bits(AlgorithmIdentifier algorithm
         }
 
         // 9. Let result be the result of creating an ArrayBuffer containing the result of performing the derive bits operation specified by normalizedAlgorithm using baseKey, algorithm and length.
+        // NOTE: Key derivation functions are designed to be slow, so where the algorithm allows it, this happens on a
+        //       worker thread and the promise is resolved from a task queued once it's done.
+        auto parallel_operation = normalized_algorithm.methods->prepare_parallel_derive_bits(*normalized_algorithm.parameter, base_key, length_optional);
+        if (parallel_operation.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), parallel_operation.release_error()).release_value());
+            return;
+        }
+        if (auto operation = parallel_operation.release_value(); operation.has_value()) {
+            resolve_promise_in_parallel(realm, promise, operation.release_value());
+            return;
+        }
+
         auto result = normalized_algorithm.methods->derive_bits(*normalized_algorithm.parameter, base_key, length_optional);
         if (result.is_error()) {
             WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result.release_error()).release_value());
@@ -645,6 +682,35 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::derive_bits(AlgorithmIdentifier algorithm
     return promise;
 }
 
+// Steps 15 to 19 of https://w3c.github.io/webcrypto/#SubtleCrypto-method-deriveKey, split out so that they can run
+// after the secret has been derived on a worker thread.
+static void import_derived_key(JS::Realm& realm, WebIDL::Promise const& promise, NormalizedAlgorithmAndParameter const& normalized_derived_key_algorithm_import, ByteBuffer secret, bool extractable, Vector<Bindings::KeyUsage> key_usages)
+{
+    // 15. Let result be the result of performing the import key operation specified by normalizedDerivedKeyAlgorithmImport using "raw" as format, secret as keyData, derivedKeyType as algorithm and using extractable and usages.
+    auto result_or_error = normalized_derived_key_algorithm_import.methods->import_key(*normalized_derived_key_algorithm_import.parameter, Bindings::KeyFormat::Raw, move(secret), extractable, key_usages);
+    if (result_or_error.is_error()) {
+        WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result_or_error.release_error()).release_value());
+        return;
+    }
+    auto result = result_or_error.release_value();
+
+    // 16. If the [[type]] internal slot of result is "secret" or "private" and usages is empty, then throw a SyntaxError.
+    if ((result->type() == Bindings::KeyType::Secret || result->type() == Bindings::KeyType::Private) && key_usages.is_empty()) {
+        WebIDL::reject_promise(realm, promise, WebIDL::SyntaxError::create(realm, "usages must not be empty"_string));
+        return;
+    }
+
+    // 17. Set the [[extractable]] internal slot of result to extractable.
+    result->set_extractable(extractable);
+
+    // 18. Set the [[usages]] internal slot of result to the normalized value of usages.
+    normalize_key_usages(key_usages);
+    result->set_usages(key_usages);
+
+    // 19. Resolve promise with result.
+    WebIDL::resolve_promise(realm, promise, result);
+}
+
 // https://w3c.github.io/webcrypto/#SubtleCrypto-method-deriveKey
 GC::Ref<WebIDL::Promise> SubtleCrypto::derive_key(AlgorithmIdentifier algorithm, GC::Ref<CryptoKey> base_key, AlgorithmIdentifier derived_key_type, bool extractable, Vector<Bindings::KeyUsage> key_usages)
 {
@@ -713,35 +779,30 @@ GC::Ref<WebIDL::Promise> SubtleCrypto::derive_key(AlgorithmIdentifier algorithm,
         }
 
         // 14. Let secret be the result of performing the derive bits operation specified by normalizedAlgorithm using key, algorithm and length.
-        auto secret = normalized_algorithm.methods->derive_bits(*normalized_algorithm.parameter, base_key, length);
-        if (secret.is_error()) {
-            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), secret.release_error()).release_value());
+        // NOTE: As in deriveBits(), the derivation itself happens on a worker thread where the algorithm allows it.
+        auto parallel_operation = normalized_algorithm.methods->prepare_parallel_derive_bits(*normalized_algorithm.parameter, base_key, length);
+        if (parallel_operation.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), parallel_operation.release_error()).release_value());
             return;
         }
-
-        // 15. Let result be the result of performing the import key operation specified by normalizedDerivedKeyAlgorithmImport using "raw" as format, secret as keyData, derivedKeyType as algorithm and using extractable and usages.
-        auto result_or_error = normalized_derived_key_algorithm_import.methods->import_key(*normalized_derived_key_algorithm_import.parameter, Bindings::KeyFormat::Raw, secret.release_value()->buffer(), extractable, key_usages);
-        if (result_or_error.is_error()) {
-            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), result_or_error.release_error()).release_value());
+        if (auto operation = parallel_operation.release_value(); operation.has_value()) {
+            HTML::perform_in_parallel(HTML::Task::Source::Crypto, realm, operation.release_value(), [promise = GC::make_root(promise), normalized_derived_key_algorithm_import = move(normalized_derived_key_algorithm_import), extractable, key_usages = move(key_usages)](JS::Realm& realm, ErrorOr<ByteBuffer> secret) mutable {
+                if (secret.is_error()) {
+                    WebIDL::reject_promise(realm, *promise, WebIDL::OperationError::create(realm, MUST(String::formatted("{}", secret.error()))));
+                    return;
+                }
+                import_derived_key(realm, *promise, normalized_derived_key_algorithm_import, secret.release_value(), extractable, move(key_usages));
+            });
             return;
         }
-        auto result = result_or_error.release_value();
 
-        // 16. If the [[type]] internal slot of result is "secret" or "private" and usages is empty, then throw a SyntaxError.
-        if ((result->type() == Bindings::KeyType::Secret || result->type() == Bindings::KeyType::Private) && key_usages.is_empty()) {
-            WebIDL::reject_promise(realm, promise, WebIDL::SyntaxError::create(realm, "usages must not be empty"_string));
+        auto secret = normalized_algorithm.methods->derive_bits(*normalized_algorithm.parameter, base_key, length);
+        if (secret.is_error()) {
+            WebIDL::reject_promise(realm, promise, Bindings::exception_to_throw_completion(realm.vm(), secret.release_error()).release_value());
             return;
         }
 
-        // 17. Set the [[extractable]] internal slot of result to extractable.
-        result->set_extractable(extractable);
-
-        // 18. Set the [[usages]] internal slot of result to the normalized value of usages.
-        normalize_key_usages(key_usages);
-        result->set_usages(key_usages);
-
-        // 19. Resolve promise with result.
-        WebIDL::resolve_promise(realm, promise, result);
+        import_derived_key(realm, promise, normalized_derived_key_algorithm_import, secret.release_value()->buffer(), extractable, move(key_usages));
     }));
 
     return promise;
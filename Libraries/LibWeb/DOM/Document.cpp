@@ -142,8 +142,10 @@
 #include <LibWeb/Layout/BlockFormattingContext.h>
 #include <LibWeb/Layout/TreeBuilder.h>
 #include <LibWeb/Layout/Viewport.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Page/Page.h>
+#include <LibWeb/Painting/StackingContext.h>
 #include <LibWeb/Painting/ViewportPaintable.h>
 #include <LibWeb/PermissionsPolicy/AutoplayAllowlist.h>
 #include <LibWeb/ResizeObserver/ResizeObserver.h>
@@ -380,6 +382,10 @@ WebIDL::ExceptionOr<GC::Ref<Document>> Document::create_and_initialize(Type type
             document->m_http_content_language = maybe_content_language.release_value();
     }
 
+    // NOTE: Non-standard: Pull out the X-DNS-Prefetch-Control header to determine whether the hosts of links may be resolved early.
+    if (auto maybe_dns_prefetch_control = navigation_params.response->header_list()->get("X-DNS-Prefetch-Control"sv.bytes()); maybe_dns_prefetch_control.has_value())
+        document->set_dns_prefetch_control(maybe_dns_prefetch_control.value());
+
     // 10. Set window's associated Document to document.
     window->set_associated_document(*document);
 
@@ -1580,6 +1586,9 @@ void Document::update_paint_and_hit_testing_properties_if_needed()
     if (auto* paintable = this->paintable()) {
         paintable->resolve_paint_only_properties();
     }
+
+    // Paint-only properties end up in the recorded commands, so none of them can be reused.
+    ++m_display_list_generation;
 }
 
 void Document::set_normal_link_color(Color color)
@@ -3147,6 +3156,33 @@ WebIDL::ExceptionOr<void> Document::set_cookie(StringView cookie_string, Cookie:
     return {};
 }
 
+// Non-standard: https://developer.mozilla.org/en-US/docs/Web/HTTP/Reference/Headers/X-DNS-Prefetch-Control
+// Like other browsers, the hosts of links are only resolved early on secure pages if the page opts in, since the
+// lookups are sent in the clear.
+bool Document::is_dns_prefetch_enabled() const
+{
+    switch (m_dns_prefetch_control) {
+    case DNSPrefetchControl::On:
+        return true;
+    case DNSPrefetchControl::Off:
+        return false;
+    case DNSPrefetchControl::Default:
+        return url().scheme() != "https"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void Document::set_dns_prefetch_control(StringView value)
+{
+    value = value.trim_whitespace();
+
+    // NOTE: Once turned off, prefetching stays off, so that markup inserted later can't turn it back on.
+    if (value.equals_ignoring_ascii_case("off"sv))
+        m_dns_prefetch_control = DNSPrefetchControl::Off;
+    else if (value.equals_ignoring_ascii_case("on"sv) && m_dns_prefetch_control != DNSPrefetchControl::Off)
+        m_dns_prefetch_control = DNSPrefetchControl::On;
+}
+
 // https://html.spec.whatwg.org/multipage/dom.html#cookie-averse-document-object
 bool Document::is_cookie_averse() const
 {
@@ -4410,6 +4446,8 @@ void Document::did_stop_being_active_document_in_navigable()
 
     if (m_animation_driver_timer)
         m_animation_driver_timer->stop();
+
+    ResourceLoader::the().discard_preloaded_resources(unique_id());
 }
 
 void Document::increment_throw_on_dynamic_markup_insertion_counter(Badge<HTML::HTMLParser>)
@@ -6357,6 +6395,7 @@ void Document::set_needs_display(CSSPixelRect const&, InvalidateDisplayList shou
 void Document::invalidate_display_list()
 {
     m_cached_display_list.clear();
+    ++m_display_list_generation;
 
     auto navigable = this->navigable();
     if (!navigable)
@@ -6367,12 +6406,51 @@ void Document::invalidate_display_list()
     }
 }
 
+void Document::invalidate_display_list_for(Painting::Paintable const& paintable)
+{
+    // NOTE: Repainting the whole viewport stands for changes that aren't local to one box, such as the selection or the
+    //       focused element changing. Those can affect any stacking context, so nothing recorded earlier can be reused.
+    if (&paintable == this->paintable()) {
+        invalidate_display_list();
+        return;
+    }
+
+    m_cached_display_list.clear();
+
+    // NOTE: A paintable is painted into its own stacking context if it has one, and into its nearest ancestor's otherwise.
+    for (auto const* ancestor = &paintable; ancestor; ancestor = ancestor->parent()) {
+        if (!ancestor->is_paintable_box())
+            continue;
+        if (auto* stacking_context = const_cast<Painting::PaintableBox&>(static_cast<Painting::PaintableBox const&>(*ancestor)).stacking_context()) {
+            stacking_context->invalidate_cached_display_list_fragment();
+            break;
+        }
+    }
+
+    auto navigable = this->navigable();
+    if (!navigable)
+        return;
+
+    if (auto container = navigable->container()) {
+        if (auto container_paintable = container->paintable())
+            container->document().invalidate_display_list_for(*container_paintable);
+        else
+            container->document().invalidate_display_list();
+    }
+}
+
 RefPtr<Painting::DisplayList> Document::record_display_list(PaintConfig config)
 {
     if (m_cached_display_list && m_cached_display_list_paint_config == config) {
         return m_cached_display_list;
     }
 
+    auto device_pixels_per_css_pixel = page().client().device_pixels_per_css_pixel();
+    if (m_cached_display_list_paint_config != config || m_display_list_device_pixels_per_css_pixel != device_pixels_per_css_pixel) {
+        ++m_display_list_generation;
+        m_display_list_device_pixels_per_css_pixel = device_pixels_per_css_pixel;
+    }
+
     auto display_list = Painting::DisplayList::create();
     Painting::DisplayListRecorder display_list_recorder(display_list);
 
@@ -6425,9 +6503,15 @@ RefPtr<Painting::DisplayList> Document::record_display_list(PaintConfig config)
 
     viewport_paintable.refresh_scroll_state();
 
+    context.set_stacking_context_cache_generation(m_display_list_generation);
     viewport_paintable.paint_all_phases(context);
 
-    display_list->set_device_pixels_per_css_pixel(page().client().device_pixels_per_css_pixel());
+    m_last_display_list_recording_stats = {
+        .recorded_commands = display_list->command_count() - context.reused_command_count(),
+        .reused_commands = context.reused_command_count(),
+    };
+
+    display_list->set_device_pixels_per_css_pixel(device_pixels_per_css_pixel);
 
     m_cached_display_list = display_list;
     m_cached_display_list_paint_config = config;
@@ -471,6 +471,9 @@ public:
     void set_pragma_set_default_language(String language) { m_pragma_set_default_language = move(language); }
     Optional<String> const& http_content_language() const { return m_http_content_language; }
 
+    bool is_dns_prefetch_enabled() const;
+    void set_dns_prefetch_control(StringView);
+
     bool has_encoding() const { return m_encoding.has_value(); }
     Optional<String> const& encoding() const { return m_encoding; }
     String encoding_or_default() const { return m_encoding.value_or("UTF-8"_string); }
@@ -834,6 +837,16 @@ public:
 
     void invalidate_display_list();
 
+    // Like invalidate_display_list(), but only the stacking context the paintable is painted into has to be recorded
+    // again. Everything else is reused from the previous display list. Invalidating the viewport invalidates everything.
+    void invalidate_display_list_for(Painting::Paintable const&);
+
+    struct DisplayListRecordingStats {
+        size_t recorded_commands { 0 };
+        size_t reused_commands { 0 };
+    };
+    DisplayListRecordingStats const& last_display_list_recording_stats() const { return m_last_display_list_recording_stats; }
+
     Unicode::Segmenter& grapheme_segmenter() const;
     Unicode::Segmenter& word_segmenter() const;
 
@@ -1017,6 +1030,13 @@ private:
     String m_content_type { "application/xml"_string };
     Optional<String> m_pragma_set_default_language;
     Optional<String> m_http_content_language;
+
+    enum class DNSPrefetchControl : u8 {
+        Default,
+        On,
+        Off,
+    };
+    DNSPrefetchControl m_dns_prefetch_control { DNSPrefetchControl::Default };
     Optional<String> m_encoding;
 
     bool m_ready_for_post_load_tasks { false };
@@ -1222,6 +1242,11 @@ private:
     Optional<PaintConfig> m_cached_display_list_paint_config;
     RefPtr<Painting::DisplayList> m_cached_display_list;
 
+    // Stacking contexts only reuse commands recorded for the current generation.
+    u64 m_display_list_generation { 0 };
+    Optional<double> m_display_list_device_pixels_per_css_pixel;
+    DisplayListRecordingStats m_last_display_list_recording_stats;
+
     mutable OwnPtr<Unicode::Segmenter> m_grapheme_segmenter;
     mutable OwnPtr<Unicode::Segmenter> m_word_segmenter;
 
@@ -77,6 +77,74 @@ bool g_http_cache_enabled;
         _temporary_result.release_value();                                                           \
     })
 
+// Picks the priority a request is sent to RequestServer with, which orders HTTP/2 streams and decides which requests
+// have to wait for others to finish before they are sent.
+static RequestServer::RequestPriority network_priority_for_request(Infrastructure::Request const& request)
+{
+    using Destination = Infrastructure::Request::Destination;
+    using RequestPriority = RequestServer::RequestPriority;
+
+    // Nothing should hold up a request for something the page can't be rendered without.
+    if (request.render_blocking())
+        return RequestPriority::Highest;
+
+    // Prefetches are for navigations that may never happen.
+    if (request.initiator() == Infrastructure::Request::Initiator::Prefetch)
+        return RequestPriority::Lowest;
+
+    auto priority = [&] {
+        if (!request.destination().has_value())
+            return RequestPriority::High;
+
+        switch (*request.destination()) {
+        case Destination::Document:
+        case Destination::Frame:
+        case Destination::IFrame:
+        case Destination::Style:
+        case Destination::Font:
+        case Destination::XSLT:
+            return RequestPriority::Highest;
+        case Destination::Script:
+        case Destination::Worker:
+        case Destination::SharedWorker:
+        case Destination::ServiceWorker:
+        case Destination::AudioWorklet:
+        case Destination::PaintWorklet:
+        case Destination::JSON:
+        case Destination::WebIdentity:
+            return RequestPriority::High;
+        case Destination::Manifest:
+        case Destination::Track:
+            return RequestPriority::Medium;
+        case Destination::Image:
+        case Destination::Audio:
+        case Destination::Video:
+        case Destination::Embed:
+        case Destination::Object:
+            return RequestPriority::Low;
+        case Destination::Report:
+            return RequestPriority::Lowest;
+        }
+        VERIFY_NOT_REACHED();
+    }();
+
+    // The request's priority is a hint that moves it up or down a step from there.
+    switch (request.priority()) {
+    case Infrastructure::Request::Priority::High:
+        if (priority != RequestPriority::Highest)
+            priority = static_cast<RequestPriority>(to_underlying(priority) - 1);
+        break;
+    case Infrastructure::Request::Priority::Low:
+        if (priority != RequestPriority::Lowest)
+            priority = static_cast<RequestPriority>(to_underlying(priority) + 1);
+        break;
+    case Infrastructure::Request::Priority::Auto:
+        break;
+    }
+
+    return priority;
+}
+
 // https://fetch.spec.whatwg.org/#concept-fetch
 WebIDL::ExceptionOr<GC::Ref<Infrastructure::FetchController>> fetch(JS::Realm& realm, Infrastructure::Request& request, Infrastructure::FetchAlgorithms const& algorithms, UseParallelQueue use_parallel_queue)
 {
@@ -252,6 +320,8 @@ WebIDL::ExceptionOr<GC::Ref<Infrastructure::FetchController>> fetch(JS::Realm& r
     //     in setting request’s priority to a user-agent-defined object.
     // NOTE: The user-agent-defined object could encompass stream weight and dependency for HTTP/2, and equivalent
     //       information used to prioritize dispatch and processing of HTTP/1 fetches.
+    if (!request.internal_priority().has_value())
+        request.set_internal_priority(Infrastructure::Request::InternalPriority { network_priority_for_request(request) });
 
     // 16. If request is a subresource request, then:
     if (request.is_subresource_request()) {
@@ -2297,6 +2367,14 @@ WebIDL::ExceptionOr<GC::Ref<PendingResponse>> nonstandard_resource_loader_file_o
     load_request.set_url(request->current_url());
     load_request.set_page(page);
     load_request.set_method(ByteString::copy(request->method()));
+    if (auto client = request->client()) {
+        if (auto* window = as_if<HTML::Window>(client->global_object()))
+            load_request.set_document_id(window->associated_document().unique_id());
+    }
+    if (request->internal_priority().has_value())
+        load_request.set_priority(request->internal_priority()->network_priority);
+    load_request.set_fetch_parameters({ request->mode(), request->credentials_mode(), request->destination() });
+    load_request.set_speculative(request->is_speculative());
 
     for (auto const& header : *request->header_list())
         load_request.set_header(ByteString::copy(header.name), ByteString::copy(header.value));
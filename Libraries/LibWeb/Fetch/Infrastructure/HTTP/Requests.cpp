@@ -233,6 +233,7 @@ GC::Ref<Request> Request::clone(JS::Realm& realm) const
     new_request->set_initiator(m_initiator);
     new_request->set_destination(m_destination);
     new_request->set_priority(m_priority);
+    new_request->set_internal_priority(m_internal_priority);
     new_request->set_origin(m_origin);
     new_request->set_policy_container(m_policy_container);
     new_request->set_referrer(m_referrer);
@@ -257,6 +258,7 @@ GC::Ref<Request> Request::clone(JS::Realm& realm) const
     new_request->set_done(m_done);
     new_request->set_timing_allow_failed(m_timing_allow_failed);
     new_request->set_buffer_policy(m_buffer_policy);
+    new_request->set_speculative(m_speculative);
 
     // 2. If request’s body is non-null, set newRequest’s body to the result of cloning request’s body.
     if (auto const* body = m_body.get_pointer<GC::Ref<Body>>())
@@ -23,6 +23,7 @@
 #include <LibWeb/Fetch/Infrastructure/HTTP/Headers.h>
 #include <LibWeb/HTML/PolicyContainers.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Web::Fetch::Infrastructure {
 
@@ -167,7 +168,10 @@ public:
     };
 
     // Members are implementation-defined
-    struct InternalPriority { };
+    struct InternalPriority {
+        // The priority the request is sent to RequestServer with.
+        RequestServer::RequestPriority network_priority { RequestServer::RequestPriority::Medium };
+    };
 
     using BodyType = Variant<Empty, ByteBuffer, GC::Ref<Body>>;
     using OriginType = Variant<Origin, URL::Origin>;
@@ -226,6 +230,9 @@ public:
     [[nodiscard]] Priority const& priority() const { return m_priority; }
     void set_priority(Priority priority) { m_priority = priority; }
 
+    [[nodiscard]] Optional<InternalPriority> const& internal_priority() const { return m_internal_priority; }
+    void set_internal_priority(Optional<InternalPriority> internal_priority) { m_internal_priority = move(internal_priority); }
+
     [[nodiscard]] OriginType const& origin() const { return m_origin; }
     void set_origin(OriginType origin) { m_origin = move(origin); }
 
@@ -335,6 +342,10 @@ public:
     [[nodiscard]] BufferPolicy buffer_policy() const { return m_buffer_policy; }
     void set_buffer_policy(BufferPolicy buffer_policy) { m_buffer_policy = buffer_policy; }
 
+    // Set for the fetches the HTML preload scanner starts, whose response is kept for the element's own fetch to adopt.
+    [[nodiscard]] bool is_speculative() const { return m_speculative; }
+    void set_speculative(bool speculative) { m_speculative = speculative; }
+
 private:
     explicit Request(GC::Ref<HeaderList>);
 
@@ -527,6 +538,8 @@ private:
     Vector<GC::Ref<Fetching::PendingResponse>> m_pending_responses;
 
     BufferPolicy m_buffer_policy { BufferPolicy::BufferResponse };
+
+    bool m_speculative { false };
 };
 
 StringView request_destination_to_string(Request::Destination);
@@ -292,6 +292,7 @@ class Tokenizer;
 struct AtRule;
 struct Declaration;
 struct Function;
+struct ParsingParams;
 struct QualifiedRule;
 struct SimpleBlock;
 }
@@ -504,6 +505,7 @@ class HTMLParamElement;
 class HTMLParser;
 class HTMLPictureElement;
 class HTMLPreElement;
+class HTMLPreloadScanner;
 class HTMLProgressElement;
 class HTMLQuoteElement;
 class HTMLScriptElement;
@@ -523,6 +525,8 @@ class HTMLTemplateElement;
 class HTMLTextAreaElement;
 class HTMLTimeElement;
 class HTMLTitleElement;
+class HTMLToken;
+class HTMLTokenizer;
 class HTMLTrackElement;
 class HTMLUListElement;
 class HTMLUnknownElement;
@@ -5,8 +5,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteBuffer.h>
 #include <LibCore/EventLoop.h>
 #include <LibJS/Runtime/VM.h>
+#include <LibThreading/ThreadPool.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
 #include <LibWeb/CSS/FontFaceSet.h>
 #include <LibWeb/CSS/StyleComputer.h>
@@ -538,6 +540,19 @@ TaskID queue_global_task(HTML::Task::Source source, JS::Object& global_object, G
     return queue_a_task(source, *event_loop, document, steps);
 }
 
+// Runs the operation on the process-wide thread pool, then queues a global task on the given task source that passes
+// its result to the completion steps within the realm. The operation must not touch any GC things, and the completion
+// steps travel through a pool thread, so they must hold on to GC things via roots.
+void perform_in_parallel(HTML::Task::Source source, JS::Realm& realm, Function<ErrorOr<ByteBuffer>()> operation, Function<void(JS::Realm&, ErrorOr<ByteBuffer>)> completion_steps)
+{
+    Threading::ThreadPool::the().run(move(operation), [source, realm = GC::make_root(realm), completion_steps = move(completion_steps)](ErrorOr<ByteBuffer> result) mutable {
+        queue_global_task(source, realm->global_object(), GC::create_function(realm->heap(), [realm = GC::Ref { *realm }, completion_steps = move(completion_steps), result = move(result)]() mutable {
+            TemporaryExecutionContext context(realm, TemporaryExecutionContext::CallbacksEnabled::Yes);
+            completion_steps(realm, move(result));
+        }));
+    });
+}
+
 // https://html.spec.whatwg.org/multipage/webappapis.html#queue-a-microtask
 void queue_a_microtask(DOM::Document const* document, GC::Ref<GC::Function<void()>> steps)
 {
@@ -143,6 +143,7 @@ private:
 EventLoop& main_thread_event_loop();
 TaskID queue_a_task(HTML::Task::Source, GC::Ptr<EventLoop>, GC::Ptr<DOM::Document>, GC::Ref<GC::Function<void()>> steps);
 TaskID queue_global_task(HTML::Task::Source, JS::Object&, GC::Ref<GC::Function<void()>> steps);
+void perform_in_parallel(HTML::Task::Source, JS::Realm&, Function<ErrorOr<ByteBuffer>()> operation, Function<void(JS::Realm&, ErrorOr<ByteBuffer>)> completion_steps);
 void queue_a_microtask(DOM::Document const*, GC::Ref<GC::Function<void()>> steps);
 void perform_a_microtask_checkpoint();
 
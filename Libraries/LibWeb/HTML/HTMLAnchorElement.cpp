@@ -13,6 +13,7 @@
 #include <LibWeb/HTML/HTMLAnchorElement.h>
 #include <LibWeb/HTML/HTMLImageElement.h>
 #include <LibWeb/HTML/Window.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/PixelUnits.h>
 #include <LibWeb/ReferrerPolicy/ReferrerPolicy.h>
 #include <LibWeb/UIEvents/MouseEvent.h>
@@ -46,12 +47,39 @@ void HTMLAnchorElement::attribute_changed(FlyString const& name, Optional<String
 
     if (name == HTML::AttributeNames::href) {
         set_the_url();
+        prefetch_dns_for_href();
     } else if (name == HTML::AttributeNames::rel) {
         if (m_rel_list)
             m_rel_list->associated_attribute_changed(value.value_or(String {}));
     }
 }
 
+void HTMLAnchorElement::inserted()
+{
+    Base::inserted();
+    prefetch_dns_for_href();
+}
+
+// Resolves the host of a link to another site while the page loads, so that following it doesn't wait on DNS.
+void HTMLAnchorElement::prefetch_dns_for_href()
+{
+    if (!is_connected() || !document().browsing_context() || !document().is_dns_prefetch_enabled())
+        return;
+
+    auto href = attribute(HTML::AttributeNames::href);
+    if (!href.has_value())
+        return;
+
+    auto url = document().encoding_parse_url(*href);
+    if (!url.has_value() || !url->scheme().is_one_of("http"sv, "https"sv))
+        return;
+
+    if (url->serialized_host() == document().url().serialized_host())
+        return;
+
+    ResourceLoader::the().prefetch_dns(*url);
+}
+
 Optional<String> HTMLAnchorElement::hyperlink_element_utils_href() const
 {
     return attribute(HTML::AttributeNames::href);
@@ -45,6 +45,11 @@ private:
     virtual void activation_behavior(Web::DOM::Event const&) override;
     virtual bool has_download_preference() const;
 
+    void prefetch_dns_for_href();
+
+    // ^DOM::Node
+    virtual void inserted() override;
+
     // ^DOM::Element
     virtual void attribute_changed(FlyString const& name, Optional<String> const& old_value, Optional<String> const& value, Optional<FlyString> const& namespace_) override;
     virtual i32 default_tab_index_value() const override;
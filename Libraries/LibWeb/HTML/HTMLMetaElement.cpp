@@ -143,6 +143,10 @@ void HTMLMetaElement::inserted()
             document().set_pragma_set_default_language(language);
             break;
         }
+        case HttpEquivAttributeState::XDNSPrefetchControl:
+            // Non-standard: https://developer.mozilla.org/en-US/docs/Web/HTTP/Reference/Headers/X-DNS-Prefetch-Control
+            document().set_dns_prefetch_control(get_attribute_value(AttributeNames::content));
+            break;
         default:
             dbgln("FIXME: Implement '{}' http-equiv state", get_attribute_value(AttributeNames::http_equiv));
             break;
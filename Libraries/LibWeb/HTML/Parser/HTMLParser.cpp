@@ -37,6 +37,7 @@
 #include <LibWeb/HTML/HTMLTemplateElement.h>
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
 #include <LibWeb/HTML/Scripting/Agent.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
@@ -3080,7 +3081,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    start_the_speculative_html_parser();
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -3099,7 +3101,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: Our speculative HTML parser runs to completion when started, so there is nothing to stop here.
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -4539,6 +4542,29 @@ void HTMLParser::reset_the_insertion_mode_appropriately()
     VERIFY_NOT_REACHED();
 }
 
+// https://html.spec.whatwg.org/multipage/parsing.html#start-the-speculative-html-parser
+void HTMLParser::start_the_speculative_html_parser()
+{
+    // NOTE: Rather than building a speculative mock element tree in parallel, we do a single tokenizer-only pass over
+    //       the unconsumed input and start speculative fetches for the resources it finds. Those fetches are adopted by
+    //       the real requests once the parser gets to the corresponding elements.
+    if (m_parsing_fragment || !m_document->browsing_context())
+        return;
+
+    auto input = m_tokenizer.unconsumed_input();
+    if (input.is_empty())
+        return;
+
+    auto input_length = m_tokenizer.source().length();
+    if (m_speculatively_scanned_input_length == input_length)
+        return;
+    m_speculatively_scanned_input_length = input_length;
+
+    auto scripting_enabled = m_scripting_enabled ? HTMLPreloadScanner::ScriptingEnabled::Yes : HTMLPreloadScanner::ScriptingEnabled::No;
+    HTMLPreloadScanner scanner { input, m_document->base_url(), scripting_enabled };
+    HTMLPreloadScanner::start_speculative_fetches(*m_document, scanner.scan());
+}
+
 char const* HTMLParser::insertion_mode_name() const
 {
     switch (m_insertion_mode) {
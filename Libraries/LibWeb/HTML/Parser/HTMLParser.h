@@ -171,6 +171,8 @@ private:
     void decrement_script_nesting_level();
     void reset_the_insertion_mode_appropriately();
 
+    void start_the_speculative_html_parser();
+
     void adjust_mathml_attributes(HTMLToken&);
     void adjust_svg_tag_names(HTMLToken&);
     void adjust_svg_attributes(HTMLToken&);
@@ -212,6 +214,10 @@ private:
     bool m_stop_parsing { false };
     size_t m_script_nesting_level { 0 };
 
+    // Length of the tokenizer input the last time the speculative HTML parser ran, so that we only scan again
+    // when document.write() or more data has changed the input.
+    Optional<size_t> m_speculatively_scanned_input_length;
+
     JS::Realm& realm();
 
     GC::Ptr<DOM::Document> m_document;
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/InsertionSort.h>
+#include <LibURL/Parser.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/Fetch/Fetching/Fetching.h>
+#include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
+#include <LibWeb/HTML/Parser/HTMLToken.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/PotentialCORSRequest.h>
+#include <LibWeb/HTML/Scripting/Environments.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+
+namespace Web::HTML {
+
+HTMLPreloadScanner::HTMLPreloadScanner(StringView input, URL::URL base_url, ScriptingEnabled scripting_enabled)
+    : m_input(input)
+    , m_base_url(move(base_url))
+    , m_scripting_enabled(scripting_enabled)
+{
+}
+
+Vector<HTMLPreloadScanner::Candidate> HTMLPreloadScanner::scan()
+{
+    m_candidates.clear();
+
+    HTMLTokenizer tokenizer { m_input, "UTF-8"sv };
+    while (true) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+        if (token->is_start_tag())
+            process_start_tag(*token, tokenizer);
+    }
+
+    // NOTE: Render-blocking resources go out first so they don't queue up behind images in the network process.
+    //       The sort is stable, so document order is preserved within each priority.
+    insertion_sort(m_candidates, [](auto const& a, auto const& b) {
+        return a.priority == Priority::High && b.priority == Priority::Low;
+    });
+
+    return move(m_candidates);
+}
+
+void HTMLPreloadScanner::process_start_tag(HTMLToken const& token, HTMLTokenizer& tokenizer)
+{
+    auto const& tag_name = token.tag_name();
+
+    // NOTE: Without a tree builder driving it, the tokenizer would treat the contents of raw text elements as markup.
+    //       Mirror the state switches the tree construction stage performs for them, so that e.g. "<img src>" inside
+    //       a script's source text is not mistaken for an element.
+    if (tag_name == TagNames::script) {
+        tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+    } else if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes)
+        || (tag_name == TagNames::noscript && m_scripting_enabled == ScriptingEnabled::Yes)) {
+        tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+    } else if (tag_name.is_one_of(TagNames::textarea, TagNames::title)) {
+        tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+    } else if (tag_name == TagNames::plaintext) {
+        tokenizer.switch_to(HTMLTokenizer::State::PLAINTEXT);
+    }
+
+    // https://html.spec.whatwg.org/multipage/semantics.html#frozen-base-url
+    // Only the first base element with an href attribute affects the document base URL.
+    if (tag_name == TagNames::base) {
+        if (m_base_url_was_set)
+            return;
+        auto href = token.attribute(AttributeNames::href);
+        if (!href.has_value())
+            return;
+        m_base_url_was_set = true;
+        if (auto url = URL::Parser::basic_parse(href->bytes_as_string_view().trim_whitespace(), m_base_url); url.has_value())
+            m_base_url = url.release_value();
+        return;
+    }
+
+    FetchOptions fetch_options;
+    fetch_options.cors_setting = cors_setting_attribute_from_keyword(token.attribute(AttributeNames::crossorigin));
+    if (auto referrer_policy = token.attribute(AttributeNames::referrerpolicy); referrer_policy.has_value())
+        fetch_options.referrer_policy = ReferrerPolicy::from_string(*referrer_policy);
+
+    if (tag_name == TagNames::script) {
+        auto src = token.attribute(AttributeNames::src);
+        if (!src.has_value())
+            return;
+
+        // Only scripts the user agent will actually run are worth fetching; data blocks are never fetched.
+        if (auto type = token.attribute(AttributeNames::type); type.has_value() && !type->is_empty()) {
+            auto type_string = type->bytes_as_string_view().trim_whitespace();
+            if (type_string.equals_ignoring_ascii_case("module"sv))
+                fetch_options.is_module_script = true;
+            else if (!MimeSniff::is_javascript_mime_type_essence_match(type_string))
+                return;
+        }
+
+        add_candidate(*src, Destination::Script, Priority::High, fetch_options);
+        return;
+    }
+
+    if (tag_name == TagNames::link) {
+        auto rel = token.attribute(AttributeNames::rel);
+        auto href = token.attribute(AttributeNames::href);
+        if (!rel.has_value() || !href.has_value())
+            return;
+
+        bool is_stylesheet = false;
+        bool is_alternate = false;
+        for (auto keyword : rel->bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace)) {
+            if (keyword.equals_ignoring_ascii_case("stylesheet"sv))
+                is_stylesheet = true;
+            else if (keyword.equals_ignoring_ascii_case("alternate"sv))
+                is_alternate = true;
+        }
+
+        // Alternate style sheets are not render-blocking and may never be applied, so leave them to the real parser.
+        if (is_stylesheet && !is_alternate)
+            add_candidate(*href, Destination::Style, Priority::High, fetch_options);
+        return;
+    }
+
+    if (tag_name == TagNames::img) {
+        // FIXME: Select a source from srcset/sizes the way the image element would.
+        if (token.has_attribute(AttributeNames::srcset))
+            return;
+        if (auto src = token.attribute(AttributeNames::src); src.has_value())
+            add_candidate(*src, Destination::Image, Priority::Low, fetch_options);
+        return;
+    }
+}
+
+void HTMLPreloadScanner::add_candidate(StringView url_string, Destination destination, Priority priority, FetchOptions fetch_options)
+{
+    url_string = url_string.trim_whitespace();
+    if (url_string.is_empty())
+        return;
+
+    auto url = URL::Parser::basic_parse(url_string, m_base_url);
+    if (!url.has_value())
+        return;
+
+    // Only network resources can benefit from being requested early.
+    if (!url->scheme().is_one_of("http"sv, "https"sv))
+        return;
+
+    url->set_fragment({});
+
+    for (auto const& candidate : m_candidates) {
+        if (candidate.url == *url)
+            return;
+    }
+
+    m_candidates.append({ url.release_value(), destination, priority, fetch_options });
+}
+
+void HTMLPreloadScanner::start_speculative_fetches(DOM::Document& document, Vector<Candidate> const& candidates)
+{
+    auto& realm = document.realm();
+    auto& vm = realm.vm();
+    auto& settings_object = document.relevant_settings_object();
+
+    for (auto const& candidate : candidates) {
+        dbgln_if(HTML_PARSER_DEBUG, "HTMLPreloadScanner: Speculatively fetching {}", candidate.url);
+
+        // NOTE: The request is set up the way the element will set up its own, so that Fetch applies the same policies
+        //       to it, and the element's fetch can adopt its response.
+        auto const& fetch_options = candidate.fetch_options;
+        GC::Ptr<Fetch::Infrastructure::Request> request;
+        switch (candidate.destination) {
+        case Destination::Script:
+            if (fetch_options.is_module_script) {
+                // https://html.spec.whatwg.org/multipage/webappapis.html#fetch-a-single-module-script
+                request = Fetch::Infrastructure::Request::create(vm);
+                request->set_url(candidate.url);
+                request->set_mode(Fetch::Infrastructure::Request::Mode::CORS);
+                request->set_destination(Fetch::Infrastructure::Request::Destination::Script);
+                request->set_credentials_mode(cors_settings_attribute_credentials_mode(fetch_options.cors_setting));
+            } else {
+                // https://html.spec.whatwg.org/multipage/webappapis.html#fetch-a-classic-script
+                request = create_potential_CORS_request(vm, candidate.url, Fetch::Infrastructure::Request::Destination::Script, fetch_options.cors_setting);
+            }
+            request->set_initiator_type(Fetch::Infrastructure::Request::InitiatorType::Script);
+            break;
+        case Destination::Style:
+            // https://html.spec.whatwg.org/multipage/semantics.html#create-a-link-request
+            request = create_potential_CORS_request(vm, candidate.url, Fetch::Infrastructure::Request::Destination::Style, fetch_options.cors_setting);
+            request->set_initiator_type(Fetch::Infrastructure::Request::InitiatorType::CSS);
+            break;
+        case Destination::Image:
+            // https://html.spec.whatwg.org/multipage/images.html#update-the-image-data
+            request = create_potential_CORS_request(vm, candidate.url, Fetch::Infrastructure::Request::Destination::Image, fetch_options.cors_setting);
+            request->set_initiator_type(Fetch::Infrastructure::Request::InitiatorType::IMG);
+            break;
+        }
+
+        request->set_client(&settings_object);
+        if (fetch_options.referrer_policy.has_value())
+            request->set_referrer_policy(*fetch_options.referrer_policy);
+        request->set_speculative(true);
+
+        // NOTE: Nothing waits for the response here; ResourceLoader keeps it until the element's fetch asks for it.
+        (void)Fetch::Fetching::fetch(realm, *request, Fetch::Infrastructure::FetchAlgorithms::create(vm, {}));
+    }
+}
+
+}
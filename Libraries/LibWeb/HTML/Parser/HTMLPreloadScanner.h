@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/CORSSettingAttribute.h>
+#include <LibWeb/ReferrerPolicy/ReferrerPolicy.h>
+
+namespace Web::HTML {
+
+// A lightweight, tokenizer-only pass over the part of the input stream that the tree builder has not reached yet.
+// While the parser is blocked on a parsing-blocking script, this discovers subresources further down the document
+// so they can be fetched speculatively instead of one after the other.
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+class HTMLPreloadScanner {
+public:
+    enum class Priority {
+        High,
+        Low,
+    };
+
+    enum class Destination {
+        Script,
+        Style,
+        Image,
+    };
+
+    // What the element's own fetch will be set up from, so that it can adopt the response of the speculative fetch.
+    struct FetchOptions {
+        CORSSettingAttribute cors_setting { CORSSettingAttribute::NoCORS };
+        bool is_module_script { false };
+        Optional<ReferrerPolicy::ReferrerPolicy> referrer_policy;
+    };
+
+    struct Candidate {
+        URL::URL url;
+        Destination destination;
+        Priority priority;
+        FetchOptions fetch_options;
+    };
+
+    enum class ScriptingEnabled {
+        No,
+        Yes,
+    };
+
+    HTMLPreloadScanner(StringView input, URL::URL base_url, ScriptingEnabled);
+
+    // Returns the discovered fetch candidates, render-blocking resources first and otherwise in document order.
+    // Duplicate URLs are only reported once.
+    Vector<Candidate> scan();
+
+    // https://html.spec.whatwg.org/multipage/parsing.html#speculative-fetch
+    static void start_speculative_fetches(DOM::Document&, Vector<Candidate> const&);
+
+private:
+    void process_start_tag(HTMLToken const&, HTMLTokenizer&);
+    void add_candidate(StringView url, Destination, Priority, FetchOptions);
+
+    StringView m_input;
+    URL::URL m_base_url;
+    bool m_base_url_was_set { false };
+    ScriptingEnabled m_scripting_enabled { ScriptingEnabled::Yes };
+    Vector<Candidate> m_candidates;
+};
+
+}
@@ -5,9 +5,13 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
+#include <AK/Endian.h>
 #include <AK/GenericShorthands.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/SourceLocation.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/HTML/Parser/Entities.h>
@@ -252,6 +256,99 @@ Optional<u32> HTMLTokenizer::peek_code_point(size_t offset, StopAtInsertionPoint
     return *it;
 }
 
+// Returns the length of the run of bytes at the start of the input that need no per-code-point processing in the
+// data and attribute value states: ASCII other than the state's delimiter, '&', U+000D CR and U+0000 NULL.
+static size_t plain_text_run_length(ReadonlyBytes input, u8 delimiter)
+{
+    using AK::SIMD::u8x16;
+
+    size_t offset = 0;
+
+    if constexpr (HostIsLittleEndian) {
+        auto splat = [](u8 value) {
+            return u8x16 { value, value, value, value, value, value, value, value, value, value, value, value, value, value, value, value };
+        };
+        auto const delimiters = splat(delimiter);
+        auto const ampersands = splat('&');
+        auto const carriage_returns = splat('\r');
+        auto const nulls = splat(0);
+        auto const high_bits = splat(0x80);
+
+        for (; offset + sizeof(u8x16) <= input.size(); offset += sizeof(u8x16)) {
+            auto chunk = AK::SIMD::load_unaligned<u8x16>(input.offset_pointer(offset));
+            auto special = (chunk == delimiters) | (chunk == ampersands) | (chunk == carriage_returns) | (chunk == nulls) | ((chunk & high_bits) != nulls);
+
+            u64 halves[2];
+            __builtin_memcpy(halves, &special, sizeof(halves));
+            if (halves[0] != 0)
+                return offset + count_trailing_zeroes(halves[0]) / 8;
+            if (halves[1] != 0)
+                return offset + 8 + count_trailing_zeroes(halves[1]) / 8;
+        }
+    }
+
+    for (; offset < input.size(); ++offset) {
+        auto byte = input[offset];
+        if (byte == delimiter || byte == '&' || byte == '\r' || byte == 0 || byte >= 0x80)
+            break;
+    }
+    return offset;
+}
+
+// Consumes the run of plain ASCII text that follows the current input character, if any, in one step.
+// This must only be used in states where the characters in such a run would each be handled the same way.
+StringView HTMLTokenizer::consume_plain_text_run(char delimiter, StopAtInsertionPoint stop_at_insertion_point)
+{
+    auto offset = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto input = m_decoded_input.view().substring_view(offset);
+
+    if (stop_at_insertion_point == StopAtInsertionPoint::Yes && m_insertion_point.defined) {
+        if (m_insertion_point.position <= offset)
+            return {};
+        input = input.substring_view(0, min(input.length(), m_insertion_point.position - offset));
+    }
+
+    auto run_length = plain_text_run_length(input.bytes(), delimiter);
+    if (run_length == 0)
+        return {};
+    auto run = input.substring_view(0, run_length);
+
+    if (!m_source_positions.is_empty()) {
+        auto position = m_source_positions.last();
+        for (auto byte : run) {
+            if (byte == '\n') {
+                position.column = 0;
+                position.line++;
+            } else {
+                position.column++;
+            }
+        }
+        m_source_positions.append(position);
+    }
+
+    m_prev_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(offset + run_length - 1);
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(offset + run_length);
+    return run;
+}
+
+void HTMLTokenizer::emit_plain_text_run_as_character_tokens(StringView run)
+{
+    // NOTE: consume_plain_text_run() only records the position after the whole run, so reconstruct the position
+    //       each character token would have had if it had been consumed on its own.
+    auto position = m_source_positions.size() >= 2 ? m_source_positions[m_source_positions.size() - 2] : HTMLToken::Position {};
+    for (auto byte : run) {
+        if (byte == '\n') {
+            position.column = 0;
+            position.line++;
+        } else {
+            position.column++;
+        }
+        auto token = HTMLToken::make_character(byte);
+        token.set_start_position({}, position);
+        m_queued_tokens.enqueue(move(token));
+    }
+}
+
 HTMLToken::Position HTMLTokenizer::nth_last_position(size_t n)
 {
     if (n + 1 > m_source_positions.size()) {
@@ -304,7 +401,14 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    create_new_token(HTMLToken::Type::Character);
+                    m_current_token.set_code_point(current_input_character.value());
+                    m_queued_tokens.enqueue(move(m_current_token));
+
+                    // NOTE: Plain text is by far the most common input in this state, so emit the rest of the run
+                    //       at once instead of going around the state machine for every character.
+                    emit_plain_text_run_as_character_tokens(consume_plain_text_run('<', stop_at_insertion_point));
+                    return m_queued_tokens.dequeue();
                 }
             }
             END_STATE
@@ -1317,6 +1421,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    m_current_builder.append(consume_plain_text_run('"', stop_at_insertion_point));
                     continue;
                 }
             }
@@ -1349,6 +1454,7 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    m_current_builder.append(consume_plain_text_run('\'', stop_at_insertion_point));
                     continue;
                 }
             }
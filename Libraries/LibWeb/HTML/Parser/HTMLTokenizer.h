@@ -131,6 +131,9 @@ public:
 
     ByteString source() const { return m_decoded_input; }
 
+    // The part of the input stream that has not been consumed by the tokenizer yet.
+    StringView unconsumed_input() const { return m_decoded_input.substring_view(m_utf8_view.byte_offset_of(m_utf8_iterator)); }
+
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
     bool is_eof_inserted();
@@ -154,6 +157,8 @@ public:
 
 private:
     void skip(size_t count);
+    StringView consume_plain_text_run(char delimiter, StopAtInsertionPoint);
+    void emit_plain_text_run_as_character_tokens(StringView run);
     Optional<u32> next_code_point(StopAtInsertionPoint);
     Optional<u32> peek_code_point(size_t offset, StopAtInsertionPoint) const;
 
@@ -70,6 +70,15 @@ JS::Object* Internals::hit_test(double x, double y)
     return nullptr;
 }
 
+JS::Object* Internals::get_display_list_recording_stats()
+{
+    auto const& stats = window().associated_document().last_display_list_recording_stats();
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("recordedCommands"_fly_string, JS::Value(stats.recorded_commands), JS::default_attributes);
+    result->define_direct_property("reusedCommands"_fly_string, JS::Value(stats.reused_commands), JS::default_attributes);
+    return result;
+}
+
 void Internals::send_text(HTML::HTMLElement& target, String const& text, WebIDL::UnsignedShort modifiers)
 {
     auto& page = this->page();
@@ -25,6 +25,7 @@ public:
 
     void gc();
     JS::Object* hit_test(double x, double y);
+    JS::Object* get_display_list_recording_stats();
 
     void send_text(HTML::HTMLElement&, String const&, WebIDL::UnsignedShort modifiers);
     void send_key(HTML::HTMLElement&, String const&, WebIDL::UnsignedShort modifiers);
@@ -11,8 +11,10 @@
 #include <AK/Time.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibURL/URL.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/Page/Page.h>
+#include <RequestServer/RequestPriority.h>
 
 namespace Web {
 
@@ -40,12 +42,35 @@ public:
     ByteBuffer const& body() const { return m_body; }
     void set_body(ByteBuffer body) { m_body = move(body); }
 
+    RequestServer::RequestPriority priority() const { return m_priority; }
+    void set_priority(RequestServer::RequestPriority priority) { m_priority = priority; }
+
     void start_timer() { m_load_timer.start(); }
     AK::Duration load_time() const { return m_load_timer.elapsed_time(); }
 
     GC::Ptr<Page> page() const { return m_page.ptr(); }
     void set_page(Page& page) { m_page = page; }
 
+    // The document on whose behalf this resource is loaded, if any.
+    Optional<UniqueNodeID> document_id() const { return m_document_id; }
+    void set_document_id(UniqueNodeID document_id) { m_document_id = document_id; }
+
+    // How the Fetch request this resource is loaded for was set up, if it came from Fetch. These decide how a response
+    // may be used, so a speculative fetch is only ever handed to a request that agrees on all of them.
+    struct FetchParameters {
+        Fetch::Infrastructure::Request::Mode mode;
+        Fetch::Infrastructure::Request::CredentialsMode credentials_mode;
+        Optional<Fetch::Infrastructure::Request::Destination> destination;
+
+        bool operator==(FetchParameters const&) const = default;
+    };
+    Optional<FetchParameters> const& fetch_parameters() const { return m_fetch_parameters; }
+    void set_fetch_parameters(FetchParameters fetch_parameters) { m_fetch_parameters = move(fetch_parameters); }
+
+    // Speculative loads are made by the HTML preload scanner, and their response is kept for the real request to adopt.
+    bool is_speculative() const { return m_speculative; }
+    void set_speculative(bool speculative) { m_speculative = speculative; }
+
     unsigned hash() const
     {
         auto body_hash = string_hash((char const*)m_body.data(), m_body.size());
@@ -80,9 +105,13 @@ private:
     ByteString m_method { "GET" };
     HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> m_headers;
     ByteBuffer m_body;
+    RequestServer::RequestPriority m_priority { RequestServer::RequestPriority::Medium };
     Core::ElapsedTimer m_load_timer;
     GC::Root<Page> m_page;
+    Optional<UniqueNodeID> m_document_id;
+    Optional<FetchParameters> m_fetch_parameters;
     bool m_main_resource { false };
+    bool m_speculative { false };
 };
 
 }
@@ -56,6 +56,8 @@ ResourceLoader::ResourceLoader(GC::Heap& heap, NonnullRefPtr<Requests::RequestCl
 {
 }
 
+static constexpr size_t max_dns_prefetched_hosts = 1024;
+
 void ResourceLoader::prefetch_dns(URL::URL const& url)
 {
     if (url.scheme().is_one_of("file"sv, "data"sv))
@@ -66,6 +68,18 @@ void ResourceLoader::prefetch_dns(URL::URL const& url)
         return;
     }
 
+    // NOTE: Pages tend to link to the same few hosts over and over, so only ask RequestServer about each of them once.
+    //       The set is bounded, as RequestServer's resolver cache eventually forgets the hosts anyway. It's kept in
+    //       order of use, so that the least recently linked host is the one that makes room for a new one.
+    auto host = url.serialized_host();
+    if (m_dns_prefetched_hosts.remove(host)) {
+        m_dns_prefetched_hosts.set(move(host));
+        return;
+    }
+    if (m_dns_prefetched_hosts.size() >= max_dns_prefetched_hosts)
+        (void)m_dns_prefetched_hosts.take_first();
+    m_dns_prefetched_hosts.set(move(host));
+
     m_request_client->ensure_connection(url, RequestServer::CacheLevel::ResolveOnly);
 }
 
@@ -407,6 +421,13 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
     }
 
     if (url.scheme() == "http" || url.scheme() == "https") {
+        if (request.is_speculative()) {
+            preload(request, success_callback, error_callback);
+            return;
+        }
+        if (adopt_preloaded_resource(request, PreloadedResource::BufferedWaiter { success_callback, error_callback }))
+            return;
+
         auto protocol_request = start_network_request(request);
         if (!protocol_request) {
             if (error_callback)
@@ -467,6 +488,184 @@ void ResourceLoader::load(LoadRequest& request, GC::Root<SuccessCallback> succes
     }
 }
 
+static constexpr size_t max_preloaded_resources = 128;
+
+// A speculative fetch that nothing adopted soon after it finished was most likely not needed. Handing it out any later
+// would serve a response that HTTP caching might no longer let us reuse.
+static constexpr auto preloaded_resource_lifetime = AK::Duration::from_seconds(10);
+
+Optional<ResourceLoader::PreloadKey> ResourceLoader::preload_key_for(LoadRequest const& request)
+{
+    if (!request.document_id().has_value() || !request.fetch_parameters().has_value())
+        return {};
+    if (request.method() != "GET"sv || !request.body().is_empty())
+        return {};
+
+    // Requests that only want part of the resource, revalidate it, or bypass caches have to go to the network.
+    for (auto const& header : request.headers()) {
+        if (header.key.is_one_of_ignoring_ascii_case("Range"sv, "Cache-Control"sv, "Pragma"sv) || header.key.starts_with("If-"sv, CaseSensitivity::CaseInsensitive))
+            return {};
+    }
+
+    auto url = request.url().value();
+    url.set_fragment({});
+
+    // NOTE: A response fetched for one mode, credentials mode or destination is never handed to another kind of request,
+    //       and the credentials are compared too, since they may have changed since the speculative fetch was made.
+    return PreloadKey {
+        .url = move(url),
+        .document_id = *request.document_id(),
+        .fetch_parameters = *request.fetch_parameters(),
+        .cookie = request.header("Cookie"),
+        .authorization = request.header("Authorization"),
+    };
+}
+
+void ResourceLoader::preload(LoadRequest& request, GC::Root<SuccessCallback> success_callback, GC::Root<ErrorCallback> error_callback)
+{
+    auto skip = [&](StringView reason) {
+        dbgln_if(CACHE_DEBUG, "ResourceLoader: Skipping speculative fetch for {}: {}", request.url().value(), reason);
+        if (error_callback)
+            error_callback->function()(ByteString { reason }, {}, {}, {}, {}, {});
+    };
+
+    auto key = preload_key_for(request);
+    if (!key.has_value())
+        return skip("Request can not be shared"sv);
+
+    remove_expired_preloaded_resources();
+    if (m_preloaded_resources.contains(*key))
+        return skip("Already fetched speculatively"sv);
+
+    // Speculative fetches that never get adopted must not accumulate forever, so make room by dropping the oldest
+    // finished one. If everything is still in flight, we're already busy enough and skip this one.
+    if (m_preloaded_resources.size() >= max_preloaded_resources) {
+        Optional<PreloadKey> key_to_evict;
+        for (auto const& [preloaded_key, preloaded_resource] : m_preloaded_resources) {
+            if (preloaded_resource->finished) {
+                key_to_evict = preloaded_key;
+                break;
+            }
+        }
+        if (!key_to_evict.has_value())
+            return skip("Too many speculative fetches in flight"sv);
+        m_preloaded_resources.remove(*key_to_evict);
+    }
+
+    dbgln_if(CACHE_DEBUG, "ResourceLoader: Starting speculative fetch for {}", key->url);
+
+    // NOTE: The Fetch that made the speculative request is told about the response like any later adopter.
+    auto preloaded_resource = adopt_ref(*new PreloadedResource);
+    preloaded_resource->waiters.append(PreloadedResource::BufferedWaiter { move(success_callback), move(error_callback) });
+
+    auto finish = [](PreloadedResource& preloaded_resource) {
+        preloaded_resource.finished = true;
+        preloaded_resource.finished_at = MonotonicTime::now_coarse();
+
+        // NOTE: A waiter's callback may spin a nested event loop, so detach the list before invoking anything.
+        auto waiters = move(preloaded_resource.waiters);
+        for (auto const& waiter : waiters)
+            preloaded_resource.deliver_to(waiter);
+    };
+
+    auto network_request = request;
+    network_request.set_speculative(false);
+
+    load(
+        network_request,
+        GC::create_function(m_heap, [preloaded_resource, finish](ReadonlyBytes data, Requests::RequestTimingInfo const& timing_info, HTTP::HeaderMap const& response_headers, Optional<u32> status_code, Optional<String> const& reason_phrase) {
+            preloaded_resource->succeeded = true;
+            preloaded_resource->data = ByteBuffer::copy(data).release_value_but_fixme_should_propagate_errors();
+            preloaded_resource->timing_info = timing_info;
+            preloaded_resource->response_headers = response_headers;
+            preloaded_resource->status_code = status_code;
+            preloaded_resource->reason_phrase = reason_phrase;
+            finish(*preloaded_resource);
+        }),
+        GC::create_function(m_heap, [preloaded_resource, finish](ByteString const& error, Requests::RequestTimingInfo const& timing_info, Optional<u32> status_code, Optional<String> const& reason_phrase, ReadonlyBytes data, HTTP::HeaderMap const& response_headers) {
+            preloaded_resource->error = error;
+            preloaded_resource->data = ByteBuffer::copy(data).release_value_but_fixme_should_propagate_errors();
+            preloaded_resource->timing_info = timing_info;
+            preloaded_resource->response_headers = response_headers;
+            preloaded_resource->status_code = status_code;
+            preloaded_resource->reason_phrase = reason_phrase;
+            finish(*preloaded_resource);
+        }));
+
+    // NOTE: This is registered after calling load(), so the speculative fetch does not adopt itself.
+    m_preloaded_resources.set(key.release_value(), move(preloaded_resource));
+}
+
+bool ResourceLoader::adopt_preloaded_resource(LoadRequest const& request, PreloadedResource::Waiter waiter)
+{
+    if (m_preloaded_resources.is_empty())
+        return false;
+
+    auto key = preload_key_for(request);
+    if (!key.has_value())
+        return false;
+
+    remove_expired_preloaded_resources();
+
+    auto preloaded_resource = m_preloaded_resources.take(*key);
+    if (!preloaded_resource.has_value())
+        return false;
+
+    dbgln_if(CACHE_DEBUG, "ResourceLoader: Adopting speculative fetch for {}", key->url);
+
+    if (!(*preloaded_resource)->finished) {
+        (*preloaded_resource)->waiters.append(move(waiter));
+        return true;
+    }
+
+    // NOTE: Callers expect network loads to complete asynchronously, even when the response is already here.
+    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(m_heap, [preloaded_resource = preloaded_resource.release_value(), waiter = move(waiter)] {
+        preloaded_resource->deliver_to(waiter);
+    }));
+    return true;
+}
+
+void ResourceLoader::remove_expired_preloaded_resources()
+{
+    auto now = MonotonicTime::now_coarse();
+    m_preloaded_resources.remove_all_matching([&](auto const&, auto const& preloaded_resource) {
+        return preloaded_resource->finished && now - preloaded_resource->finished_at > preloaded_resource_lifetime;
+    });
+}
+
+void ResourceLoader::discard_preloaded_resources(UniqueNodeID document_id)
+{
+    m_preloaded_resources.remove_all_matching([&](auto const& key, auto const&) {
+        return key.document_id == document_id;
+    });
+}
+
+void ResourceLoader::PreloadedResource::deliver_to(Waiter const& waiter) const
+{
+    waiter.visit(
+        [&](BufferedWaiter const& waiter) {
+            if (succeeded) {
+                waiter.success_callback->function()(data, timing_info, response_headers, status_code, reason_phrase);
+                return;
+            }
+
+            if (waiter.error_callback)
+                waiter.error_callback->function()(error, timing_info, status_code, reason_phrase, data, response_headers);
+        },
+        [&](UnbufferedWaiter const& waiter) {
+            // NOTE: A failed buffered load may still have received a response, which a streaming load would have seen.
+            if (succeeded || status_code.has_value())
+                waiter.on_headers_received->function()(response_headers, status_code, reason_phrase);
+            if (!data.is_empty())
+                waiter.on_data_received->function()(data);
+
+            if (succeeded)
+                waiter.on_complete->function()(true, timing_info, {});
+            else
+                waiter.on_complete->function()(false, timing_info, error.view());
+        });
+}
+
 void ResourceLoader::load_unbuffered(LoadRequest& request, GC::Root<OnHeadersReceived> on_headers_received, GC::Root<OnDataReceived> on_data_received, GC::Root<OnComplete> on_complete)
 {
     auto const& url = request.url().value();
@@ -485,6 +684,9 @@ void ResourceLoader::load_unbuffered(LoadRequest& request, GC::Root<OnHeadersRec
         return;
     }
 
+    if (adopt_preloaded_resource(request, PreloadedResource::UnbufferedWaiter { on_headers_received, on_data_received, on_complete }))
+        return;
+
     auto protocol_request = start_network_request(request);
     if (!protocol_request) {
         on_complete->function()(false, {}, "Failed to start network request"sv);
@@ -528,7 +730,7 @@ RefPtr<Requests::Request> ResourceLoader::start_network_request(LoadRequest cons
     if (!headers.contains("User-Agent"))
         headers.set("User-Agent", m_user_agent.to_byte_string());
 
-    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), headers, request.body(), proxy);
+    auto protocol_request = m_request_client->start_request(request.method(), request.url().value(), headers, request.body(), proxy, request.priority());
     if (!protocol_request) {
         log_failure(request, "Failed to initiate load"sv);
         return nullptr;
@@ -579,6 +781,7 @@ void ResourceLoader::clear_cache()
 {
     dbgln_if(CACHE_DEBUG, "Clearing {} items from ResourceLoader cache", s_resource_cache.size());
     s_resource_cache.clear();
+    m_preloaded_resources.clear();
 }
 
 void ResourceLoader::evict_from_cache(LoadRequest const& request)
@@ -9,9 +9,13 @@
 
 #include <AK/ByteString.h>
 #include <AK/Function.h>
+#include <AK/HashMap.h>
 #include <AK/HashTable.h>
+#include <AK/Variant.h>
 #include <LibCore/EventReceiver.h>
+#include <LibHTTP/HeaderMap.h>
 #include <LibRequests/Forward.h>
+#include <LibRequests/RequestTimingInfo.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Loader/Resource.h>
 #include <LibWeb/Loader/UserAgent.h>
@@ -38,6 +42,9 @@ public:
 
     void load_unbuffered(LoadRequest&, GC::Root<OnHeadersReceived>, GC::Root<OnDataReceived>, GC::Root<OnComplete>);
 
+    // Drops the speculative fetches of a document that is going away, so that nothing can adopt them later.
+    void discard_preloaded_resources(UniqueNodeID document_id);
+
     Requests::RequestClient& request_client() { return *m_request_client; }
 
     void prefetch_dns(URL::URL const&);
@@ -78,11 +85,70 @@ private:
     void handle_network_response_headers(LoadRequest const&, HTTP::HeaderMap const&);
     void finish_network_request(NonnullRefPtr<Requests::Request>);
 
+    struct PreloadKey {
+        URL::URL url;
+        UniqueNodeID document_id;
+        LoadRequest::FetchParameters fetch_parameters;
+        ByteString cookie;
+        ByteString authorization;
+
+        bool operator==(PreloadKey const&) const = default;
+    };
+
+    struct PreloadKeyTraits : public DefaultTraits<PreloadKey> {
+        static unsigned hash(PreloadKey const& key)
+        {
+            auto url_hash = Traits<URL::URL>::hash(key.url);
+            auto const& fetch_parameters = key.fetch_parameters;
+            auto destination = fetch_parameters.destination.has_value() ? to_underlying(*fetch_parameters.destination) + 1 : 0;
+            auto fetch_parameters_hash = pair_int_hash(pair_int_hash(to_underlying(fetch_parameters.mode), to_underlying(fetch_parameters.credentials_mode)), destination);
+            auto credentials_hash = pair_int_hash(key.cookie.hash(), key.authorization.hash());
+            return pair_int_hash(pair_int_hash(url_hash, u64_hash(key.document_id.value())), pair_int_hash(fetch_parameters_hash, credentials_hash));
+        }
+    };
+
+    static Optional<PreloadKey> preload_key_for(LoadRequest const&);
+
+    struct PreloadedResource : public RefCounted<PreloadedResource> {
+        struct BufferedWaiter {
+            GC::Root<SuccessCallback> success_callback;
+            GC::Root<ErrorCallback> error_callback;
+        };
+        struct UnbufferedWaiter {
+            GC::Root<OnHeadersReceived> on_headers_received;
+            GC::Root<OnDataReceived> on_data_received;
+            GC::Root<OnComplete> on_complete;
+        };
+        using Waiter = Variant<BufferedWaiter, UnbufferedWaiter>;
+
+        void deliver_to(Waiter const&) const;
+
+        bool finished { false };
+        MonotonicTime finished_at { MonotonicTime::now_coarse() };
+        bool succeeded { false };
+        ByteBuffer data;
+        ByteString error;
+        Requests::RequestTimingInfo timing_info;
+        HTTP::HeaderMap response_headers;
+        Optional<u32> status_code;
+        Optional<String> reason_phrase;
+        Vector<Waiter> waiters;
+    };
+
+    // Starts a speculative fetch for a resource the HTML preload scanner expects to be requested soon. The next GET for
+    // the same URL from the same document, made by Fetch with the same mode, credentials mode, destination and
+    // credentials, adopts the in-flight (or recently finished) response instead of going to the network.
+    void preload(LoadRequest&, GC::Root<SuccessCallback>, GC::Root<ErrorCallback>);
+    bool adopt_preloaded_resource(LoadRequest const&, PreloadedResource::Waiter);
+    void remove_expired_preloaded_resources();
+
     int m_pending_loads { 0 };
 
     GC::Heap& m_heap;
     NonnullRefPtr<Requests::RequestClient> m_request_client;
     HashTable<NonnullRefPtr<Requests::Request>> m_active_requests;
+    OrderedHashMap<PreloadKey, NonnullRefPtr<PreloadedResource>, PreloadKeyTraits> m_preloaded_resources;
+    OrderedHashTable<String> m_dns_prefetched_hosts;
 
     String m_user_agent;
     String m_platform;
@@ -4,35 +4,105 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BinarySearch.h>
 #include <LibWeb/Painting/DisplayList.h>
 
 namespace Web::Painting {
 
+DisplayList::~DisplayList()
+{
+    for_each_entry(0, end_offset(), [](CommandOffset, CommandHeader const& header) {
+        visit_entry(header, []<typename CommandType>(CommandType const& command) {
+            command.~CommandType();
+        });
+    });
+}
+
 void DisplayList::append(Command&& command, Optional<i32> scroll_frame_id)
 {
-    m_commands.append({ scroll_frame_id, move(command) });
+    command.visit([&](auto& command) { append(move(command), scroll_frame_id); });
 }
 
-static Optional<Gfx::IntRect> command_bounding_rectangle(Command const& command)
+void DisplayList::append_commands_from(DisplayList const& other, CommandOffset begin, CommandOffset end)
 {
-    return command.visit(
-        [&](auto const& command) -> Optional<Gfx::IntRect> {
-            if constexpr (requires { command.bounding_rect(); })
-                return command.bounding_rect();
-            else
-                return {};
-        });
+    other.for_each_command([&](Optional<i32> scroll_frame_id, auto const& command) {
+        append(command, scroll_frame_id);
+    },
+        begin, end);
 }
 
-static bool command_is_clip_or_mask(Command const& command)
+DisplayList::CommandOffset DisplayList::end_offset() const
 {
-    return command.visit(
-        [&](auto const& command) -> bool {
-            if constexpr (requires { command.is_clip_or_mask(); })
-                return command.is_clip_or_mask();
-            else
-                return false;
-        });
+    if (m_blocks.is_empty())
+        return 0;
+    return (m_blocks.size() - 1) * max_block_size + m_blocks.last()->used_size;
+}
+
+Optional<DisplayList::CommandOffset> DisplayList::offset_of_enclosing_state_group_end(CommandOffset offset) const
+{
+    auto const* clip_or_mask = binary_search(m_clips_and_masks, offset, nullptr, [](CommandOffset offset, ClipOrMask const& clip_or_mask) {
+        if (offset > clip_or_mask.offset)
+            return 1;
+        if (offset < clip_or_mask.offset)
+            return -1;
+        return 0;
+    });
+    if (!clip_or_mask)
+        return {};
+    return m_state_group_ends[clip_or_mask->state_group];
+}
+
+size_t DisplayList::enclosing_state_group()
+{
+    auto& state_group = m_open_state_groups.is_empty() ? m_top_level_state_group : m_open_state_groups.last();
+    if (!state_group.has_value()) {
+        state_group = m_state_group_ends.size();
+        m_state_group_ends.append({});
+    }
+    return *state_group;
+}
+
+void DisplayList::close_state_group(CommandOffset offset)
+{
+    Optional<size_t> state_group;
+    if (!m_open_state_groups.is_empty())
+        state_group = m_open_state_groups.take_last();
+    else
+        state_group = exchange(m_top_level_state_group, {});
+
+    if (state_group.has_value())
+        m_state_group_ends[*state_group] = offset;
+}
+
+DisplayList::CommandHeader* DisplayList::allocate_entry(size_t entry_size)
+{
+    if (m_blocks.is_empty() || m_blocks.last()->used_size + entry_size > m_blocks.last()->capacity) {
+        auto capacity = m_blocks.is_empty() ? first_block_size : min(m_blocks.last()->capacity * 2, max_block_size);
+        m_blocks.append(make<Block>(max(capacity, entry_size)));
+    }
+
+    auto& block = *m_blocks.last();
+    auto* header = new (block.data + block.used_size) CommandHeader;
+    block.used_size += entry_size;
+    return header;
+}
+
+template<typename CommandType>
+static Optional<Gfx::IntRect> command_bounding_rectangle(CommandType const& command)
+{
+    if constexpr (requires { command.bounding_rect(); })
+        return command.bounding_rect();
+    else
+        return {};
+}
+
+template<typename CommandType>
+static bool command_is_clip_or_mask(CommandType const& command)
+{
+    if constexpr (requires { command.is_clip_or_mask(); })
+        return command.is_clip_or_mask();
+    else
+        return false;
 }
 
 void DisplayListPlayer::execute(DisplayList& display_list, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface> surface)
@@ -55,55 +125,53 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
             (void)surfaces.take_last();
     };
 
-    auto const& commands = display_list.commands();
     auto device_pixels_per_css_pixel = display_list.device_pixels_per_css_pixel();
 
     VERIFY(!m_surfaces.is_empty());
 
-    for (size_t command_index = 0; command_index < commands.size(); command_index++) {
-        auto scroll_frame_id = commands[command_index].scroll_frame_id;
-        auto command = commands[command_index].command;
+    display_list.for_each_command_with_skipping([&]<typename CommandType>(DisplayList::CommandOffset offset, Optional<i32> scroll_frame_id, CommandType const& recorded_command) -> Optional<DisplayList::CommandOffset> {
+        auto command = recorded_command;
 
-        if (command.has<PaintScrollBar>()) {
-            auto& paint_scroll_bar = command.get<PaintScrollBar>();
-            auto scroll_offset = scroll_state.own_offset_for_frame_with_id(paint_scroll_bar.scroll_frame_id);
-            if (paint_scroll_bar.vertical) {
-                auto offset = scroll_offset.y() * paint_scroll_bar.scroll_size;
-                paint_scroll_bar.thumb_rect.translate_by(0, -offset.to_int() * device_pixels_per_css_pixel);
+        if constexpr (IsSame<CommandType, PaintScrollBar>) {
+            auto scroll_offset = scroll_state.own_offset_for_frame_with_id(command.scroll_frame_id);
+            if (command.vertical) {
+                auto offset = scroll_offset.y() * command.scroll_size;
+                command.thumb_rect.translate_by(0, -offset.to_int() * device_pixels_per_css_pixel);
             } else {
-                auto offset = scroll_offset.x() * paint_scroll_bar.scroll_size;
-                paint_scroll_bar.thumb_rect.translate_by(-offset.to_int() * device_pixels_per_css_pixel, 0);
+                auto offset = scroll_offset.x() * command.scroll_size;
+                command.thumb_rect.translate_by(-offset.to_int() * device_pixels_per_css_pixel, 0);
             }
         }
 
         if (scroll_frame_id.has_value()) {
             auto cumulative_offset = scroll_state.cumulative_offset_for_frame_with_id(scroll_frame_id.value());
             auto scroll_offset = cumulative_offset.to_type<double>().scaled(device_pixels_per_css_pixel).to_type<int>();
-            command.visit(
-                [&](auto& command) {
-                    if constexpr (requires { command.translate_by(scroll_offset); }) {
-                        command.translate_by(scroll_offset);
-                    }
-                });
+            if constexpr (requires { command.translate_by(scroll_offset); })
+                command.translate_by(scroll_offset);
         }
 
         auto bounding_rect = command_bounding_rectangle(command);
         if (bounding_rect.has_value() && (bounding_rect->is_empty() || would_be_fully_clipped_by_painter(*bounding_rect))) {
-            // Any clip or mask that's located outside of the visible region is equivalent to a simple clip-rect,
-            // so replace it with one to avoid doing unnecessary work.
             if (command_is_clip_or_mask(command)) {
-                if (command.has<AddClipRect>()) {
-                    add_clip_rect(command.get<AddClipRect>());
+                // OPTIMIZATION: Nothing painted after a clip or mask that's located outside of the visible region
+                //               can show up until the state it was applied to is restored, so skip straight to
+                //               that point instead of culling the commands in between one by one.
+                if (auto group_end_offset = display_list.offset_of_enclosing_state_group_end(offset); group_end_offset.has_value())
+                    return group_end_offset;
+
+                // Otherwise, it's equivalent to a simple clip-rect, so replace it with one to avoid doing unnecessary work.
+                if constexpr (IsSame<CommandType, AddClipRect>) {
+                    add_clip_rect(command);
                 } else {
                     add_clip_rect({ bounding_rect.release_value() });
                 }
             }
-            continue;
+            return {};
         }
 
-#define HANDLE_COMMAND(command_type, executor_method) \
-    if (command.has<command_type>()) {                \
-        executor_method(command.get<command_type>()); \
+#define HANDLE_COMMAND(command_type, executor_method)  \
+    if constexpr (IsSame<CommandType, command_type>) { \
+        executor_method(command);                      \
     }
 
         // clang-format off
@@ -145,9 +213,13 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
         else HANDLE_COMMAND(ApplyFilters, apply_filters)
         else HANDLE_COMMAND(ApplyTransform, apply_transform)
         else HANDLE_COMMAND(ApplyMaskBitmap, apply_mask_bitmap)
-        else VERIFY_NOT_REACHED();
+        else static_assert(DependentFalse<CommandType>);
         // clang-format on
-    }
+
+#undef HANDLE_COMMAND
+
+        return {};
+    });
 
     if (surface)
         flush();
@@ -8,8 +8,10 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
-#include <AK/SegmentedVector.h>
+#include <AK/TypeList.h>
+#include <AK/Vector.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/Forward.h>
 #include <LibGfx/ImmutableBitmap.h>
@@ -77,6 +79,27 @@ private:
     Vector<NonnullRefPtr<Gfx::PaintingSurface>, 1> m_surfaces;
 };
 
+template<typename>
+struct CommandTypeListFor;
+
+template<typename... Ts>
+struct CommandTypeListFor<Variant<Ts...>> {
+    using Type = TypeList<Ts...>;
+
+    template<typename T>
+    static consteval u8 index_of()
+    {
+        u8 index = 0;
+        bool found = false;
+        ((found = found || IsSame<T, Ts>, index += found ? 0 : 1), ...);
+        return index;
+    }
+};
+
+// Commands are stored back to back in a packed byte buffer instead of as a list of Command variants, so that each
+// one only takes up as much space as its own type needs. The buffer is made up of blocks that never move once
+// allocated, which lets the commands keep their (possibly ref-counted) members in place. Blocks start out small and
+// double in size as more are needed, so the many small lists (cached fragments, masks, nested lists) stay small.
 class DisplayList : public AtomicRefCounted<DisplayList> {
 public:
     static NonnullRefPtr<DisplayList> create()
@@ -84,14 +107,85 @@ public:
         return adopt_ref(*new DisplayList());
     }
 
+    ~DisplayList();
+
     void append(Command&& command, Optional<i32> scroll_frame_id);
 
-    struct CommandListItem {
-        Optional<i32> scroll_frame_id;
-        Command command;
-    };
+    template<typename T>
+    void append(T&& command, Optional<i32> scroll_frame_id)
+    requires(CommandTypeListFor<Command>::Type::size > CommandTypeListFor<Command>::index_of<RemoveCVReference<T>>())
+    {
+        using CommandType = RemoveCVReference<T>;
+        static_assert(alignof(CommandType) <= command_alignment);
+
+        constexpr auto payload_offset = align_up_to(sizeof(CommandHeader), alignof(CommandType));
+        constexpr auto entry_size = align_up_to(payload_offset + sizeof(CommandType), command_alignment);
+        static_assert(entry_size <= max_block_size);
+
+        auto* header = allocate_entry(entry_size);
+        header->type = CommandTypeListFor<Command>::index_of<CommandType>();
+        header->has_scroll_frame_id = scroll_frame_id.has_value();
+        header->size = entry_size;
+        header->scroll_frame_id = scroll_frame_id.value_or(0);
+        new (reinterpret_cast<u8*>(header) + payload_offset) CommandType(forward<T>(command));
+        ++m_command_count;
+
+        auto offset = end_offset() - entry_size;
+        if constexpr (state_group_depth_change<CommandType>() > 0)
+            m_open_state_groups.append({});
+        else if constexpr (state_group_depth_change<CommandType>() < 0)
+            close_state_group(offset);
+        else if constexpr (requires(CommandType const& command) { command.is_clip_or_mask(); })
+            m_clips_and_masks.append({ offset, enclosing_state_group() });
+    }
+
+    // Save, SaveLayer, PushStackingContext and friends open a state group, and Restore and PopStackingContext close one.
+    template<typename CommandType>
+    static constexpr int state_group_depth_change()
+    {
+        if constexpr (IsOneOf<CommandType, Save, SaveLayer, PushStackingContext, ApplyOpacity, ApplyCompositeAndBlendingOperator, ApplyFilters>)
+            return 1;
+        else if constexpr (IsOneOf<CommandType, Restore, PopStackingContext>)
+            return -1;
+        else
+            return 0;
+    }
+
+    // A position in the command buffer. Offsets only ever grow as commands are appended, so a pair of them taken
+    // before and after recording something delimits exactly the commands that were recorded in between.
+    using CommandOffset = size_t;
+
+    CommandOffset end_offset() const;
+    size_t command_count() const { return m_command_count; }
+
+    // Invokes the callback with (Optional<i32> scroll_frame_id, CommandType const&) for every command in the range.
+    template<typename Callback>
+    void for_each_command(Callback&& callback, CommandOffset begin = 0, Optional<CommandOffset> end = {}) const
+    {
+        for_each_entry(begin, end.value_or(end_offset()), [&](CommandOffset, CommandHeader const& header) {
+            visit_entry(header, [&](auto const& command) { callback(scroll_frame_id_of(header), command); });
+        });
+    }
 
-    AK::SegmentedVector<CommandListItem, 512> const& commands() const { return m_commands; }
+    // Like for_each_command(), but the callback also receives the offset of each command, and returns an
+    // Optional<CommandOffset> of a later command to skip ahead to.
+    template<typename Callback>
+    void for_each_command_with_skipping(Callback&& callback) const
+    {
+        for_each_entry(0, end_offset(), [&](CommandOffset offset, CommandHeader const& header) {
+            Optional<CommandOffset> resume_offset;
+            visit_entry(header, [&](auto const& command) { resume_offset = callback(offset, scroll_frame_id_of(header), command); });
+            return resume_offset;
+        });
+    }
+
+    // Given the offset of a clip or mask command, returns the offset of the first command after it that closes a state
+    // group (a Restore or PopStackingContext) which was opened before it, if there is one. Skipping everything in
+    // between leaves the painter in the same state once that command has been executed.
+    Optional<CommandOffset> offset_of_enclosing_state_group_end(CommandOffset) const;
+
+    // Copies the commands in the given range of another display list to the end of this one.
+    void append_commands_from(DisplayList const&, CommandOffset begin, CommandOffset end);
 
     void set_device_pixels_per_css_pixel(double device_pixels_per_css_pixel) { m_device_pixels_per_css_pixel = device_pixels_per_css_pixel; }
     double device_pixels_per_css_pixel() const { return m_device_pixels_per_css_pixel; }
@@ -99,7 +193,123 @@ public:
 private:
     DisplayList() = default;
 
-    AK::SegmentedVector<CommandListItem, 512> m_commands;
+    struct CommandHeader {
+        u8 type { 0 };
+        bool has_scroll_frame_id { false };
+        u16 size { 0 };
+        i32 scroll_frame_id { 0 };
+    };
+    static_assert(sizeof(CommandHeader) == 8);
+
+    static constexpr size_t first_block_size = 512;
+    // Offsets address block N at N * max_block_size, whatever the size of the blocks before it.
+    static constexpr size_t max_block_size = 32 * KiB;
+    // Every entry starts at a multiple of this, so the payload of any command type can directly follow its header.
+    static constexpr size_t command_alignment = 16;
+
+    struct Block {
+        AK_MAKE_NONCOPYABLE(Block);
+        AK_MAKE_NONMOVABLE(Block);
+
+    public:
+        explicit Block(size_t capacity)
+            : data(static_cast<u8*>(kmalloc(capacity)))
+            , capacity(capacity)
+        {
+            // NOTE: malloc() aligns for any fundamental type, which is all any command type needs.
+            VERIFY(data && reinterpret_cast<FlatPtr>(data) % command_alignment == 0);
+        }
+
+        ~Block() { kfree_sized(data, capacity); }
+
+        u8* data { nullptr };
+        size_t capacity { 0 };
+        size_t used_size { 0 };
+    };
+
+    static constexpr size_t align_up_to(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    CommandHeader* allocate_entry(size_t entry_size);
+
+    template<typename Callback>
+    void for_each_entry(CommandOffset begin, CommandOffset end, Callback&& callback) const
+    {
+        auto block_index = begin / max_block_size;
+        auto offset_in_block = begin % max_block_size;
+        while (block_index < m_blocks.size() && block_index * max_block_size + offset_in_block < end) {
+            auto const& block = *m_blocks[block_index];
+            if (offset_in_block >= block.used_size) {
+                ++block_index;
+                offset_in_block = 0;
+                continue;
+            }
+            auto const& header = *reinterpret_cast<CommandHeader const*>(block.data + offset_in_block);
+            if constexpr (IsSame<decltype(callback(begin, header)), void>) {
+                callback(block_index * max_block_size + offset_in_block, header);
+            } else {
+                if (auto resume_offset = callback(block_index * max_block_size + offset_in_block, header); resume_offset.has_value()) {
+                    block_index = *resume_offset / max_block_size;
+                    offset_in_block = *resume_offset % max_block_size;
+                    continue;
+                }
+            }
+            offset_in_block += header.size;
+        }
+    }
+
+    static Optional<i32> scroll_frame_id_of(CommandHeader const& header)
+    {
+        if (header.has_scroll_frame_id)
+            return header.scroll_frame_id;
+        return {};
+    }
+
+    template<size_t Index, typename Callback>
+    static void visit_entry_as(CommandHeader const& header, Callback& callback)
+    {
+        using CommandType = typename CommandTypeListFor<Command>::Type::template Type<Index>;
+        constexpr auto payload_offset = align_up_to(sizeof(CommandHeader), alignof(CommandType));
+        callback(*reinterpret_cast<CommandType const*>(reinterpret_cast<u8 const*>(&header) + payload_offset));
+    }
+
+    // Dispatches through a table indexed by the command type, rather than comparing the type against each candidate.
+    template<typename Callback, size_t... Indices>
+    static void visit_entry_impl(CommandHeader const& header, Callback& callback, IndexSequence<Indices...>)
+    {
+        using Visitor = void (*)(CommandHeader const&, Callback&);
+        static constexpr Visitor visitors[] = { &visit_entry_as<Indices, Callback>... };
+        VERIFY(header.type < sizeof...(Indices));
+        visitors[header.type](header, callback);
+    }
+
+    template<typename Callback>
+    static void visit_entry(CommandHeader const& header, Callback&& callback)
+    {
+        visit_entry_impl(header, callback, MakeIndexSequence<CommandTypeListFor<Command>::Type::size> {});
+    }
+
+    size_t enclosing_state_group();
+    void close_state_group(CommandOffset);
+
+    Vector<NonnullOwnPtr<Block>> m_blocks;
+    size_t m_command_count { 0 };
+
+    // The group ends are recorded as commands are appended, so the player can look them up instead of scanning ahead.
+    // Only groups that contain a clip or mask get an entry in m_state_group_ends.
+    struct ClipOrMask {
+        CommandOffset offset { 0 };
+        size_t state_group { 0 };
+    };
+    Vector<ClipOrMask> m_clips_and_masks;
+    Vector<Optional<CommandOffset>> m_state_group_ends;
+    // The groups that are still open, innermost last.
+    Vector<Optional<size_t>> m_open_state_groups;
+    // Commands outside of any group are enclosed by whatever group this list is played back in. That group ends at the
+    // first Restore or PopStackingContext that doesn't close a group of this list.
+    Optional<size_t> m_top_level_state_group;
     double m_device_pixels_per_css_pixel;
 };
 
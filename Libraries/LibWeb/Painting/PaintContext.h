@@ -83,6 +83,14 @@ public:
 
     u64 paint_generation_id() const { return m_paint_generation_id; }
 
+    // When set, stacking contexts reuse the commands they recorded for an earlier display list of the same
+    // generation. Contexts that record into a separate display list (e.g. for masks) leave this unset.
+    Optional<u64> stacking_context_cache_generation() const { return m_stacking_context_cache_generation; }
+    void set_stacking_context_cache_generation(u64 generation) { m_stacking_context_cache_generation = generation; }
+
+    size_t reused_command_count() const { return m_reused_command_count; }
+    void add_reused_command_count(size_t count) { m_reused_command_count += count; }
+
 private:
     Painting::DisplayListRecorder& m_display_list_recorder;
     Palette m_palette;
@@ -94,6 +102,8 @@ private:
     bool m_draw_svg_geometry_for_clip_path { false };
     Gfx::AffineTransform m_svg_transform;
     u64 m_paint_generation_id { 0 };
+    Optional<u64> m_stacking_context_cache_generation;
+    size_t m_reused_command_count { 0 };
 };
 
 }
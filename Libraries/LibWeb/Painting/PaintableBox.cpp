@@ -1252,7 +1252,10 @@ TraversalDecision PaintableWithLines::hit_test(CSSPixelPoint position, HitTestTy
 
 void PaintableBox::set_needs_display(InvalidateDisplayList should_invalidate_display_list)
 {
-    document().set_needs_display(absolute_rect(), should_invalidate_display_list);
+    auto& document = this->document();
+    if (should_invalidate_display_list == InvalidateDisplayList::Yes)
+        document.invalidate_display_list_for(*this);
+    document.set_needs_display(absolute_rect(), InvalidateDisplayList::No);
 }
 
 Optional<CSSPixelRect> PaintableBox::get_masking_area() const
@@ -301,6 +301,74 @@ static Gfx::FloatMatrix4x4 matrix_with_scaled_translation(Gfx::FloatMatrix4x4 ma
 }
 
 void StackingContext::paint(PaintContext& context) const
+{
+    auto cache_generation = context.stacking_context_cache_generation();
+    if (!cache_generation.has_value()) {
+        paint_uncached(context);
+        return;
+    }
+
+    // OPTIMIZATION: Stacking contexts in which nothing changed since the last time they were painted replay the
+    //               commands they recorded back then, instead of walking their paintables again.
+    auto& display_list = context.display_list_recorder().display_list();
+    auto begin_offset = display_list.end_offset();
+    auto first_command_index = display_list.command_count();
+    if (m_cached_display_list_fragment.has_value() && m_cached_display_list_fragment->generation == *cache_generation) {
+        replay_cached_display_list_fragment(display_list);
+        context.add_reused_command_count(display_list.command_count() - first_command_index);
+    } else {
+        m_child_fragments_being_recorded = Vector<ChildFragment> {};
+        paint_uncached(context);
+        record_cached_display_list_fragment(display_list, begin_offset, *cache_generation);
+    }
+
+    if (m_parent && m_parent->m_child_fragments_being_recorded.has_value()) {
+        m_parent->m_child_fragments_being_recorded->append({
+            .begin_offset = begin_offset,
+            .end_offset = display_list.end_offset(),
+            .child = this,
+        });
+    }
+}
+
+void StackingContext::record_cached_display_list_fragment(DisplayList const& display_list, DisplayList::CommandOffset begin_offset, u64 generation) const
+{
+    auto child_fragments = m_child_fragments_being_recorded.release_value();
+
+    CachedDisplayListFragment fragment { .generation = generation, .commands = DisplayList::create() };
+
+    auto offset = begin_offset;
+    for (auto& child_fragment : child_fragments) {
+        fragment.commands->append_commands_from(display_list, offset, child_fragment.begin_offset);
+        offset = child_fragment.end_offset;
+        child_fragment.begin_offset = child_fragment.end_offset = fragment.commands->end_offset();
+        fragment.children.append(child_fragment);
+    }
+    fragment.commands->append_commands_from(display_list, offset, display_list.end_offset());
+
+    m_cached_display_list_fragment = move(fragment);
+}
+
+void StackingContext::replay_cached_display_list_fragment(DisplayList& display_list) const
+{
+    auto const& fragment = *m_cached_display_list_fragment;
+
+    DisplayList::CommandOffset offset = 0;
+    for (auto const& child_fragment : fragment.children) {
+        display_list.append_commands_from(*fragment.commands, offset, child_fragment.begin_offset);
+        offset = child_fragment.begin_offset;
+        child_fragment.child->replay_cached_display_list_fragment(display_list);
+    }
+    display_list.append_commands_from(*fragment.commands, offset, fragment.commands->end_offset());
+}
+
+void StackingContext::invalidate_cached_display_list_fragment()
+{
+    for (auto* stacking_context = this; stacking_context; stacking_context = stacking_context->parent())
+        stacking_context->m_cached_display_list_fragment.clear();
+}
+
+void StackingContext::paint_uncached(PaintContext& context) const
 {
     auto opacity = paintable_box().computed_values().opacity();
     if (opacity == 0.0f)
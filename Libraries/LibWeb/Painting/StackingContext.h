@@ -8,6 +8,7 @@
 
 #include <AK/Vector.h>
 #include <LibGfx/Matrix4x4.h>
+#include <LibWeb/Painting/DisplayList.h>
 #include <LibWeb/Painting/Paintable.h>
 
 namespace Web::Painting {
@@ -46,6 +47,9 @@ public:
 
     void set_last_paint_generation_id(u64 generation_id);
 
+    // Drops the commands cached for this stacking context and its ancestors, which all contain them.
+    void invalidate_cached_display_list_fragment();
+
 private:
     GC::Ref<PaintableBox> m_paintable;
     StackingContext* const m_parent { nullptr };
@@ -58,6 +62,28 @@ private:
 
     static void paint_child(PaintContext&, StackingContext const&);
     void paint_internal(PaintContext&) const;
+    void paint_uncached(PaintContext&) const;
+
+    struct ChildFragment {
+        // Offsets into the commands of the parent's fragment, or into the display list while it's being recorded.
+        DisplayList::CommandOffset begin_offset { 0 };
+        DisplayList::CommandOffset end_offset { 0 };
+        StackingContext const* child { nullptr };
+    };
+
+    // The commands this stacking context recorded the last time it was painted. The commands of child stacking
+    // contexts are not copied in; they're replayed from the children's own fragments.
+    struct CachedDisplayListFragment {
+        u64 generation { 0 };
+        NonnullRefPtr<DisplayList> commands;
+        Vector<ChildFragment> children;
+    };
+
+    void record_cached_display_list_fragment(DisplayList const&, DisplayList::CommandOffset begin_offset, u64 generation) const;
+    void replay_cached_display_list_fragment(DisplayList&) const;
+
+    mutable Optional<CachedDisplayListFragment> m_cached_display_list_fragment;
+    mutable Optional<Vector<ChildFragment>> m_child_fragments_being_recorded;
 };
 
 }
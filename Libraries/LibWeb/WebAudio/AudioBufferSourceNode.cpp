@@ -130,7 +130,10 @@ WebIDL::ExceptionOr<void> AudioBufferSourceNode::start(Optional<double> when, Op
     // 3. Set the internal slot [[source started]] on this AudioBufferSourceNode to true.
     set_source_started(true);
 
-    // FIXME: 4. Queue a control message to start the AudioBufferSourceNode, including the parameter values in the message.
+    // 4. Queue a control message to start the AudioBufferSourceNode, including the parameter values in the message.
+    // FIXME: Pass the offset and duration along once the buffer is actually played.
+    schedule_start(when.value_or(0));
+
     // FIXME: 5. Acquire the contents of the buffer if the buffer has been set.
     // FIXME: 6. Send a control message to the associated AudioContext to start running its rendering thread only when all the following conditions are met:
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/EventLoop.h>
 #include <LibWeb/Bindings/AudioContextPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/DOM/Event.h>
@@ -18,6 +19,11 @@
 
 namespace Web::WebAudio {
 
+// The contexts waiting for their playback stream to start, by the ID of the start. Only the ID crosses over to the
+// audio thread, and it's looked up here once back on the main thread.
+static HashMap<u64, AudioContext*> s_contexts_awaiting_rendering_start;
+static u64 s_next_rendering_start_id { 0 };
+
 GC_DEFINE_ALLOCATOR(AudioContext);
 
 // https://webaudio.github.io/web-audio-api/#dom-audiocontext-audiocontext
@@ -90,18 +96,23 @@ WebIDL::ExceptionOr<GC::Ref<AudioContext>> AudioContext::construct_impl(JS::Real
     // FIXME: Implement control message queue to run following steps on the rendering thread
     if (context->m_allowed_to_start) {
         // FIXME: 1. Let document be the current settings object's relevant global object's associated Document.
-        // FIXME: 2. Attempt to acquire system resources to use a following audio output device based on [[sink ID]] for rendering
-
-        // 2. Set this [[rendering thread state]] to running on the AudioContext.
-        context->set_rendering_state(Bindings::AudioContextState::Running);
-
-        // 3. Queue a media element task to execute the following steps:
-        context->queue_a_media_element_task(GC::create_function(context->heap(), [&realm, context]() {
-            // 1. Set the state attribute of the AudioContext to "running".
-            context->set_control_state(Bindings::AudioContextState::Running);
-
-            // 2. Fire an event named statechange at the AudioContext.
-            context->dispatch_event(DOM::Event::create(realm, HTML::EventNames::statechange));
+        // 2. Attempt to acquire system resources to use a following audio output device based on [[sink ID]] for rendering
+        context->start_rendering_audio_graph(GC::create_function(context->heap(), [&realm, context](bool started) {
+            // In case of failure, abort the following steps.
+            if (!started)
+                return;
+
+            // 2. Set this [[rendering thread state]] to running on the AudioContext.
+            context->set_rendering_state(Bindings::AudioContextState::Running);
+
+            // 3. Queue a media element task to execute the following steps:
+            context->queue_a_media_element_task(GC::create_function(context->heap(), [&realm, context]() {
+                // 1. Set the state attribute of the AudioContext to "running".
+                context->set_control_state(Bindings::AudioContextState::Running);
+
+                // 2. Fire an event named statechange at the AudioContext.
+                context->dispatch_event(DOM::Event::create(realm, HTML::EventNames::statechange));
+            }));
         }));
     }
 
@@ -121,6 +132,14 @@ void AudioContext::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_pending_resume_promises);
+    visitor.visit(m_pending_rendering_starts);
+}
+
+void AudioContext::finalize()
+{
+    Base::finalize();
+    for (auto id : m_pending_rendering_starts.keys())
+        s_contexts_awaiting_rendering_start.remove(id);
 }
 
 // https://www.w3.org/TR/webaudio/#dom-audiocontext-getoutputtimestamp
@@ -170,52 +189,55 @@ WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> AudioContext::resume()
     set_rendering_state(Bindings::AudioContextState::Running);
 
     // 7.3: Start rendering the audio graph.
-    if (!start_rendering_audio_graph()) {
+    start_rendering_audio_graph(GC::create_function(heap(), [&realm, promise, this](bool started) {
         // 7.4: In case of failure, queue a media element task to execute the following steps:
-        queue_a_media_element_task(GC::create_function(heap(), [&realm, this]() {
-            HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+        if (!started) {
+            queue_a_media_element_task(GC::create_function(heap(), [&realm, this]() {
+                HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+
+                // 7.4.1: Reject all promises from [[pending resume promises]] in order, then clear [[pending resume promises]].
+                for (auto const& promise : m_pending_resume_promises) {
+                    WebIDL::reject_promise(realm, promise, JS::js_null());
+
+                    // 7.4.2: Additionally, remove those promises from [[pending promises]].
+                    m_pending_promises.remove_first_matching([&promise](auto& pending_promise) {
+                        return pending_promise == promise;
+                    });
+                }
+                m_pending_resume_promises.clear();
+            }));
+            return;
+        }
 
-            // 7.4.1: Reject all promises from [[pending resume promises]] in order, then clear [[pending resume promises]].
-            for (auto const& promise : m_pending_resume_promises) {
-                WebIDL::reject_promise(realm, promise, JS::js_null());
+        // 7.5: queue a media element task to execute the following steps:
+        queue_a_media_element_task(GC::create_function(heap(), [&realm, promise, this]() {
+            HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
 
-                // 7.4.2: Additionally, remove those promises from [[pending promises]].
-                m_pending_promises.remove_first_matching([&promise](auto& pending_promise) {
-                    return pending_promise == promise;
+            // 7.5.1: Resolve all promises from [[pending resume promises]] in order.
+            // 7.5.2: Clear [[pending resume promises]]. Additionally, remove those promises from
+            //        [[pending promises]].
+            for (auto const& pending_resume_promise : m_pending_resume_promises) {
+                WebIDL::resolve_promise(realm, pending_resume_promise, JS::js_undefined());
+                m_pending_promises.remove_first_matching([&pending_resume_promise](auto& pending_promise) {
+                    return pending_promise == pending_resume_promise;
                 });
             }
             m_pending_resume_promises.clear();
-        }));
-    }
-
-    // 7.5: queue a media element task to execute the following steps:
-    queue_a_media_element_task(GC::create_function(heap(), [&realm, promise, this]() {
-        HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
 
-        // 7.5.1: Resolve all promises from [[pending resume promises]] in order.
-        // 7.5.2: Clear [[pending resume promises]]. Additionally, remove those promises from
-        //        [[pending promises]].
-        for (auto const& pending_resume_promise : m_pending_resume_promises) {
-            WebIDL::resolve_promise(realm, pending_resume_promise, JS::js_undefined());
-            m_pending_promises.remove_first_matching([&pending_resume_promise](auto& pending_promise) {
-                return pending_promise == pending_resume_promise;
-            });
-        }
-        m_pending_resume_promises.clear();
+            // 7.5.3: Resolve promise.
+            WebIDL::resolve_promise(realm, promise, JS::js_undefined());
 
-        // 7.5.3: Resolve promise.
-        WebIDL::resolve_promise(realm, promise, JS::js_undefined());
+            // 7.5.4: If the state attribute of the AudioContext is not already "running":
+            if (state() != Bindings::AudioContextState::Running) {
+                // 7.5.4.1: Set the state attribute of the AudioContext to "running".
+                set_control_state(Bindings::AudioContextState::Running);
 
-        // 7.5.4: If the state attribute of the AudioContext is not already "running":
-        if (state() != Bindings::AudioContextState::Running) {
-            // 7.5.4.1: Set the state attribute of the AudioContext to "running".
-            set_control_state(Bindings::AudioContextState::Running);
-
-            // 7.5.4.2: queue a media element task to fire an event named statechange at the AudioContext.
-            queue_a_media_element_task(GC::create_function(heap(), [&realm, this]() {
-                this->dispatch_event(DOM::Event::create(realm, HTML::EventNames::statechange));
-            }));
-        }
+                // 7.5.4.2: queue a media element task to fire an event named statechange at the AudioContext.
+                queue_a_media_element_task(GC::create_function(heap(), [&realm, this]() {
+                    this->dispatch_event(DOM::Event::create(realm, HTML::EventNames::statechange));
+                }));
+            }
+        }));
     }));
 
     // 8. Return promise.
@@ -253,7 +275,8 @@ WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> AudioContext::suspend()
     // 7. Queue a control message to suspend the AudioContext.
     // FIXME: Implement control message queue to run following steps on the rendering thread
 
-    // FIXME: 7.1: Attempt to release system resources.
+    // 7.1: Attempt to release system resources.
+    stop_rendering_audio_graph();
 
     // 7.2: Set the [[rendering thread state]] on the AudioContext to suspended.
     set_rendering_state(Bindings::AudioContextState::Suspended);
@@ -306,7 +329,9 @@ WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> AudioContext::close()
     // 5. Queue a control message to close the AudioContext.
     // FIXME: Implement control message queue to run following steps on the rendering thread
 
-    // FIXME: 5.1: Attempt to release system resources.
+    // 5.1: Attempt to release system resources.
+    stop_rendering_audio_graph();
+    m_playback_stream = nullptr;
 
     // 5.2: Set the [[rendering thread state]] to "suspended".
     set_rendering_state(Bindings::AudioContextState::Suspended);
@@ -335,11 +360,73 @@ WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> AudioContext::close()
     return promise;
 }
 
-// FIXME: Actually implement the rendering thread
-bool AudioContext::start_rendering_audio_graph()
+// The audio graph is rendered on the audio output's own real-time thread: every time the output device needs more
+// audio, the playback stream's callback renders as many render quanta as it takes to fill the device's buffer.
+void AudioContext::start_rendering_audio_graph(GC::Ref<GC::Function<void(bool)>> on_complete)
+{
+    if (!m_playback_stream) {
+        // FIXME: Derive the latency from the context's latencyHint.
+        constexpr u32 target_latency_ms = 50;
+
+        auto channel_count = destination()->channel_count();
+        auto stream = Audio::PlaybackStream::create(Audio::OutputState::Suspended, static_cast<u32>(sample_rate()), static_cast<u8>(channel_count), target_latency_ms,
+            [renderer = NonnullRefPtr<AudioRenderer> { renderer() }, channel_count](Bytes buffer, Audio::PcmSampleFormat format, size_t sample_count) -> ReadonlyBytes {
+                VERIFY(format == Audio::PcmSampleFormat::Float32);
+                VERIFY(buffer.size() >= sample_count * channel_count * sizeof(float));
+
+                Span<float> samples { reinterpret_cast<float*>(buffer.data()), sample_count * channel_count };
+                renderer->render_interleaved(samples, channel_count);
+                return buffer.trim(samples.size() * sizeof(float));
+            });
+
+        // NOTE: Without an audio output device (e.g. when running headless), the graph simply isn't rendered. This
+        //       isn't reported as a failure, so that the context still behaves as if it were running.
+        if (stream.is_error()) {
+            dbgln("AudioContext: Unable to create an audio output stream: {}", stream.error());
+            on_complete->function()(true);
+            return;
+        }
+        m_playback_stream = stream.release_value();
+    }
+
+    // NOTE: The stream settles its promise on its own thread, and copies and destroys its callbacks there, so only the
+    //       ID of the start travels with it. The context and its callback are looked up back on this thread's event
+    //       loop, and are simply not found if the context was collected in the meantime.
+    auto id = s_next_rendering_start_id++;
+    m_pending_rendering_starts.set(id, on_complete);
+    s_contexts_awaiting_rendering_start.set(id, this);
+
+    auto complete = [&event_loop = Core::EventLoop::current(), id](bool started) {
+        event_loop.deferred_invoke([id, started]() {
+            auto context = s_contexts_awaiting_rendering_start.take(id);
+            if (!context.has_value())
+                return;
+            if (auto on_complete = (*context)->m_pending_rendering_starts.take(id); on_complete.has_value())
+                on_complete.value()->function()(started);
+        });
+    };
+
+    m_playback_stream->resume()
+        ->when_resolved([complete](AK::Duration) {
+            complete(true);
+        })
+        .when_rejected([complete](Error&& error) {
+            dbgln("AudioContext: Unable to resume the audio output stream: {}", error);
+            complete(false);
+        });
+}
+
+void AudioContext::stop_rendering_audio_graph()
 {
-    bool render_result = true;
-    return render_result;
+    if (!m_playback_stream)
+        return;
+
+    // NOTE: Releasing the output device has no failure path in the spec: suspend() and close() resolve their promises
+    //       regardless. If the device can't be suspended, it keeps rendering the (now idle) graph until the stream
+    //       is destroyed, so all we can do is log the failure.
+    m_playback_stream->discard_buffer_and_suspend()->when_rejected([](Error&& error) {
+        dbgln("AudioContext: Unable to suspend the audio output stream: {}", error);
+    });
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audiocontext-createmediaelementsource
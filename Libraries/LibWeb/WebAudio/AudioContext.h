@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <LibMedia/Audio/PlaybackStream.h>
 #include <LibWeb/Bindings/AudioContextPrototype.h>
 #include <LibWeb/HighResolutionTime/DOMHighResTimeStamp.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
@@ -50,6 +51,7 @@ private:
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override;
 
     double m_base_latency { 0 };
     double m_output_latency { 0 };
@@ -58,7 +60,14 @@ private:
     Vector<GC::Ref<WebIDL::Promise>> m_pending_resume_promises;
     bool m_suspended_by_user = false;
 
-    bool start_rendering_audio_graph();
+    RefPtr<Audio::PlaybackStream> m_playback_stream;
+
+    // Callbacks waiting for the playback stream to report whether it started, keyed by the ID that travels with the
+    // stream's promise. They're kept here rather than in that promise so that the GC can see them.
+    HashMap<u64, GC::Ref<GC::Function<void(bool)>>> m_pending_rendering_starts;
+
+    void start_rendering_audio_graph(GC::Ref<GC::Function<void(bool)>> on_complete);
+    void stop_rendering_audio_graph();
 };
 
 }
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/Math.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <LibWeb/WebAudio/AudioKernels.h>
+
+namespace Web::WebAudio::Kernels {
+
+using AK::SIMD::f32x4;
+using AK::SIMD::i32x4;
+
+static constexpr size_t lanes = AK::SIMD::vector_length<f32x4>;
+
+void fill(Span<float> destination, float value)
+{
+    auto values = AK::SIMD::expand4(value);
+    size_t i = 0;
+    for (; i + lanes <= destination.size(); i += lanes)
+        AK::SIMD::store_unaligned(&destination[i], values);
+    for (; i < destination.size(); ++i)
+        destination[i] = value;
+}
+
+void scale(Span<float> destination, ReadonlySpan<float> source, float gain)
+{
+    VERIFY(destination.size() == source.size());
+    auto gains = AK::SIMD::expand4(gain);
+    size_t i = 0;
+    for (; i + lanes <= destination.size(); i += lanes)
+        AK::SIMD::store_unaligned(&destination[i], AK::SIMD::load_unaligned<f32x4>(&source[i]) * gains);
+    for (; i < destination.size(); ++i)
+        destination[i] = source[i] * gain;
+}
+
+void add(Span<float> destination, ReadonlySpan<float> source)
+{
+    VERIFY(destination.size() == source.size());
+    size_t i = 0;
+    for (; i + lanes <= destination.size(); i += lanes)
+        AK::SIMD::store_unaligned(&destination[i], AK::SIMD::load_unaligned<f32x4>(&destination[i]) + AK::SIMD::load_unaligned<f32x4>(&source[i]));
+    for (; i < destination.size(); ++i)
+        destination[i] += source[i];
+}
+
+void add_scaled(Span<float> destination, ReadonlySpan<float> source, float gain)
+{
+    VERIFY(destination.size() == source.size());
+    auto gains = AK::SIMD::expand4(gain);
+    size_t i = 0;
+    for (; i + lanes <= destination.size(); i += lanes)
+        AK::SIMD::store_unaligned(&destination[i], AK::SIMD::load_unaligned<f32x4>(&destination[i]) + AK::SIMD::load_unaligned<f32x4>(&source[i]) * gains);
+    for (; i < destination.size(); ++i)
+        destination[i] += source[i] * gain;
+}
+
+void accumulate_magnitude(Span<float> destination, ReadonlySpan<float> source)
+{
+    VERIFY(destination.size() == source.size());
+    size_t i = 0;
+    for (; i + lanes <= destination.size(); i += lanes) {
+        // Clearing the sign bit yields the absolute value, and selecting through a mask avoids a branch per lane.
+        auto magnitudes = bit_cast<i32x4>(AK::SIMD::load_unaligned<f32x4>(&source[i])) & 0x7fffffff;
+        auto current = AK::SIMD::load_unaligned<f32x4>(&destination[i]);
+        auto is_greater = bit_cast<f32x4>(magnitudes) > current;
+        AK::SIMD::store_unaligned(&destination[i], bit_cast<f32x4>((magnitudes & is_greater) | (bit_cast<i32x4>(current) & ~is_greater)));
+    }
+    for (; i < destination.size(); ++i)
+        destination[i] = max(destination[i], AK::fabs(source[i]));
+}
+
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+
+// Vectorized inner loops shared by the rendering-side implementations of the audio nodes.
+// All of them operate on spans of equal size, which is usually one render quantum.
+namespace Web::WebAudio::Kernels {
+
+// destination[i] = value
+void fill(Span<float> destination, float value);
+
+// destination[i] = source[i] * gain
+void scale(Span<float> destination, ReadonlySpan<float> source, float gain);
+
+// destination[i] += source[i]
+void add(Span<float> destination, ReadonlySpan<float> source);
+
+// destination[i] += source[i] * gain
+void add_scaled(Span<float> destination, ReadonlySpan<float> source, float gain);
+
+// destination[i] = max(destination[i], abs(source[i]))
+void accumulate_magnitude(Span<float> destination, ReadonlySpan<float> source);
+
+}
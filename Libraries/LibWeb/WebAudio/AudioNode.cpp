@@ -6,7 +6,9 @@
 
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/WebAudio/AudioNode.h>
+#include <LibWeb/WebAudio/AudioParam.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
+#include <LibWeb/WebAudio/RenderNodes.h>
 
 namespace Web::WebAudio {
 
@@ -71,7 +73,16 @@ WebIDL::ExceptionOr<GC::Ref<AudioNode>> AudioNode::connect(GC::Ref<AudioNode> de
         return WebIDL::IndexSizeError::create(realm(), MUST(String::formatted("Input index '{}' exceeds number of inputs", input)));
     }
 
-    dbgln("FIXME: Implement Audio::connect(AudioNode)");
+    // There can only be one connection between a given output of one specific node and a given input of another specific node.
+    // Multiple connections with the same termini are ignored.
+    Connection connection { destination_node, output, input };
+    if (m_output_connections.contains_slow(connection))
+        return destination_node;
+
+    m_output_connections.append(connection);
+    destination_node->m_input_connections.append({ *this, output, input });
+    m_context->invalidate_render_graph();
+
     return destination_node;
 }
 
@@ -90,14 +101,48 @@ WebIDL::ExceptionOr<void> AudioNode::connect(GC::Ref<AudioParam> destination_par
         return WebIDL::IndexSizeError::create(realm(), MUST(String::formatted("Output index {} exceeds number of outputs", output)));
     }
 
-    dbgln("FIXME: Implement AudioNode::connect(AudioParam)");
+    // There can only be one connection between a given output of one specific node and a specific AudioParam.
+    // Multiple connections with the same termini are ignored.
+    ParamConnection connection { destination_param, output };
+    if (m_param_connections.contains_slow(connection))
+        return {};
+
+    // FIXME: Mix the connected outputs into the parameter's computedValue on the rendering thread.
+    m_param_connections.append(connection);
     return {};
 }
 
+template<typename Predicate>
+bool AudioNode::disconnect_outputs_matching(Predicate predicate)
+{
+    bool disconnected_any = false;
+    m_output_connections.remove_all_matching([&](Connection const& connection) {
+        if (!predicate(connection))
+            return false;
+        connection.node->m_input_connections.remove_first_matching([&](Connection const& input_connection) {
+            return input_connection == Connection { *this, connection.output, connection.input };
+        });
+        disconnected_any = true;
+        return true;
+    });
+
+    if (disconnected_any)
+        m_context->invalidate_render_graph();
+    return disconnected_any;
+}
+
+template<typename Predicate>
+bool AudioNode::disconnect_params_matching(Predicate predicate)
+{
+    return m_param_connections.remove_all_matching(predicate);
+}
+
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect
 void AudioNode::disconnect()
 {
-    dbgln("FIXME: Implement AudioNode::disconnect()");
+    // Disconnects all outgoing connections from the AudioNode.
+    disconnect_outputs_matching([](auto&) { return true; });
+    disconnect_params_matching([](auto&) { return true; });
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-output
@@ -110,35 +155,39 @@ WebIDL::ExceptionOr<void> AudioNode::disconnect(WebIDL::UnsignedLong output)
         return WebIDL::IndexSizeError::create(realm(), MUST(String::formatted("Output index {} exceeds number of outputs", output)));
     }
 
-    dbgln("FIXME: Implement AudioNode::disconnect(output)");
+    disconnect_outputs_matching([&](auto& connection) { return connection.output == output; });
+    disconnect_params_matching([&](auto& connection) { return connection.output == output; });
     return {};
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-destinationnode
-void AudioNode::disconnect(GC::Ref<AudioNode> destination_node)
+WebIDL::ExceptionOr<void> AudioNode::disconnect(GC::Ref<AudioNode> destination_node)
 {
-    (void)destination_node;
-    dbgln("FIXME: Implement AudioNode::disconnect(destination_node)");
+    // The destinationNode parameter is the AudioNode to disconnect. It disconnects all outgoing connections to the given destinationNode.
+    // If there is no connection to the destinationNode, an InvalidAccessError exception MUST be thrown.
+    if (!disconnect_outputs_matching([&](auto& connection) { return connection.node == destination_node; }))
+        return WebIDL::InvalidAccessError::create(realm(), "No connection to the given AudioNode"_string);
+    return {};
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-destinationnode-output
 WebIDL::ExceptionOr<void> AudioNode::disconnect(GC::Ref<AudioNode> destination_node, WebIDL::UnsignedLong output)
 {
-    (void)destination_node;
     // The output parameter is an index describing which output of the AudioNode from which to disconnect.
     // If this parameter is out-of-bounds, an IndexSizeError exception MUST be thrown.
     if (output >= number_of_outputs()) {
         return WebIDL::IndexSizeError::create(realm(), MUST(String::formatted("Output index {} exceeds number of outputs", output)));
     }
 
-    dbgln("FIXME: Implement AudioNode::disconnect(destination_node, output)");
+    // If there is no connection to the destinationNode from the given output, an InvalidAccessError exception MUST be thrown.
+    if (!disconnect_outputs_matching([&](auto& connection) { return connection.node == destination_node && connection.output == output; }))
+        return WebIDL::InvalidAccessError::create(realm(), "No connection from the given output to the given AudioNode"_string);
     return {};
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-destinationnode-output-input
 WebIDL::ExceptionOr<void> AudioNode::disconnect(GC::Ref<AudioNode> destination_node, WebIDL::UnsignedLong output, WebIDL::UnsignedLong input)
 {
-    (void)destination_node;
     // The output parameter is an index describing which output of the AudioNode from which to disconnect.
     // If this parameter is out-of-bounds, an IndexSizeError exception MUST be thrown.
     if (output >= number_of_outputs()) {
@@ -151,31 +200,51 @@ WebIDL::ExceptionOr<void> AudioNode::disconnect(GC::Ref<AudioNode> destination_n
         return WebIDL::IndexSizeError::create(realm(), MUST(String::formatted("Input index '{}' exceeds number of inputs", input)));
     }
 
-    dbgln("FIXME: Implement AudioNode::disconnect(destination_node, output, input)");
+    // If there is no connection to the destinationNode from the given output to the given input, an InvalidAccessError exception MUST be thrown.
+    if (!disconnect_outputs_matching([&](auto& connection) { return connection == Connection { destination_node, output, input }; }))
+        return WebIDL::InvalidAccessError::create(realm(), "No connection from the given output to the given input of the AudioNode"_string);
     return {};
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-destinationparam
-void AudioNode::disconnect(GC::Ref<AudioParam> destination_param)
+WebIDL::ExceptionOr<void> AudioNode::disconnect(GC::Ref<AudioParam> destination_param)
 {
-    (void)destination_param;
-    dbgln("FIXME: Implement AudioNode::disconnect(destination_param)");
+    // The destinationParam parameter is the AudioParam to disconnect.
+    // If there is no connection to the destinationParam, an InvalidAccessError exception MUST be thrown.
+    if (!disconnect_params_matching([&](auto& connection) { return connection.param == destination_param; }))
+        return WebIDL::InvalidAccessError::create(realm(), "No connection to the given AudioParam"_string);
+    return {};
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audionode-disconnect-destinationparam-output
 WebIDL::ExceptionOr<void> AudioNode::disconnect(GC::Ref<AudioParam> destination_param, WebIDL::UnsignedLong output)
 {
-    (void)destination_param;
     // The output parameter is an index describing which output of the AudioNode from which to disconnect.
     // If this parameter is out-of-bounds, an IndexSizeError exception MUST be thrown.
     if (output >= number_of_outputs()) {
         return WebIDL::IndexSizeError::create(realm(), MUST(String::formatted("Output index {} exceeds number of outputs", output)));
     }
 
-    dbgln("FIXME: Implement AudioNode::disconnect(destination_param, output)");
+    // If there is no connection to the destinationParam from the given output, an InvalidAccessError exception MUST be thrown.
+    if (!disconnect_params_matching([&](auto& connection) { return connection == ParamConnection { destination_param, output }; }))
+        return WebIDL::InvalidAccessError::create(realm(), "No connection from the given output to the given AudioParam"_string);
     return {};
 }
 
+RenderNode& AudioNode::render_node()
+{
+    if (!m_render_node)
+        m_render_node = create_render_node();
+    return *m_render_node;
+}
+
+NonnullRefPtr<RenderNode> AudioNode::create_render_node()
+{
+    if (number_of_inputs() == 0)
+        return SilentRenderNode::create();
+    return PassThroughRenderNode::create();
+}
+
 // https://webaudio.github.io/web-audio-api/#dom-audionode-channelcount
 WebIDL::ExceptionOr<void> AudioNode::set_channel_count(WebIDL::UnsignedLong channel_count)
 {
@@ -185,6 +254,7 @@ WebIDL::ExceptionOr<void> AudioNode::set_channel_count(WebIDL::UnsignedLong chan
         return WebIDL::NotSupportedError::create(realm(), "Invalid channel count"_string);
 
     m_channel_count = channel_count;
+    m_context->invalidate_render_graph();
     return {};
 }
 
@@ -192,6 +262,7 @@ WebIDL::ExceptionOr<void> AudioNode::set_channel_count(WebIDL::UnsignedLong chan
 WebIDL::ExceptionOr<void> AudioNode::set_channel_count_mode(Bindings::ChannelCountMode channel_count_mode)
 {
     m_channel_count_mode = channel_count_mode;
+    m_context->invalidate_render_graph();
     return {};
 }
 
@@ -205,6 +276,7 @@ Bindings::ChannelCountMode AudioNode::channel_count_mode()
 WebIDL::ExceptionOr<void> AudioNode::set_channel_interpretation(Bindings::ChannelInterpretation channel_interpretation)
 {
     m_channel_interpretation = channel_interpretation;
+    m_context->invalidate_render_graph();
     return {};
 }
 
@@ -224,6 +296,12 @@ void AudioNode::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_context);
+    for (auto& connection : m_output_connections)
+        visitor.visit(connection.node);
+    for (auto& connection : m_input_connections)
+        visitor.visit(connection.node);
+    for (auto& connection : m_param_connections)
+        visitor.visit(connection.param);
 }
 
 }
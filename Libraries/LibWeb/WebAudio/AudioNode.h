@@ -11,6 +11,7 @@
 #include <LibWeb/Bindings/AudioNodePrototype.h>
 #include <LibWeb/Bindings/PlatformObject.h>
 #include <LibWeb/DOM/EventTarget.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
 #include <LibWeb/WebIDL/Types.h>
 
 namespace Web::WebAudio {
@@ -41,10 +42,10 @@ public:
 
     void disconnect();
     WebIDL::ExceptionOr<void> disconnect(WebIDL::UnsignedLong output);
-    void disconnect(GC::Ref<AudioNode> destination_node);
+    WebIDL::ExceptionOr<void> disconnect(GC::Ref<AudioNode> destination_node);
     WebIDL::ExceptionOr<void> disconnect(GC::Ref<AudioNode> destination_node, WebIDL::UnsignedLong output);
     WebIDL::ExceptionOr<void> disconnect(GC::Ref<AudioNode> destination_node, WebIDL::UnsignedLong output, WebIDL::UnsignedLong input);
-    void disconnect(GC::Ref<AudioParam> destination_param);
+    WebIDL::ExceptionOr<void> disconnect(GC::Ref<AudioParam> destination_param);
     WebIDL::ExceptionOr<void> disconnect(GC::Ref<AudioParam> destination_param, WebIDL::UnsignedLong output);
 
     // https://webaudio.github.io/web-audio-api/#dom-audionode-context
@@ -70,17 +71,54 @@ public:
 
     WebIDL::ExceptionOr<void> initialize_audio_node_options(AudioNodeOptions const& given_options, AudioNodeDefaultOptions const& default_options);
 
+    // A connection from one of this node's outputs to an input of another node, or from an output of another node
+    // to one of this node's inputs, depending on which list of connections it's in.
+    struct Connection {
+        GC::Ref<AudioNode> node;
+        WebIDL::UnsignedLong output { 0 };
+        WebIDL::UnsignedLong input { 0 };
+
+        bool operator==(Connection const&) const = default;
+    };
+    Vector<Connection> const& input_connections() const { return m_input_connections; }
+
+    // The node's counterpart on the rendering thread, created on first use.
+    RenderNode& render_node();
+
 protected:
     AudioNode(JS::Realm&, GC::Ref<BaseAudioContext>, WebIDL::UnsignedLong channel_count = 2);
 
+    // Creates the node's counterpart on the rendering thread. Nodes whose processing isn't implemented yet pass
+    // their input through unchanged, or output silence if they have no inputs.
+    virtual NonnullRefPtr<RenderNode> create_render_node();
+
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
 private:
+    struct ParamConnection {
+        GC::Ref<AudioParam> param;
+        WebIDL::UnsignedLong output { 0 };
+
+        bool operator==(ParamConnection const&) const = default;
+    };
+
+    template<typename Predicate>
+    bool disconnect_outputs_matching(Predicate);
+
+    template<typename Predicate>
+    bool disconnect_params_matching(Predicate);
+
     GC::Ref<BaseAudioContext> m_context;
     WebIDL::UnsignedLong m_channel_count { 2 };
     Bindings::ChannelCountMode m_channel_count_mode { Bindings::ChannelCountMode::Max };
     Bindings::ChannelInterpretation m_channel_interpretation { Bindings::ChannelInterpretation::Speakers };
+
+    Vector<Connection> m_output_connections;
+    Vector<Connection> m_input_connections;
+    Vector<ParamConnection> m_param_connections;
+
+    RefPtr<RenderNode> m_render_node;
 };
 
 }
@@ -18,6 +18,7 @@ AudioParam::AudioParam(JS::Realm& realm, GC::Ref<BaseAudioContext> context, floa
     : Bindings::PlatformObject(realm)
     , m_context(context)
     , m_current_value(default_value)
+    , m_render_param(RenderParam::create(default_value, min_value, max_value))
     , m_default_value(default_value)
     , m_min_value(min_value)
     , m_max_value(max_value)
@@ -46,6 +47,7 @@ float AudioParam::value() const
 void AudioParam::set_value(float value)
 {
     m_current_value = value;
+    m_render_param->set_value(value);
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audioparam-automationrate
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/WebAudio/AudioRenderer.h>
+
+namespace Web::WebAudio {
+
+AudioRenderer::~AudioRenderer()
+{
+    delete m_graph;
+    delete m_pending_graph.exchange(nullptr);
+    destroy_retired_graphs();
+}
+
+void AudioRenderer::set_graph(NonnullOwnPtr<RenderGraph> graph)
+{
+    // NOTE: A graph that was still pending was never seen by the rendering thread, so it can be freed right away.
+    delete m_pending_graph.exchange(graph.leak_ptr(), AK::memory_order_acq_rel);
+}
+
+void AudioRenderer::retire_graph(RenderGraph* graph)
+{
+    auto* head = m_retired_graphs.load(AK::memory_order_relaxed);
+    do {
+        graph->m_next_retired_graph = head;
+    } while (!m_retired_graphs.compare_exchange_strong(head, graph, AK::memory_order_acq_rel));
+}
+
+void AudioRenderer::destroy_retired_graphs()
+{
+    auto* graph = m_retired_graphs.exchange(nullptr, AK::memory_order_acq_rel);
+    while (graph) {
+        auto* next = graph->m_next_retired_graph;
+        delete graph;
+        graph = next;
+    }
+}
+
+AudioBus const& AudioRenderer::render_quantum()
+{
+    if (auto* pending_graph = m_pending_graph.exchange(nullptr, AK::memory_order_acq_rel)) {
+        if (m_graph)
+            retire_graph(m_graph);
+        m_graph = pending_graph;
+    }
+
+    auto current_frame = m_rendered_frame_count.load(AK::memory_order_relaxed);
+
+    AudioBus const* output = &m_silence;
+    if (m_graph) {
+        m_graph->render_quantum({ .sample_rate = m_sample_rate, .current_frame = current_frame });
+        output = &m_graph->output();
+    }
+
+    m_rendered_frame_count.store(current_frame + RENDER_QUANTUM_SIZE, AK::memory_order_release);
+    return *output;
+}
+
+size_t AudioRenderer::render_interleaved(Span<float> buffer, size_t channel_count)
+{
+    VERIFY(channel_count > 0);
+    auto frame_count = buffer.size() / channel_count;
+
+    for (size_t frame = 0; frame < frame_count;) {
+        if (m_last_output_offset == RENDER_QUANTUM_SIZE) {
+            m_last_output = &render_quantum();
+            m_last_output_offset = 0;
+        }
+
+        auto frames_to_copy = min(frame_count - frame, RENDER_QUANTUM_SIZE - m_last_output_offset);
+        for (size_t channel = 0; channel < channel_count; ++channel) {
+            // FIXME: Up-mix or down-mix when the destination's channel count differs from the output device's.
+            if (channel >= m_last_output->channel_count()) {
+                for (size_t i = 0; i < frames_to_copy; ++i)
+                    buffer[(frame + i) * channel_count + channel] = 0;
+                continue;
+            }
+            auto samples = m_last_output->channel(channel);
+            for (size_t i = 0; i < frames_to_copy; ++i)
+                buffer[(frame + i) * channel_count + channel] = samples[m_last_output_offset + i];
+        }
+
+        frame += frames_to_copy;
+        m_last_output_offset += frames_to_copy;
+    }
+
+    return frame_count;
+}
+
+void AudioRenderer::render_planar(Span<Vector<float>> channels, Threading::ThreadPool* thread_pool)
+{
+    // NOTE: 64 render quanta make blocks of 8192 sample-frames, which is large enough for the per-block overhead of
+    //       handing work to the worker pool to disappear, while keeping every node's output buffers within the cache.
+    static constexpr size_t quanta_per_block = 64;
+
+    if (auto* pending_graph = m_pending_graph.exchange(nullptr, AK::memory_order_acq_rel)) {
+        if (m_graph)
+            retire_graph(m_graph);
+        m_graph = pending_graph;
+    }
+
+    size_t frame_count = 0;
+    for (auto const& channel : channels)
+        frame_count = max(frame_count, channel.size());
+
+    for (size_t frame = 0; frame < frame_count;) {
+        auto current_frame = m_rendered_frame_count.load(AK::memory_order_relaxed);
+        auto quantum_count = min(quanta_per_block, ceil_div(frame_count - frame, RENDER_QUANTUM_SIZE));
+
+        if (m_graph)
+            m_graph->render_block({ .sample_rate = m_sample_rate, .current_frame = current_frame }, quantum_count, thread_pool);
+
+        for (size_t quantum_index = 0; quantum_index < quantum_count; ++quantum_index) {
+            auto const& output = m_graph ? m_graph->output(quantum_index) : m_silence;
+            auto quantum_frame = frame + quantum_index * RENDER_QUANTUM_SIZE;
+            for (size_t channel = 0; channel < min(channels.size(), output.channel_count()); ++channel) {
+                auto& buffer = channels[channel];
+                if (quantum_frame >= buffer.size())
+                    continue;
+                auto frames_to_copy = min(RENDER_QUANTUM_SIZE, buffer.size() - quantum_frame);
+                output.channel(channel).trim(frames_to_copy).copy_to(buffer.span().slice(quantum_frame));
+            }
+        }
+
+        frame += quantum_count * RENDER_QUANTUM_SIZE;
+        m_rendered_frame_count.store(current_frame + quantum_count * RENDER_QUANTUM_SIZE, AK::memory_order_release);
+    }
+}
+
+}
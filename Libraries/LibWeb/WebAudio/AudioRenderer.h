@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
+
+namespace Web::WebAudio {
+
+// Drives a RenderGraph one render quantum at a time on behalf of a BaseAudioContext.
+//
+// The control thread and the rendering thread never block on each other: a newly compiled graph is handed over
+// through an atomic mailbox that the rendering thread checks at the start of every render quantum, and the graph it
+// replaces is pushed onto a lock-free list for the control thread to destroy, so that the rendering thread never
+// frees memory.
+class AudioRenderer final : public AtomicRefCounted<AudioRenderer> {
+public:
+    static NonnullRefPtr<AudioRenderer> create() { return adopt_ref(*new AudioRenderer); }
+
+    ~AudioRenderer();
+
+    // Called from the control thread. The sample rate must be set before rendering starts.
+    void set_sample_rate(float sample_rate) { m_sample_rate = sample_rate; }
+    float sample_rate() const { return m_sample_rate; }
+
+    // Called from the control thread. The graph is picked up at the start of the next render quantum.
+    void set_graph(NonnullOwnPtr<RenderGraph>);
+
+    // Called from the control thread, to free the graphs that the rendering thread has stopped using.
+    void destroy_retired_graphs();
+
+    // The number of sample-frames rendered so far. Safe to call from any thread.
+    u64 rendered_frame_count() const { return m_rendered_frame_count.load(AK::memory_order_acquire); }
+
+    // Renders the next render quantum. Returns the output of the destination node, which stays valid until the next
+    // call.
+    AudioBus const& render_quantum();
+
+    // Fills the buffer with interleaved sample-frames of the given channel count, rendering as many render quanta as
+    // needed. Frames left over from a render quantum are returned first by the next call. Returns the number of
+    // sample-frames written, which is always as many as fit into the buffer.
+    size_t render_interleaved(Span<float> buffer, size_t channel_count);
+
+    // Renders consecutive sample-frames into one buffer per channel until the buffers are full, a large block of render
+    // quanta at a time. Channels the destination doesn't output are left untouched. This is meant for offline
+    // rendering; see RenderGraph::render_block().
+    void render_planar(Span<Vector<float>> channels, Threading::ThreadPool* = nullptr);
+
+private:
+    AudioRenderer() = default;
+
+    void retire_graph(RenderGraph*);
+
+    float m_sample_rate { 0 };
+
+    Atomic<RenderGraph*> m_pending_graph { nullptr };
+    Atomic<RenderGraph*> m_retired_graphs { nullptr };
+    Atomic<u64> m_rendered_frame_count { 0 };
+
+    // Only ever touched by the rendering thread.
+    RenderGraph* m_graph { nullptr };
+    AudioBus const* m_last_output { nullptr };
+    size_t m_last_output_offset { RENDER_QUANTUM_SIZE };
+    AudioBus m_silence;
+};
+
+}
@@ -8,6 +8,7 @@
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/HTML/EventNames.h>
 #include <LibWeb/WebAudio/AudioScheduledSourceNode.h>
+#include <LibWeb/WebAudio/RenderNodes.h>
 
 namespace Web::WebAudio {
 
@@ -47,10 +48,12 @@ WebIDL::ExceptionOr<void> AudioScheduledSourceNode::start(double when)
     // 3. Set the internal slot [[source started]] on this AudioScheduledSourceNode to true.
     set_source_started(true);
 
-    // FIXME: 4. Queue a control message to start the AudioScheduledSourceNode, including the parameter values in the message.
+    // 4. Queue a control message to start the AudioScheduledSourceNode, including the parameter values in the message.
+    schedule_start(when);
+
     // FIXME: 5. Send a control message to the associated AudioContext to start running its rendering thread only when all the following conditions are met:
 
-    return WebIDL::NotSupportedError::create(realm(), "FIXME: Implement AudioScheduledSourceNode::start"_string);
+    return {};
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-audioscheduledsourcenode-stop
@@ -65,9 +68,27 @@ WebIDL::ExceptionOr<void> AudioScheduledSourceNode::stop(double when)
     if (when < 0)
         return WebIDL::SimpleException { WebIDL::SimpleExceptionType::RangeError, "when must not be negative"sv };
 
-    // FIXME: 3. Queue a control message to stop the AudioScheduledSourceNode, including the parameter values in the message.
+    // 3. Queue a control message to stop the AudioScheduledSourceNode, including the parameter values in the message.
+    schedule_stop(when);
+
+    return {};
+}
+
+// NOTE: The start and stop times are the only parameters of these control messages, so rather than going through a
+//       queue they are stored directly into atomics that the rendering thread reads at every render quantum.
+void AudioScheduledSourceNode::schedule_start(double when)
+{
+    static_cast<ScheduledSourceRenderNode&>(render_node()).set_start_time(when);
+}
+
+void AudioScheduledSourceNode::schedule_stop(double when)
+{
+    static_cast<ScheduledSourceRenderNode&>(render_node()).set_stop_time(when);
+}
 
-    return WebIDL::NotSupportedError::create(realm(), "FIXME: Implement AudioScheduledSourceNode::stop"_string);
+NonnullRefPtr<RenderNode> AudioScheduledSourceNode::create_render_node()
+{
+    return ScheduledSourceRenderNode::create();
 }
 
 void AudioScheduledSourceNode::initialize(JS::Realm& realm)
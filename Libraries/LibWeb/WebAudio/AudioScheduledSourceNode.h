@@ -30,6 +30,12 @@ protected:
     bool source_started() const { return m_source_started; }
     void set_source_started(bool started) { m_source_started = started; }
 
+    // Schedules the start or stop of the source on the rendering thread.
+    void schedule_start(double when);
+    void schedule_stop(double when);
+
+    virtual NonnullRefPtr<RenderNode> create_render_node() override;
+
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
@@ -6,8 +6,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashMap.h>
 #include <LibWeb/Bindings/BaseAudioContextPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/EventNames.h>
 #include <LibWeb/HTML/Scripting/ExceptionReporter.h>
 #include <LibWeb/HTML/Window.h>
@@ -30,8 +32,10 @@ namespace Web::WebAudio {
 BaseAudioContext::BaseAudioContext(JS::Realm& realm, float sample_rate)
     : DOM::EventTarget(realm)
     , m_sample_rate(sample_rate)
+    , m_renderer(AudioRenderer::create())
     , m_listener(AudioListener::create(realm, *this))
 {
+    m_renderer->set_sample_rate(sample_rate);
 }
 
 BaseAudioContext::~BaseAudioContext() = default;
@@ -60,6 +64,89 @@ WebIDL::CallbackType* BaseAudioContext::onstatechange()
     return event_handler_attribute(HTML::EventNames::statechange);
 }
 
+// https://webaudio.github.io/web-audio-api/#dom-baseaudiocontext-currenttime
+double BaseAudioContext::current_time() const
+{
+    // This is the time in seconds of the sample frame immediately following the last sample-frame in the block of audio
+    // most recently processed by the context’s rendering graph.
+    if (m_sample_rate == 0)
+        return 0;
+    return static_cast<double>(m_renderer->rendered_frame_count()) / m_sample_rate;
+}
+
+void BaseAudioContext::invalidate_render_graph()
+{
+    if (m_render_graph_update_pending)
+        return;
+    m_render_graph_update_pending = true;
+
+    // NOTE: Scripts usually make several connections in a row, so batch them up into a single recompilation.
+    HTML::queue_a_microtask(nullptr, GC::create_function(heap(), [self = GC::Ref { *this }] {
+        self->update_render_graph();
+    }));
+}
+
+// Compiles the nodes that feed into the destination into a RenderGraph, ordered so that every node comes after the
+// nodes connected to its input. Nodes that don't reach the destination don't contribute to the output, so they're
+// left out.
+void BaseAudioContext::update_render_graph()
+{
+    m_render_graph_update_pending = false;
+    m_renderer->destroy_retired_graphs();
+
+    if (!m_destination)
+        return;
+
+    auto graph = make<RenderGraph>();
+    HashMap<AudioNode const*, size_t> node_indices;
+    HashTable<AudioNode const*> nodes_being_visited;
+
+    struct PendingNode {
+        GC::Ref<AudioNode> node;
+        size_t next_input_connection { 0 };
+    };
+    Vector<PendingNode> stack;
+    stack.append({ *m_destination });
+    nodes_being_visited.set(m_destination.ptr());
+
+    while (!stack.is_empty()) {
+        auto& pending_node = stack.last();
+        auto node = pending_node.node;
+        auto const& input_connections = node->input_connections();
+
+        if (pending_node.next_input_connection < input_connections.size()) {
+            auto source = input_connections[pending_node.next_input_connection++].node;
+            // FIXME: A cycle is only allowed if it contains a DelayNode, and should otherwise be muted. For now, cycles
+            //        are broken at the connection that closes them.
+            if (node_indices.contains(source.ptr()) || nodes_being_visited.contains(source.ptr()))
+                continue;
+            nodes_being_visited.set(source.ptr());
+            stack.append({ source });
+            continue;
+        }
+
+        // FIXME: Route each output to the input it's connected to, once nodes with several inputs or outputs
+        //        (ChannelMergerNode, ChannelSplitterNode) are rendered. For now, everything is mixed into one input.
+        Vector<size_t> input_node_indices;
+        for (auto const& connection : input_connections) {
+            auto index = node_indices.get(connection.node.ptr());
+            if (index.has_value() && !input_node_indices.contains_slow(*index))
+                input_node_indices.append(*index);
+        }
+
+        RenderGraph::ChannelConfiguration channel_configuration {
+            .channel_count = node->channel_count(),
+            .channel_count_mode = node->channel_count_mode(),
+            .channel_interpretation = node->channel_interpretation(),
+        };
+        node_indices.set(node.ptr(), graph->add_node(node->render_node(), channel_configuration, move(input_node_indices)));
+        nodes_being_visited.remove(node.ptr());
+        stack.take_last();
+    }
+
+    m_renderer->set_graph(move(graph));
+}
+
 // https://webaudio.github.io/web-audio-api/#dom-baseaudiocontext-createanalyser
 WebIDL::ExceptionOr<GC::Ref<AnalyserNode>> BaseAudioContext::create_analyser()
 {
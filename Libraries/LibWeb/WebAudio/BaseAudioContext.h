@@ -12,6 +12,7 @@
 #include <LibWeb/DOM/EventTarget.h>
 #include <LibWeb/WebAudio/AnalyserNode.h>
 #include <LibWeb/WebAudio/AudioListener.h>
+#include <LibWeb/WebAudio/AudioRenderer.h>
 #include <LibWeb/WebAudio/BiquadFilterNode.h>
 #include <LibWeb/WebAudio/ChannelMergerNode.h>
 #include <LibWeb/WebAudio/ChannelSplitterNode.h>
@@ -45,7 +46,7 @@ public:
 
     GC::Ref<AudioDestinationNode> destination() const { return *m_destination; }
     float sample_rate() const { return m_sample_rate; }
-    double current_time() const { return m_current_time; }
+    double current_time() const;
     GC::Ref<AudioListener> listener() const { return m_listener; }
     Bindings::AudioContextState state() const { return m_control_thread_state; }
 
@@ -55,7 +56,11 @@ public:
     void set_onstatechange(WebIDL::CallbackType*);
     WebIDL::CallbackType* onstatechange();
 
-    void set_sample_rate(float sample_rate) { m_sample_rate = sample_rate; }
+    void set_sample_rate(float sample_rate)
+    {
+        m_sample_rate = sample_rate;
+        m_renderer->set_sample_rate(sample_rate);
+    }
     void set_control_state(Bindings::AudioContextState state) { m_control_thread_state = state; }
     void set_rendering_state(Bindings::AudioContextState state) { m_rendering_thread_state = state; }
 
@@ -79,11 +84,20 @@ public:
 
     GC::Ref<WebIDL::Promise> decode_audio_data(GC::Root<WebIDL::BufferSource>, GC::Ptr<WebIDL::CallbackType>, GC::Ptr<WebIDL::CallbackType>);
 
+    // Called whenever a connection or a channel configuration changes. The render graph is recompiled once the current
+    // task is done making changes, and handed over to the rendering thread.
+    void invalidate_render_graph();
+
+    AudioRenderer& renderer() { return *m_renderer; }
+
 protected:
     explicit BaseAudioContext(JS::Realm&, float m_sample_rate = 0);
 
     void queue_a_media_element_task(GC::Ref<GC::Function<void()>>);
 
+    // Compiles the current connections into a RenderGraph right away, rather than at the end of the current task.
+    void update_render_graph();
+
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
@@ -94,7 +108,9 @@ private:
     void queue_a_decoding_operation(GC::Ref<JS::PromiseCapability>, GC::Root<WebIDL::BufferSource>, GC::Ptr<WebIDL::CallbackType>, GC::Ptr<WebIDL::CallbackType>);
 
     float m_sample_rate { 0 };
-    double m_current_time { 0 };
+
+    NonnullRefPtr<AudioRenderer> m_renderer;
+    bool m_render_graph_update_pending { false };
 
     GC::Ref<AudioListener> m_listener;
 
@@ -12,6 +12,7 @@
 #include <LibWeb/WebAudio/AudioParam.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
 #include <LibWeb/WebAudio/BiquadFilterNode.h>
+#include <LibWeb/WebAudio/RenderNodes.h>
 
 namespace Web::WebAudio {
 
@@ -33,6 +34,7 @@ BiquadFilterNode::~BiquadFilterNode() = default;
 void BiquadFilterNode::set_type(Bindings::BiquadFilterType type)
 {
     m_type = type;
+    static_cast<BiquadFilterRenderNode&>(render_node()).set_type(type);
 }
 
 // https://webaudio.github.io/web-audio-api/#dom-biquadfilternode-type
@@ -100,6 +102,11 @@ WebIDL::ExceptionOr<GC::Ref<BiquadFilterNode>> BiquadFilterNode::construct_impl(
     return node;
 }
 
+NonnullRefPtr<RenderNode> BiquadFilterNode::create_render_node()
+{
+    return BiquadFilterRenderNode::create(m_type, m_frequency->render_param(), m_detune->render_param(), m_q->render_param(), m_gain->render_param());
+}
+
 void BiquadFilterNode::initialize(JS::Realm& realm)
 {
     WEB_SET_PROTOTYPE_FOR_INTERFACE(BiquadFilterNode);
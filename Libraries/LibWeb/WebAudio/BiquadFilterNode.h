@@ -49,6 +49,8 @@ protected:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual NonnullRefPtr<RenderNode> create_render_node() override;
+
 private:
     Bindings::BiquadFilterType m_type { Bindings::BiquadFilterType::Lowpass };
 
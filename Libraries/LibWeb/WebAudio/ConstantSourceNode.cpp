@@ -9,6 +9,7 @@
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
 #include <LibWeb/WebAudio/ConstantSourceNode.h>
+#include <LibWeb/WebAudio/RenderNodes.h>
 
 namespace Web::WebAudio {
 
@@ -32,6 +33,11 @@ WebIDL::ExceptionOr<GC::Ref<ConstantSourceNode>> ConstantSourceNode::construct_i
     return realm.create<ConstantSourceNode>(realm, context, options);
 }
 
+NonnullRefPtr<RenderNode> ConstantSourceNode::create_render_node()
+{
+    return ConstantSourceRenderNode::create(m_offset->render_param());
+}
+
 void ConstantSourceNode::initialize(JS::Realm& realm)
 {
     WEB_SET_PROTOTYPE_FOR_INTERFACE(ConstantSourceNode);
@@ -38,6 +38,8 @@ private:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual NonnullRefPtr<RenderNode> create_render_node() override;
+
     // https://webaudio.github.io/web-audio-api/#dom-delaynode-delaytime
     GC::Ref<AudioParam> m_delay_time;
 };
@@ -8,6 +8,7 @@
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/WebAudio/AudioParam.h>
 #include <LibWeb/WebAudio/DynamicsCompressorNode.h>
+#include <LibWeb/WebAudio/RenderNodes.h>
 
 namespace Web::WebAudio {
 
@@ -49,6 +50,24 @@ DynamicsCompressorNode::DynamicsCompressorNode(JS::Realm& realm, GC::Ref<BaseAud
 {
 }
 
+// https://webaudio.github.io/web-audio-api/#dom-dynamicscompressornode-reduction
+float DynamicsCompressorNode::reduction()
+{
+    // The [[internal reduction]] slot is updated by the rendering thread after every render quantum.
+    return static_cast<DynamicsCompressorRenderNode&>(render_node()).reduction();
+}
+
+NonnullRefPtr<RenderNode> DynamicsCompressorNode::create_render_node()
+{
+    return DynamicsCompressorRenderNode::create({
+        .threshold = m_threshold->render_param(),
+        .knee = m_knee->render_param(),
+        .ratio = m_ratio->render_param(),
+        .attack = m_attack->render_param(),
+        .release = m_release->render_param(),
+    });
+}
+
 void DynamicsCompressorNode::initialize(JS::Realm& realm)
 {
     WEB_SET_PROTOTYPE_FOR_INTERFACE(DynamicsCompressorNode);
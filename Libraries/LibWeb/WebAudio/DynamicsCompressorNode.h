@@ -38,7 +38,7 @@ public:
     GC::Ref<AudioParam const> ratio() const { return m_ratio; }
     GC::Ref<AudioParam const> attack() const { return m_attack; }
     GC::Ref<AudioParam const> release() const { return m_release; }
-    float reduction() const { return m_reduction; }
+    float reduction();
 
     WebIDL::ExceptionOr<void> set_channel_count_mode(Bindings::ChannelCountMode) override;
     WebIDL::ExceptionOr<void> set_channel_count(WebIDL::UnsignedLong) override;
@@ -49,6 +49,8 @@ protected:
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    virtual NonnullRefPtr<RenderNode> create_render_node() override;
+
 private:
     // https://webaudio.github.io/web-audio-api/#dom-dynamicscompressornode-threshold
     GC::Ref<AudioParam> m_threshold;
@@ -64,9 +66,6 @@ private:
 
     // https://webaudio.github.io/web-audio-api/#dom-dynamicscompressornode-release
     GC::Ref<AudioParam> m_release;
-
-    // https://webaudio.github.io/web-audio-api/#dom-dynamicscompressornode-internal-reduction-slot
-    float m_reduction { 0 }; // [[internal reduction]]
 };
 
 }
@@ -9,6 +9,7 @@
 #include <LibWeb/WebAudio/AudioParam.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
 #include <LibWeb/WebAudio/GainNode.h>
+#include <LibWeb/WebAudio/RenderNodes.h>
 
 namespace Web::WebAudio {
 
@@ -45,6 +46,11 @@ GainNode::GainNode(JS::Realm& realm, GC::Ref<BaseAudioContext> context, GainOpti
 {
 }
 
+NonnullRefPtr<RenderNode> GainNode::create_render_node()
+{
+    return GainRenderNode::create(m_gain->render_param());
+}
+
 void GainNode::initialize(JS::Realm& realm)
 {
     WEB_SET_PROTOTYPE_FOR_INTERFACE(GainNode);
@@ -4,11 +4,18 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/EventLoop.h>
+#include <LibThreading/ThreadPool.h>
+#include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/DOM/Event.h>
 #include <LibWeb/HTML/EventNames.h>
+#include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/HTML/Window.h>
+#include <LibWeb/WebAudio/AudioBuffer.h>
 #include <LibWeb/WebAudio/AudioDestinationNode.h>
 #include <LibWeb/WebAudio/OfflineAudioContext.h>
+#include <LibWeb/WebIDL/Promise.h>
 
 namespace Web::WebAudio {
 
@@ -23,7 +30,7 @@ WebIDL::ExceptionOr<GC::Ref<OfflineAudioContext>> OfflineAudioContext::construct
     TRY(verify_audio_options_inside_nominal_range(realm, context_options.number_of_channels, context_options.length, context_options.sample_rate));
 
     // Let c be a new OfflineAudioContext object. Initialize c as follows:
-    auto c = realm.create<OfflineAudioContext>(realm, context_options.length, context_options.sample_rate);
+    auto c = realm.create<OfflineAudioContext>(realm, context_options.number_of_channels, context_options.length, context_options.sample_rate);
 
     // 1. Set the [[control thread state]] for c to "suspended".
     c->set_control_state(Bindings::AudioContextState::Suspended);
@@ -58,7 +65,129 @@ OfflineAudioContext::~OfflineAudioContext() = default;
 // https://webaudio.github.io/web-audio-api/#dom-offlineaudiocontext-startrendering
 WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> OfflineAudioContext::start_rendering()
 {
-    return WebIDL::NotSupportedError::create(realm(), "FIXME: Implement OfflineAudioContext::start_rendering"_string);
+    auto& realm = this->realm();
+
+    // 1. If this's relevant global object's associated Document is not fully active then return a promise rejected with
+    //    "InvalidStateError" DOMException.
+    auto const& associated_document = as<HTML::Window>(HTML::relevant_global_object(*this)).associated_document();
+    if (!associated_document.is_fully_active()) {
+        auto error = WebIDL::InvalidStateError::create(realm, "The document is not fully active."_string);
+        return WebIDL::create_rejected_promise_from_exception(realm, error);
+    }
+
+    // 2. If the [[rendering started]] slot on the OfflineAudioContext is true, return a rejected promise with
+    //    InvalidStateError, and abort these steps.
+    if (m_rendering_started) {
+        auto error = WebIDL::InvalidStateError::create(realm, "Rendering has already started."_string);
+        return WebIDL::create_rejected_promise_from_exception(realm, error);
+    }
+
+    // 3. Set the [[rendering started]] slot of the OfflineAudioContext to true.
+    m_rendering_started = true;
+
+    // 4. Let promise be a new promise.
+    auto promise = WebIDL::create_promise(realm);
+
+    // 5. Create a new AudioBuffer, with a number of channels, length and sample rate equal respectively to the
+    //    numberOfChannels, length and sampleRate values passed to this instance's constructor in the contextOptions
+    //    parameter. Assign this buffer to an internal slot [[rendered buffer]] in the OfflineAudioContext.
+    auto buffer_or_exception = AudioBuffer::create(realm, m_number_of_channels, m_length, sample_rate());
+
+    // 6. If an exception was thrown during the preceding AudioBuffer constructor call, reject promise with this exception.
+    if (buffer_or_exception.is_exception()) {
+        auto completion = Bindings::exception_to_throw_completion(vm(), buffer_or_exception.release_error());
+        WebIDL::reject_promise(realm, promise, completion.value());
+    }
+    // 7. Otherwise, in the case that the buffer was successfully constructed, begin offline rendering.
+    else {
+        m_rendered_buffer = buffer_or_exception.release_value();
+        begin_offline_rendering(promise);
+    }
+
+    // 8. Append promise to [[pending promises]].
+    m_pending_promises.append(promise);
+
+    // 9. Return promise.
+    return promise;
+}
+
+// https://webaudio.github.io/web-audio-api/#begin-offline-rendering
+void OfflineAudioContext::begin_offline_rendering(GC::Ref<WebIDL::Promise> promise)
+{
+    m_rendering_promise = promise;
+
+    // NOTE: Connections made earlier in this task are normally compiled in a microtask, which would be too late.
+    update_render_graph();
+
+    set_rendering_state(Bindings::AudioContextState::Running);
+    queue_a_media_element_task(GC::create_function(heap(), [this] {
+        set_control_state(Bindings::AudioContextState::Running);
+        dispatch_event(DOM::Event::create(realm(), HTML::EventNames::statechange));
+    }));
+
+    // 1. Given the current connections and scheduled changes, start rendering length sample-frames of audio into
+    //    [[rendered buffer]].
+    // NOTE: Nothing is waiting on the output, so rather than pacing the graph like an audio device would, it's rendered
+    //       as fast as possible on a thread of its own. The thread only sees the compiled graph and plain sample
+    //       buffers; the [[rendered buffer]] is filled in once it reports back to this thread.
+    // FIXME: 2. For every render quantum, check and suspend rendering if necessary.
+    // FIXME: 3. If a suspended context is resumed, continue to render the buffer.
+    m_rendering_keepalive = GC::make_root(*this);
+    m_rendering_thread = Threading::Thread::construct([this, audio_renderer = NonnullRefPtr { renderer() }, &main_thread_event_loop = Core::EventLoop::current(), number_of_channels = m_number_of_channels, length = m_length] {
+        Vector<Vector<float>> rendered_channels;
+        rendered_channels.resize(number_of_channels);
+        for (auto& channel : rendered_channels)
+            channel.resize(length);
+
+        audio_renderer->render_planar(rendered_channels, &Threading::ThreadPool::the());
+
+        main_thread_event_loop.deferred_invoke([this, rendered_channels = move(rendered_channels)]() mutable {
+            finish_offline_rendering(move(rendered_channels));
+        });
+        return static_cast<intptr_t>(0);
+    },
+        "Offline Audio"sv);
+    m_rendering_thread->start();
+}
+
+void OfflineAudioContext::finish_offline_rendering(Vector<Vector<float>> rendered_channels)
+{
+    (void)m_rendering_thread->join();
+    m_rendering_thread = nullptr;
+
+    HTML::TemporaryExecutionContext execution_context(realm());
+
+    for (size_t channel = 0; channel < rendered_channels.size(); ++channel) {
+        auto channel_data = MUST(m_rendered_buffer->get_channel_data(channel));
+        rendered_channels[channel].span().copy_to(channel_data->data());
+    }
+
+    set_rendering_state(Bindings::AudioContextState::Closed);
+
+    // 4. Once the rendering is complete, queue a media element task to execute the following steps:
+    queue_a_media_element_task(GC::create_function(heap(), [this] {
+        auto& realm = this->realm();
+        HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+
+        // 1. Resolve the promise created by startRendering() with [[rendered buffer]].
+        GC::Ref promise = *m_rendering_promise;
+        WebIDL::resolve_promise(realm, promise, m_rendered_buffer.ptr());
+        m_pending_promises.remove_first_matching([&promise](auto& pending_promise) {
+            return pending_promise == promise;
+        });
+
+        // AD-HOC: The context can't render again, so it's closed, like it is in other engines.
+        set_control_state(Bindings::AudioContextState::Closed);
+        dispatch_event(DOM::Event::create(realm, HTML::EventNames::statechange));
+
+        // 2. Queue a media element task to fire an event named complete using an instance of OfflineAudioCompletionEvent
+        //    whose renderedBuffer property is set to [[rendered buffer]].
+        // FIXME: Fire an OfflineAudioCompletionEvent once it's implemented.
+        queue_a_media_element_task(GC::create_function(heap(), [this, &realm] {
+            dispatch_event(DOM::Event::create(realm, HTML::EventNames::complete));
+            m_rendering_keepalive = {};
+        }));
+    }));
 }
 
 WebIDL::ExceptionOr<GC::Ref<WebIDL::Promise>> OfflineAudioContext::resume()
@@ -91,8 +220,9 @@ void OfflineAudioContext::set_oncomplete(GC::Ptr<WebIDL::CallbackType> value)
     set_event_handler_attribute(HTML::EventNames::complete, value);
 }
 
-OfflineAudioContext::OfflineAudioContext(JS::Realm& realm, WebIDL::UnsignedLong length, float sample_rate)
+OfflineAudioContext::OfflineAudioContext(JS::Realm& realm, WebIDL::UnsignedLong number_of_channels, WebIDL::UnsignedLong length, float sample_rate)
     : BaseAudioContext(realm, sample_rate)
+    , m_number_of_channels(number_of_channels)
     , m_length(length)
 {
 }
@@ -106,6 +236,8 @@ void OfflineAudioContext::initialize(JS::Realm& realm)
 void OfflineAudioContext::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
+    visitor.visit(m_rendered_buffer);
+    visitor.visit(m_rendering_promise);
 }
 
 }
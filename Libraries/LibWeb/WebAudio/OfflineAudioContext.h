@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <LibThreading/Thread.h>
 #include <LibWeb/Bindings/OfflineAudioContextPrototype.h>
 #include <LibWeb/HighResolutionTime/DOMHighResTimeStamp.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
@@ -42,12 +43,28 @@ public:
     void set_oncomplete(GC::Ptr<WebIDL::CallbackType>);
 
 private:
-    OfflineAudioContext(JS::Realm&, WebIDL::UnsignedLong length, float sample_rate);
+    OfflineAudioContext(JS::Realm&, WebIDL::UnsignedLong number_of_channels, WebIDL::UnsignedLong length, float sample_rate);
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Cell::Visitor&) override;
 
+    void begin_offline_rendering(GC::Ref<WebIDL::Promise>);
+    void finish_offline_rendering(Vector<Vector<float>> rendered_channels);
+
+    WebIDL::UnsignedLong m_number_of_channels {};
     WebIDL::UnsignedLong m_length {};
+
+    // https://webaudio.github.io/web-audio-api/#dom-offlineaudiocontext-rendering-started-slot
+    bool m_rendering_started { false };
+
+    // https://webaudio.github.io/web-audio-api/#dom-offlineaudiocontext-rendered-buffer-slot
+    GC::Ptr<AudioBuffer> m_rendered_buffer;
+
+    GC::Ptr<WebIDL::Promise> m_rendering_promise;
+
+    // Keeps this context alive while the rendering thread has yet to report back, even if script dropped it.
+    GC::Root<OfflineAudioContext> m_rendering_keepalive;
+    RefPtr<Threading::Thread> m_rendering_thread;
 };
 
 }
@@ -11,6 +11,7 @@
 #include <LibWeb/WebAudio/AudioParam.h>
 #include <LibWeb/WebAudio/BaseAudioContext.h>
 #include <LibWeb/WebAudio/OscillatorNode.h>
+#include <LibWeb/WebAudio/RenderNodes.h>
 
 namespace Web::WebAudio {
 
@@ -71,6 +72,7 @@ WebIDL::ExceptionOr<void> OscillatorNode::set_type(Bindings::OscillatorType type
     set_periodic_wave(nullptr);
 
     m_type = type;
+    static_cast<OscillatorRenderNode&>(render_node()).set_type(type);
     return {};
 }
 
@@ -79,6 +81,15 @@ void OscillatorNode::set_periodic_wave(GC::Ptr<PeriodicWave> periodic_wave)
 {
     m_periodic_wave = periodic_wave;
     m_type = Bindings::OscillatorType::Custom;
+
+    // NOTE: set_type() clears the periodic wave before it updates the rendering thread with the new type itself.
+    if (periodic_wave)
+        static_cast<OscillatorRenderNode&>(render_node()).set_type(m_type);
+}
+
+NonnullRefPtr<RenderNode> OscillatorNode::create_render_node()
+{
+    return OscillatorRenderNode::create(m_type, m_frequency->render_param(), m_detune->render_param());
 }
 
 void OscillatorNode::initialize(JS::Realm& realm)
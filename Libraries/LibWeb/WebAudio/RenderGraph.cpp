@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibThreading/ThreadPool.h>
+#include <LibWeb/WebAudio/AudioKernels.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
+
+namespace Web::WebAudio {
+
+void AudioBus::set_channel_count(size_t channel_count)
+{
+    // NOTE: Storage is never released, so that a bus that settled on a channel count doesn't allocate again.
+    if (m_channels.size() < channel_count)
+        m_channels.resize(channel_count);
+    m_channel_count = channel_count;
+}
+
+void AudioBus::zero()
+{
+    for (size_t i = 0; i < m_channel_count; ++i)
+        Kernels::fill(channel(i), 0);
+}
+
+void AudioBus::copy_from(AudioBus const& other)
+{
+    set_channel_count(other.channel_count());
+    for (size_t i = 0; i < m_channel_count; ++i)
+        other.channel(i).copy_to(channel(i));
+}
+
+// https://webaudio.github.io/web-audio-api/#channel-up-mixing-and-down-mixing
+void AudioBus::sum_from(AudioBus const& other, Bindings::ChannelInterpretation interpretation)
+{
+    auto input_channel_count = other.channel_count();
+
+    if (input_channel_count == m_channel_count) {
+        for (size_t i = 0; i < m_channel_count; ++i)
+            Kernels::add(channel(i), other.channel(i));
+        return;
+    }
+
+    if (interpretation == Bindings::ChannelInterpretation::Speakers) {
+        // Mono up-mix:
+        //     1 -> 2 : up-mix from mono to stereo
+        //         output.L = input;
+        //         output.R = input;
+        if (input_channel_count == 1 && m_channel_count == 2) {
+            Kernels::add(channel(0), other.channel(0));
+            Kernels::add(channel(1), other.channel(0));
+            return;
+        }
+
+        // Mono down-mix:
+        //     2 -> 1 : stereo to mono
+        //         output = 0.5 * (input.L + input.R);
+        if (input_channel_count == 2 && m_channel_count == 1) {
+            Kernels::add_scaled(channel(0), other.channel(0), 0.5f);
+            Kernels::add_scaled(channel(0), other.channel(1), 0.5f);
+            return;
+        }
+
+        // FIXME: Implement the quad and 5.1 speaker layouts. Until then, they're mixed like discrete channels.
+    }
+
+    // Discrete:
+    //     Up-mix by filling channels until they run out then zero out remaining channels.
+    //     Down-mix by filling as many channels as possible, then dropping remaining channels.
+    for (size_t i = 0; i < min(input_channel_count, m_channel_count); ++i)
+        Kernels::add(channel(i), other.channel(i));
+}
+
+size_t RenderGraph::add_node(NonnullRefPtr<RenderNode> render_node, ChannelConfiguration channel_configuration, Vector<size_t> input_node_indices)
+{
+    size_t level = 0;
+    for (auto index : input_node_indices) {
+        VERIFY(index < m_nodes.size());
+        level = max(level, m_node_levels[index] + 1);
+    }
+
+    m_nodes.append({
+        .render_node = move(render_node),
+        .channel_configuration = channel_configuration,
+        .input_node_indices = move(input_node_indices),
+        .input = {},
+        .outputs = {},
+    });
+    m_nodes.last().outputs.resize(1);
+
+    auto node_index = m_nodes.size() - 1;
+    m_node_levels.append(level);
+    if (m_levels.size() <= level)
+        m_levels.resize(level + 1);
+    m_levels[level].append(node_index);
+    return node_index;
+}
+
+void RenderGraph::render_quantum(RenderContext const& context)
+{
+    for (auto& node : m_nodes)
+        process_node(node, 0, context);
+}
+
+void RenderGraph::render_block(RenderContext const& context, size_t quantum_count, Threading::ThreadPool* thread_pool)
+{
+    VERIFY(quantum_count > 0);
+    for (auto& node : m_nodes) {
+        if (node.outputs.size() < quantum_count)
+            node.outputs.resize(quantum_count);
+    }
+
+    // NOTE: Nodes were added after everything connected to their input, so rendering them in order is always valid.
+    if (!thread_pool) {
+        for (auto& node : m_nodes)
+            process_node_block(node, quantum_count, context);
+        return;
+    }
+
+    for (auto const& level : m_levels) {
+        if (level.size() == 1) {
+            process_node_block(m_nodes[level.first()], quantum_count, context);
+            continue;
+        }
+        thread_pool->for_each_index(level.size(), [&](size_t index) {
+            process_node_block(m_nodes[level[index]], quantum_count, context);
+        });
+    }
+}
+
+void RenderGraph::process_node_block(Node& node, size_t quantum_count, RenderContext const& context)
+{
+    auto quantum_context = context;
+    for (size_t quantum_index = 0; quantum_index < quantum_count; ++quantum_index) {
+        quantum_context.current_frame = context.current_frame + quantum_index * RENDER_QUANTUM_SIZE;
+        process_node(node, quantum_index, quantum_context);
+    }
+}
+
+void RenderGraph::process_node(Node& node, size_t quantum_index, RenderContext const& context)
+{
+    auto const& configuration = node.channel_configuration;
+
+    // https://webaudio.github.io/web-audio-api/#computednumberofchannels
+    // An input with no connections has one channel of silence.
+    size_t max_input_channel_count = 1;
+    for (auto index : node.input_node_indices)
+        max_input_channel_count = max(max_input_channel_count, m_nodes[index].outputs[quantum_index].channel_count());
+
+    size_t computed_number_of_channels = 0;
+    switch (configuration.channel_count_mode) {
+    case Bindings::ChannelCountMode::Max:
+        computed_number_of_channels = max_input_channel_count;
+        break;
+    case Bindings::ChannelCountMode::ClampedMax:
+        computed_number_of_channels = min(max_input_channel_count, configuration.channel_count);
+        break;
+    case Bindings::ChannelCountMode::Explicit:
+        computed_number_of_channels = configuration.channel_count;
+        break;
+    }
+
+    node.input.set_channel_count(computed_number_of_channels);
+    node.input.zero();
+    for (auto index : node.input_node_indices)
+        node.input.sum_from(m_nodes[index].outputs[quantum_index], configuration.channel_interpretation);
+
+    auto& output = node.outputs[quantum_index];
+    output.set_channel_count(node.render_node->output_channel_count(computed_number_of_channels));
+    node.render_node->process(node.input, output, context);
+}
+
+AudioBus const& RenderGraph::output(size_t quantum_index) const
+{
+    if (m_nodes.is_empty())
+        return m_silence;
+    return m_nodes.last().outputs[quantum_index];
+}
+
+}
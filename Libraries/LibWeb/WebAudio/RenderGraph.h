@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+#include <LibThreading/Forward.h>
+#include <LibWeb/Bindings/AudioNodePrototype.h>
+
+namespace Web::WebAudio {
+
+// https://webaudio.github.io/web-audio-api/#render-quantum-size
+static constexpr size_t RENDER_QUANTUM_SIZE = 128;
+
+// https://webaudio.github.io/web-audio-api/#audio-bus
+// One render quantum of audio, with any number of channels.
+class AudioBus {
+public:
+    using Channel = Array<float, RENDER_QUANTUM_SIZE>;
+
+    size_t channel_count() const { return m_channel_count; }
+    void set_channel_count(size_t);
+
+    Span<float> channel(size_t index) { return m_channels[index].span(); }
+    ReadonlySpan<float> channel(size_t index) const { return m_channels[index].span(); }
+
+    void zero();
+    void copy_from(AudioBus const&);
+
+    // Adds the other bus to this one, up-mixing or down-mixing it to this bus's channel count.
+    // https://webaudio.github.io/web-audio-api/#channel-up-mixing-and-down-mixing
+    void sum_from(AudioBus const&, Bindings::ChannelInterpretation);
+
+private:
+    size_t m_channel_count { 0 };
+    Vector<Channel, 2> m_channels;
+};
+
+// The [[current value]] of an AudioParam. It's shared between the control thread, which sets it, and the rendering
+// thread, which reads it once per render quantum, so it's stored in an atomic rather than being passed in a message.
+class RenderParam final : public AtomicRefCounted<RenderParam> {
+public:
+    static NonnullRefPtr<RenderParam> create(float value, float min_value, float max_value)
+    {
+        return adopt_ref(*new RenderParam(value, min_value, max_value));
+    }
+
+    float value() const { return clamp(m_value.load(AK::memory_order_relaxed), m_min_value, m_max_value); }
+    void set_value(float value) { m_value.store(value, AK::memory_order_relaxed); }
+
+private:
+    RenderParam(float value, float min_value, float max_value)
+        : m_value(value)
+        , m_min_value(min_value)
+        , m_max_value(max_value)
+    {
+    }
+
+    Atomic<float> m_value;
+    float m_min_value { 0 };
+    float m_max_value { 0 };
+};
+
+struct RenderContext {
+    float sample_rate { 0 };
+
+    // The index of the first sample-frame of the render quantum being rendered.
+    u64 current_frame { 0 };
+
+    double time_of_frame(u64 frame) const { return static_cast<double>(frame) / sample_rate; }
+};
+
+// The rendering-thread counterpart of an AudioNode. It's created once by its node on the control thread, and from
+// then on only used by whichever thread renders the graph, so it can keep state (oscillator phase, filter history,
+// delay lines) across render quanta and across recompilations of the graph.
+class RenderNode : public AtomicRefCounted<RenderNode> {
+public:
+    virtual ~RenderNode() = default;
+
+    // Returns the number of channels this node outputs, given the computedNumberOfChannels of its input.
+    virtual size_t output_channel_count(size_t input_channel_count) const { return input_channel_count; }
+
+    // Renders one render quantum of output from the node's mixed input.
+    virtual void process(AudioBus const& input, AudioBus& output, RenderContext const&) = 0;
+};
+
+// A snapshot of the connections between the nodes of a BaseAudioContext, compiled into a flat list that the
+// rendering thread can process without touching any GC-allocated objects.
+class RenderGraph {
+    AK_MAKE_NONCOPYABLE(RenderGraph);
+    AK_MAKE_NONMOVABLE(RenderGraph);
+
+public:
+    RenderGraph() = default;
+
+    struct ChannelConfiguration {
+        size_t channel_count { 2 };
+        Bindings::ChannelCountMode channel_count_mode { Bindings::ChannelCountMode::Max };
+        Bindings::ChannelInterpretation channel_interpretation { Bindings::ChannelInterpretation::Speakers };
+    };
+
+    // Nodes must be added after all the nodes connected to their input. The last node added is the destination.
+    size_t add_node(NonnullRefPtr<RenderNode>, ChannelConfiguration, Vector<size_t> input_node_indices);
+
+    size_t node_count() const { return m_nodes.size(); }
+
+    // Renders one render quantum through every node of the graph.
+    void render_quantum(RenderContext const&);
+
+    // Renders several consecutive render quanta, one node at a time. This is meant for offline rendering, where
+    // nothing is waiting on the output of a single quantum: running each node over a whole block keeps its state and
+    // code hot, and lets the nodes of a level be spread across the threads of the thread pool, if one is given.
+    void render_block(RenderContext const&, size_t quantum_count, Threading::ThreadPool* = nullptr);
+
+    // The output of the destination node for the given quantum of the last rendered block.
+    AudioBus const& output(size_t quantum_index = 0) const;
+
+    // A node's level is one more than the highest level of the nodes connected to its input, so the nodes of a level
+    // never depend on each other and can be rendered in any order, or at the same time.
+    size_t level_count() const { return m_levels.size(); }
+
+private:
+    friend class AudioRenderer;
+
+    struct Node {
+        NonnullRefPtr<RenderNode> render_node;
+        ChannelConfiguration channel_configuration;
+        Vector<size_t> input_node_indices;
+        AudioBus input;
+
+        // One bus per render quantum of the block being rendered.
+        Vector<AudioBus, 1> outputs;
+    };
+
+    void process_node(Node&, size_t quantum_index, RenderContext const&);
+    void process_node_block(Node&, size_t quantum_count, RenderContext const&);
+
+    Vector<Node> m_nodes;
+    Vector<size_t> m_node_levels;
+    Vector<Vector<size_t>> m_levels;
+    AudioBus m_silence;
+
+    // Links graphs that the rendering thread stopped using, until the control thread gets around to destroying them.
+    RenderGraph* m_next_retired_graph { nullptr };
+};
+
+}
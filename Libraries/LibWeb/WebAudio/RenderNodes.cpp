@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/GenericShorthands.h>
+#include <AK/Math.h>
+#include <LibWeb/WebAudio/AudioKernels.h>
+#include <LibWeb/WebAudio/RenderNodes.h>
+
+namespace Web::WebAudio {
+
+static double decibels_to_linear(double decibels)
+{
+    return AK::pow(10.0, decibels / 20);
+}
+
+static double linear_to_decibels(double linear)
+{
+    // NOTE: Anything this quiet is silence as far as the dynamics processing is concerned, and clamping avoids -inf.
+    return 20 * AK::log10(max(linear, 1e-10));
+}
+
+void PassThroughRenderNode::process(AudioBus const& input, AudioBus& output, RenderContext const&)
+{
+    output.copy_from(input);
+}
+
+void SilentRenderNode::process(AudioBus const&, AudioBus& output, RenderContext const&)
+{
+    output.zero();
+}
+
+static u64 frame_at_time(double time, float sample_rate)
+{
+    return static_cast<u64>(AK::ceil(time * sample_rate));
+}
+
+void ScheduledSourceRenderNode::process(AudioBus const&, AudioBus& output, RenderContext const& context)
+{
+    output.zero();
+
+    auto start_time = m_start_time.load(AK::memory_order_acquire);
+    if (start_time == not_scheduled)
+        return;
+    auto stop_time = m_stop_time.load(AK::memory_order_acquire);
+
+    // https://webaudio.github.io/web-audio-api/#dom-audioscheduledsourcenode-start
+    // If the value is less than currentTime, then the sound will start playing immediately.
+    auto quantum_begin = context.current_frame;
+    auto quantum_end = quantum_begin + RENDER_QUANTUM_SIZE;
+    auto start_frame = clamp(frame_at_time(start_time, context.sample_rate), quantum_begin, quantum_end);
+    auto stop_frame = stop_time == not_scheduled ? quantum_end : clamp(frame_at_time(stop_time, context.sample_rate), quantum_begin, quantum_end);
+    if (start_frame >= stop_frame)
+        return;
+
+    render(output, start_frame - quantum_begin, stop_frame - quantum_begin, context);
+}
+
+void GainRenderNode::process(AudioBus const& input, AudioBus& output, RenderContext const&)
+{
+    // FIXME: The gain is an a-rate parameter, but without automation events it's constant over a render quantum.
+    auto gain = m_gain->value();
+    for (size_t i = 0; i < output.channel_count(); ++i)
+        Kernels::scale(output.channel(i), input.channel(i), gain);
+}
+
+void ConstantSourceRenderNode::render(AudioBus& output, size_t begin, size_t end, RenderContext const&)
+{
+    Kernels::fill(output.channel(0).slice(begin, end - begin), m_offset->value());
+}
+
+// https://webaudio.github.io/web-audio-api/#oscillator-coefficients
+void OscillatorRenderNode::render(AudioBus& output, size_t begin, size_t end, RenderContext const& context)
+{
+    // computedOscFrequency(t) = frequency(t) * pow(2, detune(t) / 1200)
+    auto nyquist_frequency = context.sample_rate / 2;
+    auto computed_frequency = clamp(m_frequency->value() * AK::exp2(m_detune->value() / 1200.0), -nyquist_frequency, nyquist_frequency);
+    auto phase_increment = computed_frequency / context.sample_rate;
+
+    // FIXME: The square, sawtooth and triangle waveforms should be band-limited, as if they were generated from their
+    //        Fourier series, rather than computed directly from the phase.
+    auto type = m_type.load(AK::memory_order_relaxed);
+    auto samples = output.channel(0);
+    for (size_t i = begin; i < end; ++i) {
+        switch (type) {
+        case Bindings::OscillatorType::Square:
+            samples[i] = m_phase < 0.5 ? 1 : -1;
+            break;
+        case Bindings::OscillatorType::Sawtooth:
+            samples[i] = static_cast<float>(m_phase < 0.5 ? 2 * m_phase : 2 * m_phase - 2);
+            break;
+        case Bindings::OscillatorType::Triangle:
+            if (m_phase < 0.25)
+                samples[i] = static_cast<float>(4 * m_phase);
+            else if (m_phase < 0.75)
+                samples[i] = static_cast<float>(2 - 4 * m_phase);
+            else
+                samples[i] = static_cast<float>(4 * m_phase - 4);
+            break;
+        case Bindings::OscillatorType::Custom:
+            // FIXME: Render the PeriodicWave set by setPeriodicWave().
+            [[fallthrough]];
+        case Bindings::OscillatorType::Sine:
+            samples[i] = static_cast<float>(AK::sin(2 * AK::Pi<double> * m_phase));
+            break;
+        }
+
+        m_phase += phase_increment;
+        m_phase -= AK::floor(m_phase);
+    }
+}
+
+// https://webaudio.github.io/web-audio-api/#filters-characteristics
+BiquadFilterRenderNode::Coefficients BiquadFilterRenderNode::compute_coefficients(Bindings::BiquadFilterType type, double sample_rate, double frequency, double detune, double q, double gain)
+{
+    auto computed_frequency = clamp(frequency * AK::exp2(detune / 1200), 0.0, sample_rate / 2);
+
+    auto A = AK::pow(10.0, gain / 40);
+    auto omega_0 = 2 * AK::Pi<double> * computed_frequency / sample_rate;
+    auto sin_omega_0 = AK::sin(omega_0);
+    auto cos_omega_0 = AK::cos(omega_0);
+    auto alpha_q = sin_omega_0 / (2 * q);
+    auto alpha_q_db = sin_omega_0 / (2 * AK::pow(10.0, q / 20));
+    auto alpha_s = sin_omega_0 / 2 * AK::sqrt(2.0);
+    auto sqrt_A = AK::sqrt(A);
+
+    double b0 = 1, b1 = 0, b2 = 0, a0 = 1, a1 = 0, a2 = 0;
+
+    // FIXME: Handle the remaining limiting cases from the spec, for frequencies of 0 or the Nyquist frequency.
+    //        A non-positive Q is the one that would otherwise produce a division by zero, so for now the filters that
+    //        depend on it simply pass their input through.
+    auto uses_q_as_bandwidth = first_is_one_of(type, Bindings::BiquadFilterType::Bandpass, Bindings::BiquadFilterType::Notch, Bindings::BiquadFilterType::Allpass, Bindings::BiquadFilterType::Peaking);
+    if (uses_q_as_bandwidth && q <= 0)
+        return {};
+
+    switch (type) {
+    case Bindings::BiquadFilterType::Lowpass:
+        b0 = (1 - cos_omega_0) / 2;
+        b1 = 1 - cos_omega_0;
+        b2 = (1 - cos_omega_0) / 2;
+        a0 = 1 + alpha_q_db;
+        a1 = -2 * cos_omega_0;
+        a2 = 1 - alpha_q_db;
+        break;
+    case Bindings::BiquadFilterType::Highpass:
+        b0 = (1 + cos_omega_0) / 2;
+        b1 = -(1 + cos_omega_0);
+        b2 = (1 + cos_omega_0) / 2;
+        a0 = 1 + alpha_q_db;
+        a1 = -2 * cos_omega_0;
+        a2 = 1 - alpha_q_db;
+        break;
+    case Bindings::BiquadFilterType::Bandpass:
+        b0 = alpha_q;
+        b1 = 0;
+        b2 = -alpha_q;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_omega_0;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Notch:
+        b0 = 1;
+        b1 = -2 * cos_omega_0;
+        b2 = 1;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_omega_0;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Allpass:
+        b0 = 1 - alpha_q;
+        b1 = -2 * cos_omega_0;
+        b2 = 1 + alpha_q;
+        a0 = 1 + alpha_q;
+        a1 = -2 * cos_omega_0;
+        a2 = 1 - alpha_q;
+        break;
+    case Bindings::BiquadFilterType::Peaking:
+        b0 = 1 + alpha_q * A;
+        b1 = -2 * cos_omega_0;
+        b2 = 1 - alpha_q * A;
+        a0 = 1 + alpha_q / A;
+        a1 = -2 * cos_omega_0;
+        a2 = 1 - alpha_q / A;
+        break;
+    case Bindings::BiquadFilterType::Lowshelf:
+        b0 = A * ((A + 1) - (A - 1) * cos_omega_0 + 2 * alpha_s * sqrt_A);
+        b1 = 2 * A * ((A - 1) - (A + 1) * cos_omega_0);
+        b2 = A * ((A + 1) - (A - 1) * cos_omega_0 - 2 * alpha_s * sqrt_A);
+        a0 = (A + 1) + (A - 1) * cos_omega_0 + 2 * alpha_s * sqrt_A;
+        a1 = -2 * ((A - 1) + (A + 1) * cos_omega_0);
+        a2 = (A + 1) + (A - 1) * cos_omega_0 - 2 * alpha_s * sqrt_A;
+        break;
+    case Bindings::BiquadFilterType::Highshelf:
+        b0 = A * ((A + 1) + (A - 1) * cos_omega_0 + 2 * alpha_s * sqrt_A);
+        b1 = -2 * A * ((A - 1) + (A + 1) * cos_omega_0);
+        b2 = A * ((A + 1) + (A - 1) * cos_omega_0 - 2 * alpha_s * sqrt_A);
+        a0 = (A + 1) - (A - 1) * cos_omega_0 + 2 * alpha_s * sqrt_A;
+        a1 = 2 * ((A - 1) - (A + 1) * cos_omega_0);
+        a2 = (A + 1) - (A - 1) * cos_omega_0 - 2 * alpha_s * sqrt_A;
+        break;
+    }
+
+    return { b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0 };
+}
+
+void BiquadFilterRenderNode::process(AudioBus const& input, AudioBus& output, RenderContext const& context)
+{
+    // FIXME: All four parameters are a-rate, but without automation events they're constant over a render quantum,
+    //        which lets the coefficients be computed once per quantum instead of once per sample-frame.
+    auto coefficients = compute_coefficients(m_type.load(AK::memory_order_relaxed), context.sample_rate,
+        m_frequency->value(), m_detune->value(), m_q->value(), m_gain->value());
+
+    // A change in the number of channels starts the new channels from silence.
+    if (m_history.size() != output.channel_count())
+        m_history.resize(output.channel_count());
+
+    for (size_t channel = 0; channel < output.channel_count(); ++channel) {
+        auto source = input.channel(channel);
+        auto destination = output.channel(channel);
+        auto& history = m_history[channel];
+
+        for (size_t i = 0; i < RENDER_QUANTUM_SIZE; ++i) {
+            double x = source[i];
+            double y = coefficients.b0 * x + coefficients.b1 * history.x1 + coefficients.b2 * history.x2
+                - coefficients.a1 * history.y1 - coefficients.a2 * history.y2;
+            history.x2 = history.x1;
+            history.x1 = x;
+            history.y2 = history.y1;
+            history.y1 = y;
+            destination[i] = static_cast<float>(y);
+        }
+    }
+}
+
+void DelayRenderNode::process(AudioBus const& input, AudioBus& output, RenderContext const& context)
+{
+    // The ring buffer holds the maximum delay, plus one frame for the interpolation and one for the current frame.
+    auto delay_line_size = static_cast<size_t>(AK::ceil(m_max_delay_time * context.sample_rate)) + 2;
+
+    // NOTE: This only allocates the first time a channel is seen, never in the steady state.
+    if (m_delay_lines.size() < output.channel_count()) {
+        m_delay_lines.resize(output.channel_count());
+        for (auto& delay_line : m_delay_lines) {
+            if (delay_line.is_empty())
+                delay_line.resize(delay_line_size);
+        }
+    }
+
+    // FIXME: The delay time is an a-rate parameter, but without automation events it's constant over a render quantum.
+    auto delay_in_frames = clamp(static_cast<double>(m_delay_time->value()), 0.0, m_max_delay_time) * context.sample_rate;
+
+    for (size_t channel = 0; channel < output.channel_count(); ++channel) {
+        auto source = input.channel(channel);
+        auto destination = output.channel(channel);
+        auto& delay_line = m_delay_lines[channel];
+
+        for (size_t i = 0; i < RENDER_QUANTUM_SIZE; ++i) {
+            auto write_index = (m_write_index + i) % delay_line_size;
+            delay_line[write_index] = source[i];
+
+            // Linearly interpolate between the two frames surrounding the fractional read position.
+            auto read_position = static_cast<double>(write_index + delay_line_size) - delay_in_frames;
+            auto read_index = static_cast<size_t>(read_position);
+            auto fraction = static_cast<float>(read_position - static_cast<double>(read_index));
+            auto earlier = delay_line[read_index % delay_line_size];
+            auto later = delay_line[(read_index + 1) % delay_line_size];
+            destination[i] = earlier + (later - earlier) * fraction;
+        }
+    }
+
+    m_write_index = (m_write_index + RENDER_QUANTUM_SIZE) % delay_line_size;
+}
+
+// https://webaudio.github.io/web-audio-api/#DynamicsCompressorOptions-processing
+void DynamicsCompressorRenderNode::process(AudioBus const& input, AudioBus& output, RenderContext const& context)
+{
+    auto threshold = static_cast<double>(m_parameters.threshold->value());
+    auto knee = static_cast<double>(m_parameters.knee->value());
+    auto ratio = static_cast<double>(m_parameters.ratio->value());
+    auto attack = max(static_cast<double>(m_parameters.attack->value()), 1.0 / context.sample_rate);
+    auto release = max(static_cast<double>(m_parameters.release->value()), 1.0 / context.sample_rate);
+
+    // The static compression curve, with a quadratic soft knee centered on the threshold. Returns the output level in
+    // decibels for an input level in decibels.
+    auto compression_curve = [&](double level) {
+        auto overshoot = level - threshold;
+        if (2 * overshoot < -knee)
+            return level;
+        if (2 * AK::fabs(overshoot) <= knee) {
+            auto knee_position = overshoot + knee / 2;
+            return level + (1 / ratio - 1) * knee_position * knee_position / (2 * knee);
+        }
+        return threshold + overshoot / ratio;
+    };
+
+    // https://webaudio.github.io/web-audio-api/#compression-curve
+    // makeupGain = (1 / fullRangeGain) ^ 0.6, where fullRangeGain is the curve's gain for a full-scale input.
+    auto makeup_gain_in_decibels = -0.6 * compression_curve(0);
+
+    auto attack_coefficient = AK::exp(-1 / (attack * context.sample_rate));
+    auto release_coefficient = AK::exp(-1 / (release * context.sample_rate));
+
+    // The detector follows the loudest channel, so that all channels are reduced by the same amount.
+    AudioBus::Channel detector;
+    Kernels::fill(detector.span(), 0);
+    for (size_t channel = 0; channel < input.channel_count(); ++channel)
+        Kernels::accumulate_magnitude(detector.span(), input.channel(channel));
+
+    AudioBus::Channel gains;
+    for (size_t i = 0; i < RENDER_QUANTUM_SIZE; ++i) {
+        auto level = linear_to_decibels(detector[i]);
+        auto target = compression_curve(level) - level;
+
+        auto coefficient = target < m_envelope_in_decibels ? attack_coefficient : release_coefficient;
+        m_envelope_in_decibels = static_cast<float>(target + coefficient * (m_envelope_in_decibels - target));
+        gains[i] = static_cast<float>(decibels_to_linear(m_envelope_in_decibels + makeup_gain_in_decibels));
+    }
+
+    for (size_t channel = 0; channel < output.channel_count(); ++channel) {
+        auto source = input.channel(channel);
+        auto destination = output.channel(channel);
+        for (size_t i = 0; i < RENDER_QUANTUM_SIZE; ++i)
+            destination[i] = source[i] * gains[i];
+    }
+
+    m_reduction.store(m_envelope_in_decibels, AK::memory_order_relaxed);
+}
+
+}
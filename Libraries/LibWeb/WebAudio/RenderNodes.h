@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/NumericLimits.h>
+#include <AK/Vector.h>
+#include <LibWeb/Bindings/BiquadFilterNodePrototype.h>
+#include <LibWeb/Bindings/OscillatorNodePrototype.h>
+#include <LibWeb/WebAudio/RenderGraph.h>
+
+// The rendering-side implementations of the audio nodes. Everything here runs on the rendering thread, except for
+// the setters that are explicitly documented as being called from the control thread; those only store atomics.
+namespace Web::WebAudio {
+
+// Copies its input to its output. Used for nodes that don't alter the signal (AudioDestinationNode, AnalyserNode),
+// and for nodes whose processing isn't implemented yet.
+class PassThroughRenderNode final : public RenderNode {
+public:
+    static NonnullRefPtr<PassThroughRenderNode> create() { return adopt_ref(*new PassThroughRenderNode); }
+
+    virtual void process(AudioBus const& input, AudioBus& output, RenderContext const&) override;
+};
+
+// Outputs a single channel of silence. Used for source nodes whose processing isn't implemented yet.
+class SilentRenderNode final : public RenderNode {
+public:
+    static NonnullRefPtr<SilentRenderNode> create() { return adopt_ref(*new SilentRenderNode); }
+
+    virtual size_t output_channel_count(size_t) const override { return 1; }
+    virtual void process(AudioBus const& input, AudioBus& output, RenderContext const&) override;
+};
+
+// https://webaudio.github.io/web-audio-api/#AudioScheduledSourceNode
+// Outputs silence outside of the time span between the scheduled start and stop times, with sample accuracy.
+class ScheduledSourceRenderNode : public RenderNode {
+public:
+    static NonnullRefPtr<ScheduledSourceRenderNode> create() { return adopt_ref(*new ScheduledSourceRenderNode); }
+
+    // Called from the control thread.
+    void set_start_time(double when) { m_start_time.store(when, AK::memory_order_release); }
+    void set_stop_time(double when) { m_stop_time.store(when, AK::memory_order_release); }
+
+    virtual size_t output_channel_count(size_t) const override { return 1; }
+    virtual void process(AudioBus const& input, AudioBus& output, RenderContext const&) final;
+
+protected:
+    ScheduledSourceRenderNode() = default;
+
+    // Renders the frames [begin, end) of the output, which is zeroed beforehand. Sources whose playback isn't
+    // implemented yet (AudioBufferSourceNode) keep this default and stay silent.
+    virtual void render(AudioBus&, size_t, size_t, RenderContext const&) { }
+
+private:
+    static constexpr double not_scheduled = AK::NumericLimits<double>::max();
+
+    Atomic<double> m_start_time { not_scheduled };
+    Atomic<double> m_stop_time { not_scheduled };
+};
+
+// https://webaudio.github.io/web-audio-api/#GainNode
+class GainRenderNode final : public RenderNode {
+public:
+    static NonnullRefPtr<GainRenderNode> create(NonnullRefPtr<RenderParam> gain) { return adopt_ref(*new GainRenderNode(move(gain))); }
+
+    virtual void process(AudioBus const& input, AudioBus& output, RenderContext const&) override;
+
+private:
+    explicit GainRenderNode(NonnullRefPtr<RenderParam> gain)
+        : m_gain(move(gain))
+    {
+    }
+
+    NonnullRefPtr<RenderParam> m_gain;
+};
+
+// https://webaudio.github.io/web-audio-api/#ConstantSourceNode
+class ConstantSourceRenderNode final : public ScheduledSourceRenderNode {
+public:
+    static NonnullRefPtr<ConstantSourceRenderNode> create(NonnullRefPtr<RenderParam> offset) { return adopt_ref(*new ConstantSourceRenderNode(move(offset))); }
+
+private:
+    explicit ConstantSourceRenderNode(NonnullRefPtr<RenderParam> offset)
+        : m_offset(move(offset))
+    {
+    }
+
+    virtual void render(AudioBus&, size_t begin, size_t end, RenderContext const&) override;
+
+    NonnullRefPtr<RenderParam> m_offset;
+};
+
+// https://webaudio.github.io/web-audio-api/#OscillatorNode
+class OscillatorRenderNode final : public ScheduledSourceRenderNode {
+public:
+    static NonnullRefPtr<OscillatorRenderNode> create(Bindings::OscillatorType type, NonnullRefPtr<RenderParam> frequency, NonnullRefPtr<RenderParam> detune)
+    {
+        return adopt_ref(*new OscillatorRenderNode(type, move(frequency), move(detune)));
+    }
+
+    // Called from the control thread.
+    void set_type(Bindings::OscillatorType type) { m_type.store(type, AK::memory_order_relaxed); }
+
+private:
+    OscillatorRenderNode(Bindings::OscillatorType type, NonnullRefPtr<RenderParam> frequency, NonnullRefPtr<RenderParam> detune)
+        : m_type(type)
+        , m_frequency(move(frequency))
+        , m_detune(move(detune))
+    {
+    }
+
+    virtual void render(AudioBus&, size_t begin, size_t end, RenderContext const&) override;
+
+    Atomic<Bindings::OscillatorType> m_type;
+    NonnullRefPtr<RenderParam> m_frequency;
+    NonnullRefPtr<RenderParam> m_detune;
+
+    // The position within the current period, in the range [0, 1).
+    double m_phase { 0 };
+};
+
+// https://webaudio.github.io/web-audio-api/#BiquadFilterNode
+class BiquadFilterRenderNode final : public RenderNode {
+public:
+    static NonnullRefPtr<BiquadFilterRenderNode> create(Bindings::BiquadFilterType type, NonnullRefPtr<RenderParam> frequency, NonnullRefPtr<RenderParam> detune, NonnullRefPtr<RenderParam> q, NonnullRefPtr<RenderParam> gain)
+    {
+        return adopt_ref(*new BiquadFilterRenderNode(type, move(frequency), move(detune), move(q), move(gain)));
+    }
+
+    // Called from the control thread.
+    void set_type(Bindings::BiquadFilterType type) { m_type.store(type, AK::memory_order_relaxed); }
+
+    virtual void process(AudioBus const& input, AudioBus& output, RenderContext const&) override;
+
+    // The normalized coefficients of the transfer function, with a0 divided out.
+    // https://webaudio.github.io/web-audio-api/#filters-characteristics
+    struct Coefficients {
+        double b0 { 1 };
+        double b1 { 0 };
+        double b2 { 0 };
+        double a1 { 0 };
+        double a2 { 0 };
+    };
+    static Coefficients compute_coefficients(Bindings::BiquadFilterType, double sample_rate, double frequency, double detune, double q, double gain);
+
+private:
+    BiquadFilterRenderNode(Bindings::BiquadFilterType type, NonnullRefPtr<RenderParam> frequency, NonnullRefPtr<RenderParam> detune, NonnullRefPtr<RenderParam> q, NonnullRefPtr<RenderParam> gain)
+        : m_type(type)
+        , m_frequency(move(frequency))
+        , m_detune(move(detune))
+        , m_q(move(q))
+        , m_gain(move(gain))
+    {
+    }
+
+    struct History {
+        double x1 { 0 };
+        double x2 { 0 };
+        double y1 { 0 };
+        double y2 { 0 };
+    };
+
+    Atomic<Bindings::BiquadFilterType> m_type;
+    NonnullRefPtr<RenderParam> m_frequency;
+    NonnullRefPtr<RenderParam> m_detune;
+    NonnullRefPtr<RenderParam> m_q;
+    NonnullRefPtr<RenderParam> m_gain;
+
+    Vector<History, 2> m_history;
+};
+
+// https://webaudio.github.io/web-audio-api/#DelayNode
+class DelayRenderNode final : public RenderNode {
+public:
+    static NonnullRefPtr<DelayRenderNode> create(NonnullRefPtr<RenderParam> delay_time, double max_delay_time)
+    {
+        return adopt_ref(*new DelayRenderNode(move(delay_time), max_delay_time));
+    }
+
+    virtual void process(AudioBus const& input, AudioBus& output, RenderContext const&) override;
+
+private:
+    DelayRenderNode(NonnullRefPtr<RenderParam> delay_time, double max_delay_time)
+        : m_delay_time(move(delay_time))
+        , m_max_delay_time(max_delay_time)
+    {
+    }
+
+    NonnullRefPtr<RenderParam> m_delay_time;
+    double m_max_delay_time { 0 };
+
+    // One ring buffer per channel, all sharing the same write position.
+    Vector<Vector<float>, 2> m_delay_lines;
+    size_t m_write_index { 0 };
+};
+
+// https://webaudio.github.io/web-audio-api/#DynamicsCompressorNode
+class DynamicsCompressorRenderNode final : public RenderNode {
+public:
+    struct Parameters {
+        NonnullRefPtr<RenderParam> threshold;
+        NonnullRefPtr<RenderParam> knee;
+        NonnullRefPtr<RenderParam> ratio;
+        NonnullRefPtr<RenderParam> attack;
+        NonnullRefPtr<RenderParam> release;
+    };
+    static NonnullRefPtr<DynamicsCompressorRenderNode> create(Parameters parameters) { return adopt_ref(*new DynamicsCompressorRenderNode(move(parameters))); }
+
+    // https://webaudio.github.io/web-audio-api/#dom-dynamicscompressornode-internal-reduction-slot
+    // Read by the control thread.
+    float reduction() const { return m_reduction.load(AK::memory_order_relaxed); }
+
+    virtual void process(AudioBus const& input, AudioBus& output, RenderContext const&) override;
+
+private:
+    explicit DynamicsCompressorRenderNode(Parameters parameters)
+        : m_parameters(move(parameters))
+    {
+    }
+
+    Parameters m_parameters;
+
+    // The smoothed gain reduction currently applied, in decibels (always <= 0).
+    float m_envelope_in_decibels { 0 };
+
+    Atomic<float> m_reduction { 0 };
+};
+
+}
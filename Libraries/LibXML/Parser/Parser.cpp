@@ -68,18 +68,35 @@ namespace XML {
 
 size_t Parser::s_debug_indent_level { 0 };
 
-void Parser::append_node(NonnullOwnPtr<Node> node)
+void Parser::enter_element(StartTag&& tag)
 {
+    // NOTE: A listener sees the element as it goes by, there is no tree to keep it in.
+    if (m_listener) {
+        m_listener->element_start(tag.name, tag.attributes);
+        return;
+    }
+
+    auto node = make<Node>(tag.position, Node::Element { move(tag.name), move(tag.attributes), {} }, m_entered_node);
     if (m_entered_node) {
         auto& entered_element = m_entered_node->content.get<Node::Element>();
         entered_element.children.append(move(node));
-        enter_node(*entered_element.children.last());
+        m_entered_node = entered_element.children.last().ptr();
     } else {
         m_root_node = move(node);
-        enter_node(*m_root_node);
+        m_entered_node = m_root_node.ptr();
     }
 }
 
+void Parser::leave_element(Name const& name)
+{
+    if (m_listener) {
+        m_listener->element_end(name);
+        return;
+    }
+
+    m_entered_node = m_entered_node->parent;
+}
+
 void Parser::append_text(StringView text, LineTrackingLexer::Position position)
 {
     if (m_listener) {
@@ -135,28 +152,6 @@ void Parser::append_comment(StringView text, LineTrackingLexer::Position positio
         });
 }
 
-void Parser::enter_node(Node& node)
-{
-    if (m_listener) {
-        auto& element = node.content.get<Node::Element>();
-        m_listener->element_start(element.name, element.attributes);
-    }
-
-    if (&node != m_root_node.ptr())
-        node.parent = m_entered_node;
-    m_entered_node = &node;
-}
-
-void Parser::leave_node()
-{
-    if (m_listener) {
-        auto& element = m_entered_node->content.get<Node::Element>();
-        m_listener->element_end(element.name);
-    }
-
-    m_entered_node = m_entered_node->parent;
-}
-
 ErrorOr<Document, ParseError> Parser::parse()
 {
     if (auto result = parse_internal(); result.is_error()) {
@@ -174,6 +169,7 @@ ErrorOr<Document, ParseError> Parser::parse()
 
 ErrorOr<void, ParseError> Parser::parse_with_listener(Listener& listener)
 {
+    VERIFY(!m_incremental_state);
     m_listener = &listener;
     ScopeGuard unset_listener { [this] { m_listener = nullptr; } };
     m_listener->set_source(m_source);
@@ -186,6 +182,331 @@ ErrorOr<void, ParseError> Parser::parse_with_listener(Listener& listener)
     return result;
 }
 
+ErrorOr<void, ParseError> Parser::feed(StringView chunk)
+{
+    VERIFY(m_incremental_state);
+    auto& state = *m_incremental_state;
+    VERIFY(!state.is_finished);
+    if (state.error.has_value())
+        return *state.error;
+
+    state.input.append(chunk.bytes());
+    return parse_available_input();
+}
+
+ErrorOr<void, ParseError> Parser::finish()
+{
+    VERIFY(m_incremental_state);
+    auto& state = *m_incremental_state;
+    VERIFY(!state.is_finished);
+    if (state.error.has_value())
+        return *state.error;
+
+    // NOTE: There is no more input to wait for, so whatever is left has to parse as it is.
+    state.is_finished = true;
+    TRY(parse_available_input());
+
+    if (state.stage == IncrementalState::Stage::Content)
+        return fail_incremental_parse(ParseError { state.position, ByteString::formatted("Expected '</{}>'", state.open_elements.last()) });
+
+    m_listener->document_end();
+    return {};
+}
+
+ErrorOr<void, ParseError> Parser::fail_incremental_parse(ParseError error)
+{
+    m_incremental_state->error = error;
+    m_listener->error(error);
+    m_listener->document_end();
+    return error;
+}
+
+ErrorOr<void, ParseError> Parser::parse_available_input()
+{
+    auto& state = *m_incremental_state;
+    if (!state.has_started_document) {
+        state.has_started_document = true;
+        m_listener->document_start();
+    }
+
+    m_source = StringView { state.input.bytes() }.substring_view(state.consumed_offset);
+    m_lexer = LineTrackingLexer(m_source, state.position);
+
+    auto result = [&]() -> ErrorOr<void, ParseError> {
+        if (state.stage == IncrementalState::Stage::Prolog)
+            TRY(parse_available_prolog());
+        if (state.stage == IncrementalState::Stage::Content)
+            TRY(parse_available_content());
+        if (state.stage == IncrementalState::Stage::Epilog)
+            TRY(parse_available_epilog());
+        return check_for_restricted_characters(0, m_lexer.tell());
+    }();
+    if (result.is_error())
+        return fail_incremental_parse(result.release_error());
+
+    state.position = m_lexer.current_position();
+    state.consumed_offset += m_lexer.tell();
+
+    // Drop the consumed input once it makes up most of the buffer, so only incomplete markup is held on to.
+    if (state.consumed_offset > state.input.size() / 2) {
+        state.input = MUST(ByteBuffer::copy(state.input.bytes().slice(state.consumed_offset)));
+        state.consumed_offset = 0;
+        m_source = {};
+        m_lexer = LineTrackingLexer(m_source, state.position);
+    }
+
+    return {};
+}
+
+ErrorOr<void, ParseError> Parser::parse_available_prolog()
+{
+    auto& state = *m_incremental_state;
+
+    // prolog ::= XMLDecl? Misc* (doctypedecl Misc*)?
+    // NOTE: Like the content, each of these is only parsed once all of it is here, so nothing in the prolog is parsed
+    //       (or has its external resources resolved) more than once.
+    if (!state.has_checked_for_xml_decl) {
+        if (!state.is_finished && ("<?xml"sv.starts_with(m_lexer.remaining()) || (m_lexer.next_is("<?"sv) && !markup_is_complete())))
+            return {};
+
+        if (auto result = parse_xml_decl(); result.is_error()) {
+            m_version = Version::Version10;
+            m_in_compatibility_mode = true;
+        }
+        state.has_checked_for_xml_decl = true;
+    }
+
+    while (true) {
+        TRY(skip_whitespace());
+        if (m_lexer.is_eof()) {
+            // Without a root element, the content is what reports it missing.
+            if (state.is_finished)
+                state.stage = IncrementalState::Stage::Content;
+            return {};
+        }
+
+        if (!state.is_finished) {
+            auto remaining = m_lexer.remaining();
+            if ("<!DOCTYPE"sv.starts_with(remaining) || "<!--"sv.starts_with(remaining) || "<?"sv.starts_with(remaining))
+                return {};
+        }
+
+        if (m_lexer.next_is("<!--"sv) || m_lexer.next_is("<?"sv)) {
+            if (!state.is_finished && !markup_is_complete())
+                return {};
+            if (m_lexer.next_is("<!--"sv))
+                TRY(parse_comment());
+            else
+                TRY(parse_processing_instruction());
+            continue;
+        }
+
+        if (!state.has_parsed_doctype && m_lexer.next_is("<!DOCTYPE"sv)) {
+            if (!state.is_finished && !doctype_is_complete())
+                return {};
+            TRY(parse_doctype_decl());
+            state.has_parsed_doctype = true;
+            continue;
+        }
+
+        break;
+    }
+
+    state.stage = IncrementalState::Stage::Content;
+    return {};
+}
+
+bool Parser::doctype_is_complete()
+{
+    auto& scan = m_incremental_state->doctype_scan;
+    auto remaining = m_lexer.remaining();
+
+    // doctypedecl ::= '<!DOCTYPE' S Name (S ExternalID)? S? ('[' intSubset ']' S?)? '>'
+    // NOTE: The doctype ends at the first '>' past its internal subset that is not inside a literal. Inside the internal
+    //       subset, comments and processing instructions may contain anything too. The scan picks up where the last
+    //       one stopped, so a large internal subset that arrives in pieces is only looked at once.
+    while (scan.offset < remaining.length()) {
+        if (!scan.awaited_delimiter.is_empty()) {
+            auto delimiter_offset = remaining.find(scan.awaited_delimiter, scan.offset);
+            if (!delimiter_offset.has_value()) {
+                // The delimiter may be split across chunks, so its start is looked at again.
+                scan.offset = max(scan.offset, remaining.length() - min(remaining.length(), scan.awaited_delimiter.length() - 1));
+                return false;
+            }
+            scan.offset = *delimiter_offset + scan.awaited_delimiter.length();
+            scan.awaited_delimiter = {};
+            continue;
+        }
+
+        auto rest = remaining.substring_view(scan.offset);
+        auto ch = rest[0];
+        if (ch == '"' || ch == '\'') {
+            scan.awaited_delimiter = ch == '"' ? "\""sv : "'"sv;
+        } else if (scan.is_in_internal_subset) {
+            if (rest.starts_with("<!--"sv)) {
+                scan.awaited_delimiter = "-->"sv;
+                scan.offset += 3;
+            } else if (rest.starts_with("<?"sv)) {
+                scan.awaited_delimiter = "?>"sv;
+                scan.offset += 1;
+            } else if ("<!--"sv.starts_with(rest)) {
+                return false;
+            } else if (ch == ']') {
+                scan.is_in_internal_subset = false;
+            }
+        } else if (ch == '[') {
+            scan.is_in_internal_subset = true;
+        } else if (ch == '>') {
+            scan = {};
+            return true;
+        }
+        ++scan.offset;
+    }
+    return false;
+}
+
+bool Parser::markup_is_complete() const
+{
+    auto remaining = m_lexer.remaining();
+    if (remaining.starts_with("<!--"sv))
+        return remaining.find("-->"sv, 4).has_value();
+    if (remaining.starts_with("<![CDATA["sv))
+        return remaining.find("]]>"sv, 9).has_value();
+    if (remaining.starts_with("<?"sv))
+        return remaining.find("?>"sv, 2).has_value();
+    if ("<!--"sv.starts_with(remaining) || "<![CDATA["sv.starts_with(remaining))
+        return false;
+
+    // Anything else is a tag, which ends at the first '>' that is not inside an attribute value.
+    Optional<char> quote;
+    for (auto ch : remaining) {
+        if (quote.has_value()) {
+            if (ch == *quote)
+                quote.clear();
+        } else if (ch == '"' || ch == '\'') {
+            quote = ch;
+        } else if (ch == '>') {
+            return true;
+        }
+    }
+    return false;
+}
+
+ErrorOr<void, ParseError> Parser::parse_available_content()
+{
+    auto& state = *m_incremental_state;
+
+    // element ::= EmptyElemTag
+    //           | STag content ETag
+    // content ::= CharData? ((element | Reference | CDSect | PI | Comment) CharData?)*
+    // NOTE: Each of these is only parsed once all of it is here. Elements are entered and left as their tags go by,
+    //       starting with the root element.
+    if (state.open_elements.is_empty() && m_lexer.is_eof()) {
+        if (state.is_finished)
+            return parse_error(m_lexer.current_position(), Expectation { "the root element"sv });
+        return {};
+    }
+
+    while (!m_lexer.is_eof()) {
+        auto node_start = m_lexer.tell();
+
+        if (state.open_elements.is_empty() || m_lexer.next_is('<')) {
+            if (!state.is_finished && !markup_is_complete())
+                return {};
+
+            if (state.open_elements.is_empty()) {
+                // This is the root element.
+            } else if (m_lexer.next_is("</"sv)) {
+                auto closing_name = TRY(parse_end_tag());
+
+                // Well-formedness constraint: The Name in an element's end-tag MUST match the element type in the start-tag.
+                if (m_options.treat_errors_as_fatal && closing_name != state.open_elements.last())
+                    return parse_error(m_lexer.position_for(node_start), ByteString { "Invalid closing tag"sv });
+
+                leave_element(state.open_elements.take_last());
+                if (state.open_elements.is_empty()) {
+                    state.stage = IncrementalState::Stage::Epilog;
+                    return {};
+                }
+                continue;
+            } else if (m_lexer.next_is("<!--"sv)) {
+                TRY(parse_comment());
+                continue;
+            } else if (m_lexer.next_is("<![CDATA["sv)) {
+                auto text = TRY(parse_cdata_section());
+                if (m_options.preserve_cdata)
+                    append_text(text, m_lexer.position_for(node_start));
+                continue;
+            } else if (m_lexer.next_is("<?"sv)) {
+                TRY(parse_processing_instruction());
+                continue;
+            }
+
+            auto start_tag = TRY(parse_start_tag());
+            auto name = start_tag.name;
+            auto is_empty_element_tag = start_tag.is_empty_element_tag;
+            enter_element(move(start_tag));
+
+            if (!is_empty_element_tag) {
+                state.open_elements.append(move(name));
+                continue;
+            }
+
+            leave_element(name);
+            if (state.open_elements.is_empty()) {
+                state.stage = IncrementalState::Stage::Epilog;
+                return {};
+            }
+            continue;
+        }
+
+        if (m_lexer.next_is('&')) {
+            if (!state.is_finished && !m_lexer.remaining().contains(';'))
+                return {};
+
+            auto reference = TRY(parse_reference());
+            auto reference_offset = m_lexer.position_for(node_start);
+            if (auto char_reference = reference.get_pointer<ByteString>())
+                append_text(*char_reference, reference_offset);
+            else
+                append_text(TRY(resolve_reference(reference.get<EntityReference>(), ReferencePlacement::Content)), reference_offset);
+            continue;
+        }
+
+        // Character data runs up to the next markup or reference, so it can't be parsed before that is here.
+        if (!state.is_finished && !m_lexer.remaining().find_any_of("<&"sv).has_value())
+            return {};
+
+        auto text = TRY(parse_char_data());
+        if (text.is_empty())
+            return parse_error(m_lexer.current_position(), ByteString { "']]>' is not allowed in character data"sv });
+        append_text(text, m_lexer.position_for(node_start));
+    }
+
+    return {};
+}
+
+ErrorOr<void, ParseError> Parser::parse_available_epilog()
+{
+    auto& state = *m_incremental_state;
+
+    // Misc ::= Comment | PI | S
+    while (true) {
+        TRY(skip_whitespace());
+        if (m_lexer.is_eof())
+            return {};
+        if (!state.is_finished && m_lexer.next_is('<') && !markup_is_complete())
+            return {};
+
+        if (m_lexer.next_is("<!--"sv))
+            TRY(parse_comment());
+        else if (m_lexer.next_is("<?"sv))
+            TRY(parse_processing_instruction());
+        else
+            return parse_error(m_lexer.current_position(), ByteString { "Garbage after document"sv });
+    }
+}
+
 // 2.3.3. S, https://www.w3.org/TR/2006/REC-xml11-20060816/#NT-S
 ErrorOr<void, ParseError> Parser::skip_whitespace(Required required)
 {
@@ -217,12 +538,7 @@ ErrorOr<void, ParseError> Parser::parse_internal()
             break;
     }
 
-    auto matched_source = m_source.substring_view(0, m_lexer.tell());
-    if (auto it = find_if(matched_source.begin(), matched_source.end(), s_restricted_characters); !it.is_end()) {
-        return parse_error(
-            m_lexer.position_for(it.index()),
-            ByteString::formatted("Invalid character #{:x} used in document", *it));
-    }
+    TRY(check_for_restricted_characters(0, m_lexer.tell()));
 
     if (!m_lexer.is_eof())
         return parse_error(m_lexer.current_position(), ByteString { "Garbage after document"sv });
@@ -230,6 +546,17 @@ ErrorOr<void, ParseError> Parser::parse_internal()
     return {};
 }
 
+ErrorOr<void, ParseError> Parser::check_for_restricted_characters(size_t start, size_t end)
+{
+    auto matched_source = m_source.substring_view(start, end - start);
+    if (auto it = find_if(matched_source.begin(), matched_source.end(), s_restricted_characters); !it.is_end()) {
+        return parse_error(
+            m_lexer.position_for(start + it.index()),
+            ByteString::formatted("Invalid character #{:x} used in document", *it));
+    }
+    return {};
+}
+
 ErrorOr<void, ParseError> Parser::expect(StringView expected)
 {
     auto rollback = rollback_point();
@@ -510,7 +837,7 @@ ErrorOr<void, ParseError> Parser::parse_processing_instruction()
 }
 
 // 2.6.17. PITarget, https://www.w3.org/TR/2006/REC-xml11-20060816/#NT-PITarget
-ErrorOr<Name, ParseError> Parser::parse_processing_instruction_target()
+ErrorOr<StringView, ParseError> Parser::parse_processing_instruction_target()
 {
     auto rollback = rollback_point();
     auto rule = enter_rule();
@@ -536,7 +863,7 @@ constexpr static auto s_name_start_characters = ranges_for_search<Range(':', ':'
 constexpr static auto s_name_characters = s_name_start_characters.with<Range('-', '-'), Range('.', '.'), Range('0', '9'), Range(0xb7, 0xb7), Range(0x0300, 0x036f), Range(0x203f, 0x2040)>();
 
 // 2.3.5. Name, https://www.w3.org/TR/2006/REC-xml11-20060816/#NT-Name
-ErrorOr<Name, ParseError> Parser::parse_name()
+ErrorOr<StringView, ParseError> Parser::parse_name()
 {
     auto rollback = rollback_point();
     auto rule = enter_rule();
@@ -634,21 +961,21 @@ ErrorOr<void, ParseError> Parser::parse_element()
 
     // element ::= EmptyElemTag
     //           | STag content ETag
-    if (auto result = parse_empty_element_tag(); !result.is_error()) {
-        append_node(result.release_value());
-        leave_node();
+    auto accept = accept_rule();
+    auto start_tag = TRY(parse_start_tag());
+    auto name = start_tag.name;
+    auto is_empty_element_tag = start_tag.is_empty_element_tag;
+    enter_element(move(start_tag));
+
+    if (is_empty_element_tag) {
+        leave_element(name);
         rollback.disarm();
         return {};
     }
 
-    auto accept = accept_rule();
-    auto start_tag = TRY(parse_start_tag());
-    auto& node = *start_tag;
-    auto& tag = node.content.get<Node::Element>();
-    append_node(move(start_tag));
     ScopeGuard quit {
         [&] {
-            leave_node();
+            leave_element(name);
         }
     };
 
@@ -658,47 +985,13 @@ ErrorOr<void, ParseError> Parser::parse_element()
     auto closing_name = TRY(parse_end_tag());
 
     // Well-formedness constraint: The Name in an element's end-tag MUST match the element type in the start-tag.
-    if (m_options.treat_errors_as_fatal && closing_name != tag.name)
+    if (m_options.treat_errors_as_fatal && closing_name != name)
         return parse_error(m_lexer.position_for(tag_location), ByteString { "Invalid closing tag"sv });
 
     rollback.disarm();
     return {};
 }
 
-// 3.1.44. EmptyElemTag, https://www.w3.org/TR/2006/REC-xml11-20060816/#NT-EmptyElemTag
-ErrorOr<NonnullOwnPtr<Node>, ParseError> Parser::parse_empty_element_tag()
-{
-    auto rollback = rollback_point();
-    auto rule = enter_rule();
-
-    // EmptyElemTag ::= '<' Name (S Attribute)* S? '/>'
-    auto tag_start = m_lexer.tell();
-    TRY(expect("<"sv));
-
-    auto name = TRY(parse_name());
-    HashMap<Name, ByteString> attributes;
-
-    while (true) {
-        if (auto result = skip_whitespace(Required::Yes); result.is_error())
-            break;
-
-        if (auto result = parse_attribute(); !result.is_error()) {
-            auto attribute = result.release_value();
-            attributes.set(move(attribute.name), move(attribute.value));
-        } else {
-            break;
-        }
-    }
-
-    TRY(skip_whitespace());
-    TRY(expect("/>"sv));
-
-    auto accept = accept_rule();
-
-    rollback.disarm();
-    return make<Node>(m_lexer.position_for(tag_start), Node::Element { move(name), move(attributes), {} });
-}
-
 // 3.1.41. Attribute, https://www.w3.org/TR/2006/REC-xml11-20060816/#NT-Attribute
 ErrorOr<Attribute, ParseError> Parser::parse_attribute()
 {
@@ -741,6 +1034,9 @@ ErrorOr<ByteString, ParseError> Parser::parse_attribute_value_inner(StringView d
 {
     StringBuilder builder;
     while (true) {
+        // OPTIMIZATION: Copy runs of plain characters in one go, only references need to be looked at individually.
+        builder.append(m_lexer.consume_while([&](char ch) { return ch != '<' && ch != '&' && !disallow.contains(ch); }));
+
         if (m_lexer.next_is(is_any_of(disallow)) || m_lexer.is_eof())
             break;
 
@@ -819,12 +1115,15 @@ ErrorOr<Variant<Parser::EntityReference, ByteString>, ParseError> Parser::parse_
 }
 
 // 3.1.40 STag, https://www.w3.org/TR/2006/REC-xml11-20060816/#NT-STag
-ErrorOr<NonnullOwnPtr<Node>, ParseError> Parser::parse_start_tag()
+// 3.1.44. EmptyElemTag, https://www.w3.org/TR/2006/REC-xml11-20060816/#NT-EmptyElemTag
+ErrorOr<Parser::StartTag, ParseError> Parser::parse_start_tag()
 {
     auto rollback = rollback_point();
     auto rule = enter_rule();
 
     // STag ::= '<' Name (S Attribute)* S? '>'
+    // EmptyElemTag ::= '<' Name (S Attribute)* S? '/>'
+    // NOTE: Both are parsed here, as they only differ in how they end.
     auto tag_start = m_lexer.tell();
     TRY(expect("<"sv));
     auto accept = accept_rule();
@@ -845,14 +1144,16 @@ ErrorOr<NonnullOwnPtr<Node>, ParseError> Parser::parse_start_tag()
     }
 
     TRY(skip_whitespace());
-    TRY(expect(">"sv));
+    auto is_empty_element_tag = m_lexer.consume_specific("/>"sv);
+    if (!is_empty_element_tag)
+        TRY(expect(">"sv));
 
     rollback.disarm();
-    return make<Node>(m_lexer.position_for(tag_start), Node::Element { move(name), move(attributes), {} });
+    return StartTag { m_lexer.position_for(tag_start), name, move(attributes), is_empty_element_tag };
 }
 
 // 3.1.42 ETag, https://www.w3.org/TR/2006/REC-xml11-20060816/#NT-ETag
-ErrorOr<Name, ParseError> Parser::parse_end_tag()
+ErrorOr<StringView, ParseError> Parser::parse_end_tag()
 {
     auto rollback = rollback_point();
     auto rule = enter_rule();
@@ -1314,7 +1615,7 @@ ErrorOr<ElementDeclaration::ContentSpec, ParseError> Parser::parse_content_spec(
 
             auto parse_cp_init = [&]() -> ErrorOr<Variant<Name, ElementDeclaration::Children::Choice, ElementDeclaration::Children::Sequence>, ParseError> {
                 if (auto result = parse_name(); !result.is_error())
-                    return result.release_value();
+                    return Name { result.release_value() };
                 if (auto result = parse_choice(); !result.is_error())
                     return result.release_value();
                 return TRY(parse_sequence());
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
 #include <AK/Debug.h>
 #include <AK/Function.h>
@@ -66,9 +67,23 @@ public:
     {
     }
 
+    // Creates a parser that is handed its input piece by piece with feed(), and reports everything to the listener as
+    // soon as the markup for it is complete. The parser keeps its own copy of the input.
+    Parser(Listener& listener, Options options)
+        : m_lexer(StringView {})
+        , m_options(move(options))
+        , m_listener(&listener)
+        , m_incremental_state(make<IncrementalState>())
+    {
+    }
+
     ErrorOr<Document, ParseError> parse();
     ErrorOr<void, ParseError> parse_with_listener(Listener&);
 
+    // Incremental (SAX-style) parsing, only for parsers created with a listener. The listener is not given the source.
+    ErrorOr<void, ParseError> feed(StringView chunk);
+    ErrorOr<void, ParseError> finish();
+
     Vector<ParseError> const& parse_error_causes() const { return m_parse_errors; }
 
     ErrorOr<Vector<MarkupDeclaration>, ParseError> parse_external_subset();
@@ -78,12 +93,56 @@ private:
         Name name;
     };
 
+    struct StartTag {
+        LineTrackingLexer::Position position;
+        Name name;
+        HashMap<Name, ByteString> attributes;
+        bool is_empty_element_tag { false };
+    };
+
+    struct IncrementalState {
+        enum class Stage {
+            Prolog,
+            Content,
+            Epilog,
+        };
+
+        // Input that has been fed but not consumed yet starts at consumed_offset, and at position in the document.
+        ByteBuffer input;
+        size_t consumed_offset { 0 };
+        LineTrackingLexer::Position position { 0, 1, 1 };
+
+        Stage stage { Stage::Prolog };
+        Vector<Name> open_elements;
+        bool has_checked_for_xml_decl { false };
+        bool has_parsed_doctype { false };
+
+        // How far into the doctype at the start of the unconsumed input its end has been looked for.
+        struct DoctypeScan {
+            size_t offset { 0 };
+            bool is_in_internal_subset { false };
+            StringView awaited_delimiter;
+        } doctype_scan;
+
+        bool has_started_document { false };
+        bool is_finished { false };
+        Optional<ParseError> error;
+    };
+
     ErrorOr<void, ParseError> parse_internal();
-    void append_node(NonnullOwnPtr<Node>);
+    ErrorOr<void, ParseError> parse_available_input();
+    ErrorOr<void, ParseError> parse_available_prolog();
+    ErrorOr<void, ParseError> parse_available_content();
+    ErrorOr<void, ParseError> parse_available_epilog();
+    ErrorOr<void, ParseError> check_for_restricted_characters(size_t start, size_t end);
+    bool markup_is_complete() const;
+    bool doctype_is_complete();
+    ErrorOr<void, ParseError> parse_root_start_tag();
+    ErrorOr<void, ParseError> fail_incremental_parse(ParseError);
+    void enter_element(StartTag&&);
+    void leave_element(Name const&);
     void append_text(StringView, LineTrackingLexer::Position);
     void append_comment(StringView, LineTrackingLexer::Position);
-    void enter_node(Node&);
-    void leave_node();
 
     enum class ReferencePlacement {
         AttributeValue,
@@ -108,11 +167,10 @@ private:
     ErrorOr<void, ParseError> parse_eq();
     ErrorOr<void, ParseError> parse_comment();
     ErrorOr<void, ParseError> parse_processing_instruction();
-    ErrorOr<Name, ParseError> parse_processing_instruction_target();
-    ErrorOr<Name, ParseError> parse_name();
-    ErrorOr<NonnullOwnPtr<Node>, ParseError> parse_empty_element_tag();
-    ErrorOr<NonnullOwnPtr<Node>, ParseError> parse_start_tag();
-    ErrorOr<Name, ParseError> parse_end_tag();
+    ErrorOr<StringView, ParseError> parse_processing_instruction_target();
+    ErrorOr<StringView, ParseError> parse_name();
+    ErrorOr<StartTag, ParseError> parse_start_tag();
+    ErrorOr<StringView, ParseError> parse_end_tag();
     ErrorOr<void, ParseError> parse_content();
     ErrorOr<Attribute, ParseError> parse_attribute();
     ErrorOr<ByteString, ParseError> parse_attribute_value();
@@ -221,6 +279,8 @@ private:
     Vector<ParseError> m_parse_errors;
 
     Optional<Doctype> m_doctype;
+
+    OwnPtr<IncrementalState> m_incremental_state;
 };
 }
 
@@ -9,6 +9,7 @@
 #include <AK/Badge.h>
 #include <AK/IDAllocator.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/QuickSort.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Proxy.h>
@@ -21,6 +22,7 @@
 #include <LibWebSocket/ConnectionInfo.h>
 #include <LibWebSocket/Message.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/ContentDecoder.h>
 #include <RequestServer/RequestClientEndpoint.h>
 #ifdef AK_OS_WINDOWS
 // needed because curl.h includes winsock2.h
@@ -32,8 +34,26 @@ namespace RequestServer {
 
 ByteString g_default_certificate_path;
 static HashMap<int, RefPtr<ConnectionFromClient>> s_connections;
+// Connections whose client went away, but that still run transfers for requests from other clients.
+static HashTable<NonnullRefPtr<ConnectionFromClient>> s_draining_connections;
 static IDAllocator s_client_ids;
 static long s_connect_timeout_seconds = 90L;
+
+// RFC 8305, 5. Connection Attempts
+// "the RECOMMENDED value for a default delay is 250 milliseconds."
+// NOTE: The resolver hands curl both the IPv6 and IPv4 addresses of a host, and curl races connection attempts to them,
+//       giving IPv6 this much of a head start.
+static long s_happy_eyeballs_connection_attempt_delay_ms = 250L;
+
+// Requests that are not urgent (images, media, prefetches and the like) are delayable: only so many of them are sent at
+// once, and fewer while more urgent requests are in flight, so they don't compete for bandwidth with what the page
+// needs to render.
+static size_t s_max_running_delayable_requests = 10;
+static size_t s_max_running_delayable_requests_while_urgent_requests_are_running = 2;
+
+// The number of connections to keep statistics for, older ones have most likely been closed by curl.
+static size_t s_max_tracked_connections = 64;
+
 static struct {
     Optional<Core::SocketAddress> server_address;
     Optional<ByteString> server_hostname;
@@ -81,6 +101,29 @@ static NonnullRefPtr<Resolver> default_resolver()
     return resolver;
 }
 
+static bool is_delayable(RequestPriority priority)
+{
+    return priority >= RequestPriority::Low;
+}
+
+// The HTTP/2 stream weight (RFC 9113, 5.3.2) requests of each priority are sent with.
+static long http2_stream_weight_for_priority(RequestPriority priority)
+{
+    switch (priority) {
+    case RequestPriority::Highest:
+        return 256;
+    case RequestPriority::High:
+        return 220;
+    case RequestPriority::Medium:
+        return 183;
+    case RequestPriority::Low:
+        return 147;
+    case RequestPriority::Lowest:
+        return 110;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 ByteString build_curl_resolve_list(DNS::LookupResult const& dns_result, StringView host, u16 port)
 {
     StringBuilder resolve_opt_builder;
@@ -99,6 +142,64 @@ ByteString build_curl_resolve_list(DNS::LookupResult const& dns_result, StringVi
     return resolve_opt_builder.to_byte_string();
 }
 
+// Identical GET requests that are in flight at the same time, from any client, share a single transfer. The first one
+// is sent, and the others are coalesced into it: they get copies of its response, without a transfer of their own.
+struct CoalescedRequest {
+    WeakPtr<ConnectionFromClient> client;
+    i32 request_id { 0 };
+};
+
+// Requests that others can still be coalesced into, by coalescing key. Requests stop being available once their
+// response starts arriving, as the part that already went by could not be handed to requests coalesced after that.
+static HashMap<ByteString, CoalescedRequest> s_coalescable_requests;
+
+static Optional<ByteString> coalescing_key_for_request(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers, ByteBuffer const& request_body)
+{
+    // Only requests that can't have side effects are coalesced.
+    if (method != "GET"sv || !request_body.is_empty())
+        return {};
+
+    // Requests are only coalesced if they send the same headers, which includes their cookies, so every client gets
+    // exactly the response it would have gotten by itself. The referrer is left out: it differs between pages, and
+    // servers hardly ever send something else depending on it.
+    Vector<ByteString> header_lines;
+    for (auto const& header : request_headers.headers()) {
+        if (header.name.equals_ignoring_ascii_case("Referer"sv))
+            continue;
+        header_lines.append(ByteString::formatted("{}: {}", header.name.to_lowercase(), header.value));
+    }
+    quick_sort(header_lines);
+
+    StringBuilder builder;
+    builder.append(url.serialize());
+    for (auto const& header_line : header_lines) {
+        builder.append('\n');
+        builder.append(header_line);
+    }
+    return builder.to_byte_string();
+}
+
+static void write_to_pipe(int fd, ReadonlyBytes bytes)
+{
+    while (!bytes.is_empty()) {
+        auto result = Core::System::write(fd, bytes);
+        if (result.is_error()) {
+            if (result.error().code() != EAGAIN) {
+                dbgln("on_data_received: write failed: {}", result.error());
+                VERIFY_NOT_REACHED();
+            }
+            sched_yield();
+            continue;
+        }
+        auto nwritten = result.value();
+        if (nwritten == 0) {
+            dbgln("on_data_received: write returned 0");
+            VERIFY_NOT_REACHED();
+        }
+        bytes = bytes.slice(nwritten);
+    }
+}
+
 struct ConnectionFromClient::ActiveRequest {
     CURLM* multi { nullptr };
     CURL* easy { nullptr };
@@ -110,6 +211,15 @@ struct ConnectionFromClient::ActiveRequest {
     HTTP::HeaderMap headers;
     bool got_all_headers { false };
     bool is_connect_only { false };
+    RequestPriority priority { RequestPriority::Medium };
+    bool is_queued { false };
+    bool is_coalesced { false };
+    bool was_stopped { false };
+    bool has_content_encoding_error { false };
+    Optional<ByteString> coalescing_key;
+    Vector<CoalescedRequest> coalesced_requests;
+    RefPtr<ContentDecoder> content_decoder;
+    size_t received_so_far { 0 };
     size_t downloaded_so_far { 0 };
     String url;
     Optional<String> reason_phrase;
@@ -126,17 +236,117 @@ struct ConnectionFromClient::ActiveRequest {
 
     ~ActiveRequest()
     {
+        if (content_decoder)
+            content_decoder->cancel();
+
+        stop_accepting_coalesced_requests();
+
+        // If the transfer is going away before it finished, the requests coalesced into it won't get their response.
+        // NOTE: That only happens when RequestServer is shutting down. When just our client goes away, transfers that
+        //       other clients' requests were coalesced into keep running for them.
+        for (auto const& coalesced : coalesced_requests) {
+            if (coalesced.client.ptr() == client.ptr())
+                continue;
+            auto coalesced_client = coalesced.client.strong_ref();
+            if (!coalesced_client || !coalesced_client->m_active_requests.contains(coalesced.request_id))
+                continue;
+            coalesced_client->async_request_finished(coalesced.request_id, 0, {}, Requests::NetworkError::Unknown);
+            coalesced_client->remove_request(coalesced.request_id);
+        }
+
         if (writer_fd > 0)
             MUST(Core::System::close(writer_fd));
 
-        auto result = curl_multi_remove_handle(multi, easy);
-        VERIFY(result == CURLM_OK);
-        curl_easy_cleanup(easy);
+        if (easy) {
+            auto result = curl_multi_remove_handle(multi, easy);
+            VERIFY(result == CURLM_OK);
+            curl_easy_cleanup(easy);
+        }
 
         for (auto* string_list : curl_string_lists)
             curl_slist_free_all(string_list);
     }
 
+    void stop_accepting_coalesced_requests()
+    {
+        if (!coalescing_key.has_value())
+            return;
+        if (auto coalescable = s_coalescable_requests.get(*coalescing_key); coalescable.has_value() && coalescable->client.ptr() == client.ptr() && coalescable->request_id == request_id)
+            s_coalescable_requests.remove(*coalescing_key);
+        coalescing_key.clear();
+    }
+
+    // Calls the callback with the client and request of every coalesced request that is still around.
+    template<typename Callback>
+    void for_each_coalesced_request(Callback callback)
+    {
+        for (auto const& coalesced : coalesced_requests) {
+            auto coalesced_client = coalesced.client.strong_ref();
+            if (!coalesced_client)
+                continue;
+            auto coalesced_request = coalesced_client->m_active_requests.get(coalesced.request_id);
+            if (!coalesced_request.has_value())
+                continue;
+            callback(*coalesced_client, **coalesced_request);
+        }
+    }
+
+    // Keeps the transfer running for the requests coalesced into it, without sending anything to our client.
+    void stop_responding_to_client()
+    {
+        was_stopped = true;
+        if (writer_fd > 0) {
+            MUST(Core::System::close(writer_fd));
+            writer_fd = 0;
+        }
+    }
+
+    bool has_coalesced_requests()
+    {
+        bool found = false;
+        for_each_coalesced_request([&](auto&, auto&) { found = true; });
+        return found;
+    }
+
+    void write_response_data(ReadonlyBytes data)
+    {
+        if (writer_fd > 0)
+            write_to_pipe(writer_fd, data);
+        for_each_coalesced_request([&](ConnectionFromClient&, ActiveRequest& coalesced_request) {
+            write_to_pipe(coalesced_request.writer_fd, data);
+        });
+    }
+
+    // Returns false if the response body uses a content coding that can't be undone.
+    bool start_decoding_content_if_needed()
+    {
+        auto content_encoding = headers.get("Content-Encoding"sv);
+        if (!content_encoding.has_value())
+            return true;
+
+        auto decoder = ContentDecoder::create(
+            *content_encoding,
+            [this](ReadonlyBytes data) {
+                write_response_data(data);
+                downloaded_so_far += data.size();
+            },
+            [this](ErrorOr<void> result) {
+                Optional<Requests::NetworkError> network_error;
+                if (result.is_error()) {
+                    dbgln("ContentDecoder: Failed to decode response body: {}", result.error());
+                    network_error = Requests::NetworkError::InvalidContentEncoding;
+                }
+                client->finish_request(*this, network_error);
+            });
+        if (decoder.is_error()) {
+            dbgln("ContentDecoder: Unable to decode '{}': {}", *content_encoding, decoder.error());
+            return false;
+        }
+
+        content_decoder = decoder.release_value();
+        return true;
+    }
+
     void flush_headers_if_needed()
     {
         if (got_all_headers)
@@ -145,7 +355,11 @@ struct ConnectionFromClient::ActiveRequest {
         long http_status_code = 0;
         auto result = curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &http_status_code);
         VERIFY(result == CURLE_OK);
-        client->async_headers_became_available(request_id, headers, http_status_code, reason_phrase);
+        if (!was_stopped)
+            client->async_headers_became_available(request_id, headers, http_status_code, reason_phrase);
+        for_each_coalesced_request([&](ConnectionFromClient& coalesced_client, ActiveRequest& coalesced_request) {
+            coalesced_client.async_headers_became_available(coalesced_request.request_id, headers, http_status_code, reason_phrase);
+        });
     }
 };
 
@@ -155,6 +369,8 @@ size_t ConnectionFromClient::on_header_received(void* buffer, size_t size, size_
     size_t total_size = size * nmemb;
     auto header_line = StringView { static_cast<char const*>(buffer), total_size };
 
+    request->stop_accepting_coalesced_requests();
+
     // NOTE: We need to extract the HTTP reason phrase since it can be a custom value.
     //       Fetching infrastructure needs this value for setting the status message.
     if (!request->reason_phrase.has_value() && header_line.starts_with("HTTP/"sv)) {
@@ -187,28 +403,22 @@ size_t ConnectionFromClient::on_data_received(void* buffer, size_t size, size_t
     request->flush_headers_if_needed();
 
     size_t total_size = size * nmemb;
+    ReadonlyBytes data { static_cast<u8 const*>(buffer), total_size };
 
-    size_t remaining_length = total_size;
-    u8 const* remaining_data = static_cast<u8 const*>(buffer);
-    while (remaining_length > 0) {
-        auto result = Core::System::write(request->writer_fd, { remaining_data, remaining_length });
-        if (result.is_error()) {
-            if (result.error().code() != EAGAIN) {
-                dbgln("on_data_received: write failed: {}", result.error());
-                VERIFY_NOT_REACHED();
-            }
-            sched_yield();
-            continue;
-        }
-        auto nwritten = result.value();
-        if (nwritten == 0) {
-            dbgln("on_data_received: write returned 0");
-            VERIFY_NOT_REACHED();
-        }
-        remaining_data += nwritten;
-        remaining_length -= nwritten;
+    // Content codings are undone on the content decoder's threads rather than here, along with the other transfers.
+    if (request->received_so_far == 0 && !request->start_decoding_content_if_needed()) {
+        request->has_content_encoding_error = true;
+        return CURL_WRITEFUNC_ERROR;
+    }
+    request->received_so_far += total_size;
+
+    if (request->content_decoder) {
+        if (request->content_decoder->write(data).is_error())
+            return CURL_WRITEFUNC_ERROR;
+        return total_size;
     }
 
+    request->write_response_data(data);
     request->downloaded_so_far += total_size;
 
     return total_size;
@@ -285,6 +495,9 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transpo
     set_option(CURLMOPT_TIMERFUNCTION, &on_timeout_callback);
     set_option(CURLMOPT_TIMERDATA, this);
 
+    // Send requests to the same host as streams on a single HTTP/2 connection whenever the server supports it.
+    set_option(CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
     m_timer = Core::Timer::create_single_shot(0, [this] {
         int still_running = 0;
         auto result = curl_multi_socket_action(m_curl_multi, CURL_SOCKET_TIMEOUT, 0, &still_running);
@@ -304,6 +517,29 @@ ConnectionFromClient::~ConnectionFromClient()
 void ConnectionFromClient::die()
 {
     auto client_id = this->client_id();
+
+    auto remove_requests_if = [this](auto predicate) {
+        Vector<i32> request_ids;
+        for (auto const& [request_id, request] : m_active_requests) {
+            if (predicate(*request))
+                request_ids.append(request_id);
+        }
+        for (auto request_id : request_ids)
+            remove_request(request_id);
+    };
+
+    // Our requests that were coalesced into another transfer go first, so that they don't keep it running for nothing.
+    // Transfers that other clients' requests were coalesced into then keep running for them, and this connection sticks
+    // around until they're done. Everything else goes away with the client.
+    m_queued_request_ids.clear();
+    remove_requests_if([](ActiveRequest& request) { return request.is_coalesced; });
+    remove_requests_if([](ActiveRequest& request) { return !request.has_coalesced_requests(); });
+    for (auto& it : m_active_requests)
+        it.value->stop_responding_to_client();
+    if (!m_active_requests.is_empty()) {
+        m_is_draining = true;
+        s_draining_connections.set(*this);
+    }
     s_connections.remove(client_id);
     s_client_ids.deallocate(client_id);
 
@@ -384,13 +620,17 @@ void ConnectionFromClient::set_use_system_dns()
 }
 
 #ifdef AK_OS_WINDOWS
-void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData)
+void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, RequestPriority)
 {
     VERIFY(0 && "RequestServer::ConnectionFromClient::start_request is not implemented");
 }
 #else
-void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data)
+void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data, RequestPriority priority)
 {
+    auto coalescing_key = coalescing_key_for_request(method, url, request_headers, request_body);
+    if (coalescing_key.has_value() && coalesce_request(request_id, *coalescing_key))
+        return;
+
     auto host = url.serialized_host().to_byte_string();
 
     m_resolver->dns.lookup(host, DNS::Messages::Class::IN, { DNS::Messages::ResourceType::A, DNS::Messages::ResourceType::AAAA })
@@ -399,7 +639,7 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
             // FIXME: Implement timing info for DNS lookup failure.
             async_request_finished(request_id, 0, {}, Requests::NetworkError::UnableToResolveHost);
         })
-        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data](auto const& dns_result) mutable {
+        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data, priority, coalescing_key = move(coalescing_key)](auto const& dns_result) mutable {
             if (dns_result->records().is_empty() || dns_result->cached_addresses().is_empty()) {
                 dbgln("StartRequest: DNS lookup failed for '{}'", host);
                 // FIXME: Implement timing info for DNS lookup failure.
@@ -426,6 +666,7 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
 
             auto request = make<ActiveRequest>(*this, m_curl_multi, easy, request_id, writer_fd);
             request->url = url.to_string();
+            request->priority = priority;
 
             auto set_option = [easy](auto option, auto value) {
                 auto result = curl_easy_setopt(easy, option, value);
@@ -442,9 +683,17 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
                 set_option(CURLOPT_CAINFO, g_default_certificate_path.characters());
 
             set_option(CURLOPT_ACCEPT_ENCODING, "gzip, deflate, br");
+            // NOTE: We decode the response body ourselves, see on_data_received().
+            set_option(CURLOPT_HTTP_CONTENT_DECODING, 0L);
             set_option(CURLOPT_URL, url.to_string().to_byte_string().characters());
             set_option(CURLOPT_PORT, url.port_or_default());
             set_option(CURLOPT_CONNECTTIMEOUT, s_connect_timeout_seconds);
+            set_option(CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS, s_happy_eyeballs_connection_attempt_delay_ms);
+            set_option(CURLOPT_STREAM_WEIGHT, http2_stream_weight_for_priority(priority));
+
+            // Wait for a connection to the host that is still being set up, in case it can be multiplexed, instead
+            // of opening another one.
+            set_option(CURLOPT_PIPEWAIT, 1L);
 
             bool did_set_body = false;
 
@@ -507,14 +756,124 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
             } else
                 VERIFY_NOT_REACHED();
 
-            auto result = curl_multi_add_handle(m_curl_multi, easy);
-            VERIFY(result == CURLM_OK);
+            if (coalescing_key.has_value() && !s_coalescable_requests.contains(*coalescing_key)) {
+                s_coalescable_requests.set(*coalescing_key, { *this, request_id });
+                request->coalescing_key = move(coalescing_key);
+            }
 
-            m_active_requests.set(request_id, move(request));
+            schedule_request(move(request));
         });
 }
 #endif
 
+bool ConnectionFromClient::coalesce_request(i32 request_id, ByteString const& coalescing_key)
+{
+    auto coalescable = s_coalescable_requests.get(coalescing_key);
+    if (!coalescable.has_value())
+        return false;
+
+    auto client = coalescable->client.strong_ref();
+    if (!client)
+        return false;
+    auto request = client->m_active_requests.get(coalescable->request_id);
+    if (!request.has_value())
+        return false;
+
+    // A request that is still queued may wait behind less urgent requests of its own client, which this request
+    // shouldn't have to, so it gets a transfer of its own instead.
+    if ((*request)->is_queued)
+        return false;
+
+    auto fds_or_error = Core::System::pipe2(O_NONBLOCK);
+    if (fds_or_error.is_error()) {
+        dbgln("StartRequest: Failed to create pipe: {}", fds_or_error.error());
+        return false;
+    }
+
+    auto fds = fds_or_error.release_value();
+    async_request_started(request_id, IPC::File::adopt_fd(fds[0]));
+
+    auto coalesced_request = make<ActiveRequest>(*this, nullptr, nullptr, request_id, fds[1]);
+    coalesced_request->url = (*request)->url;
+    coalesced_request->is_coalesced = true;
+    m_active_requests.set(request_id, move(coalesced_request));
+
+    (*request)->coalesced_requests.append({ *this, request_id });
+    return true;
+}
+
+void ConnectionFromClient::schedule_request(NonnullOwnPtr<ActiveRequest> request)
+{
+    auto& active_request = *request;
+    auto request_id = request->request_id;
+    m_active_requests.set(request_id, move(request));
+
+    if (!is_delayable(active_request.priority) || can_start_delayable_request()) {
+        start_transfer(active_request);
+        return;
+    }
+
+    // Keep the queue ordered by priority, and first come, first served within a priority.
+    auto index = m_queued_request_ids.find_first_index_if([&](i32 queued_request_id) {
+        return m_active_requests.get(queued_request_id).value()->priority > active_request.priority;
+    });
+    active_request.is_queued = true;
+    m_queued_request_ids.insert(index.value_or(m_queued_request_ids.size()), request_id);
+}
+
+void ConnectionFromClient::start_transfer(ActiveRequest& request)
+{
+    request.is_queued = false;
+    if (is_delayable(request.priority))
+        ++m_running_delayable_request_count;
+    else
+        ++m_running_urgent_request_count;
+
+    auto result = curl_multi_add_handle(m_curl_multi, request.easy);
+    VERIFY(result == CURLM_OK);
+}
+
+bool ConnectionFromClient::can_start_delayable_request() const
+{
+    if (m_running_urgent_request_count > 0)
+        return m_running_delayable_request_count < s_max_running_delayable_requests_while_urgent_requests_are_running;
+    return m_running_delayable_request_count < s_max_running_delayable_requests;
+}
+
+void ConnectionFromClient::start_queued_requests()
+{
+    while (!m_queued_request_ids.is_empty() && can_start_delayable_request()) {
+        auto request_id = m_queued_request_ids.take_first();
+        start_transfer(*m_active_requests.get(request_id).value());
+    }
+}
+
+void ConnectionFromClient::remove_request(i32 request_id)
+{
+    auto request = m_active_requests.take(request_id);
+    if (!request.has_value())
+        return;
+
+    if ((*request)->is_queued) {
+        m_queued_request_ids.remove_first_matching([&](i32 queued_request_id) { return queued_request_id == request_id; });
+    } else if (!(*request)->is_connect_only && !(*request)->is_coalesced) {
+        if (is_delayable((*request)->priority))
+            --m_running_delayable_request_count;
+        else
+            --m_running_urgent_request_count;
+    }
+
+    request.clear();
+    start_queued_requests();
+
+    if (m_is_draining && m_active_requests.is_empty()) {
+        m_is_draining = false;
+        Core::deferred_invoke([self = NonnullRefPtr { *this }] {
+            s_draining_connections.remove(self);
+        });
+    }
+}
+
 static Requests::NetworkError map_curl_code_to_network_error(CURLcode const& code)
 {
     switch (code) {
@@ -634,45 +993,126 @@ void ConnectionFromClient::check_active_requests()
 
         auto* request = static_cast<ActiveRequest*>(application_private);
 
-        if (!request->is_connect_only) {
-            auto timing_info = get_timing_info_from_curl_easy_handle(msg->easy_handle);
-            request->flush_headers_if_needed();
+        if (request->is_connect_only) {
+            remove_request(request->request_id);
+            continue;
+        }
+
+        request->flush_headers_if_needed();
 
-            auto result_code = msg->data.result;
+        auto result_code = msg->data.result;
 
-            // HTTPS servers might terminate their connection without proper notice of shutdown - i.e. they do not send
-            // a "close notify" alert. OpenSSL version 3.2 began treating this as an error, which curl translates to
-            // CURLE_RECV_ERROR in the absence of a Content-Length response header. The Python server used by WPT is one
-            // such server. We ignore this error if we were actually able to download some response data.
-            if (result_code == CURLE_RECV_ERROR && request->downloaded_so_far != 0 && !request->headers.contains("Content-Length"sv))
-                result_code = CURLE_OK;
+        // HTTPS servers might terminate their connection without proper notice of shutdown - i.e. they do not send
+        // a "close notify" alert. OpenSSL version 3.2 began treating this as an error, which curl translates to
+        // CURLE_RECV_ERROR in the absence of a Content-Length response header. The Python server used by WPT is one
+        // such server. We ignore this error if we were actually able to download some response data.
+        if (result_code == CURLE_RECV_ERROR && request->received_so_far != 0 && !request->headers.contains("Content-Length"sv))
+            result_code = CURLE_OK;
 
-            Optional<Requests::NetworkError> network_error;
-            bool const request_was_successful = result_code == CURLE_OK;
-            if (!request_was_successful) {
-                network_error = map_curl_code_to_network_error(result_code);
+        Optional<Requests::NetworkError> network_error;
+        bool const request_was_successful = result_code == CURLE_OK;
+        if (request->has_content_encoding_error) {
+            network_error = Requests::NetworkError::InvalidContentEncoding;
+        } else if (!request_was_successful) {
+            network_error = map_curl_code_to_network_error(result_code);
 
-                if (network_error.has_value() && network_error.value() == Requests::NetworkError::Unknown) {
-                    char const* curl_error_message = curl_easy_strerror(result_code);
-                    dbgln("ConnectionFromClient: Unable to map error ({}), message: \"\033[31;1m{}\033[0m\"", static_cast<int>(result_code), curl_error_message);
-                }
+            if (network_error.has_value() && network_error.value() == Requests::NetworkError::Unknown) {
+                char const* curl_error_message = curl_easy_strerror(result_code);
+                dbgln("ConnectionFromClient: Unable to map error ({}), message: \"\033[31;1m{}\033[0m\"", static_cast<int>(result_code), curl_error_message);
             }
+        }
 
-            async_request_finished(request->request_id, request->downloaded_so_far, timing_info, network_error);
+        // The response is finished once the content decoder has caught up with the transfer.
+        if (request->content_decoder && !network_error.has_value()) {
+            request->content_decoder->finish();
+            continue;
         }
 
-        m_active_requests.remove(request->request_id);
+        finish_request(*request, network_error);
+    }
+}
+
+void ConnectionFromClient::finish_request(ActiveRequest& request, Optional<Requests::NetworkError> network_error)
+{
+    auto timing_info = get_timing_info_from_curl_easy_handle(request.easy);
+    record_connection_stats(request.easy, timing_info);
+
+    if (!request.was_stopped)
+        async_request_finished(request.request_id, request.downloaded_so_far, timing_info, network_error);
+
+    // NOTE: The requests coalesced into this one are removed as they are handed their response, so they are
+    //       only visited once.
+    request.for_each_coalesced_request([&](ConnectionFromClient& coalesced_client, ActiveRequest& coalesced_request) {
+        auto coalesced_request_id = coalesced_request.request_id;
+        coalesced_client.async_request_finished(coalesced_request_id, request.downloaded_so_far, timing_info, network_error);
+        coalesced_client.remove_request(coalesced_request_id);
+    });
+
+    remove_request(request.request_id);
+}
+
+void ConnectionFromClient::record_connection_stats(CURL* easy, Requests::RequestTimingInfo& timing_info)
+{
+    auto get_info = [easy](auto option) {
+        curl_off_t value = 0;
+        auto result = curl_easy_getinfo(easy, option, &value);
+        VERIFY(result == CURLE_OK);
+        return value;
+    };
+
+    auto connection_id = get_info(CURLINFO_CONN_ID);
+    if (connection_id < 0)
+        return;
+
+    long new_connection_count = 0;
+    auto result = curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &new_connection_count);
+    VERIFY(result == CURLE_OK);
+
+    if (!m_connection_stats.contains(static_cast<u64>(connection_id)) && m_connection_stats.size() >= s_max_tracked_connections) {
+        auto oldest_connection_id = NumericLimits<u64>::max();
+        for (auto const& it : m_connection_stats)
+            oldest_connection_id = min(oldest_connection_id, it.key);
+        m_connection_stats.remove(oldest_connection_id);
     }
+    auto& stats = m_connection_stats.ensure(static_cast<u64>(connection_id));
+
+    // Setting up a TCP connection takes a single round trip, which makes for a good estimate of the round trip time.
+    if (new_connection_count > 0)
+        stats.round_trip_time_microseconds = get_info(CURLINFO_CONNECT_TIME_T) - get_info(CURLINFO_NAMELOOKUP_TIME_T);
+
+    long request_header_size = 0;
+    result = curl_easy_getinfo(easy, CURLINFO_REQUEST_SIZE, &request_header_size);
+    VERIFY(result == CURLE_OK);
+    long response_header_size = 0;
+    result = curl_easy_getinfo(easy, CURLINFO_HEADER_SIZE, &response_header_size);
+    VERIFY(result == CURLE_OK);
+
+    // NOTE: These are the sizes of the HTTP messages, before any compression HTTP/2 or HTTP/3 apply to headers.
+    stats.bytes_sent += request_header_size + get_info(CURLINFO_SIZE_UPLOAD_T);
+    stats.bytes_received += response_header_size + get_info(CURLINFO_SIZE_DOWNLOAD_T);
+
+    timing_info.connection_id = static_cast<u64>(connection_id);
+    timing_info.connection_reuse_count = stats.request_count++;
+    timing_info.connection_round_trip_time_microseconds = stats.round_trip_time_microseconds;
+    timing_info.connection_bytes_sent = stats.bytes_sent;
+    timing_info.connection_bytes_received = stats.bytes_received;
 }
 
 Messages::RequestServer::StopRequestResponse ConnectionFromClient::stop_request(i32 request_id)
 {
-    auto request = m_active_requests.take(request_id);
+    auto request = m_active_requests.get(request_id);
     if (!request.has_value()) {
         dbgln("StopRequest: Request ID {} not found", request_id);
         return false;
     }
 
+    // Requests that were coalesced into this one still need its transfer, so only this request's response goes away.
+    if ((*request)->has_coalesced_requests()) {
+        (*request)->stop_responding_to_client();
+        return true;
+    }
+
+    remove_request(request_id);
     return true;
 }
 
@@ -714,6 +1154,7 @@ void ConnectionFromClient::ensure_connection(URL::URL url, ::RequestServer::Cach
         set_option(CURLOPT_URL, url_string_value.to_byte_string().characters());
         set_option(CURLOPT_PORT, url.port_or_default());
         set_option(CURLOPT_CONNECTTIMEOUT, s_connect_timeout_seconds);
+        set_option(CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS, s_happy_eyeballs_connection_attempt_delay_ms);
         set_option(CURLOPT_CONNECT_ONLY, 1L);
 
         auto const result = curl_multi_add_handle(m_curl_multi, easy);
@@ -11,6 +11,7 @@
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibWebSocket/WebSocket.h>
 #include <RequestServer/RequestClientEndpoint.h>
+#include <RequestServer/RequestPriority.h>
 #include <RequestServer/RequestServerEndpoint.h>
 
 namespace RequestServer {
@@ -42,7 +43,7 @@ private:
     virtual Messages::RequestServer::IsSupportedProtocolResponse is_supported_protocol(ByteString) override;
     virtual void set_dns_server(ByteString host_or_address, u16 port, bool use_tls) override;
     virtual void set_use_system_dns() override;
-    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData) override;
+    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, RequestPriority) override;
     virtual Messages::RequestServer::StopRequestResponse stop_request(i32) override;
     virtual Messages::RequestServer::SetCertificateResponse set_certificate(i32, ByteString, ByteString) override;
     virtual void ensure_connection(URL::URL url, ::RequestServer::CacheLevel cache_level) override;
@@ -64,6 +65,33 @@ private:
 
     HashMap<i32, NonnullOwnPtr<ActiveRequest>> m_active_requests;
 
+    void schedule_request(NonnullOwnPtr<ActiveRequest>);
+    void start_transfer(ActiveRequest&);
+    void start_queued_requests();
+    bool can_start_delayable_request() const;
+    void remove_request(i32 request_id);
+    void finish_request(ActiveRequest&, Optional<Requests::NetworkError>);
+    bool coalesce_request(i32 request_id, ByteString const& coalescing_key);
+
+    // Set once our client went away while other clients' requests were still coalesced into our transfers.
+    bool m_is_draining { false };
+
+    // Requests that are not urgent wait here while the delayable request limit is reached, most urgent first.
+    Vector<i32> m_queued_request_ids;
+    size_t m_running_delayable_request_count { 0 };
+    size_t m_running_urgent_request_count { 0 };
+
+    struct ConnectionStats {
+        u64 request_count { 0 };
+        long round_trip_time_microseconds { 0 };
+        u64 bytes_sent { 0 };
+        u64 bytes_received { 0 };
+    };
+    void record_connection_stats(void* easy, Requests::RequestTimingInfo&);
+
+    // Keyed by curl's connection ID, which grows with every new connection.
+    HashMap<u64, ConnectionStats> m_connection_stats;
+
     void check_active_requests();
     void* m_curl_multi { nullptr };
     RefPtr<Core::Timer> m_timer;
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibCompress/Brotli.h>
+#include <LibCompress/Decompress.h>
+#include <LibCompress/Deflate.h>
+#include <LibCompress/Gzip.h>
+#include <LibCompress/Zlib.h>
+#include <LibCore/EventLoop.h>
+#include <LibThreading/ThreadPool.h>
+#include <RequestServer/ContentDecoder.h>
+
+namespace RequestServer {
+
+// Hands out the bytes that were read ahead of the stream, and then the rest of the stream.
+class ReplayingStream final : public Stream {
+public:
+    ReplayingStream(ReadonlyBytes replayed_bytes, MaybeOwned<Stream> stream)
+        : m_stream(move(stream))
+    {
+        m_replayed_bytes.append(replayed_bytes.data(), replayed_bytes.size());
+    }
+
+    virtual ErrorOr<Bytes> read_some(Bytes bytes) override
+    {
+        if (m_replayed_bytes.is_empty())
+            return m_stream->read_some(bytes);
+
+        auto size = min(bytes.size(), m_replayed_bytes.size());
+        m_replayed_bytes.span().slice(0, size).copy_to(bytes);
+        m_replayed_bytes.remove(0, size);
+        return bytes.slice(0, size);
+    }
+
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override { return Error::from_errno(EBADF); }
+    virtual bool is_eof() const override { return m_replayed_bytes.is_empty() && m_stream->is_eof(); }
+    virtual bool is_open() const override { return m_stream->is_open(); }
+    virtual void close() override { }
+
+private:
+    Vector<u8, 2> m_replayed_bytes;
+    MaybeOwned<Stream> m_stream;
+};
+
+// The "deflate" content coding is the zlib format (RFC 9110, 8.4.1.2), but some servers send a raw deflate stream
+// instead, which browsers accept as well. Which of the two it is only becomes clear once the first two bytes arrive:
+// a raw deflate stream won't start with a valid zlib header.
+class DeflateContentDecompressor final : public Stream {
+public:
+    explicit DeflateContentDecompressor(MaybeOwned<Stream> input)
+        : m_input(move(input))
+    {
+    }
+
+    virtual ErrorOr<Bytes> read_some(Bytes bytes) override
+    {
+        if (!m_decompressor) {
+            while (m_header_size < m_header.size()) {
+                auto header = TRY(m_input->read_some(m_header.span().slice(m_header_size)));
+                if (header.is_empty())
+                    return bytes.trim(0);
+                m_header_size += header.size();
+            }
+
+            auto input = make<ReplayingStream>(m_header.span(), move(m_input));
+            if (is_zlib_header(m_header[0], m_header[1]))
+                m_decompressor = TRY(Compress::ZlibDecompressor::create(move(input)));
+            else
+                m_decompressor = TRY(Compress::DeflateDecompressor::create(move(input)));
+        }
+
+        return m_decompressor->read_some(bytes);
+    }
+
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override { return Error::from_errno(EBADF); }
+
+    virtual bool is_eof() const override
+    {
+        if (m_decompressor)
+            return m_decompressor->is_eof();
+        return m_header_size == 0 && m_input->is_eof();
+    }
+
+    virtual bool is_open() const override { return true; }
+    virtual void close() override { }
+
+private:
+    // RFC 1950, 2.2: The compression method is deflate with a window of at most 32 KiB, and the check bits make the
+    // two bytes a multiple of 31.
+    static bool is_zlib_header(u8 compression_method_and_flags, u8 flags)
+    {
+        if ((compression_method_and_flags & 0x0f) != 8 || (compression_method_and_flags >> 4) > 7)
+            return false;
+        return ((compression_method_and_flags << 8) | flags) % 31 == 0;
+    }
+
+    MaybeOwned<Stream> m_input;
+    Array<u8, 2> m_header {};
+    size_t m_header_size { 0 };
+    OwnPtr<Stream> m_decompressor;
+};
+
+static ErrorOr<NonnullOwnPtr<Stream>> create_decompressor(StringView coding, MaybeOwned<Stream> input)
+{
+    if (coding.equals_ignoring_ascii_case("gzip"sv) || coding.equals_ignoring_ascii_case("x-gzip"sv))
+        return TRY(Compress::GzipDecompressor::create(move(input)));
+    if (coding.equals_ignoring_ascii_case("deflate"sv))
+        return TRY(try_make<DeflateContentDecompressor>(move(input)));
+    if (coding.equals_ignoring_ascii_case("br"sv))
+        return TRY(Compress::BrotliDecompressor::create(move(input)));
+    return Error::from_string_literal("Unsupported content coding");
+}
+
+ErrorOr<RefPtr<ContentDecoder>> ContentDecoder::create(StringView content_encoding, DataHandler on_data, CompletionHandler on_complete)
+{
+    Vector<StringView> codings;
+    for (auto coding : content_encoding.split_view(',')) {
+        coding = coding.trim_whitespace();
+        if (!coding.is_empty() && !coding.equals_ignoring_ascii_case("identity"sv))
+            TRY(codings.try_append(coding));
+    }
+    if (codings.is_empty())
+        return nullptr;
+
+    auto encoded_stream = TRY(try_make<AllocatingMemoryStream>());
+
+    // The codings are listed in the order they were applied, so they are undone starting from the last one.
+    Vector<NonnullOwnPtr<Stream>> decompressors;
+    for (auto coding : codings.in_reverse()) {
+        auto input = decompressors.is_empty() ? MaybeOwned<Stream> { *encoded_stream } : MaybeOwned<Stream> { *decompressors.last() };
+        TRY(decompressors.try_append(TRY(create_decompressor(coding, move(input)))));
+    }
+
+    return TRY(adopt_nonnull_ref_or_enomem(new (nothrow) ContentDecoder(move(encoded_stream), move(decompressors), move(on_data), move(on_complete))));
+}
+
+ContentDecoder::ContentDecoder(NonnullOwnPtr<AllocatingMemoryStream> encoded_stream, Vector<NonnullOwnPtr<Stream>> decompressors, DataHandler on_data, CompletionHandler on_complete)
+    : m_event_loop(Core::EventLoop::current())
+    , m_on_data(move(on_data))
+    , m_on_complete(move(on_complete))
+    , m_encoded_stream(move(encoded_stream))
+    , m_decompressors(move(decompressors))
+{
+}
+
+ContentDecoder::~ContentDecoder() = default;
+
+ErrorOr<void> ContentDecoder::write(ReadonlyBytes data)
+{
+    auto buffer = TRY(ByteBuffer::copy(data));
+
+    Threading::MutexLocker locker { m_mutex };
+    VERIFY(!m_input_finished);
+    if (m_is_complete)
+        return {};
+
+    TRY(m_pending_input.try_append(move(buffer)));
+    schedule_if_needed();
+    return {};
+}
+
+void ContentDecoder::finish()
+{
+    Threading::MutexLocker locker { m_mutex };
+    m_input_finished = true;
+    schedule_if_needed();
+}
+
+void ContentDecoder::cancel()
+{
+    m_is_cancelled = true;
+    m_on_data = nullptr;
+    m_on_complete = nullptr;
+
+    Threading::MutexLocker locker { m_mutex };
+    m_pending_input.clear();
+}
+
+void ContentDecoder::schedule_if_needed()
+{
+    if (m_is_scheduled || m_is_complete || m_is_cancelled)
+        return;
+    if (m_pending_input.is_empty() && !m_input_finished)
+        return;
+
+    // NOTE: A decoder is only ever worked on by one thread at a time, which keeps its output in order, and it goes to
+    //       the back of the pool's queue after every batch of input, so large responses don't keep the others waiting.
+    m_is_scheduled = true;
+    Threading::ThreadPool::the().submit([decoder = NonnullRefPtr { *this }] {
+        decoder->decode_pending_input();
+    });
+}
+
+void ContentDecoder::decode_pending_input()
+{
+    Vector<ByteBuffer> input;
+    bool input_finished = false;
+    {
+        Threading::MutexLocker locker { m_mutex };
+        input = move(m_pending_input);
+        input_finished = m_input_finished;
+    }
+
+    ErrorOr<void> result {};
+    for (auto const& encoded_data : input) {
+        if (m_is_cancelled)
+            break;
+        result = decode(encoded_data);
+        if (result.is_error())
+            break;
+    }
+
+    // A body that ends before its content coding does was cut short, which is only fine if it was empty to begin with.
+    if (!result.is_error() && input_finished && !m_is_cancelled && m_has_encoded_input && !m_decompressors.last()->is_eof())
+        result = Error::from_string_literal("Response body ended before the end of its content coding");
+
+    if (result.is_error() || input_finished)
+        complete(move(result));
+
+    Threading::MutexLocker locker { m_mutex };
+    m_is_scheduled = false;
+    schedule_if_needed();
+}
+
+ErrorOr<void> ContentDecoder::decode(ReadonlyBytes encoded_data)
+{
+    TRY(m_encoded_stream->write_until_depleted(encoded_data));
+    if (!encoded_data.is_empty())
+        m_has_encoded_input = true;
+
+    return Compress::decompress_available_input(*m_decompressors.last(), *m_encoded_stream, [&](ReadonlyBytes decoded_data) -> ErrorOr<IterationDecision> {
+        if (m_is_cancelled)
+            return IterationDecision::Break;
+
+        auto buffer = TRY(ByteBuffer::copy(decoded_data));
+        m_event_loop.deferred_invoke([self = NonnullRefPtr { *this }, buffer = move(buffer)] {
+            if (!self->m_is_cancelled)
+                self->m_on_data(buffer.bytes());
+        });
+        m_event_loop.wake();
+        return IterationDecision::Continue;
+    });
+}
+
+void ContentDecoder::complete(ErrorOr<void> result)
+{
+    {
+        Threading::MutexLocker locker { m_mutex };
+        m_is_complete = true;
+        m_pending_input.clear();
+    }
+
+    m_event_loop.deferred_invoke([self = NonnullRefPtr { *this }, result = move(result)]() mutable {
+        if (self->m_is_cancelled)
+            return;
+
+        // NOTE: The handler is moved out first, as it's likely to end up destroying the request that owns this decoder.
+        auto on_complete = move(self->m_on_complete);
+        on_complete(move(result));
+    });
+    m_event_loop.wake();
+}
+
+}
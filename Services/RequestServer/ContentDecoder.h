@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
+#include <AK/Function.h>
+#include <AK/MemoryStream.h>
+#include <AK/Vector.h>
+#include <LibCore/Forward.h>
+#include <LibThreading/Mutex.h>
+
+namespace RequestServer {
+
+// Undoes the content codings of a response body (RFC 9110, 8.4.1) on a background thread, so that decoding a large
+// response neither holds up the other transfers nor the delivery of data to clients. The body is written to the
+// decoder as it arrives from the network, and the decoded data is handed back, in order, on the event loop that
+// created the decoder.
+class ContentDecoder : public AtomicRefCounted<ContentDecoder> {
+public:
+    using DataHandler = Function<void(ReadonlyBytes)>;
+    using CompletionHandler = Function<void(ErrorOr<void>)>;
+
+    // Returns null if the Content-Encoding header value doesn't call for any decoding.
+    static ErrorOr<RefPtr<ContentDecoder>> create(StringView content_encoding, DataHandler, CompletionHandler);
+
+    ~ContentDecoder();
+
+    ErrorOr<void> write(ReadonlyBytes);
+
+    // Called once the whole body has been written. The completion handler runs after the last of the decoded data
+    // has been handed over.
+    void finish();
+
+    // Drops any data that is yet to be decoded. None of the handlers are called after this.
+    void cancel();
+
+private:
+    ContentDecoder(NonnullOwnPtr<AllocatingMemoryStream>, Vector<NonnullOwnPtr<Stream>>, DataHandler, CompletionHandler);
+
+    // Must be called with the mutex locked.
+    void schedule_if_needed();
+
+    void decode_pending_input();
+    ErrorOr<void> decode(ReadonlyBytes);
+    void complete(ErrorOr<void>);
+
+    Core::EventLoop& m_event_loop;
+
+    // These are only used on the event loop's thread.
+    DataHandler m_on_data;
+    CompletionHandler m_on_complete;
+
+    // These are only used by the thread pool, by one thread at a time.
+    NonnullOwnPtr<AllocatingMemoryStream> m_encoded_stream;
+    Vector<NonnullOwnPtr<Stream>> m_decompressors;
+    bool m_has_encoded_input { false };
+
+    Threading::Mutex m_mutex;
+    Vector<ByteBuffer> m_pending_input;
+    bool m_input_finished { false };
+    bool m_is_scheduled { false };
+    bool m_is_complete { false };
+    Atomic<bool> m_is_cancelled { false };
+};
+
+}
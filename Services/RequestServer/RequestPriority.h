@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace RequestServer {
+
+// How urgently the client needs a response, from most to least urgent.
+enum class RequestPriority : u8 {
+    Highest,
+    High,
+    Medium,
+    Low,
+    Lowest,
+};
+
+}
@@ -169,6 +169,19 @@ TEST_CASE(find_any_of)
     EXPECT_EQ(test_string_view.find_any_of("/"sv, StringView::SearchDirection::Backward), 0U);
 }
 
+TEST_CASE(ascii_prefix_length)
+{
+    EXPECT_EQ(""sv.ascii_prefix_length(), 0U);
+    EXPECT_EQ("hello"sv.ascii_prefix_length(), 5U);
+    EXPECT_EQ("\xe2\x82\xac"sv.ascii_prefix_length(), 0U);
+    EXPECT_EQ("price: \xe2\x82\xac 5"sv.ascii_prefix_length(), 7U);
+
+    // Long enough to be checked in vectorized blocks, with the first non-ASCII byte in the middle of a block.
+    auto long_string = "0123456789abcdef0123456789abcdef0123456789abcdef0123456789\xff"sv;
+    EXPECT_EQ(long_string.ascii_prefix_length(), 58U);
+    EXPECT_EQ(long_string.substring_view(0, 58).ascii_prefix_length(), 58U);
+}
+
 TEST_CASE(split_view)
 {
     StringView test_string_view = "axxbxcxd"sv;
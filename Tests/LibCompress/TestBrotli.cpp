@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/MaybeOwned.h>
+#include <AK/MemoryStream.h>
+#include <LibCompress/Brotli.h>
+#include <LibTest/TestCase.h>
+
+static constexpr Array<u8, 26> compressed {
+    0x1B, 0x1C, 0x00, 0xF8, 0x25, 0x53, 0x74, 0xC2, 0x5A, 0x90, 0x42, 0x1A, 0x91,
+    0x44, 0xC7, 0x80, 0xCE, 0x3D, 0x0A, 0xF1, 0x29, 0x5D, 0x02, 0xD0, 0x71, 0x00
+};
+
+static constexpr auto uncompressed = "This is a simple text file :)"sv;
+
+TEST_CASE(brotli_decompress_simple)
+{
+    auto decompressed = TRY_OR_FAIL(Compress::BrotliDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.bytes(), uncompressed.bytes());
+}
+
+TEST_CASE(brotli_decompress_stream)
+{
+    // Feed the compressed data one byte at a time, the way it might arrive from the network.
+    auto stream = make<AllocatingMemoryStream>();
+    auto decompressor = TRY_OR_FAIL(Compress::BrotliDecompressor::create(MaybeOwned<Stream> { *stream }));
+
+    ByteBuffer decompressed;
+    Array<u8, 64> buffer;
+    for (auto byte : compressed) {
+        TRY_OR_FAIL(stream->write_value(byte));
+        while (true) {
+            auto decompressed_bytes = TRY_OR_FAIL(decompressor->read_some(buffer));
+            if (decompressed_bytes.is_empty())
+                break;
+            decompressed.append(decompressed_bytes);
+        }
+    }
+
+    EXPECT(decompressor->is_eof());
+    EXPECT_EQ(decompressed.bytes(), uncompressed.bytes());
+}
+
+TEST_CASE(brotli_decompress_invalid_data)
+{
+    auto invalid = compressed;
+    invalid[5] ^= 0xFF;
+    invalid[6] ^= 0xFF;
+
+    auto decompressed = Compress::BrotliDecompressor::decompress_all(invalid);
+    EXPECT(decompressed.is_error());
+}
+
+TEST_CASE(brotli_decompress_truncated_data)
+{
+    auto decompressed = Compress::BrotliDecompressor::decompress_all(ReadonlyBytes { compressed }.trim(10));
+    EXPECT(decompressed.is_error());
+}
@@ -4,8 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/MemoryStream.h>
+#include <AK/StringBuilder.h>
+#include <AK/Time.h>
 #include <LibCompress/Gzip.h>
 #include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
 
 TEST_CASE(gzip_decompress_simple)
 {
@@ -102,3 +106,108 @@ TEST_CASE(gzip_truncated_uncompressed_block)
     auto const decompressed_or_error = Compress::GzipDecompressor::decompress_all(compressed);
     EXPECT(decompressed_or_error.is_error());
 }
+
+static constexpr size_t concurrent_download_count = 4;
+static constexpr size_t network_chunk_size = 16 * KiB;
+
+// Decompresses a gzip stream that arrives a piece at a time, the way a response body arrives from the network.
+class GzipDownload {
+public:
+    explicit GzipDownload(ReadonlyBytes compressed)
+        : m_compressed(compressed)
+        , m_decompressor(MUST(Compress::GzipDecompressor::create(MaybeOwned<Stream> { m_input })))
+    {
+    }
+
+    bool is_done() const { return m_compressed.is_empty(); }
+    size_t decompressed_size() const { return m_decompressed_size; }
+
+    void receive_next_chunk()
+    {
+        auto chunk = m_compressed.trim(network_chunk_size);
+        m_compressed = m_compressed.slice(chunk.size());
+        MUST(m_input.write_until_depleted(chunk));
+
+        while (true) {
+            auto decompressed = MUST(m_decompressor->read_some(m_buffer));
+            m_decompressed_size += decompressed.size();
+            if (decompressed.is_empty() && (m_input.is_eof() || m_decompressor->is_eof()))
+                break;
+        }
+    }
+
+private:
+    ReadonlyBytes m_compressed;
+    AllocatingMemoryStream m_input;
+    NonnullOwnPtr<Compress::GzipDecompressor> m_decompressor;
+    Array<u8, 64 * KiB> m_buffer;
+    size_t m_decompressed_size { 0 };
+};
+
+static ByteBuffer const& large_compressed_json()
+{
+    static ByteBuffer compressed = [] {
+        StringBuilder builder;
+        builder.append('[');
+        for (size_t i = 0; builder.length() < 16 * MiB; ++i)
+            builder.appendff("{{\"id\":{},\"name\":\"item {}\",\"tags\":[\"red\",\"green\"],\"value\":{}}},", i, i, (i * 7919) % 1000);
+        builder.append("{}]"sv);
+        return MUST(Compress::GzipCompressor::compress_all(builder.string_view().bytes()));
+    }();
+    return compressed;
+}
+
+static void report_throughput(StringView description, Vector<NonnullOwnPtr<GzipDownload>> const& downloads, MonotonicTime start)
+{
+    auto elapsed = MonotonicTime::now() - start;
+
+    size_t decompressed_size = 0;
+    for (auto const& download : downloads)
+        decompressed_size += download->decompressed_size();
+    EXPECT(decompressed_size > 16 * MiB * concurrent_download_count);
+
+    outln("Decompressed {} MiB from {} concurrent downloads {} in {} ms", decompressed_size / MiB, downloads.size(), description, elapsed.to_milliseconds());
+}
+
+// Every download is decompressed on the thread that receives the data, in between receiving the others.
+BENCHMARK_CASE(gzip_decompress_concurrent_downloads_on_one_thread)
+{
+    Vector<NonnullOwnPtr<GzipDownload>> downloads;
+    for (size_t i = 0; i < concurrent_download_count; ++i)
+        downloads.append(make<GzipDownload>(large_compressed_json()));
+
+    auto start = MonotonicTime::now();
+    for (bool any_left = true; any_left;) {
+        any_left = false;
+        for (auto& download : downloads) {
+            if (download->is_done())
+                continue;
+            download->receive_next_chunk();
+            any_left = true;
+        }
+    }
+    report_throughput("on one thread"sv, downloads, start);
+}
+
+// Every download is decompressed on a thread of its own, alongside the others.
+BENCHMARK_CASE(gzip_decompress_concurrent_downloads_on_threads)
+{
+    Vector<NonnullOwnPtr<GzipDownload>> downloads;
+    for (size_t i = 0; i < concurrent_download_count; ++i)
+        downloads.append(make<GzipDownload>(large_compressed_json()));
+
+    auto start = MonotonicTime::now();
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (auto& download : downloads) {
+        auto thread = Threading::Thread::construct([&download]() -> intptr_t {
+            while (!download->is_done())
+                download->receive_next_chunk();
+            return 0;
+        });
+        thread->start();
+        threads.append(move(thread));
+    }
+    for (auto& thread : threads)
+        MUST(thread->join());
+    report_throughput("on threads"sv, downloads, start);
+}
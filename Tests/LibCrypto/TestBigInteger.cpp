@@ -203,6 +203,25 @@ TEST_CASE(test_unsigned_bigint_multiplication_with_big_numbers2)
     EXPECT_EQ(result.words(), expected_result);
 }
 
+TEST_CASE(test_unsigned_bigint_karatsuba_multiplication)
+{
+    // (2^k - 1)^2 = 2^2k - 2^(k + 1) + 1, with k large enough for both operands to be split several times.
+    size_t k = 32 * 300 + 5;
+    auto one = Crypto::UnsignedBigInteger(1);
+    auto all_ones = one.shift_left(k).minus(one);
+    auto expected = one.shift_left(2 * k).minus(one.shift_left(k + 1)).plus(one);
+    EXPECT_EQ(all_ones.multiplied_by(all_ones), expected);
+
+    // Operands of very different sizes are multiplied piecewise.
+    auto large = bigint_fibonacci(20000);
+    auto medium = bigint_fibonacci(3000);
+    auto product = large.multiplied_by(medium);
+    EXPECT_EQ(product, medium.multiplied_by(large));
+    auto division_result = product.divided_by(medium);
+    EXPECT_EQ(division_result.quotient, large);
+    EXPECT(division_result.remainder.is_zero());
+}
+
 TEST_CASE(test_unsigned_bigint_simple_division)
 {
     Crypto::UnsignedBigInteger num1(27194);
@@ -254,6 +273,23 @@ TEST_CASE(test_unsigned_bigint_base10_to_string)
     EXPECT_EQ(result, "57195071295721390579057195715793");
 }
 
+TEST_CASE(test_unsigned_bigint_to_and_from_base_roundtrip)
+{
+    auto number = bigint_fibonacci(5000);
+    for (u16 base : { 2, 7, 10, 16, 36 }) {
+        auto string = MUST(number.to_base(base));
+        EXPECT_EQ(TRY_OR_FAIL(Crypto::UnsignedBigInteger::from_base(base, string)), number);
+    }
+
+    // Chunks of digits in the middle of the number have to keep their leading zeros.
+    auto power_of_ten = Crypto::UnsignedBigInteger(1);
+    for (size_t i = 0; i < 50; ++i)
+        power_of_ten = power_of_ten.multiplied_by(Crypto::UnsignedBigInteger(10));
+    EXPECT_EQ(MUST(power_of_ten.to_base(10)), MUST(String::formatted("1{}", String::repeated('0', 50).release_value())));
+    EXPECT_EQ(MUST(Crypto::UnsignedBigInteger(0).to_base(10)), "0"_string);
+    EXPECT(TRY_OR_FAIL(Crypto::UnsignedBigInteger::from_base(10, "000"sv)).is_zero());
+}
+
 TEST_CASE(test_bigint_modular_inverse)
 {
     auto result = Crypto::NumberTheory::ModularInverse(7, 87);
@@ -1122,6 +1158,44 @@ TEST_CASE(unsigned_bigint_double_comparisons)
 #undef EXPECT_EQUAL_TO
 }
 
+BENCHMARK_CASE(bigint_multiply_2048_bit)
+{
+    auto one = Crypto::UnsignedBigInteger(1);
+    auto left = one.shift_left(2048).minus(bigint_fibonacci(1000));
+    auto right = one.shift_left(2047).minus(bigint_fibonacci(900));
+    for (size_t i = 0; i < 10000; ++i)
+        (void)left.multiplied_by(right);
+}
+
+BENCHMARK_CASE(bigint_multiply_65536_bit)
+{
+    auto one = Crypto::UnsignedBigInteger(1);
+    auto left = one.shift_left(65536).minus(bigint_fibonacci(1000));
+    auto right = one.shift_left(65535).minus(bigint_fibonacci(900));
+    for (size_t i = 0; i < 20; ++i)
+        (void)left.multiplied_by(right);
+}
+
+BENCHMARK_CASE(bigint_to_base_10)
+{
+    auto number = bigint_fibonacci(100000);
+    (void)MUST(number.to_base(10));
+}
+
+BENCHMARK_CASE(bigint_from_base_10)
+{
+    auto string = MUST(bigint_fibonacci(100000).to_base(10));
+    (void)MUST(Crypto::UnsignedBigInteger::from_base(10, string));
+}
+
+BENCHMARK_CASE(signed_bigint_factorial)
+{
+    Crypto::SignedBigInteger factorial { 1 };
+    for (i32 i = 2; i <= 3000; ++i)
+        factorial = factorial.multiplied_by(Crypto::SignedBigInteger { i });
+    EXPECT(!factorial.is_negative());
+}
+
 namespace AK {
 
 template<>
@@ -4,12 +4,200 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/MemoryStream.h>
 #include <LibCore/Socket.h>
+#include <LibCore/System.h>
+#include <LibCore/UDPServer.h>
 #include <LibDNS/Resolver.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibTLS/TLSv12.h>
 #include <LibTest/TestCase.h>
 
+// A DNS server on the loopback interface that answers every question with whatever the test tells it to.
+class StubDNSServer {
+public:
+    using Answer = Function<void(DNS::Messages::Question const&, DNS::Messages::Message& response)>;
+
+    explicit StubDNSServer(Answer answer)
+        : m_server(Core::UDPServer::construct())
+        , m_answer(move(answer))
+    {
+        VERIFY(m_server->bind({ 127, 0, 0, 1 }, 0));
+        m_server->on_ready_to_receive = [this] { answer_query(); };
+    }
+
+    void set_answer(Answer answer) { m_answer = move(answer); }
+    Vector<DNS::Messages::Question> const& questions() const { return m_questions; }
+
+    Function<ErrorOr<DNS::Resolver::SocketResult>()> socket_factory() const
+    {
+        return [port = *m_server->local_port()] -> ErrorOr<DNS::Resolver::SocketResult> {
+            Core::SocketAddress addr = { IPv4Address { 127, 0, 0, 1 }, port };
+            return DNS::Resolver::SocketResult {
+                TRY(Core::BufferedSocket<Core::UDPSocket>::create(TRY(Core::UDPSocket::connect(addr)))),
+                DNS::Resolver::ConnectionMode::UDP,
+            };
+        };
+    }
+
+private:
+    void answer_query()
+    {
+        sockaddr_in from {};
+        auto query_bytes = MUST(m_server->receive(512, from));
+        FixedMemoryStream stream { query_bytes.bytes() };
+        auto query = MUST(DNS::Messages::Message::from_raw(stream));
+
+        DNS::Messages::Message response;
+        response.header.id = query.header.id;
+        response.header.options.raw = query.header.options.raw | DNS::Messages::Options::QRMask;
+        response.header.question_count = query.questions.size();
+        response.questions = query.questions;
+        for (auto const& question : query.questions) {
+            m_questions.append(question);
+            m_answer(question, response);
+        }
+        response.header.answer_count = response.answers.size();
+        response.header.authority_count = response.authorities.size();
+
+        ByteBuffer response_bytes;
+        MUST(response.to_raw(response_bytes));
+        MUST(m_server->send(response_bytes, from));
+    }
+
+    NonnullRefPtr<Core::UDPServer> m_server;
+    Answer m_answer;
+    Vector<DNS::Messages::Question> m_questions;
+};
+
+static void answer_with_address(DNS::Messages::Question const& question, DNS::Messages::Message& response, Variant<IPv4Address, IPv6Address> address, u32 ttl)
+{
+    address.visit(
+        [&](IPv4Address const& ipv4) {
+            if (question.type == DNS::Messages::ResourceType::A)
+                response.answers.append({ .name = question.name, .type = DNS::Messages::ResourceType::A, .class_ = DNS::Messages::Class::IN, .ttl = ttl, .record = DNS::Messages::Records::A { ipv4 }, .raw = {} });
+        },
+        [&](IPv6Address const& ipv6) {
+            if (question.type == DNS::Messages::ResourceType::AAAA)
+                response.answers.append({ .name = question.name, .type = DNS::Messages::ResourceType::AAAA, .class_ = DNS::Messages::Class::IN, .ttl = ttl, .record = DNS::Messages::Records::AAAA { ipv6 }, .raw = {} });
+        });
+}
+
+static void answer_with_soa(DNS::Messages::Question const& question, DNS::Messages::Message& response, u32 minimum_ttl)
+{
+    auto soa = DNS::Messages::Records::SOA {
+        .mname = DNS::Messages::DomainName::from_string("ns.test"sv),
+        .rname = DNS::Messages::DomainName::from_string("hostmaster.test"sv),
+        .serial = 1,
+        .refresh = 3600,
+        .retry = 600,
+        .expire = 86400,
+        .minimum = minimum_ttl,
+    };
+    response.authorities.append({ .name = question.name, .type = DNS::Messages::ResourceType::SOA, .class_ = DNS::Messages::Class::IN, .ttl = 3600, .record = move(soa), .raw = {} });
+}
+
+static bool is_ipv4(Variant<IPv4Address, IPv6Address> const& address) { return address.has<IPv4Address>(); }
+
+TEST_CASE(test_parallel_a_and_aaaa_queries)
+{
+    Core::EventLoop loop;
+    StubDNSServer server { [](auto const& question, auto& response) {
+        answer_with_address(question, response, IPv4Address { 192, 0, 2, 1 }, 300);
+        answer_with_address(question, response, IPv6Address::loopback(), 300);
+    } };
+    DNS::Resolver resolver { server.socket_factory() };
+    TRY_OR_FAIL(resolver.when_socket_ready()->await());
+
+    auto result = TRY_OR_FAIL(resolver.lookup("dual-stack.test")->await());
+    EXPECT_EQ(result->cached_addresses().size(), 2u);
+
+    // One question per query, so that A and AAAA are answered independently.
+    EXPECT_EQ(server.questions().size(), 2u);
+    EXPECT_NE(server.questions()[0].type, server.questions()[1].type);
+
+    auto cached = TRY_OR_FAIL(resolver.lookup("dual-stack.test")->await());
+    EXPECT_EQ(cached.ptr(), result.ptr());
+    EXPECT_EQ(server.questions().size(), 2u);
+}
+
+TEST_CASE(test_negative_answers_are_cached)
+{
+    Core::EventLoop loop;
+    StubDNSServer server { [](auto const& question, auto& response) {
+        response.header.options.set_response_code(DNS::Messages::Options::ResponseCode::NameError);
+        answer_with_soa(question, response, 60);
+    } };
+    DNS::Resolver resolver { server.socket_factory() };
+    TRY_OR_FAIL(resolver.when_socket_ready()->await());
+
+    auto result = TRY_OR_FAIL(resolver.lookup("missing.test")->await());
+    EXPECT(result->records().is_empty());
+    EXPECT_EQ(server.questions().size(), 2u);
+
+    auto cached = TRY_OR_FAIL(resolver.lookup("missing.test")->await());
+    EXPECT(cached->records().is_empty());
+    EXPECT_EQ(server.questions().size(), 2u);
+}
+
+TEST_CASE(test_missing_aaaa_records_are_cached)
+{
+    Core::EventLoop loop;
+    StubDNSServer server { [](auto const& question, auto& response) {
+        answer_with_address(question, response, IPv4Address { 192, 0, 2, 1 }, 300);
+        if (question.type == DNS::Messages::ResourceType::AAAA)
+            answer_with_soa(question, response, 60);
+    } };
+    DNS::Resolver resolver { server.socket_factory() };
+    TRY_OR_FAIL(resolver.when_socket_ready()->await());
+
+    auto result = TRY_OR_FAIL(resolver.lookup("ipv4-only.test")->await());
+    EXPECT_EQ(result->cached_addresses().size(), 1u);
+    EXPECT(is_ipv4(result->cached_addresses().first()));
+
+    // Without the negative AAAA answer, every lookup of an IPv4-only host would go out to the network again.
+    (void)TRY_OR_FAIL(resolver.lookup("ipv4-only.test")->await());
+    EXPECT_EQ(server.questions().size(), 2u);
+}
+
+TEST_CASE(test_stale_entries_are_served_while_revalidating)
+{
+    Core::EventLoop loop;
+    StubDNSServer server { [](auto const& question, auto& response) {
+        answer_with_address(question, response, IPv4Address { 192, 0, 2, 1 }, 1);
+        if (question.type == DNS::Messages::ResourceType::AAAA)
+            answer_with_soa(question, response, 60);
+    } };
+    DNS::Resolver resolver { server.socket_factory() };
+    TRY_OR_FAIL(resolver.when_socket_ready()->await());
+
+    (void)TRY_OR_FAIL(resolver.lookup("changing.test")->await());
+    EXPECT_EQ(server.questions().size(), 2u);
+
+    server.set_answer([](auto const& question, auto& response) {
+        answer_with_address(question, response, IPv4Address { 192, 0, 2, 2 }, 300);
+        if (question.type == DNS::Messages::ResourceType::AAAA)
+            answer_with_soa(question, response, 60);
+    });
+    MUST(Core::System::sleep_ms(1100));
+
+    // The expired answer is handed out right away...
+    auto stale = resolver.lookup("changing.test");
+    EXPECT(stale->is_resolved());
+    EXPECT_EQ(TRY_OR_FAIL(stale->await())->cached_addresses().first().get<IPv4Address>(), (IPv4Address { 192, 0, 2, 1 }));
+
+    // ...while the entry is refreshed in the background.
+    auto refreshed_address = [&] -> Optional<IPv4Address> {
+        auto result = resolver.lookup_in_cache("changing.test"sv);
+        if (!result || result->is_stale())
+            return {};
+        return result->cached_addresses().first().get<IPv4Address>();
+    };
+    while (!refreshed_address().has_value())
+        loop.pump();
+    EXPECT_EQ(refreshed_address(), (IPv4Address { 192, 0, 2, 2 }));
+}
+
 TEST_CASE(test_udp)
 {
     Core::EventLoop loop;
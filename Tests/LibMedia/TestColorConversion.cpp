@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Vector.h>
+#include <LibMedia/Color/ColorConverter.h>
+#include <LibMedia/VideoFrame.h>
+
+// Fills a row with values that cover the whole range of the bit depth, including the values outside of studio range.
+template<typename T>
+static Vector<T> make_row(size_t width, u8 bit_depth, u32 seed)
+{
+    Vector<T> row;
+    row.resize(width);
+    u32 state = seed;
+    for (auto& value : row) {
+        state = state * 1664525 + 1013904223;
+        value = static_cast<T>((state >> 8) & ((1u << bit_depth) - 1));
+    }
+    return row;
+}
+
+template<typename T>
+static void expect_row_conversion_matches_pixel_conversion(u8 bit_depth, Media::CodingIndependentCodePoints cicp)
+{
+    // An odd width exercises the scalar tail of the vectorized loops.
+    static constexpr size_t width = 1027;
+    auto y_row = make_row<T>(width, bit_depth, 1);
+    auto u_row = make_row<T>(width, bit_depth, 2);
+    auto v_row = make_row<T>(width, bit_depth, 3);
+
+    constexpr auto output_cicp = Media::CodingIndependentCodePoints(Media::ColorPrimaries::BT709, Media::TransferCharacteristics::SRGB, Media::MatrixCoefficients::BT709, Media::VideoFullRangeFlag::Full);
+    auto converter = MUST(Media::ColorConverter::create(bit_depth, cicp, output_cicp));
+
+    Vector<u32> output;
+    output.resize(width);
+    converter.convert_yuv_row(y_row.data(), u_row.data(), v_row.data(), output.data(), width);
+    for (size_t column = 0; column < width; ++column)
+        EXPECT_EQ(output[column], converter.convert_yuv(y_row[column], u_row[column], v_row[column]).value());
+}
+
+TEST_CASE(row_conversion_matches_pixel_conversion)
+{
+    using namespace Media;
+    for (auto range : { VideoFullRangeFlag::Studio, VideoFullRangeFlag::Full }) {
+        for (auto matrix : { MatrixCoefficients::BT601, MatrixCoefficients::BT709, MatrixCoefficients::BT2020NonConstantLuminance }) {
+            CodingIndependentCodePoints cicp { ColorPrimaries::BT709, TransferCharacteristics::SRGB, matrix, range };
+            expect_row_conversion_matches_pixel_conversion<u8>(8, cicp);
+            expect_row_conversion_matches_pixel_conversion<u16>(10, cicp);
+            expect_row_conversion_matches_pixel_conversion<u16>(12, cicp);
+        }
+    }
+
+    // Color remapping isn't vectorized, but should still produce the same results.
+    expect_row_conversion_matches_pixel_conversion<u16>(10, { ColorPrimaries::BT2020, TransferCharacteristics::SMPTE2084, MatrixCoefficients::BT2020NonConstantLuminance, VideoFullRangeFlag::Studio });
+}
+
+template<Media::MatrixCoefficients MC>
+static void expect_simple_row_conversion_matches_pixel_conversion()
+{
+    static constexpr size_t width = 1027;
+    auto y_row = make_row<u8>(width, 8, 4);
+    auto u_row = make_row<u8>(width, 8, 5);
+    auto v_row = make_row<u8>(width, 8, 6);
+
+    Vector<u32> output;
+    output.resize(width);
+    Media::ColorConverter::convert_simple_yuv_row_to_rgb<MC, Media::VideoFullRangeFlag::Studio>(y_row.data(), u_row.data(), v_row.data(), output.data(), width);
+    for (size_t column = 0; column < width; ++column)
+        EXPECT_EQ(output[column], (Media::ColorConverter::convert_simple_yuv_to_rgb<MC, Media::VideoFullRangeFlag::Studio>(y_row[column], u_row[column], v_row[column]).value()));
+}
+
+TEST_CASE(simple_row_conversion_matches_pixel_conversion)
+{
+    expect_simple_row_conversion_matches_pixel_conversion<Media::MatrixCoefficients::BT601>();
+    expect_simple_row_conversion_matches_pixel_conversion<Media::MatrixCoefficients::BT709>();
+}
+
+template<typename T>
+static void convert_1080p_frame(u8 bit_depth, Media::VideoFullRangeFlag range)
+{
+    using namespace Media;
+    Gfx::Size<u32> size { 1920, 1080 };
+    Subsampling subsampling { true, true };
+    auto y_plane = make_row<T>(size.to_type<size_t>().area(), bit_depth, 7);
+    auto u_plane = make_row<T>(subsampling.subsampled_size(size).to_type<size_t>().area(), bit_depth, 8);
+    auto v_plane = make_row<T>(subsampling.subsampled_size(size).to_type<size_t>().area(), bit_depth, 9);
+
+    CodingIndependentCodePoints cicp { ColorPrimaries::BT709, TransferCharacteristics::SRGB, MatrixCoefficients::BT709, range };
+    auto bytes_of = [](Vector<T> const& plane) { return ReadonlyBytes { plane.data(), plane.size() * sizeof(T) }; };
+    auto frame = MUST(SubsampledYUVFrame::try_create_from_data({}, size, bit_depth, cicp, subsampling, bytes_of(y_plane), bytes_of(u_plane), bytes_of(v_plane)));
+
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, size.to_type<int>()));
+    for (size_t i = 0; i < 60; ++i)
+        MUST(frame->output_to_bitmap(bitmap));
+}
+
+BENCHMARK_CASE(convert_1080p_8_bit_studio_range_frames)
+{
+    convert_1080p_frame<u8>(8, Media::VideoFullRangeFlag::Studio);
+}
+
+BENCHMARK_CASE(convert_1080p_8_bit_full_range_frames)
+{
+    convert_1080p_frame<u8>(8, Media::VideoFullRangeFlag::Full);
+}
+
+BENCHMARK_CASE(convert_1080p_10_bit_frames)
+{
+    convert_1080p_frame<u16>(10, Media::VideoFullRangeFlag::Studio);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibMedia/FramePool.h>
+
+TEST_CASE(bitmaps_are_recycled_once_released)
+{
+    Media::FramePool pool { 2 };
+    Gfx::IntSize size { 16, 8 };
+
+    auto first = MUST(pool.take_bitmap(size));
+    auto* first_pointer = first.ptr();
+    EXPECT_EQ(pool.allocation_count(), 1u);
+
+    // The first bitmap is still in use, so a second one has to be allocated.
+    auto second = MUST(pool.take_bitmap(size));
+    EXPECT_NE(second.ptr(), first_pointer);
+    EXPECT_EQ(pool.allocation_count(), 2u);
+
+    {
+        auto released = move(first);
+    }
+    auto recycled = MUST(pool.take_bitmap(size));
+    EXPECT_EQ(recycled.ptr(), first_pointer);
+    EXPECT_EQ(pool.allocation_count(), 2u);
+}
+
+TEST_CASE(pool_does_not_grow_past_its_capacity)
+{
+    Media::FramePool pool { 1 };
+    Gfx::IntSize size { 4, 4 };
+
+    auto first = MUST(pool.take_bitmap(size));
+    auto second = MUST(pool.take_bitmap(size));
+    EXPECT_EQ(pool.size(), 1u);
+    EXPECT_EQ(pool.allocation_count(), 2u);
+}
+
+TEST_CASE(bitmaps_of_another_size_are_freed)
+{
+    Media::FramePool pool { 2 };
+
+    (void)MUST(pool.take_bitmap({ 4, 4 }));
+    EXPECT_EQ(pool.size(), 1u);
+
+    auto bitmap = MUST(pool.take_bitmap({ 8, 8 }));
+    EXPECT_EQ(bitmap->size(), Gfx::IntSize(8, 8));
+    EXPECT_EQ(pool.size(), 1u);
+    EXPECT_EQ(pool.allocation_count(), 2u);
+}
@@ -4,10 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
 #include <AK/String.h>
+#include <AK/StringBuilder.h>
 #include <AK/Vector.h>
 #include <LibTest/TestCase.h>
 #include <LibTextCodec/Decoder.h>
+#include <LibTextCodec/Encoder.h>
+#include <LibTextCodec/LookupTables.h>
 
 TEST_CASE(test_utf8_decode)
 {
@@ -25,6 +30,13 @@ TEST_CASE(test_utf8_decode)
     EXPECT(processed_code_points[0] == 0x1F600);
 
     EXPECT(MUST(decoder.to_utf8(test_string)) == test_string);
+
+    // Unlike the decoding entry points, process() hands out a leading BOM.
+    processed_code_points.clear();
+    MUST(decoder.process("\xef\xbb\xbf" "a"sv, [&](u32 code_point) {
+        return processed_code_points.try_append(code_point);
+    }));
+    EXPECT_EQ(processed_code_points, (Vector<u32> { 0xFEFF, 'a' }));
 }
 
 TEST_CASE(test_utf16be_decode)
@@ -48,3 +60,174 @@ TEST_CASE(test_utf16le_decode)
     auto utf8 = MUST(decoder.to_utf8(test_string));
     EXPECT_EQ(utf8, "säk😀"sv);
 }
+
+// Surrounds the given text with runs of ASCII long enough to go through the decoders' bulk copy, so that the runs
+// end right before and start right after the non-ASCII bytes.
+static ByteString between_long_ascii_runs(StringView text)
+{
+    return ByteString::formatted("{}{}{}", ByteString::repeated('<', 300), text, ByteString::repeated('>', 300));
+}
+
+static void expect_decoded(StringView encoding, StringView input, StringView expected)
+{
+    auto decoder = TextCodec::decoder_for_exact_name(encoding);
+    VERIFY(decoder.has_value());
+
+    StringBuilder builder;
+    MUST(decoder->decode_into(input, builder));
+    EXPECT_EQ(builder.string_view(), expected);
+    EXPECT_EQ(MUST(decoder->to_utf8(input)), expected);
+
+    auto long_input = between_long_ascii_runs(input);
+    auto long_expected = between_long_ascii_runs(expected);
+    StringBuilder long_builder;
+    MUST(decoder->decode_into(long_input, long_builder));
+    EXPECT_EQ(long_builder.string_view(), long_expected.view());
+}
+
+TEST_CASE(test_decode_into_utf8)
+{
+    expect_decoded("utf-8"sv, "caf\xc3\xa9 \xf0\x9f\x98\x80"sv, "café 😀"sv);
+    // A lead byte followed by ASCII, and a sequence cut short at the end of the input.
+    expect_decoded("utf-8"sv, "\xc3x\xe2\x82"sv, "�x�"sv);
+    // A four-byte sequence cut short by ASCII.
+    expect_decoded("utf-8"sv, "\xf0\x9f\x98x"sv, "�x"sv);
+    // The two halves of a surrogate pair for U+1F600, each encoded on its own. Every byte is an error of its own.
+    expect_decoded("utf-8"sv, "a\xed\xa0\xbd\xed\xb8\x80z"sv, "a������z"sv);
+    // An overlong encoding of "/", and a code point above U+10FFFF.
+    expect_decoded("utf-8"sv, "\xe0\x80\xaf\xf4\x90\x80\x80"sv, "�������"sv);
+}
+
+TEST_CASE(test_decode_into_utf8_bom)
+{
+    auto decoder = TextCodec::decoder_for("utf-8"sv);
+    VERIFY(decoder.has_value());
+
+    // The BOM is discarded whether or not the rest of the input is valid.
+    StringBuilder valid;
+    MUST(decoder->decode_into("\xef\xbb\xbf" "abc"sv, valid));
+    EXPECT_EQ(valid.string_view(), "abc"sv);
+    EXPECT_EQ(MUST(decoder->to_utf8("\xef\xbb\xbf" "abc"sv)), "abc"sv);
+
+    StringBuilder invalid;
+    MUST(decoder->decode_into("\xef\xbb\xbf" "abc\xff"sv, invalid));
+    EXPECT_EQ(invalid.string_view(), "abc�"sv);
+    EXPECT_EQ(MUST(decoder->to_utf8("\xef\xbb\xbf" "abc\xff"sv)), "abc�"sv);
+
+    // Only a single leading BOM is discarded.
+    StringBuilder twice;
+    MUST(decoder->decode_into("\xef\xbb\xbf\xef\xbb\xbf" "abc"sv, twice));
+    EXPECT_EQ(twice.string_view(), "\xef\xbb\xbf" "abc"sv);
+}
+
+TEST_CASE(test_decode_into_single_byte)
+{
+    expect_decoded("iso-8859-1"sv, "\xe9t\xe9"sv, "été"sv);
+    expect_decoded("x-user-defined"sv, "a\x80\xff"sv, "a\xef\x9e\x80\xef\x9f\xbf"sv);
+    expect_decoded("windows-1252"sv, "\x80\x81\xe9"sv, "€\xc2\x81é"sv);
+}
+
+TEST_CASE(test_decode_into_gb18030)
+{
+    expect_decoded("gb18030"sv, "\xd2\xbb\x80"sv, "一€"sv);
+    // Four-byte sequences for U+0080 and U+10000.
+    expect_decoded("gb18030"sv, "\x81\x30\x81\x30\x90\x30\x81\x30"sv, "\xc2\x80\xf0\x90\x80\x80"sv);
+    // A lead byte followed by ASCII that can't be a trail byte, and a byte that can't start a sequence.
+    expect_decoded("gb18030"sv, "\xd2!\xff"sv, "�!�"sv);
+}
+
+TEST_CASE(test_decode_into_big5)
+{
+    expect_decoded("big5"sv, "\xa4\x40"sv, "一"sv);
+    expect_decoded("big5"sv, "\xa4" "0"sv, "�0"sv);
+}
+
+TEST_CASE(test_decode_into_euc_jp)
+{
+    expect_decoded("euc-jp"sv, "\xa4\xa2\x8e\xb1"sv, "あｱ"sv);
+    expect_decoded("euc-jp"sv, "\xa4x"sv, "�x"sv);
+}
+
+TEST_CASE(test_decode_into_shift_jis)
+{
+    expect_decoded("shift_jis"sv, "\x82\xa0\xb1"sv, "あｱ"sv);
+    expect_decoded("shift_jis"sv, "\x82" "0"sv, "�0"sv);
+}
+
+TEST_CASE(test_decode_into_euc_kr)
+{
+    expect_decoded("euc-kr"sv, "\xb0\xa1"sv, "가"sv);
+    expect_decoded("euc-kr"sv, "\xb0" "0"sv, "�0"sv);
+}
+
+TEST_CASE(test_decode_into_appends)
+{
+    auto decoder = TextCodec::decoder_for("shift_jis"sv);
+    VERIFY(decoder.has_value());
+
+    StringBuilder builder;
+    builder.append("prefix "sv);
+    // Bytes for U+3088 HIRAGANA LETTER YO and U+30C4 KATAKANA LETTER TU, followed by a lead byte with no trail byte.
+    MUST(decoder->decode_into("abc\x82\xe6\x83\x63xyz\x82"sv, builder));
+    EXPECT_EQ(builder.string_view(), "prefix abcよツxyz�"sv);
+}
+
+// Roughly 10 MiB of markup with the given text in between, encoded in the given encoding.
+static ByteBuffer benchmark_document(StringView encoding, StringView text)
+{
+    StringBuilder builder;
+    while (builder.length() < 10 * MiB)
+        builder.appendff("<p class=\"paragraph\"><a href=\"/wiki/Page\">{}</a> {}</p>\n", text, text);
+
+    auto encoder = TextCodec::encoder_for(encoding);
+    VERIFY(encoder.has_value());
+
+    ByteBuffer document;
+    MUST(encoder->encode_into(Utf8View { builder.string_view() }, document, [](u32) -> ErrorOr<void> { VERIFY_NOT_REACHED(); }));
+    return document;
+}
+
+static void benchmark_decoding(StringView encoding, StringView text)
+{
+    auto document = benchmark_document(encoding, text);
+    auto decoder = TextCodec::decoder_for(encoding);
+    VERIFY(decoder.has_value());
+
+    auto decoded = MUST(decoder->to_utf8(StringView { document }));
+    EXPECT(decoded.bytes().size() >= document.size());
+}
+
+BENCHMARK_CASE(decode_windows_1252)
+{
+    benchmark_decoding("windows-1252"sv, "Café au lait, crème brûlée et déjà vu"sv);
+}
+
+BENCHMARK_CASE(decode_iso_8859_2)
+{
+    benchmark_decoding("iso-8859-2"sv, "Příliš žluťoučký kůň úpěl ďábelské ódy"sv);
+}
+
+BENCHMARK_CASE(decode_gb18030)
+{
+    benchmark_decoding("gb18030"sv, "维基百科是一个自由的百科全书"sv);
+}
+
+BENCHMARK_CASE(decode_big5)
+{
+    benchmark_decoding("big5"sv, "維基百科是一個自由的百科全書"sv);
+}
+
+BENCHMARK_CASE(decode_euc_jp)
+{
+    benchmark_decoding("euc-jp"sv, "ウィキペディアはフリーな百科事典です"sv);
+}
+
+BENCHMARK_CASE(decode_shift_jis)
+{
+    benchmark_decoding("shift_jis"sv, "ウィキペディアはフリーな百科事典です"sv);
+}
+
+BENCHMARK_CASE(decode_euc_kr)
+{
+    benchmark_decoding("euc-kr"sv, "위키백과는 자유 백과사전입니다"sv);
+}
@@ -4,6 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteBuffer.h>
+#include <AK/StringBuilder.h>
+#include <AK/Utf8View.h>
 #include <LibTest/TestCase.h>
 #include <LibTextCodec/Encoder.h>
 
@@ -172,3 +175,104 @@ TEST_CASE(test_windows1252_encoder)
     EXPECT(processed_bytes[18] == 0x6F);
     EXPECT(processed_bytes[19] == 0x80);
 }
+
+// Text that every encoder below can only partially represent, with runs of ASCII of varying length in between.
+static constexpr auto mixed_test_text = "<p>ÀÁÂ€ and ¥ ‾</p> <a href=\"/wiki/Page\">ウィキペディア</a> 维基百科 維基百科 위키백과 😀 \xff\xfe broken\xe3\x81"sv;
+
+template<typename EncoderType>
+static void expect_encode_into_matches_process(EncoderType& encoder)
+{
+    for (size_t repeat = 1; repeat <= 4; ++repeat) {
+        StringBuilder builder;
+        for (size_t i = 0; i < repeat; ++i)
+            builder.append(mixed_test_text);
+        Utf8View input { builder.string_view() };
+
+        ByteBuffer expected;
+        Vector<u32> expected_errors;
+        MUST(encoder.process(
+            input,
+            [&](u8 byte) { return expected.try_append(byte); },
+            [&](u32 code_point) { return expected_errors.try_append(code_point); }));
+
+        ByteBuffer actual;
+        Vector<u32> actual_errors;
+        MUST(encoder.encode_into(input, actual, [&](u32 code_point) { return actual_errors.try_append(code_point); }));
+
+        EXPECT_EQ(actual.bytes(), expected.bytes());
+        EXPECT_EQ(actual_errors, expected_errors);
+    }
+}
+
+TEST_CASE(test_encode_into_matches_process)
+{
+    TextCodec::UTF8Encoder utf8_encoder;
+    expect_encode_into_matches_process(utf8_encoder);
+
+    TextCodec::EUCJPEncoder euc_jp_encoder;
+    expect_encode_into_matches_process(euc_jp_encoder);
+
+    TextCodec::ShiftJISEncoder shift_jis_encoder;
+    expect_encode_into_matches_process(shift_jis_encoder);
+
+    TextCodec::EUCKREncoder euc_kr_encoder;
+    expect_encode_into_matches_process(euc_kr_encoder);
+
+    TextCodec::Big5Encoder big5_encoder;
+    expect_encode_into_matches_process(big5_encoder);
+
+    TextCodec::GB18030Encoder gb18030_encoder;
+    expect_encode_into_matches_process(gb18030_encoder);
+
+    auto windows1252_encoder = TextCodec::encoder_for_exact_name("windows-1252"sv);
+    expect_encode_into_matches_process(windows1252_encoder.value());
+}
+
+static void benchmark_encoding(StringView encoding, StringView text)
+{
+    StringBuilder builder;
+    while (builder.length() < 10 * MiB)
+        builder.appendff("<p class=\"paragraph\"><a href=\"/wiki/Page\">{}</a> {}</p>\n", text, text);
+
+    auto encoder = TextCodec::encoder_for(encoding);
+    VERIFY(encoder.has_value());
+
+    ByteBuffer output;
+    MUST(encoder->encode_into(Utf8View { builder.string_view() }, output, [](u32) -> ErrorOr<void> { VERIFY_NOT_REACHED(); }));
+    EXPECT(!output.is_empty());
+}
+
+BENCHMARK_CASE(encode_utf8)
+{
+    benchmark_encoding("utf-8"sv, "Café au lait, crème brûlée et déjà vu"sv);
+}
+
+BENCHMARK_CASE(encode_windows_1252)
+{
+    benchmark_encoding("windows-1252"sv, "Café au lait, crème brûlée et déjà vu"sv);
+}
+
+BENCHMARK_CASE(encode_gb18030)
+{
+    benchmark_encoding("gb18030"sv, "维基百科是一个自由的百科全书"sv);
+}
+
+BENCHMARK_CASE(encode_big5)
+{
+    benchmark_encoding("big5"sv, "維基百科是一個自由的百科全書"sv);
+}
+
+BENCHMARK_CASE(encode_euc_jp)
+{
+    benchmark_encoding("euc-jp"sv, "ウィキペディアはフリーな百科事典です"sv);
+}
+
+BENCHMARK_CASE(encode_shift_jis)
+{
+    benchmark_encoding("shift_jis"sv, "ウィキペディアはフリーな百科事典です"sv);
+}
+
+BENCHMARK_CASE(encode_euc_kr)
+{
+    benchmark_encoding("euc-kr"sv, "위키백과는 자유 백과사전입니다"sv);
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Time.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Timer.h>
+#include <LibCrypto/Hash/PBKDF2.h>
+#include <LibThreading/ThreadPool.h>
+#include <pthread.h>
+
+static constexpr size_t derivation_count = 4;
+
+static ErrorOr<ByteBuffer> derive_key()
+{
+    // A realistic password hashing workload, in the range OWASP recommends for PBKDF2-HMAC-SHA256.
+    Crypto::Hash::PBKDF2 pbkdf2(Crypto::Hash::HashKind::SHA256);
+    return pbkdf2.derive_key("correct horse battery staple"sv.bytes(), "salt"sv.bytes(), 600'000, 32);
+}
+
+TEST_CASE(results_are_delivered_on_the_calling_event_loop)
+{
+    Core::EventLoop event_loop;
+    auto event_loop_thread = pthread_self();
+
+    Vector<ByteBuffer> results;
+    for (size_t i = 0; i < derivation_count; ++i) {
+        Threading::ThreadPool::the().run([] { return ByteBuffer::copy("result"sv.bytes()); }, [&](ErrorOr<ByteBuffer> result) {
+            EXPECT(pthread_equal(pthread_self(), event_loop_thread));
+            results.append(MUST(move(result)));
+            if (results.size() == derivation_count)
+                event_loop.quit(0);
+        });
+    }
+    event_loop.exec();
+
+    EXPECT_EQ(results.size(), derivation_count);
+    for (auto const& result : results)
+        EXPECT_EQ(result.bytes(), "result"sv.bytes());
+}
+
+TEST_CASE(errors_are_delivered_to_the_completion_handler)
+{
+    Core::EventLoop event_loop;
+
+    bool completed = false;
+    Threading::ThreadPool::the().run([]() -> ErrorOr<ByteBuffer> { return Error::from_string_literal("Failed to derive key"); }, [&](ErrorOr<ByteBuffer> result) {
+        EXPECT(result.is_error());
+        completed = true;
+        event_loop.quit(0);
+    });
+    event_loop.exec();
+
+    EXPECT(completed);
+}
+
+TEST_CASE(for_each_index_visits_every_index_once)
+{
+    for (size_t count : { 0, 1, 3, 1000 }) {
+        Vector<size_t> visits;
+        visits.resize(count);
+        Threading::ThreadPool::the().for_each_index(count, [&](size_t index) {
+            ++visits[index];
+        });
+        for (auto visit_count : visits)
+            EXPECT_EQ(visit_count, 1u);
+    }
+}
+
+// Measures the longest time the event loop went without servicing a 1 ms timer while the derivations ran. Before
+// SubtleCrypto handed its work to the thread pool, deriveBits() and friends ran on the event loop itself.
+static AK::Duration longest_event_loop_stall(Function<void(Function<void()> const& on_done)> start_derivations)
+{
+    Core::EventLoop event_loop;
+    Function<void()> on_done = [&] { event_loop.quit(0); };
+
+    auto last_tick = MonotonicTime::now();
+    AK::Duration longest_stall;
+    auto record_stall = [&] {
+        auto now = MonotonicTime::now();
+        longest_stall = max(longest_stall, now - last_tick);
+        last_tick = now;
+    };
+    auto timer = Core::Timer::create_repeating(1, [&] { record_stall(); });
+    timer->start();
+
+    event_loop.deferred_invoke([&] {
+        record_stall();
+        start_derivations(on_done);
+    });
+    event_loop.exec();
+    record_stall();
+
+    return longest_stall;
+}
+
+BENCHMARK_CASE(derive_keys_on_event_loop)
+{
+    auto stall = longest_event_loop_stall([](auto const& on_done) {
+        for (size_t i = 0; i < derivation_count; ++i)
+            EXPECT(!derive_key().is_error());
+        on_done();
+    });
+    outln("Longest event loop stall deriving keys on the event loop: {} ms", stall.to_milliseconds());
+}
+
+BENCHMARK_CASE(derive_keys_on_thread_pool)
+{
+    size_t completed = 0;
+    auto stall = longest_event_loop_stall([&](auto const& on_done) {
+        for (size_t i = 0; i < derivation_count; ++i) {
+            Threading::ThreadPool::the().run(derive_key, [&completed, &on_done](ErrorOr<ByteBuffer> result) {
+                EXPECT(!result.is_error());
+                if (++completed == derivation_count)
+                    on_done();
+            });
+        }
+    });
+    outln("Longest event loop stall deriving keys on the thread pool: {} ms", stall.to_milliseconds());
+}
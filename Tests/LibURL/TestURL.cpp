@@ -604,3 +604,127 @@ TEST_CASE(get_registrable_domain)
         EXPECT_EQ(*domain, "ladybird.github.io"sv);
     }
 }
+
+TEST_CASE(canonical_special_urls)
+{
+    auto urls = to_array({
+        "https://example.com/"sv,
+        "http://example.com:8080/a/b/"sv,
+        "https://sub.example-site.co.uk/path/to/file.html?x=1&y=%20z#section-2"sv,
+        "wss://example.com/socket?"sv,
+        "https://example.com/#"sv,
+        "https://example.com/a%2Fb/%zz|[]?q=a?b#frag#ment"sv,
+        "ftp://example.com:2121/pub/"sv,
+    });
+    for (auto input : urls) {
+        auto url = URL::Parser::basic_parse(input);
+        VERIFY(url.has_value());
+        EXPECT_EQ(url->serialize(), input);
+    }
+
+    auto url = URL::Parser::basic_parse("http://example.com:8080/a/b/?q#f"sv);
+    VERIFY(url.has_value());
+    EXPECT_EQ(url->scheme(), "http"sv);
+    EXPECT_EQ(url->serialized_host(), "example.com"sv);
+    EXPECT_EQ(url->port(), 8080);
+    EXPECT_EQ(url->path_segment_count(), 3u);
+    EXPECT_EQ(url->paths()[2], ""sv);
+    EXPECT_EQ(url->query(), "q"sv);
+    EXPECT_EQ(url->fragment(), "f"sv);
+}
+
+TEST_CASE(almost_canonical_special_urls)
+{
+    auto expect_parses_to = [](StringView input, StringView expected) {
+        auto url = URL::Parser::basic_parse(input);
+        VERIFY(url.has_value());
+        EXPECT_EQ(url->serialize(), expected);
+    };
+
+    expect_parses_to("HTTPS://Example.COM/"sv, "https://example.com/"sv);
+    expect_parses_to("https://example.com"sv, "https://example.com/"sv);
+    expect_parses_to("https://example.com:443/"sv, "https://example.com/"sv);
+    expect_parses_to("http://example.com:080/"sv, "http://example.com/"sv);
+    expect_parses_to("http://example.com:/"sv, "http://example.com/"sv);
+    expect_parses_to("https://example.com/a/./b/../c"sv, "https://example.com/a/c"sv);
+    expect_parses_to("https://example.com/a/%2e%2E/c"sv, "https://example.com/c"sv);
+    expect_parses_to("https://example.com/a b?c d#e f"sv, "https://example.com/a%20b?c%20d#e%20f"sv);
+    expect_parses_to("https://example.com/it's?it's"sv, "https://example.com/it's?it%27s"sv);
+    expect_parses_to("https://example.com\\a\\b"sv, "https://example.com/a/b"sv);
+    expect_parses_to("https://user@example.com/"sv, "https://user@example.com/"sv);
+    expect_parses_to("https://0x7f.1/"sv, "https://127.0.0.1/"sv);
+    expect_parses_to("https://192.168.0.1/"sv, "https://192.168.0.1/"sv);
+    expect_parses_to(" https://example.com/\t"sv, "https://example.com/"sv);
+
+    EXPECT(!URL::Parser::basic_parse("https://example.com:65536/"sv).has_value());
+    EXPECT(!URL::Parser::basic_parse("https://256.256.256.256/"sv).has_value());
+}
+
+TEST_CASE(parse_cache)
+{
+    auto base_url = URL::Parser::basic_parse("https://example.com/a/b"sv);
+    VERIFY(base_url.has_value());
+    auto other_base_url = URL::Parser::basic_parse("https://example.org/x/y"sv);
+    VERIFY(other_base_url.has_value());
+
+    for (size_t i = 0; i < 2; ++i) {
+        EXPECT_EQ(base_url->complete_url("c"sv)->serialize(), "https://example.com/a/c"sv);
+        EXPECT_EQ(other_base_url->complete_url("c"sv)->serialize(), "https://example.org/x/c"sv);
+        EXPECT(!URL::Parser::basic_parse("c"sv).has_value());
+    }
+
+    // A base URL that changes after a parse must not be mistaken for the one that was cached.
+    base_url->set_paths({ "d", "e" });
+    EXPECT_EQ(base_url->complete_url("c"sv)->serialize(), "https://example.com/d/c"sv);
+
+    // Parsing with a non-UTF-8 encoding only affects the query, and must not reuse the UTF-8 result.
+    auto utf8_url = URL::Parser::basic_parse("?\xc3\xa9"sv, *base_url);
+    VERIFY(utf8_url.has_value());
+    EXPECT_EQ(utf8_url->query(), "%C3%A9"sv);
+    auto latin1_url = URL::Parser::basic_parse("?\xc3\xa9"sv, *base_url, nullptr, {}, "windows-1252"sv);
+    VERIFY(latin1_url.has_value());
+    EXPECT_EQ(latin1_url->query(), "%E9"sv);
+}
+
+static constexpr auto benchmark_iterations = 100'000;
+
+BENCHMARK_CASE(parse_canonical_absolute_urls)
+{
+    auto urls = to_array({
+        "https://en.wikipedia.org/wiki/Main_Page"sv,
+        "https://upload.wikimedia.org/wikipedia/commons/thumb/a/a9/Example.jpg/120px-Example.jpg"sv,
+        "https://www.example.com/search?q=ladybird&hl=en#results"sv,
+    });
+    for (size_t i = 0; i < benchmark_iterations; ++i) {
+        auto url = URL::Parser::basic_parse(urls[i % urls.size()]);
+        VERIFY(url.has_value());
+    }
+}
+
+BENCHMARK_CASE(resolve_repeated_relative_urls)
+{
+    auto base_url = URL::Parser::basic_parse("https://www.example.com/articles/2025/index.html"sv);
+    VERIFY(base_url.has_value());
+    auto urls = to_array({
+        "../../static/css/main.css"sv,
+        "images/header.png"sv,
+        "/static/fonts/Inter.woff2"sv,
+        "?page=2"sv,
+        "#comments"sv,
+    });
+    for (size_t i = 0; i < benchmark_iterations; ++i) {
+        auto url = URL::Parser::basic_parse(urls[i % urls.size()], *base_url);
+        VERIFY(url.has_value());
+    }
+}
+
+BENCHMARK_CASE(resolve_distinct_relative_urls)
+{
+    auto base_url = URL::Parser::basic_parse("https://www.example.com/articles/2025/index.html"sv);
+    VERIFY(base_url.has_value());
+    for (size_t i = 0; i < benchmark_iterations; ++i) {
+        auto input = ByteString::formatted("../images/photo-{}.jpg?size=large", i);
+        auto url = URL::Parser::basic_parse(input, *base_url);
+        VERIFY(url.has_value());
+    }
+}
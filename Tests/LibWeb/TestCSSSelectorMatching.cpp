@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/StringBuilder.h>
+#include <LibCore/EventLoop.h>
+#include <LibWeb/Bindings/MainThreadVM.h>
+#include <LibWeb/CSS/CSSRuleList.h>
+#include <LibWeb/CSS/CSSStyleRule.h>
+#include <LibWeb/CSS/CSSStyleSheet.h>
+#include <LibWeb/CSS/Parser/Parser.h>
+#include <LibWeb/CSS/SelectorEngine.h>
+#include <LibWeb/DOM/ElementFactory.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/HTMLDocument.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Namespace.h>
+
+namespace Web {
+
+static GC::Root<HTML::HTMLDocument> create_document()
+{
+    static OwnPtr<Core::EventLoop> event_loop;
+    if (!event_loop) {
+        event_loop = make<Core::EventLoop>();
+        MUST(Bindings::initialize_main_thread_vm(HTML::EventLoop::Type::Window));
+    }
+    return GC::make_root(*HTML::HTMLDocument::create(*internal_css_realm()));
+}
+
+static GC::Ref<DOM::Element> append_element(DOM::Node& parent, FlyString const& tag_name, Optional<String> class_name = {}, Optional<String> id = {})
+{
+    auto element = MUST(DOM::create_element(parent.document(), tag_name, Namespace::HTML));
+    if (class_name.has_value())
+        MUST(element->set_attribute(HTML::AttributeNames::class_, *class_name));
+    if (id.has_value())
+        MUST(element->set_attribute(HTML::AttributeNames::id, *id));
+    MUST(parent.append_child(element));
+    return element;
+}
+
+static bool selector_matches(StringView selector_text, DOM::Element const& element)
+{
+    auto selectors = parse_selector(CSS::Parser::ParsingParams { element.document() }, selector_text);
+    VERIFY(selectors.has_value() && selectors->size() == 1);
+
+    SelectorEngine::MatchContext context;
+    return SelectorEngine::matches(selectors->first(), element, nullptr, context);
+}
+
+TEST_CASE(fast_match_shapes)
+{
+    auto document = create_document();
+    auto html = append_element(*document, HTML::TagNames::html);
+    auto container = append_element(html, HTML::TagNames::div, {}, "container"_string);
+    auto span = append_element(container, HTML::TagNames::span, "a b"_string);
+    auto paragraph = append_element(html, HTML::TagNames::p, "a"_string);
+
+    auto shape_of = [&](StringView selector_text) {
+        return parse_selector(CSS::Parser::ParsingParams { *document }, selector_text)->first()->fast_match_shape();
+    };
+    EXPECT_EQ(shape_of(".a"sv), CSS::Selector::FastMatchShape::Class);
+    EXPECT_EQ(shape_of("span.a"sv), CSS::Selector::FastMatchShape::TagNameAndClass);
+    EXPECT_EQ(shape_of(".a:hover"sv), CSS::Selector::FastMatchShape::ClassWithHover);
+    EXPECT_EQ(shape_of("#container .a"sv), CSS::Selector::FastMatchShape::ClassDescendantOfId);
+    EXPECT_EQ(shape_of("#container > .a"sv), CSS::Selector::FastMatchShape::Generic);
+    EXPECT_EQ(shape_of(".a.b"sv), CSS::Selector::FastMatchShape::Generic);
+
+    EXPECT(selector_matches(".a"sv, span));
+    EXPECT(selector_matches(".b"sv, span));
+    EXPECT(!selector_matches(".c"sv, span));
+
+    EXPECT(selector_matches("span.a"sv, span));
+    EXPECT(!selector_matches("p.b"sv, span));
+    EXPECT(!selector_matches("span.a"sv, paragraph));
+
+    EXPECT(!selector_matches(".a:hover"sv, span));
+
+    EXPECT(selector_matches("#container .b"sv, span));
+    EXPECT(!selector_matches("#container .a"sv, paragraph));
+    EXPECT(!selector_matches("#elsewhere .a"sv, span));
+}
+
+BENCHMARK_CASE(match_large_style_sheet_against_large_document)
+{
+    auto document = create_document();
+    auto html = append_element(*document, HTML::TagNames::html);
+    auto body = append_element(html, HTML::TagNames::body, {}, "body"_string);
+
+    Vector<GC::Ref<DOM::Element>> elements;
+    for (size_t section_index = 0; section_index < 100; ++section_index) {
+        auto section = append_element(body, HTML::TagNames::div, MUST(String::formatted("section s{}", section_index)), MUST(String::formatted("section-{}", section_index)));
+        elements.append(section);
+        for (size_t item_index = 0; item_index < 50; ++item_index) {
+            auto item = append_element(section, HTML::TagNames::span, MUST(String::formatted("item i{} c{}", item_index, (section_index + item_index) % 20)));
+            elements.append(item);
+        }
+    }
+
+    StringBuilder builder;
+    for (size_t i = 0; i < 200; ++i) {
+        builder.appendff(".c{} {{ color: red; }}\n", i);
+        builder.appendff("span.i{} {{ color: red; }}\n", i);
+        builder.appendff(".s{}:hover {{ color: red; }}\n", i);
+        builder.appendff("#section-{} .c{} {{ color: red; }}\n", i, i % 20);
+        builder.appendff("#body > div.s{} span {{ color: red; }}\n", i);
+    }
+    auto style_sheet = parse_css_stylesheet(CSS::Parser::ParsingParams { *document }, builder.string_view());
+
+    Vector<NonnullRefPtr<CSS::Selector>> selectors;
+    for (auto const& rule : style_sheet->rules()) {
+        if (auto const* style_rule = as_if<CSS::CSSStyleRule>(*rule))
+            selectors.extend(style_rule->selectors());
+    }
+
+    size_t match_count = 0;
+    for (auto const& element : elements) {
+        for (auto const& selector : selectors) {
+            SelectorEngine::MatchContext context;
+            if (SelectorEngine::matches(selector, element, nullptr, context))
+                ++match_count;
+        }
+    }
+    EXPECT(match_count > 0);
+}
+
+}
@@ -4,10 +4,56 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/FlyString.h>
+#include <AK/StringBuilder.h>
+#include <AK/Time.h>
 #include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
 #include <LibTest/TestCase.h>
+#include <LibWeb/Bindings/MainThreadVM.h>
+#include <LibWeb/CSS/CSSRuleList.h>
+#include <LibWeb/CSS/CSSStyleSheet.h>
+#include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/Parser/TokenStream.h>
+#include <stdlib.h>
+
+// Every allocation made through operator new is counted, so the benchmarks below can report how many allocations
+// parsing makes and how much memory is alive at its peak. The size of each block is stored in front of it.
+static constexpr size_t allocation_header_size = 16;
+static Atomic<size_t> s_allocation_count;
+static Atomic<size_t> s_live_bytes;
+static Atomic<size_t> s_peak_live_bytes;
+
+void* operator new(size_t size)
+{
+    auto* block = static_cast<u8*>(malloc(size + allocation_header_size));
+    VERIFY(block);
+    *reinterpret_cast<size_t*>(block) = size;
+
+    s_allocation_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    auto live_bytes = s_live_bytes.fetch_add(size, AK::MemoryOrder::memory_order_relaxed) + size;
+    auto peak_live_bytes = s_peak_live_bytes.load(AK::MemoryOrder::memory_order_relaxed);
+    while (live_bytes > peak_live_bytes && !s_peak_live_bytes.compare_exchange_strong(peak_live_bytes, live_bytes, AK::MemoryOrder::memory_order_relaxed))
+        ;
+
+    return block + allocation_header_size;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (!pointer)
+        return;
+
+    auto* block = static_cast<u8*>(pointer) - allocation_header_size;
+    s_live_bytes.fetch_sub(*reinterpret_cast<size_t*>(block), AK::MemoryOrder::memory_order_relaxed);
+    free(block);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    operator delete(pointer);
+}
 
 namespace Web::CSS::Parser {
 
@@ -95,4 +141,118 @@ TEST_CASE(marks)
     EXPECT_EQ(stream.remaining_token_count(), 7u);
 }
 
+TEST_CASE(tokenizer_backed)
+{
+    TokenStream<Token> stream { Tokenizer::create("a b"sv, "utf-8"sv) };
+    EXPECT(!stream.is_empty());
+
+    // Peeking ahead pulls tokens from the tokenizer without consuming them.
+    EXPECT(stream.peek_token(2).is(Token::Type::Ident));
+    EXPECT_EQ(stream.peek_token(2).ident(), "b"_fly_string);
+
+    auto const& first = stream.consume_a_token();
+    EXPECT(first.is(Token::Type::Ident));
+    EXPECT_EQ(first.ident(), "a"_fly_string);
+
+    stream.mark();
+    EXPECT(stream.consume_a_token().is(Token::Type::Whitespace));
+    EXPECT_EQ(stream.remaining_token_count(), 1u);
+    stream.restore_a_mark();
+    EXPECT_EQ(stream.remaining_token_count(), 2u);
+
+    // References to earlier tokens stay valid while later ones are pulled in.
+    EXPECT_EQ(first.ident(), "a"_fly_string);
+
+    stream.discard_a_token();
+    EXPECT_EQ(stream.consume_a_token().ident(), "b"_fly_string);
+    EXPECT(stream.is_empty());
+    EXPECT(stream.next_token().is(Token::Type::EndOfFile));
+}
+
+static String make_identifier_list(size_t count)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < count; ++i)
+        builder.appendff("a{} ", i);
+    return builder.to_string_without_validation();
+}
+
+TEST_CASE(tokenizer_backed_discard_consumed_tokens)
+{
+    // Token 2n is the identifier "a<n>", and token 2n+1 is the whitespace after it.
+    auto input = make_identifier_list(2000);
+    TokenStream<Token> stream { Tokenizer::create(input, "utf-8"sv) };
+
+    for (size_t i = 0; i < 1000; ++i)
+        stream.discard_a_token();
+
+    // Marked tokens are kept around.
+    stream.mark();
+    for (size_t i = 0; i < 1000; ++i)
+        stream.discard_a_token();
+    stream.discard_consumed_tokens();
+    stream.restore_a_mark();
+    EXPECT_EQ(stream.next_token().ident(), "a500"_fly_string);
+
+    // So are the tokens an open transaction may rewind to.
+    {
+        auto transaction = stream.begin_transaction();
+        for (size_t i = 0; i < 1000; ++i)
+            stream.discard_a_token();
+        stream.discard_consumed_tokens();
+    }
+    EXPECT_EQ(stream.next_token().ident(), "a500"_fly_string);
+
+    // Otherwise, everything before the current token can go.
+    for (size_t i = 0; i < 1000; ++i)
+        stream.discard_a_token();
+    stream.discard_consumed_tokens();
+    EXPECT(stream.current_token().is(Token::Type::Whitespace));
+    EXPECT_EQ(stream.next_token().ident(), "a1000"_fly_string);
+    EXPECT_EQ(stream.remaining_token_count(), 2000u);
+}
+
+static String make_large_style_sheet()
+{
+    // About 1.5 MiB, in the range of a large framework style sheet.
+    StringBuilder builder;
+    for (size_t i = 0; i < 20000; ++i)
+        builder.appendff(".rule-{} > span:hover {{ color: rgb({}, 20, 30); margin: {}px auto; }}\n", i, i % 256, i % 100);
+    return builder.to_string_without_validation();
+}
+
+static void measure(StringView description, Function<void()> const& callback)
+{
+    auto allocation_count_before = s_allocation_count.load();
+    auto live_bytes_before = s_live_bytes.load();
+    s_peak_live_bytes.store(live_bytes_before);
+
+    auto start = MonotonicTime::now();
+    callback();
+    auto elapsed = MonotonicTime::now() - start;
+
+    outln("{}: {} ms, {} allocations, {} KiB peak heap growth", description, elapsed.to_milliseconds(),
+        s_allocation_count.load() - allocation_count_before, (s_peak_live_bytes.load() - live_bytes_before) / KiB);
+}
+
+BENCHMARK_CASE(parse_large_stylesheet)
+{
+    Core::EventLoop event_loop;
+    MUST(Bindings::initialize_main_thread_vm(HTML::EventLoop::Type::Window));
+    ParsingParams parsing_params { *internal_css_realm() };
+
+    auto input = make_large_style_sheet();
+
+    // For comparison: what the parser used to hold before the first rule was parsed.
+    measure("Tokenize whole style sheet up front"sv, [&] {
+        auto tokens = Tokenizer::tokenize(input, "utf-8"sv);
+        EXPECT(tokens.size() > 20000);
+    });
+
+    measure("Parse style sheet"sv, [&] {
+        auto style_sheet = parse_css_stylesheet(parsing_params, input);
+        EXPECT_EQ(style_sheet->rules().length(), 20000u);
+    });
+}
+
 }
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListPlayerSkia.h>
+#include <LibWeb/Painting/DisplayListRecorder.h>
+
+namespace Web::Painting {
+
+static constexpr Gfx::IntSize page_size { 1280, 20000 };
+
+static void record_synthetic_page(DisplayListRecorder& recorder)
+{
+    for (int row = 0; row < page_size.height() / 20; ++row) {
+        recorder.save();
+        recorder.push_scroll_frame_id(row % 3 == 0 ? Optional<i32> { 0 } : Optional<i32> {});
+        recorder.add_clip_rect({ 0, row * 20, page_size.width(), 20 });
+        for (int column = 0; column < 16; ++column) {
+            Gfx::IntRect cell { column * 80, row * 20, 78, 18 };
+            recorder.fill_rect(cell, Color::from_rgb(row * 16 + column));
+            recorder.draw_rect(cell, Color::Black);
+        }
+        recorder.draw_line({ 0, row * 20 + 19 }, { page_size.width(), row * 20 + 19 }, Color::MidGray);
+        recorder.pop_scroll_frame_id();
+        recorder.restore();
+    }
+}
+
+static size_t count_commands(DisplayList const& display_list, DisplayList::CommandOffset begin = 0, Optional<DisplayList::CommandOffset> end = {})
+{
+    size_t count = 0;
+    display_list.for_each_command([&](Optional<i32>, auto const&) { ++count; }, begin, end);
+    return count;
+}
+
+TEST_CASE(append_and_iterate)
+{
+    auto display_list = DisplayList::create();
+    display_list->append(FillRect { { 0, 0, 10, 10 }, Color::Red }, {});
+    display_list->append(Save {}, 3);
+    auto middle = display_list->end_offset();
+    display_list->append(Translate { { 4, 5 } }, {});
+    display_list->append(Restore {}, 3);
+
+    EXPECT_EQ(display_list->command_count(), 4u);
+    EXPECT_EQ(count_commands(*display_list), 4u);
+    EXPECT_EQ(count_commands(*display_list, 0, middle), 2u);
+    EXPECT_EQ(count_commands(*display_list, middle), 2u);
+
+    Vector<Optional<i32>> scroll_frame_ids;
+    bool saw_translation = false;
+    display_list->for_each_command([&]<typename CommandType>(Optional<i32> scroll_frame_id, CommandType const& command) {
+        scroll_frame_ids.append(scroll_frame_id);
+        if constexpr (IsSame<CommandType, Translate>)
+            saw_translation = command.delta == Gfx::IntPoint { 4, 5 };
+    });
+    EXPECT(saw_translation);
+    EXPECT_EQ(scroll_frame_ids, (Vector<Optional<i32>> { {}, 3, {}, 3 }));
+
+    auto copy = DisplayList::create();
+    copy->append_commands_from(*display_list, middle, display_list->end_offset());
+    EXPECT_EQ(copy->command_count(), 2u);
+    EXPECT_EQ(count_commands(*copy), 2u);
+}
+
+TEST_CASE(commands_spanning_multiple_blocks)
+{
+    auto display_list = DisplayList::create();
+    DisplayListRecorder recorder(*display_list);
+    record_synthetic_page(recorder);
+
+    EXPECT(display_list->command_count() > 10'000u);
+    EXPECT_EQ(count_commands(*display_list), display_list->command_count());
+
+    // Blocks grow as the list does, so ranges that start and end in blocks of different sizes must still line up.
+    Vector<DisplayList::CommandOffset> offsets;
+    auto copy = DisplayList::create();
+    display_list->for_each_command([&](Optional<i32> scroll_frame_id, auto const& command) {
+        if (copy->command_count() % 1000 == 0)
+            offsets.append(copy->end_offset());
+        copy->append(command, scroll_frame_id);
+    });
+    offsets.append(copy->end_offset());
+
+    size_t total = 0;
+    for (size_t i = 1; i < offsets.size(); ++i)
+        total += count_commands(*copy, offsets[i - 1], offsets[i]);
+    EXPECT_EQ(total, display_list->command_count());
+}
+
+TEST_CASE(enclosing_state_group_end)
+{
+    auto display_list = DisplayList::create();
+    display_list->append(Save {}, {});
+    auto clip_offset = display_list->end_offset();
+    display_list->append(AddClipRect { { 0, 0, 10, 10 } }, {});
+    display_list->append(Save {}, {});
+    display_list->append(FillRect { { 0, 0, 10, 10 }, Color::Red }, {});
+    display_list->append(Restore {}, {});
+    display_list->append(PushStackingContext { .opacity = 1, .compositing_and_blending_operator = Gfx::CompositingAndBlendingOperator::Normal, .isolate = false, .source_paintable_rect = {}, .transform = {} }, {});
+    display_list->append(PopStackingContext {}, {});
+    auto restore_offset = display_list->end_offset();
+    display_list->append(Restore {}, {});
+    display_list->append(FillRect { { 0, 0, 10, 10 }, Color::Blue }, {});
+
+    EXPECT_EQ(display_list->offset_of_enclosing_state_group_end(clip_offset), restore_offset);
+    EXPECT(!display_list->offset_of_enclosing_state_group_end(0).has_value());
+
+    // A clip outside of any group is enclosed by the group the list is played back in, which ends at the first
+    // unmatched Restore or PopStackingContext. Unclosed groups have no end.
+    auto fragment = DisplayList::create();
+    auto top_level_clip_offset = fragment->end_offset();
+    fragment->append(AddClipRect { { 0, 0, 10, 10 } }, {});
+    fragment->append(Save {}, {});
+    fragment->append(Restore {}, {});
+    auto unmatched_restore_offset = fragment->end_offset();
+    fragment->append(Restore {}, {});
+    fragment->append(Save {}, {});
+    auto unclosed_clip_offset = fragment->end_offset();
+    fragment->append(AddClipRect { { 0, 0, 10, 10 } }, {});
+
+    EXPECT_EQ(fragment->offset_of_enclosing_state_group_end(top_level_clip_offset), unmatched_restore_offset);
+    EXPECT(!fragment->offset_of_enclosing_state_group_end(unclosed_clip_offset).has_value());
+}
+
+BENCHMARK_CASE(record_and_replay_large_synthetic_page)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { page_size.width(), 2000 }));
+    auto surface = Gfx::PaintingSurface::wrap_bitmap(*bitmap);
+    DisplayListPlayerSkia player;
+
+    for (size_t i = 0; i < 10; ++i) {
+        auto display_list = DisplayList::create();
+        display_list->set_device_pixels_per_css_pixel(1);
+        DisplayListRecorder recorder(*display_list);
+        record_synthetic_page(recorder);
+        player.execute(*display_list, {}, surface);
+    }
+}
+
+}
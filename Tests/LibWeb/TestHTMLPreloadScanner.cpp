@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibURL/Parser.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
+
+using Scanner = Web::HTML::HTMLPreloadScanner;
+
+static Vector<Scanner::Candidate> run_scanner(StringView input, Scanner::ScriptingEnabled scripting_enabled = Scanner::ScriptingEnabled::Yes)
+{
+    auto base_url = URL::Parser::basic_parse("https://example.com/dir/page.html"sv);
+    VERIFY(base_url.has_value());
+
+    Scanner scanner { input, base_url.release_value(), scripting_enabled };
+    return scanner.scan();
+}
+
+TEST_CASE(finds_scripts_stylesheets_and_images)
+{
+    auto candidates = run_scanner(R"(<html><head><link rel="stylesheet" href="style.css"><script src="/app.js"></script></head><body><img src="logo.png"></body></html>)"sv);
+    EXPECT_EQ(candidates.size(), 3u);
+
+    EXPECT_EQ(candidates[0].url.serialize(), "https://example.com/dir/style.css"sv);
+    EXPECT_EQ(candidates[0].destination, Scanner::Destination::Style);
+    EXPECT_EQ(candidates[0].priority, Scanner::Priority::High);
+
+    EXPECT_EQ(candidates[1].url.serialize(), "https://example.com/app.js"sv);
+    EXPECT_EQ(candidates[1].destination, Scanner::Destination::Script);
+
+    EXPECT_EQ(candidates[2].url.serialize(), "https://example.com/dir/logo.png"sv);
+    EXPECT_EQ(candidates[2].destination, Scanner::Destination::Image);
+    EXPECT_EQ(candidates[2].priority, Scanner::Priority::Low);
+}
+
+TEST_CASE(render_blocking_resources_come_first)
+{
+    auto candidates = run_scanner(R"(<img src="a.png"><script src="b.js"></script><img src="c.png"><link rel=stylesheet href="d.css">)"sv);
+    EXPECT_EQ(candidates.size(), 4u);
+    EXPECT_EQ(candidates[0].url.serialize(), "https://example.com/dir/b.js"sv);
+    EXPECT_EQ(candidates[1].url.serialize(), "https://example.com/dir/d.css"sv);
+    EXPECT_EQ(candidates[2].url.serialize(), "https://example.com/dir/a.png"sv);
+    EXPECT_EQ(candidates[3].url.serialize(), "https://example.com/dir/c.png"sv);
+}
+
+TEST_CASE(ignores_markup_inside_raw_text_elements)
+{
+    auto candidates = run_scanner(R"(<script>document.write('<img src="fake.png">');</script><style>/* <link rel=stylesheet href=fake.css> */</style><textarea><img src="fake2.png"></textarea><img src="real.png">)"sv);
+    EXPECT_EQ(candidates.size(), 1u);
+    EXPECT_EQ(candidates[0].url.serialize(), "https://example.com/dir/real.png"sv);
+}
+
+TEST_CASE(noscript_depends_on_scripting_flag)
+{
+    auto input = R"(<noscript><img src="fallback.png"></noscript>)"sv;
+    EXPECT_EQ(run_scanner(input, Scanner::ScriptingEnabled::Yes).size(), 0u);
+    EXPECT_EQ(run_scanner(input, Scanner::ScriptingEnabled::No).size(), 1u);
+}
+
+TEST_CASE(respects_base_element)
+{
+    auto candidates = run_scanner(R"(<base href="https://cdn.example.net/assets/"><base href="https://ignored.example/"><script src="x.js"></script>)"sv);
+    EXPECT_EQ(candidates.size(), 1u);
+    EXPECT_EQ(candidates[0].url.serialize(), "https://cdn.example.net/assets/x.js"sv);
+}
+
+TEST_CASE(skips_duplicates_non_network_and_non_script_types)
+{
+    auto candidates = run_scanner(R"(
+        <script src="a.js"></script>
+        <script src="a.js#fragment"></script>
+        <script type="text/template" src="template.html"></script>
+        <script type="module" src="module.js"></script>
+        <link rel="alternate stylesheet" href="alt.css">
+        <img src="data:image/png;base64,AAAA">
+        <img srcset="1x.png 1x, 2x.png 2x">
+    )"sv);
+    EXPECT_EQ(candidates.size(), 2u);
+    EXPECT_EQ(candidates[0].url.serialize(), "https://example.com/dir/a.js"sv);
+    EXPECT_EQ(candidates[1].url.serialize(), "https://example.com/dir/module.js"sv);
+}
+
+TEST_CASE(records_how_the_element_will_fetch)
+{
+    auto candidates = run_scanner(R"(
+        <script type="module" src="module.js"></script>
+        <script src="classic.js" crossorigin="use-credentials" referrerpolicy="no-referrer"></script>
+        <img src="image.png" crossorigin>
+    )"sv);
+    EXPECT_EQ(candidates.size(), 3u);
+
+    EXPECT(candidates[0].fetch_options.is_module_script);
+    EXPECT_EQ(candidates[0].fetch_options.cors_setting, Web::HTML::CORSSettingAttribute::NoCORS);
+
+    EXPECT(!candidates[1].fetch_options.is_module_script);
+    EXPECT_EQ(candidates[1].fetch_options.cors_setting, Web::HTML::CORSSettingAttribute::UseCredentials);
+    EXPECT_EQ(candidates[1].fetch_options.referrer_policy, Web::ReferrerPolicy::ReferrerPolicy::NoReferrer);
+
+    EXPECT_EQ(candidates[2].fetch_options.cors_setting, Web::HTML::CORSSettingAttribute::Anonymous);
+    EXPECT(!candidates[2].fetch_options.referrer_policy.has_value());
+}
@@ -218,6 +218,43 @@ TEST_CASE(hex_character_reference)
     END_ENUMERATION();
 }
 
+TEST_CASE(long_text_runs)
+{
+    auto tokens = run_tokenizer("<p>A fairly long run of text\r\nwith &amp; entity and \xc3\xa9 and a NUL \0 in it.</p>"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p, 1u, 2u);
+    EXPECT_CHARACTER_TOKENS(A fairly long run of text);
+    EXPECT_CHARACTER_TOKEN('\n');
+    EXPECT_CHARACTER_TOKENS(with);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKEN('&');
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKENS(entity and);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKEN(0xE9);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKENS(and a NUL);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKEN(0);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKENS(in it.);
+    EXPECT_END_TAG_TOKEN(p, 44u, 45u);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
+TEST_CASE(long_attribute_values)
+{
+    auto tokens = run_tokenizer("<a title=\"a long double-quoted value &amp; more\" alt='a long single-quoted value with \"quotes\" inside'>"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(a, 1u, 2u);
+    EXPECT_TAG_TOKEN_ATTRIBUTE(title, "a long double-quoted value & more"sv, 3u, 8u, 9u, 48u);
+    EXPECT_TAG_TOKEN_ATTRIBUTE(alt, "a long single-quoted value with \"quotes\" inside"sv, 49u, 52u, 53u, 102u);
+    EXPECT_TAG_TOKEN_ATTRIBUTE_COUNT(2);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
 TEST_CASE(comment)
 {
     auto tokens = run_tokenizer("<p><!-- This is a comment --></p>"sv);
@@ -253,3 +290,32 @@ TEST_CASE(regression)
     u32 hash = hash_tokens(tokens);
     EXPECT_EQ(hash, 3657343287u);
 }
+
+static ByteString make_large_document()
+{
+    // Roughly shaped like a long article: mostly prose, with links, inline formatting and attributes.
+    StringBuilder builder;
+    builder.append("<!DOCTYPE html><html><head><title>Benchmark</title></head><body>\n"sv);
+    for (size_t i = 0; i < 20'000; ++i) {
+        builder.appendff("<div class=\"article-paragraph paragraph-{}\" data-index=\"{}\">\n", i % 7, i);
+        builder.append("  <p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. "sv);
+        builder.append("Ut enim ad minim veniam, quis nostrud <a href=\"https://example.com/some/fairly/long/path?query=value&amp;other=thing\" title='A descriptive link title'>exercitation ullamco</a> laboris nisi ut aliquip ex ea commodo consequat. "sv);
+        builder.append("Duis aute irure dolor in <em>reprehenderit</em> in voluptate velit esse cillum dolore eu fugiat nulla pariatur &mdash; excepteur sint occaecat cupidatat non proident.</p>\n"sv);
+        builder.append("</div>\n"sv);
+    }
+    builder.append("</body></html>\n"sv);
+    return builder.to_byte_string();
+}
+
+BENCHMARK_CASE(tokenize_large_document)
+{
+    auto document = make_large_document();
+
+    for (size_t i = 0; i < 5; ++i) {
+        Tokenizer tokenizer { document, "UTF-8"sv };
+        size_t token_count = 0;
+        while (tokenizer.next_token().has_value())
+            ++token_count;
+        EXPECT(token_count > document.length() / 2);
+    }
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2025, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Math.h>
+#include <AK/Time.h>
+#include <LibThreading/ThreadPool.h>
+#include <LibWeb/WebAudio/AudioRenderer.h>
+#include <LibWeb/WebAudio/RenderNodes.h>
+
+namespace Web::WebAudio {
+
+static constexpr float sample_rate = 48000;
+
+static RenderGraph::ChannelConfiguration const stereo_destination {
+    .channel_count = 2,
+    .channel_count_mode = Bindings::ChannelCountMode::Explicit,
+    .channel_interpretation = Bindings::ChannelInterpretation::Speakers,
+};
+
+static NonnullRefPtr<RenderParam> param(float value)
+{
+    return RenderParam::create(value, -1e6f, 1e6f);
+}
+
+static NonnullRefPtr<ConstantSourceRenderNode> started_constant_source(float offset)
+{
+    auto source = ConstantSourceRenderNode::create(param(offset));
+    source->set_start_time(0);
+    return source;
+}
+
+static RenderContext context_for_quantum(u64 quantum_index)
+{
+    return { .sample_rate = sample_rate, .current_frame = quantum_index * RENDER_QUANTUM_SIZE };
+}
+
+TEST_CASE(gain_and_up_mixing)
+{
+    RenderGraph graph;
+    auto source = graph.add_node(started_constant_source(0.5f), {}, {});
+    auto gain = graph.add_node(GainRenderNode::create(param(2)), {}, { source });
+    graph.add_node(PassThroughRenderNode::create(), stereo_destination, { gain });
+
+    graph.render_quantum(context_for_quantum(0));
+
+    auto const& output = graph.output();
+    EXPECT_EQ(output.channel_count(), 2u);
+    for (size_t channel = 0; channel < 2; ++channel) {
+        for (auto sample : output.channel(channel))
+            EXPECT_EQ(sample, 1.0f);
+    }
+}
+
+TEST_CASE(scheduled_source_is_sample_accurate)
+{
+    RenderGraph graph;
+    auto source = ConstantSourceRenderNode::create(param(1));
+    source->set_start_time(10.0 / sample_rate);
+    source->set_stop_time(20.0 / sample_rate);
+    graph.add_node(source, {}, {});
+
+    graph.render_quantum(context_for_quantum(0));
+
+    auto samples = graph.output().channel(0);
+    EXPECT_EQ(samples[9], 0.0f);
+    EXPECT_EQ(samples[10], 1.0f);
+    EXPECT_EQ(samples[19], 1.0f);
+    EXPECT_EQ(samples[20], 0.0f);
+}
+
+static float steady_state_peak_through_filter(float oscillator_frequency, Bindings::BiquadFilterType type)
+{
+    RenderGraph graph;
+    auto oscillator = OscillatorRenderNode::create(Bindings::OscillatorType::Sine, param(oscillator_frequency), param(0));
+    oscillator->set_start_time(0);
+    auto source = graph.add_node(oscillator, {}, {});
+    graph.add_node(BiquadFilterRenderNode::create(type, param(500), param(0), param(1), param(0)), {}, { source });
+
+    float peak = 0;
+    for (u64 quantum = 0; quantum < 100; ++quantum) {
+        graph.render_quantum(context_for_quantum(quantum));
+        if (quantum < 50)
+            continue;
+        for (auto sample : graph.output().channel(0))
+            peak = max(peak, AK::fabs(sample));
+    }
+    return peak;
+}
+
+TEST_CASE(biquad_filter_attenuates_stop_band)
+{
+    EXPECT(steady_state_peak_through_filter(100, Bindings::BiquadFilterType::Lowpass) > 0.9f);
+    EXPECT(steady_state_peak_through_filter(10000, Bindings::BiquadFilterType::Lowpass) < 0.01f);
+    EXPECT(steady_state_peak_through_filter(10000, Bindings::BiquadFilterType::Highpass) > 0.9f);
+    EXPECT(steady_state_peak_through_filter(50, Bindings::BiquadFilterType::Highpass) < 0.02f);
+}
+
+TEST_CASE(delay_shifts_signal)
+{
+    RenderGraph graph;
+    auto source = graph.add_node(started_constant_source(1), {}, {});
+    graph.add_node(DelayRenderNode::create(param(100 / sample_rate), 1), {}, { source });
+
+    graph.render_quantum(context_for_quantum(0));
+    EXPECT_EQ(graph.output().channel(0)[99], 0.0f);
+    EXPECT_APPROXIMATE_WITH_ERROR(graph.output().channel(0)[100], 1.0f, 1e-4f);
+
+    graph.render_quantum(context_for_quantum(1));
+    EXPECT_APPROXIMATE_WITH_ERROR(graph.output().channel(0)[0], 1.0f, 1e-4f);
+}
+
+TEST_CASE(dynamics_compressor_reduces_loud_input)
+{
+    RenderGraph graph;
+    auto source = graph.add_node(started_constant_source(1), {}, {});
+    auto compressor = DynamicsCompressorRenderNode::create({
+        .threshold = param(-24),
+        .knee = param(30),
+        .ratio = param(12),
+        .attack = param(0.003f),
+        .release = param(0.25f),
+    });
+    graph.add_node(compressor, {}, { source });
+
+    for (u64 quantum = 0; quantum < 200; ++quantum)
+        graph.render_quantum(context_for_quantum(quantum));
+
+    EXPECT(compressor->reduction() < -10);
+    EXPECT(graph.output().channel(0)[0] < 1);
+}
+
+TEST_CASE(renderer_switches_graphs_between_quanta)
+{
+    auto renderer = AudioRenderer::create();
+    renderer->set_sample_rate(sample_rate);
+
+    // Without a graph, the renderer outputs silence.
+    Array<float, 300 * 2> buffer;
+    EXPECT_EQ(renderer->render_interleaved(buffer.span(), 2), 300u);
+    EXPECT_EQ(buffer[0], 0.0f);
+
+    auto graph = make<RenderGraph>();
+    auto source = graph->add_node(started_constant_source(1), {}, {});
+    graph->add_node(PassThroughRenderNode::create(), stereo_destination, { source });
+    renderer->set_graph(move(graph));
+
+    // The frames left over from the previous quantum come first, then those rendered with the new graph.
+    EXPECT_EQ(renderer->render_interleaved(buffer.span(), 2), 300u);
+    EXPECT_EQ(buffer[0], 0.0f);
+    EXPECT_EQ(buffer[buffer.size() - 1], 1.0f);
+
+    renderer->set_graph(make<RenderGraph>());
+    renderer->render_quantum();
+    renderer->destroy_retired_graphs();
+    EXPECT_EQ(renderer->rendered_frame_count(), 6 * RENDER_QUANTUM_SIZE);
+}
+
+// Independent oscillator -> filter -> gain branches, mixed into a stereo destination.
+static NonnullOwnPtr<RenderGraph> create_branching_graph(size_t branch_count)
+{
+    auto graph = make<RenderGraph>();
+    Vector<size_t> gains;
+    for (size_t branch = 0; branch < branch_count; ++branch) {
+        auto oscillator = OscillatorRenderNode::create(Bindings::OscillatorType::Sawtooth, param(110 * (branch + 1)), param(0));
+        oscillator->set_start_time(0);
+        auto source = graph->add_node(oscillator, {}, {});
+        auto filter = graph->add_node(BiquadFilterRenderNode::create(Bindings::BiquadFilterType::Lowpass, param(2000), param(0), param(1), param(0)), {}, { source });
+        gains.append(graph->add_node(GainRenderNode::create(param(1.0f / branch_count)), {}, { filter }));
+    }
+    graph->add_node(PassThroughRenderNode::create(), stereo_destination, move(gains));
+    return graph;
+}
+
+static Vector<Vector<float>> render_offline(size_t branch_count, size_t frame_count, Threading::ThreadPool* thread_pool)
+{
+    auto renderer = AudioRenderer::create();
+    renderer->set_sample_rate(sample_rate);
+    renderer->set_graph(create_branching_graph(branch_count));
+
+    Vector<Vector<float>> channels;
+    channels.resize(2);
+    for (auto& channel : channels)
+        channel.resize(frame_count);
+    renderer->render_planar(channels, thread_pool);
+    return channels;
+}
+
+TEST_CASE(offline_rendering_matches_real_time_rendering)
+{
+    static constexpr size_t frame_count = 100 * RENDER_QUANTUM_SIZE + 17;
+
+    auto renderer = AudioRenderer::create();
+    renderer->set_sample_rate(sample_rate);
+    renderer->set_graph(create_branching_graph(4));
+    Vector<float> interleaved;
+    interleaved.resize(frame_count * 2);
+    renderer->render_interleaved(interleaved.span(), 2);
+
+    for (auto* pool : { static_cast<Threading::ThreadPool*>(nullptr), &Threading::ThreadPool::the() }) {
+        auto channels = render_offline(4, frame_count, pool);
+        for (size_t frame = 0; frame < frame_count; ++frame) {
+            EXPECT_EQ(channels[0][frame], interleaved[frame * 2]);
+            EXPECT_EQ(channels[1][frame], interleaved[frame * 2 + 1]);
+        }
+    }
+}
+
+BENCHMARK_CASE(render_offline_graph)
+{
+    static constexpr size_t seconds = 30;
+    static constexpr size_t branch_count = 16;
+    static constexpr size_t frame_count = seconds * static_cast<size_t>(sample_rate);
+
+    auto report_realtime_factor = [](StringView label, Threading::ThreadPool* thread_pool) {
+        auto start = MonotonicTime::now();
+        auto channels = render_offline(branch_count, frame_count, thread_pool);
+        auto elapsed = MonotonicTime::now() - start;
+        EXPECT_EQ(channels[0].size(), frame_count);
+        outln("{}: rendered {}s of audio in {}ms ({:.1}x realtime)", label, seconds, elapsed.to_milliseconds(),
+            static_cast<double>(seconds) * 1000 / max<i64>(elapsed.to_milliseconds(), 1));
+    };
+
+    report_realtime_factor("Single thread"sv, nullptr);
+    report_realtime_factor("Thread pool"sv, &Threading::ThreadPool::the());
+}
+
+}
@@ -5,6 +5,10 @@
  */
 
 #include <LibTest/TestCase.h>
+
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <AK/Time.h>
 #include <LibXML/Parser/Parser.h>
 
 TEST_CASE(char_data_ending)
@@ -47,3 +51,174 @@ TEST_CASE(unicode_name)
     XML::Parser parser("<div 中文=\"\"></div>"sv);
     TRY_OR_FAIL(parser.parse());
 }
+
+struct RecordingListener final : public XML::Listener {
+    virtual void document_start() override { events.append("document_start"); }
+    virtual void document_end() override { events.append("document_end"); }
+    virtual void element_start(XML::Name const& name, HashMap<XML::Name, ByteString> const& attributes) override
+    {
+        Vector<ByteString> sorted_attributes;
+        for (auto const& attribute : attributes)
+            sorted_attributes.append(ByteString::formatted("{}={}", attribute.key, attribute.value));
+        quick_sort(sorted_attributes);
+        events.append(ByteString::formatted("element_start {} [{}]", name, ByteString::join(","sv, sorted_attributes)));
+    }
+    virtual void element_end(XML::Name const& name) override { events.append(ByteString::formatted("element_end {}", name)); }
+    virtual void text(StringView text) override { events.append(ByteString::formatted("text {}", text)); }
+    virtual void comment(StringView text) override { events.append(ByteString::formatted("comment {}", text)); }
+    virtual void error(XML::ParseError const&) override { events.append("error"); }
+
+    Vector<ByteString> events;
+};
+
+static ErrorOr<Vector<ByteString>, XML::ParseError> events_from_feeding(StringView source, size_t chunk_size)
+{
+    RecordingListener listener;
+    XML::Parser parser(listener, { .preserve_comments = true });
+    for (size_t offset = 0; offset < source.length(); offset += chunk_size)
+        TRY(parser.feed(source.substring_view(offset, min(chunk_size, source.length() - offset))));
+    TRY(parser.finish());
+    return listener.events;
+}
+
+TEST_CASE(incremental_parsing_matches_whole_document_parsing)
+{
+    auto source = R"~~~(<?xml version="1.0"?>
+<!DOCTYPE svg>
+<!-- A comment with a <fake> tag -->
+<svg xmlns="http://www.w3.org/2000/svg" viewBox='0 0 10 10'>
+    <g id="group" data-text="a > b">
+        <rect x="1" y="2"/>
+        <text>Fish &amp; chips &#x41;<![CDATA[<not a tag>]]></text>
+        <?target data?>
+    </g>
+</svg>
+<!-- trailing -->
+)~~~"sv;
+
+    RecordingListener expected_listener;
+    XML::Parser whole_document_parser(source, { .preserve_comments = true });
+    TRY_OR_FAIL(whole_document_parser.parse_with_listener(expected_listener));
+    EXPECT(!expected_listener.events.contains_slow("error"sv));
+
+    for (size_t chunk_size : { 1uz, 2uz, 7uz, 64uz, source.length() })
+        EXPECT_EQ(TRY_OR_FAIL(events_from_feeding(source, chunk_size)), expected_listener.events);
+}
+
+TEST_CASE(incremental_parsing_reports_errors)
+{
+    {
+        RecordingListener listener;
+        XML::Parser parser(listener, {});
+        TRY_OR_FAIL(parser.feed("<a><b>"sv));
+        EXPECT(parser.feed("</a>"sv).is_error());
+        EXPECT_EQ(listener.events.last(), "document_end");
+        EXPECT(listener.events.contains_slow("error"sv));
+    }
+    {
+        RecordingListener listener;
+        XML::Parser parser(listener, {});
+        TRY_OR_FAIL(parser.feed("<a>text"sv));
+        EXPECT(parser.finish().is_error());
+    }
+    {
+        RecordingListener listener;
+        XML::Parser parser(listener, {});
+        TRY_OR_FAIL(parser.feed("<a/>"sv));
+        EXPECT(parser.feed("<b/>"sv).is_error());
+    }
+}
+
+TEST_CASE(incremental_parsing_parses_the_prolog_once)
+{
+    auto source = R"~~~(<?xml version="1.0"?>
+<!DOCTYPE doc SYSTEM "doc.dtd" [
+    <!-- A comment with ] and > in it -->
+    <!ENTITY greeting "hello > world ]">
+    <?target ]>?>
+]>
+<doc>&greeting;</doc>
+)~~~"sv;
+
+    size_t resolve_count = 0;
+    auto options = [&] {
+        return XML::Parser::Options {
+            .resolve_external_resource = [&](auto&, auto&) -> ErrorOr<Variant<ByteString, Vector<XML::MarkupDeclaration>>> {
+                ++resolve_count;
+                return ByteString {};
+            },
+        };
+    };
+
+    RecordingListener expected_listener;
+    XML::Parser whole_document_parser(source, options());
+    TRY_OR_FAIL(whole_document_parser.parse_with_listener(expected_listener));
+    EXPECT(expected_listener.events.contains_slow("text hello > world ]"sv));
+
+    for (size_t chunk_size : { 1uz, 3uz, 16uz, source.length() }) {
+        resolve_count = 0;
+        RecordingListener listener;
+        XML::Parser parser(listener, options());
+        for (size_t offset = 0; offset < source.length(); offset += chunk_size)
+            TRY_OR_FAIL(parser.feed(source.substring_view(offset, min(chunk_size, source.length() - offset))));
+        TRY_OR_FAIL(parser.finish());
+
+        EXPECT_EQ(resolve_count, 1u);
+        EXPECT_EQ(listener.events, expected_listener.events);
+    }
+}
+
+TEST_CASE(incremental_parsing_reports_offsets_in_the_whole_document)
+{
+    RecordingListener listener;
+    XML::Parser parser(listener, {});
+    TRY_OR_FAIL(parser.feed("<a>\n"sv));
+    TRY_OR_FAIL(parser.feed("<b/>"sv));
+    auto result = parser.feed("</a>!"sv);
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().position.offset, 12u);
+    EXPECT_EQ(result.error().position.line, 2u);
+}
+
+static ByteString generate_large_svg()
+{
+    StringBuilder builder;
+    builder.append("<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 1000 1000\">\n"sv);
+    for (size_t i = 0; i < 50'000; ++i) {
+        builder.appendff("<g id=\"group-{}\" transform=\"translate({} {})\">", i, i % 1000, i / 1000);
+        builder.appendff("<path d=\"M {} {} L {} {} Z\" fill=\"#{:06x}\" stroke-width=\"1.5\"/>", i % 97, i % 89, i % 83, i % 79, i * 2654435761u % 0xffffff);
+        builder.appendff("<text x=\"{}\" y=\"{}\">Label &amp; {}</text></g>\n", i % 1000, i / 1000, i);
+    }
+    builder.append("</svg>\n"sv);
+    return builder.to_byte_string();
+}
+
+BENCHMARK_CASE(parse_large_svg)
+{
+    auto source = generate_large_svg();
+
+    auto report = [&](StringView name, auto parse) {
+        auto start = MonotonicTime::now();
+        parse();
+        auto elapsed = MonotonicTime::now() - start;
+        auto megabytes = static_cast<double>(source.length()) / MiB;
+        outln("{}: {:.1} MiB/s", name, megabytes / (static_cast<double>(elapsed.to_microseconds()) / 1'000'000));
+    };
+
+    report("Document tree"sv, [&] {
+        XML::Parser parser(source);
+        TRY_OR_FAIL(parser.parse());
+    });
+    report("Listener"sv, [&] {
+        XML::Listener listener;
+        XML::Parser parser(source);
+        TRY_OR_FAIL(parser.parse_with_listener(listener));
+    });
+    report("Listener, fed in 16 KiB chunks"sv, [&] {
+        XML::Listener listener;
+        XML::Parser parser(listener, {});
+        for (size_t offset = 0; offset < source.length(); offset += 16 * KiB)
+            TRY_OR_FAIL(parser.feed(source.substring_view(offset, min(16 * KiB, source.length() - offset))));
+        TRY_OR_FAIL(parser.finish());
+    });
+}